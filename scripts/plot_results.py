@@ -185,6 +185,58 @@ def plot_cost_curve():
         print(f"⚠ Erreur lors de la création de la courbe de coût: {e}")
         return False
 
+def plot_decision_curves():
+    """Visualise ROC, précision-rappel et gains cumulés depuis le balayage des seuils du code C"""
+    print("\n📊 Génération des courbes ROC, précision-rappel et gains...")
+    
+    roc_files = {'Régression Logistique': Path("results/plots/roc_data.csv"),
+                 'Arbre de Décision': Path("results/plots/dt_roc_data.csv")}
+    roc_files = {name: path for name, path in roc_files.items()
+                 if path.exists() and path.stat().st_size > 0}
+    if not roc_files:
+        print("⚠ Fichier roc_data.csv non trouvé. Exécutez d'abord ./build/credit_risk_predictor")
+        return False
+    
+    try:
+        fig, axes = plt.subplots(1, 3, figsize=(18, 6))
+        
+        for name, path in roc_files.items():
+            df = pd.read_csv(path)
+            # Aire sous la courbe recalculée sur les points exportés (sous-échantillonnés)
+            auc = np.trapz(df['tpr'], df['fpr'])
+            axes[0].plot(df['fpr'], df['tpr'], linewidth=2, label=f'{name} (AUC≈{auc:.3f})')
+            axes[1].plot(df['tpr'], df['precision'], linewidth=2, label=name)
+            axes[2].plot(df['population'], df['tpr'], linewidth=2, label=name)
+        
+        axes[0].plot([0, 1], [0, 1], 'k--', alpha=0.5, label='Aléatoire')
+        axes[0].set_xlabel('Taux de faux positifs', fontweight='bold')
+        axes[0].set_ylabel('Taux de vrais positifs', fontweight='bold')
+        axes[0].set_title('Courbe ROC', fontsize=14, fontweight='bold')
+        
+        axes[1].set_xlabel('Rappel', fontweight='bold')
+        axes[1].set_ylabel('Précision', fontweight='bold')
+        axes[1].set_title('Courbe Précision-Rappel', fontsize=14, fontweight='bold')
+        
+        axes[2].plot([0, 1], [0, 1], 'k--', alpha=0.5, label='Aléatoire')
+        axes[2].set_xlabel('Part de la population ciblée', fontweight='bold')
+        axes[2].set_ylabel('Part des défauts captés', fontweight='bold')
+        axes[2].set_title('Gains Cumulés', fontsize=14, fontweight='bold')
+        
+        for ax in axes:
+            ax.set_xlim(0, 1)
+            ax.set_ylim(0, 1.02)
+            ax.grid(True, alpha=0.3)
+            ax.legend(loc='lower right')
+        
+        plt.tight_layout()
+        plt.savefig('results/plots/decision_curves.png', dpi=300)
+        print("✓ Graphique sauvegardé: results/plots/decision_curves.png")
+        
+        return True
+    except Exception as e:
+        print(f"⚠ Erreur lors de la création des courbes: {e}")
+        return False
+
 def plot_feature_importance():
     """Visualise l'importance des features (poids du modèle)"""
     print("\n📊 Génération du graphique d'importance des features...")
@@ -340,6 +392,9 @@ def main():
     if plot_cost_curve():
         success_count += 1
     
+    if plot_decision_curves():
+        success_count += 1
+    
     if plot_feature_importance():
         success_count += 1
     
@@ -347,12 +402,13 @@ def main():
     success_count += 1
     
     print("\n" + "=" * 60)
-    print(f"✓ VISUALISATION TERMINÉE ({success_count}/5 graphiques générés)")
+    print(f"✓ VISUALISATION TERMINÉE ({success_count}/6 graphiques générés)")
     print("=" * 60)
     print("\nFichiers générés:")
     print("  - results/plots/confusion_matrix_visual.png")
     print("  - results/plots/metrics_comparison.png")
     print("  - results/plots/cost_curve_visual.png")
+    print("  - results/plots/decision_curves.png")
     print("  - results/plots/feature_importance_visual.png")
     print("  - results/plots/summary_figure.png")
     print()
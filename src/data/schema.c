@@ -0,0 +1,426 @@
+/*****************************************************************************************************
+
+Nom : src/data/schema.c
+
+Rôle : Chargement CSV piloté par un schéma (noms, types, encodeurs, label, colonnes ignorées) via un plan de parsing
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "schema.h"
+#include "../utils/memory_manager.h"
+#include "../utils/utils.h"
+#include <math.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCHEMA_LINE_SIZE 8192
+
+typedef struct ParseStep ParseStep;
+
+// Traitement d'une cellule : choisi une fois par colonne du CSV, appelé sans test sur l'index de colonne
+typedef void (*CellParser)(const ParseStep* step, const char* field, int length,
+                           double* row, int* label, LoadReport* report);
+
+struct ParseStep {
+    CellParser parse;
+    int target;                        // Colonne de sortie dans Dataset->data
+    CategoryDictionary* dictionary;
+};
+
+/* **************************************************
+ * # --- LECTURE DU SCHÉMA --- #
+ * ************************************************** */
+
+/**
+ * Fonction : parse_category_spec
+ * Rôle     : Ajoute au dictionnaire une modalité déclarée sous la forme VALEUR=code
+ * Param    : dict (dictionnaire), spec (texte "VALEUR=code")
+ * Retour   : int (1 si la déclaration est valide, 0 si elle est mal formée ou si la modalité est déjà déclarée)
+ */
+static int parse_category_spec(CategoryDictionary* dict, char* spec) {
+    char* equal = strrchr(spec, '=');
+    if (!equal || equal == spec) return 0;
+
+    char* end;
+    long code = strtol(equal + 1, &end, 10);
+    if (end == equal + 1 || *end != '\0' || code < 0 || code > CATEGORY_MAX_CODE) return 0;
+
+    *equal = '\0';
+    return add_category(dict, spec, (int)code);
+}
+
+/**
+ * Fonction : parse_schema_line
+ * Rôle     : Analyse une ligne du fichier de schéma et remplit la colonne correspondante
+ * Param    : line (ligne à analyser, modifiée), column (colonne à remplir)
+ * Retour   : int (1 si une colonne a été lue, 0 pour une ligne vide ou un commentaire, -1 si invalide)
+ */
+static int parse_schema_line(char* line, SchemaColumn* column) {
+    char* name = strtok(line, " \t\r\n");
+    if (!name || name[0] == '#') return 0;
+
+    char* type = strtok(NULL, " \t\r\n");
+    if (!type) return -1;
+
+    column->name = strdup(name);
+    column->dictionary = NULL;
+    column->feature_index = -1;
+
+    if (strcmp(type, "numeric") == 0) {
+        column->type = COLUMN_NUMERIC;
+    } else if (strcmp(type, "label") == 0) {
+        column->type = COLUMN_LABEL;
+    } else if (strcmp(type, "drop") == 0) {
+        column->type = COLUMN_DROP;
+    } else if (strcmp(type, "categorical") == 0) {
+        column->type = COLUMN_CATEGORICAL;
+        char* fallback = strtok(NULL, " \t\r\n");
+        if (!fallback) return -1;
+
+        char* end;
+        long default_code = (strcmp(fallback, "unseen") == 0) ? CATEGORY_UNSEEN : strtol(fallback, &end, 10);
+        if (default_code != CATEGORY_UNSEEN &&
+            (end == fallback || *end != '\0' || default_code < 0 || default_code > CATEGORY_MAX_CODE)) return -1;
+
+        column->dictionary = create_category_dictionary((int)default_code);
+        char* spec;
+        while ((spec = strtok(NULL, " \t\r\n")) != NULL) {
+            if (!parse_category_spec(column->dictionary, spec)) return -1;
+        }
+        if (!compile_category_dictionary(column->dictionary)) return -1;
+    } else {
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * Fonction : load_schema
+ * Rôle     : Charge un fichier de schéma et compile les dictionnaires de ses colonnes catégorielles
+ * Param    : filename (chemin du fichier de schéma)
+ * Retour   : Schema* (schéma chargé, NULL en cas d'erreur)
+ */
+Schema* load_schema(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+
+    Schema* schema = (Schema*)safe_malloc(sizeof(Schema));
+    int capacity = 16;
+    schema->columns = (SchemaColumn*)safe_malloc(capacity * sizeof(SchemaColumn));
+    schema->n_columns = 0;
+    schema->n_features = 0;
+    schema->label_column = -1;
+
+    char buffer[SCHEMA_LINE_SIZE];
+    int line_number = 0;
+    int valid = 1;
+    while (valid && fgets(buffer, sizeof(buffer), file)) {
+        line_number++;
+        if (schema->n_columns == capacity) {
+            capacity *= 2;
+            schema->columns = (SchemaColumn*)safe_realloc(schema->columns, capacity * sizeof(SchemaColumn));
+        }
+
+        SchemaColumn* column = &schema->columns[schema->n_columns];
+        column->name = NULL;
+        column->dictionary = NULL;
+        int status = parse_schema_line(buffer, column);
+        if (status == 0) continue;
+
+        // La colonne (même partielle) appartient désormais au schéma pour être libérée avec lui
+        schema->n_columns++;
+        if (status < 0 || (column->type == COLUMN_LABEL && schema->label_column >= 0)) {
+            fprintf(stderr, "Invalid schema line %d in %s\n", line_number, filename);
+            valid = 0;
+        } else if (column->type == COLUMN_LABEL) {
+            schema->label_column = schema->n_columns - 1;
+        } else if (column->type != COLUMN_DROP) {
+            column->feature_index = schema->n_features++;
+        }
+    }
+    fclose(file);
+
+    if (!valid || schema->n_features == 0) {
+        if (valid) fprintf(stderr, "Schema has no feature column: %s\n", filename);
+        free_schema(schema);
+        return NULL;
+    }
+    return schema;
+}
+
+/* **************************************************
+ * # --- PLAN DE PARSING --- #
+ * ************************************************** */
+
+/**
+ * Fonction : parse_numeric_cell
+ * Rôle     : Cellule numérique : champ vide, non numérique ou suivi de caractères parasites -> NaN (imputé plus tard)
+ * Param    : step (étape du plan), field (début du champ), length (longueur), row (ligne de sortie), label (label de la ligne), report (bilan)
+ * Retour   : void
+ */
+static void parse_numeric_cell(const ParseStep* step, const char* field, int length,
+                               double* row, int* label, LoadReport* report) {
+    (void)label;
+    char* end = (char*)field;
+    double value = (length > 0) ? strtod(field, &end) : 0.0;
+    // Le nombre doit occuper tout le champ : "12abc" ou "3.5%" sont des valeurs manquantes, pas 12 ou 3.5
+    if (length == 0 || end != field + length || isnan(value)) {
+        value = NAN;
+        report->n_missing++;
+    }
+    row[step->target] = value;
+}
+
+/**
+ * Fonction : parse_categorical_cell
+ * Rôle     : Cellule catégorielle : code du dictionnaire (hachage parfait), NaN si vide ou inconnue avec CATEGORY_UNSEEN
+ * Param    : step (étape du plan), field (début du champ), length (longueur), row (ligne de sortie), label (label de la ligne), report (bilan)
+ * Retour   : void
+ */
+static void parse_categorical_cell(const ParseStep* step, const char* field, int length,
+                                   double* row, int* label, LoadReport* report) {
+    (void)label;
+    if (length == 0) {
+        row[step->target] = NAN;
+        report->n_missing++;
+        return;
+    }
+
+    int found;
+    int code = lookup_category(step->dictionary, field, length, &found);
+    if (!found) report->n_unseen++;
+    row[step->target] = (code == CATEGORY_UNSEEN) ? NAN : (double)code;
+}
+
+/**
+ * Fonction : parse_label_cell
+ * Rôle     : Cellule label : entier >= 0 occupant tout le champ ; un label vide ou invalide vaut -1 et la ligne
+ *            est écartée par load_csv_with_schema (le compter comme 0 l'entraînerait comme « pas de défaut »)
+ * Param    : step (étape du plan), field (début du champ), length (longueur), row (ligne de sortie), label (label de la ligne), report (bilan)
+ * Retour   : void
+ */
+static void parse_label_cell(const ParseStep* step, const char* field, int length,
+                             double* row, int* label, LoadReport* report) {
+    (void)step;
+    (void)row;
+    (void)report;
+    char* end = (char*)field;
+    long value = (length > 0) ? strtol(field, &end, 10) : -1;
+    *label = (end == field + length && value >= 0 && value <= INT_MAX) ? (int)value : -1;
+}
+
+/**
+ * Fonction : skip_cell
+ * Rôle     : Colonne ignorée (drop ou absente du schéma)
+ * Param    : step, field, length, row, label, report (inutilisés)
+ * Retour   : void
+ */
+static void skip_cell(const ParseStep* step, const char* field, int length,
+                      double* row, int* label, LoadReport* report) {
+    (void)step;
+    (void)field;
+    (void)length;
+    (void)row;
+    (void)label;
+    (void)report;
+}
+
+/**
+ * Fonction : field_length
+ * Rôle     : Longueur du champ courant (jusqu'à la virgule ou la fin de ligne)
+ * Param    : field (début du champ)
+ * Retour   : int (nombre de caractères du champ)
+ */
+static int field_length(const char* field) {
+    const char* end = field;
+    while (*end && *end != ',' && *end != '\n' && *end != '\r') end++;
+    return (int)(end - field);
+}
+
+/**
+ * Fonction : build_parse_plan
+ * Rôle     : Associe chaque colonne de l'en-tête CSV à une colonne du schéma par son nom et choisit son parseur
+ * Param    : schema (schéma), header (ligne d'en-tête), n_steps (sortie : nombre de colonnes du CSV), report (bilan)
+ * Retour   : ParseStep* (plan [n_steps], NULL si une colonne requise du schéma manque)
+ */
+static ParseStep* build_parse_plan(Schema* schema, const char* header, int* n_steps, LoadReport* report) {
+    int capacity = schema->n_columns + 8;
+    ParseStep* plan = (ParseStep*)safe_malloc(capacity * sizeof(ParseStep));
+    int* matched = (int*)safe_calloc(schema->n_columns, sizeof(int));
+    *n_steps = 0;
+
+    const char* field = header;
+    while (1) {
+        int length = field_length(field);
+        if (*n_steps == capacity) {
+            capacity *= 2;
+            plan = (ParseStep*)safe_realloc(plan, capacity * sizeof(ParseStep));
+        }
+
+        ParseStep* step = &plan[(*n_steps)++];
+        step->parse = skip_cell;
+        step->target = -1;
+        step->dictionary = NULL;
+
+        for (int c = 0; c < schema->n_columns; c++) {
+            SchemaColumn* column = &schema->columns[c];
+            if (matched[c] || (int)strlen(column->name) != length || strncmp(column->name, field, length) != 0) continue;
+
+            matched[c] = 1;
+            step->target = column->feature_index;
+            step->dictionary = column->dictionary;
+            switch (column->type) {
+                case COLUMN_NUMERIC: step->parse = parse_numeric_cell; break;
+                case COLUMN_CATEGORICAL: step->parse = parse_categorical_cell; break;
+                case COLUMN_LABEL: step->parse = parse_label_cell; break;
+                case COLUMN_DROP: break;
+            }
+            break;
+        }
+        if (step->parse == skip_cell) report->n_ignored_columns++;
+
+        if (field[length] != ',') break;
+        field += length + 1;
+    }
+
+    // Les colonnes du schéma sont obligatoires, sauf celles déclarées drop
+    int valid = 1;
+    for (int c = 0; c < schema->n_columns; c++) {
+        if (!matched[c] && schema->columns[c].type != COLUMN_DROP) {
+            fprintf(stderr, "Missing column in CSV: %s\n", schema->columns[c].name);
+            valid = 0;
+        }
+    }
+    safe_free(matched);
+
+    if (!valid) {
+        safe_free(plan);
+        return NULL;
+    }
+    return plan;
+}
+
+/* **************************************************
+ * # --- CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : load_csv_with_schema
+ * Rôle     : Charge un CSV avec en-tête selon un schéma : le plan de parsing (un pointeur de fonction par colonne)
+ *            est construit une fois à partir de l'en-tête, puis chaque ligne est lue en une passe sur ses champs.
+ *            Les champs vides sont conservés (NaN) et n'entraînent aucun décalage de colonnes.
+ * Param    : filename (fichier CSV), schema (schéma chargé), report (bilan du chargement, peut être NULL)
+ * Retour   : Dataset* (features dans l'ordre du schéma, NULL en cas d'erreur)
+ */
+Dataset* load_csv_with_schema(const char* filename, Schema* schema, LoadReport* report) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+
+    LoadReport local = {0, 0, 0, 0};
+    char buffer[SCHEMA_LINE_SIZE];
+    if (!fgets(buffer, sizeof(buffer), file)) {
+        fclose(file);
+        return NULL;
+    }
+
+    int n_steps;
+    ParseStep* plan = build_parse_plan(schema, buffer, &n_steps, &local);
+    if (!plan) {
+        fclose(file);
+        return NULL;
+    }
+
+    // Comptage des lignes non vides
+    long pos = ftell(file);
+    int rows = 0;
+    while (fgets(buffer, sizeof(buffer), file)) {
+        if (field_length(buffer) > 0 || buffer[0] == ',') rows++;
+    }
+    fseek(file, pos, SEEK_SET);
+
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = rows;
+    dataset->cols = schema->n_features;
+    dataset->data = allocate_matrix(rows, schema->n_features);
+    dataset->labels = (int*)safe_calloc(rows > 0 ? rows : 1, sizeof(int));
+
+    int row = 0;
+    while (row < rows && fgets(buffer, sizeof(buffer), file)) {
+        if (field_length(buffer) == 0 && buffer[0] != ',') continue;
+
+        const char* field = buffer;
+        int at_end = 0;
+        for (int k = 0; k < n_steps; k++) {
+            // Ligne trop courte : les colonnes restantes sont traitées comme des champs vides
+            int length = at_end ? 0 : field_length(field);
+            plan[k].parse(&plan[k], field, length, dataset->data[row], &dataset->labels[row], &local);
+            if (!at_end) {
+                at_end = field[length] != ',';
+                field += at_end ? length : length + 1;
+            }
+        }
+
+        // Label vide ou invalide : la ligne est écartée (la suivante réutilise son emplacement)
+        if (dataset->labels[row] < 0) {
+            dataset->labels[row] = 0;
+            local.n_invalid_labels++;
+            continue;
+        }
+        row++;
+    }
+    for (int i = row; i < rows; i++) {
+        free(dataset->data[i]);
+    }
+    dataset->rows = row;
+
+    fclose(file);
+    safe_free(plan);
+    if (report) *report = local;
+    return dataset;
+}
+
+/**
+ * Fonction : schema_feature_index
+ * Rôle     : Retrouve la colonne de Dataset->data d'une colonne du schéma à partir de son nom
+ * Param    : schema (schéma), name (nom de la colonne)
+ * Retour   : int (index de feature, -1 si la colonne est absente, label ou ignorée)
+ */
+int schema_feature_index(Schema* schema, const char* name) {
+    for (int c = 0; c < schema->n_columns; c++) {
+        if (strcmp(schema->columns[c].name, name) == 0) return schema->columns[c].feature_index;
+    }
+    return -1;
+}
+
+/**
+ * Fonction : free_schema
+ * Rôle     : Libère un schéma et les dictionnaires de ses colonnes
+ * Param    : schema (schéma à libérer)
+ * Retour   : void
+ */
+void free_schema(Schema* schema) {
+    if (schema) {
+        for (int c = 0; c < schema->n_columns; c++) {
+            free(schema->columns[c].name);
+            free_category_dictionary(schema->columns[c].dictionary);
+        }
+        safe_free(schema->columns);
+        safe_free(schema);
+    }
+}
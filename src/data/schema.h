@@ -0,0 +1,68 @@
+/*****************************************************************************************************
+
+Nom : src/data/schema.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le chargement CSV piloté par un fichier de schéma
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include "../utils/csv_parser.h"
+#include "../preprocessing/encoder.h"
+
+typedef enum {
+    COLUMN_NUMERIC,
+    COLUMN_CATEGORICAL,
+    COLUMN_LABEL,
+    COLUMN_DROP
+} ColumnType;
+
+typedef struct {
+    char* name;
+    ColumnType type;
+    CategoryDictionary* dictionary;   // Modalités -> codes (COLUMN_CATEGORICAL, NULL sinon)
+    int feature_index;                // Colonne dans Dataset->data (-1 pour label et drop)
+} SchemaColumn;
+
+/*
+ * Schéma déclaratif d'un CSV, une ligne par colonne (lignes vides et '#' ignorés) :
+ *   <nom> numeric
+ *   <nom> categorical <défaut|unseen> <MODALITÉ>=<code> ...
+ *   <nom> label
+ *   <nom> drop
+ * Les features du Dataset suivent l'ordre du schéma ; les colonnes du CSV sont associées par leur nom
+ * dans l'en-tête, si bien qu'un extrait réordonné ou avec des colonnes en plus se charge sans recompiler.
+ */
+typedef struct {
+    int n_columns;
+    SchemaColumn* columns;   // [n_columns] dans l'ordre du fichier de schéma
+    int n_features;
+    int label_column;        // Index de la colonne label dans le schéma (-1 si absente)
+} Schema;
+
+// Bilan d'un chargement : valeurs manquantes (NaN), modalités inconnues, colonnes du CSV hors schéma,
+// lignes écartées faute de label valide
+typedef struct {
+    long n_missing;
+    long n_unseen;
+    int n_ignored_columns;
+    long n_invalid_labels;
+} LoadReport;
+
+Schema* load_schema(const char* filename);
+Dataset* load_csv_with_schema(const char* filename, Schema* schema, LoadReport* report);
+int schema_feature_index(Schema* schema, const char* name);
+void free_schema(Schema* schema);
+
+#endif
@@ -0,0 +1,243 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/bootstrap.c
+
+Rôle : Intervalles de confiance bootstrap (AUC, KS, précision, rappel, F1) en parallèle, sans retri des réplicats
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "bootstrap.h"
+#include "../utils/memory_manager.h"
+#include "../utils/parallel.h"
+#include "../utils/quantile_sketch.h"
+#include "../utils/radix_sort.h"
+#include "../utils/random.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define BOOTSTRAP_METRICS 5   // AUC, KS, précision, rappel, F1 (dans cet ordre)
+
+/*
+ * Échantillon trié une fois par score croissant. Un réplicat bootstrap n'est qu'un vecteur de
+ * multiplicités sur ces positions : tirer n positions avec remise revient à tirer n lignes, et le
+ * parcours pondéré dans l'ordre trié donne toutes les métriques sans retrier.
+ */
+typedef struct {
+    int n_samples;
+    uint8_t* labels;       // [n] label de la k-ième plus petite probabilité
+    uint8_t* predicted;    // [n] prédiction associée
+    uint8_t* group_last;   // [n] 1 si la position termine un groupe de scores égaux
+} SortedSample;
+
+typedef struct {
+    SortedSample* sample;
+    int n_replicates;
+    int n_tasks;
+    uint64_t seed;
+    double* values;        // [BOOTSTRAP_METRICS * n_replicates] métrique m du réplicat b en m * B + b
+} BootstrapJob;
+
+/* **************************************************
+ * # --- MÉTRIQUES PONDÉRÉES --- #
+ * ************************************************** */
+
+/**
+ * Fonction : weighted_metrics
+ * Rôle     : Calcule AUC (Mann-Whitney, ex aequo à 1/2), KS, précision, rappel et F1 en un parcours de
+ *            l'échantillon trié, chaque position comptant weights[k] fois
+ * Param    : sample (échantillon trié), weights (multiplicités [n], NULL = 1 partout),
+ *            n_positive, n_negative (totaux pondérés par classe), out (métriques [BOOTSTRAP_METRICS])
+ * Retour   : void
+ */
+static void weighted_metrics(SortedSample* sample, const int* weights, long n_positive, long n_negative, double* out) {
+    double wins = 0.0, ks = 0.0;
+    long group_pos = 0, group_neg = 0, pos_below = 0, neg_below = 0;
+    long tp = 0, predicted_pos = 0;
+
+    for (int k = 0; k < sample->n_samples; k++) {
+        long w = weights ? weights[k] : 1;
+        long positive = w * sample->labels[k];
+        group_pos += positive;
+        group_neg += w - positive;
+        tp += positive * sample->predicted[k];
+        predicted_pos += w * sample->predicted[k];
+
+        if (sample->group_last[k]) {
+            wins += group_pos * (neg_below + 0.5 * group_neg);
+            pos_below += group_pos;
+            neg_below += group_neg;
+            group_pos = 0;
+            group_neg = 0;
+            if (n_positive > 0 && n_negative > 0) {
+                double gap = fabs((double)neg_below / n_negative - (double)pos_below / n_positive);
+                if (gap > ks) ks = gap;
+            }
+        }
+    }
+
+    out[0] = (n_positive > 0 && n_negative > 0) ? wins / ((double)n_positive * n_negative) : 0.5;
+    out[1] = ks;
+    out[2] = predicted_pos > 0 ? (double)tp / predicted_pos : 0.0;
+    out[3] = n_positive > 0 ? (double)tp / n_positive : 0.0;
+    out[4] = predicted_pos + n_positive > 0 ? 2.0 * tp / (predicted_pos + n_positive) : 0.0;
+}
+
+/* **************************************************
+ * # --- RÉPLICATS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : bootstrap_task
+ * Rôle     : Tâche parallèle : calcule une tranche contiguë de réplicats avec un seul tableau de multiplicités.
+ *            Le réplicat b utilise le flux (seed, b) : résultats indépendants du nombre de threads.
+ * Param    : task (index de la tranche), context (BootstrapJob partagé)
+ * Retour   : void
+ */
+static void bootstrap_task(int task, void* context) {
+    BootstrapJob* job = (BootstrapJob*)context;
+    SortedSample* sample = job->sample;
+    int n = sample->n_samples;
+    int start = (int)((long)job->n_replicates * task / job->n_tasks);
+    int end = (int)((long)job->n_replicates * (task + 1) / job->n_tasks);
+
+    int* weights = (int*)safe_malloc(n * sizeof(int));
+    double metrics[BOOTSTRAP_METRICS];
+    for (int b = start; b < end; b++) {
+        RandomStream rng;
+        seed_random_stream(&rng, job->seed, (uint64_t)b);
+        memset(weights, 0, n * sizeof(int));
+
+        long n_positive = 0;
+        for (int i = 0; i < n; i++) {
+            int k = random_index(&rng, n);
+            weights[k]++;
+            n_positive += sample->labels[k];
+        }
+
+        weighted_metrics(sample, weights, n_positive, n - n_positive, metrics);
+        for (int m = 0; m < BOOTSTRAP_METRICS; m++) {
+            job->values[m * job->n_replicates + b] = metrics[m];
+        }
+    }
+    safe_free(weights);
+}
+
+/**
+ * Fonction : percentile_interval
+ * Rôle     : Intervalle percentile et écart-type d'une série de réplicats (tableau réordonné)
+ * Param    : values (réplicats [n]), n (nombre de réplicats), estimate (valeur sur l'échantillon complet),
+ *            confidence (niveau de l'intervalle)
+ * Retour   : ConfidenceInterval (intervalle complet)
+ */
+static ConfidenceInterval percentile_interval(double* values, int n, double estimate, double confidence) {
+    ConfidenceInterval interval;
+    interval.estimate = estimate;
+
+    double mean = 0.0, m2 = 0.0;
+    for (int b = 0; b < n; b++) {
+        double delta = values[b] - mean;
+        mean += delta / (b + 1);
+        m2 += delta * (values[b] - mean);
+    }
+    interval.std_error = n > 1 ? sqrt(m2 / (n - 1)) : 0.0;
+
+    double alpha = 1.0 - confidence;
+    interval.lower = select_quantile(values, n, alpha / 2.0);
+    interval.upper = select_quantile(values, n, 1.0 - alpha / 2.0);
+    return interval;
+}
+
+/**
+ * Fonction : bootstrap_metrics
+ * Rôle     : Rééchantillonne le jeu de test n_replicates fois (tirage avec remise) et retourne les intervalles
+ *            percentile de l'AUC, du KS, de la précision, du rappel et du F1. Les scores sont triés une seule
+ *            fois (tri radix) ; chaque réplicat est un vecteur de multiplicités parcouru linéairement.
+ * Param    : probabilities (scores [n]), y_true (labels [n]), y_pred (prédictions [n] au seuil retenu),
+ *            n_samples (taille du jeu), n_replicates (nombre de réplicats B), confidence (niveau, ex. 0.95),
+ *            seed (graine : mêmes intervalles à graine égale)
+ * Retour   : BootstrapReport (estimations et intervalles)
+ */
+BootstrapReport bootstrap_metrics(double* probabilities, int* y_true, int* y_pred, int n_samples,
+                                  int n_replicates, double confidence, uint64_t seed) {
+    BootstrapReport report;
+    report.n_replicates = n_replicates > 0 ? n_replicates : 0;
+    report.confidence = confidence;
+
+    SortedSample sample;
+    sample.n_samples = n_samples > 0 ? n_samples : 0;
+    int alloc = sample.n_samples > 0 ? sample.n_samples : 1;
+    sample.labels = (uint8_t*)safe_malloc(alloc);
+    sample.predicted = (uint8_t*)safe_malloc(alloc);
+    sample.group_last = (uint8_t*)safe_malloc(alloc);
+
+    int* order = radix_argsort(probabilities, sample.n_samples);
+    long n_positive = 0;
+    for (int k = 0; k < sample.n_samples; k++) {
+        int i = order[k];
+        sample.labels[k] = (y_true[i] == 1);
+        sample.predicted[k] = (y_pred[i] == 1);
+        sample.group_last[k] = (k == sample.n_samples - 1) || probabilities[order[k + 1]] != probabilities[i];
+        n_positive += sample.labels[k];
+    }
+    safe_free(order);
+
+    double estimates[BOOTSTRAP_METRICS];
+    weighted_metrics(&sample, NULL, n_positive, sample.n_samples - n_positive, estimates);
+
+    BootstrapJob job;
+    job.sample = &sample;
+    job.n_replicates = report.n_replicates;
+    job.seed = seed;
+    job.n_tasks = get_num_threads();
+    if (job.n_tasks > job.n_replicates) job.n_tasks = job.n_replicates;
+    job.values = (double*)safe_malloc((BOOTSTRAP_METRICS * job.n_replicates + 1) * sizeof(double));
+    if (job.n_tasks > 0 && sample.n_samples > 0) {
+        parallel_for(job.n_tasks, bootstrap_task, &job);
+    } else {
+        // Pas de réplicat possible : intervalles réduits à l'estimation
+        job.n_replicates = 1;
+        for (int m = 0; m < BOOTSTRAP_METRICS; m++) job.values[m] = estimates[m];
+    }
+
+    ConfidenceInterval* intervals[BOOTSTRAP_METRICS] = {
+        &report.auc_roc, &report.ks, &report.precision, &report.recall, &report.f1_score
+    };
+    for (int m = 0; m < BOOTSTRAP_METRICS; m++) {
+        *intervals[m] = percentile_interval(job.values + m * job.n_replicates, job.n_replicates,
+                                            estimates[m], confidence);
+    }
+
+    safe_free(job.values);
+    safe_free(sample.labels);
+    safe_free(sample.predicted);
+    safe_free(sample.group_last);
+    return report;
+}
+
+/**
+ * Fonction : print_bootstrap_report
+ * Rôle     : Affiche les estimations et intervalles de confiance bootstrap
+ * Param    : report (rapport bootstrap)
+ * Retour   : void
+ */
+void print_bootstrap_report(const BootstrapReport* report) {
+    const char* names[BOOTSTRAP_METRICS] = {"AUC-ROC", "KS", "Precision", "Recall", "F1-Score"};
+    const ConfidenceInterval* intervals[BOOTSTRAP_METRICS] = {
+        &report->auc_roc, &report->ks, &report->precision, &report->recall, &report->f1_score
+    };
+    printf("Bootstrap (%d replicates, %.0f%% percentile intervals):\n", report->n_replicates, 100.0 * report->confidence);
+    for (int m = 0; m < BOOTSTRAP_METRICS; m++) {
+        printf("%-10s %.4f  [%.4f, %.4f]  (se %.4f)\n", names[m], intervals[m]->estimate,
+               intervals[m]->lower, intervals[m]->upper, intervals[m]->std_error);
+    }
+}
@@ -0,0 +1,45 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/bootstrap.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour les intervalles de confiance bootstrap des métriques
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef BOOTSTRAP_H
+#define BOOTSTRAP_H
+
+#include <stdint.h>
+
+// Estimation sur l'échantillon complet et intervalle percentile des réplicats
+typedef struct {
+    double estimate;
+    double lower;
+    double upper;
+    double std_error;    // Écart-type des réplicats
+} ConfidenceInterval;
+
+typedef struct {
+    int n_replicates;
+    double confidence;   // Niveau des intervalles (ex. 0.95)
+    ConfidenceInterval auc_roc;
+    ConfidenceInterval ks;
+    ConfidenceInterval precision;
+    ConfidenceInterval recall;
+    ConfidenceInterval f1_score;
+} BootstrapReport;
+
+BootstrapReport bootstrap_metrics(double* probabilities, int* y_true, int* y_pred, int n_samples,
+                                  int n_replicates, double confidence, uint64_t seed);
+void print_bootstrap_report(const BootstrapReport* report);
+
+#endif
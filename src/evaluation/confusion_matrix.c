@@ -23,6 +23,30 @@ Usage : Pour compiler : make
  * # --- MATRICE DE CONFUSION --- #
  * ************************************************** */
 
+/**
+ * Fonction : fill_confusion_matrix
+ * Rôle     : Remplit une matrice de confusion en une passe sans branchement (labels binaires 0/1) :
+ *            seuls TP, positifs réels et positifs prédits sont accumulés, FP/FN/TN s'en déduisent
+ * Param    : cm (matrice à remplir), y_true (labels réels), y_pred (labels prédits), n_samples (nombre d'échantillons)
+ * Retour   : void
+ */
+void fill_confusion_matrix(ConfusionMatrix* cm, int* y_true, int* y_pred, int n_samples) {
+    int tp = 0, actual_pos = 0, predicted_pos = 0;
+    
+    for (int i = 0; i < n_samples; i++) {
+        int t = (y_true[i] == 1);
+        int p = (y_pred[i] == 1);
+        tp += t & p;
+        actual_pos += t;
+        predicted_pos += p;
+    }
+    
+    cm->tp = tp;
+    cm->fp = predicted_pos - tp;
+    cm->fn = actual_pos - tp;
+    cm->tn = n_samples - tp - cm->fp - cm->fn;
+}
+
 /**
  * Fonction : compute_confusion_matrix
  * Rôle     : Calcule la matrice de confusion en comptant TP, TN, FP, FN
@@ -31,15 +55,7 @@ Usage : Pour compiler : make
  */
 ConfusionMatrix* compute_confusion_matrix(int* y_true, int* y_pred, int n_samples) {
     ConfusionMatrix* cm = (ConfusionMatrix*)safe_malloc(sizeof(ConfusionMatrix));
-    cm->tp = cm->tn = cm->fp = cm->fn = 0;
-    
-    for (int i = 0; i < n_samples; i++) {
-        if (y_true[i] == 1 && y_pred[i] == 1) cm->tp++;
-        else if (y_true[i] == 0 && y_pred[i] == 0) cm->tn++;
-        else if (y_true[i] == 0 && y_pred[i] == 1) cm->fp++;
-        else if (y_true[i] == 1 && y_pred[i] == 0) cm->fn++;
-    }
-    
+    fill_confusion_matrix(cm, y_true, y_pred, n_samples);
     return cm;
 }
 
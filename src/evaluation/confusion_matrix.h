@@ -25,6 +25,7 @@ typedef struct {
     int fn;  // False Negatives
 } ConfusionMatrix;
 
+void fill_confusion_matrix(ConfusionMatrix* cm, int* y_true, int* y_pred, int n_samples);
 ConfusionMatrix* compute_confusion_matrix(int* y_true, int* y_pred, int n_samples);
 void print_confusion_matrix(ConfusionMatrix* cm);
 void save_confusion_matrix(const char* filename, ConfusionMatrix* cm);
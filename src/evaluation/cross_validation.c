@@ -0,0 +1,427 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/cross_validation.c
+
+Rôle : Validation croisée k-fold et stratifiée sur des vues par index, folds évalués en parallèle
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "cross_validation.h"
+#include "../utils/memory_manager.h"
+#include "../utils/parallel.h"
+#include "../utils/random.h"
+#include "../utils/utils.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+typedef enum {
+    CV_LOGISTIC,
+    CV_TREE
+} CVModelType;
+
+typedef struct {
+    Dataset* dataset;
+    Folds* folds;
+    CVModelType model_type;
+    LogisticRegression* logistic;   // Hyperparamètres (CV_LOGISTIC)
+    DecisionTree* tree;             // Hyperparamètres (CV_TREE)
+    TreePresort* presort;           // Pré-tri du dataset partagé par les folds (CV_TREE)
+    int n_workers;
+    CrossValidationReport* report;
+} CVJob;
+
+/*
+ * Mémoire d'un thread, allouée une fois pour tous ses folds. Le train est une liste d'index (la
+ * régression logistique en copie les lignes dans scaled_rows pour les normaliser), le test une vue
+ * sur les lignes du dataset partagé, qui n'est jamais modifié.
+ */
+typedef struct {
+    int* train_index;        // [max_train] lignes d'entraînement du fold
+    double** scaled_rows;    // [max_train][cols] copie normalisée (CV_LOGISTIC, NULL sinon)
+    Dataset test;            // Vue : test.data pointe sur les lignes du dataset
+    double* probabilities;   // [max_test]
+    int* predictions;        // [max_test]
+} FoldBuffers;
+
+/* **************************************************
+ * # --- CONSTRUCTION DES FOLDS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : folds_from_assignment
+ * Rôle     : Regroupe les lignes par fold (tri par comptage stable) à partir du fold de chaque ligne
+ * Param    : order (lignes dans l'ordre de parcours [n]), fold_of (fold de order[k] [n]), n_samples, n_folds
+ * Retour   : Folds* (partition)
+ */
+static Folds* folds_from_assignment(const int* order, const int* fold_of, int n_samples, int n_folds) {
+    Folds* folds = (Folds*)safe_malloc(sizeof(Folds));
+    folds->n_folds = n_folds;
+    folds->n_samples = n_samples;
+    folds->indices = (int*)safe_malloc((n_samples > 0 ? n_samples : 1) * sizeof(int));
+    folds->offsets = (int*)safe_calloc(n_folds + 1, sizeof(int));
+
+    for (int k = 0; k < n_samples; k++) {
+        folds->offsets[fold_of[k] + 1]++;
+    }
+    for (int f = 0; f < n_folds; f++) {
+        folds->offsets[f + 1] += folds->offsets[f];
+    }
+    int* cursor = (int*)safe_malloc(n_folds * sizeof(int));
+    memcpy(cursor, folds->offsets, n_folds * sizeof(int));
+    for (int k = 0; k < n_samples; k++) {
+        folds->indices[cursor[fold_of[k]]++] = order[k];
+    }
+    safe_free(cursor);
+    return folds;
+}
+
+/**
+ * Fonction : make_kfolds
+ * Rôle     : Découpe les lignes mélangées en n_folds folds de tailles égales à une ligne près
+ * Param    : n_samples (nombre de lignes), n_folds (nombre de folds, >= 2), seed (graine du mélange)
+ * Retour   : Folds* (partition, NULL si n_folds invalide)
+ */
+Folds* make_kfolds(int n_samples, int n_folds, uint64_t seed) {
+    if (n_folds < 2 || n_folds > n_samples) {
+        fprintf(stderr, "Invalid number of folds: %d for %d samples\n", n_folds, n_samples);
+        return NULL;
+    }
+
+    int* order = (int*)safe_malloc(n_samples * sizeof(int));
+    int* fold_of = (int*)safe_malloc(n_samples * sizeof(int));
+    for (int i = 0; i < n_samples; i++) order[i] = i;
+    RandomStream rng;
+    seed_random_stream(&rng, seed, 0);
+    random_shuffle(&rng, order, n_samples);
+    for (int k = 0; k < n_samples; k++) fold_of[k] = k % n_folds;
+
+    Folds* folds = folds_from_assignment(order, fold_of, n_samples, n_folds);
+    safe_free(order);
+    safe_free(fold_of);
+    return folds;
+}
+
+/**
+ * Fonction : make_stratified_folds
+ * Rôle     : Folds stratifiés : les positifs puis les négatifs (mélangés) sont distribués à tour de rôle,
+ *            la rotation continuant d'une classe à l'autre. Chaque fold reçoit la même proportion de défauts
+ *            (~22 %) à une ligne près et les tailles restent égales à une ligne près.
+ * Param    : labels (labels [n]), n_samples (nombre de lignes), n_folds (nombre de folds, >= 2), seed (graine)
+ * Retour   : Folds* (partition, NULL si n_folds invalide)
+ */
+Folds* make_stratified_folds(int* labels, int n_samples, int n_folds, uint64_t seed) {
+    if (n_folds < 2 || n_folds > n_samples) {
+        fprintf(stderr, "Invalid number of folds: %d for %d samples\n", n_folds, n_samples);
+        return NULL;
+    }
+
+    int* order = (int*)safe_malloc(n_samples * sizeof(int));
+    int* fold_of = (int*)safe_malloc(n_samples * sizeof(int));
+    int n_positive = 0;
+    for (int i = 0; i < n_samples; i++) n_positive += (labels[i] == 1);
+    int pos = 0, neg = n_positive;
+    for (int i = 0; i < n_samples; i++) {
+        if (labels[i] == 1) order[pos++] = i;
+        else order[neg++] = i;
+    }
+
+    RandomStream rng;
+    seed_random_stream(&rng, seed, 0);
+    random_shuffle(&rng, order, n_positive);
+    random_shuffle(&rng, order + n_positive, n_samples - n_positive);
+    for (int k = 0; k < n_samples; k++) fold_of[k] = k % n_folds;
+
+    Folds* folds = folds_from_assignment(order, fold_of, n_samples, n_folds);
+    safe_free(order);
+    safe_free(fold_of);
+    return folds;
+}
+
+/**
+ * Fonction : free_folds
+ * Rôle     : Libère complètement la mémoire allouée pour une partition en folds
+ * Param    : folds (partition à libérer)
+ * Retour   : void
+ */
+void free_folds(Folds* folds) {
+    if (folds) {
+        safe_free(folds->indices);
+        safe_free(folds->offsets);
+        safe_free(folds);
+    }
+}
+
+/* **************************************************
+ * # --- AJUSTEMENT SUR UN SOUS-ENSEMBLE DE LIGNES --- #
+ * ************************************************** */
+
+/**
+ * Fonction : fit_score_logistic_rows
+ * Rôle     : Copie les lignes d'entraînement, y ajuste un scaler puis une régression logistique (silencieuse),
+ *            et score la vue de test brute avec le modèle exporté en espace brut (seuil 0.5)
+ * Param    : config (hyperparamètres), dataset (dataset imputé, lu seulement), train_rows (index [n_train]),
+ *            n_train (nombre de lignes d'entraînement), scaled_rows (buffer [n_train][cols] ou NULL),
+ *            test (vue de test), probabilities, predictions (sorties [test->rows])
+ * Retour   : void
+ */
+void fit_score_logistic_rows(LogisticRegression* config, Dataset* dataset, const int* train_rows, int n_train,
+                             double** scaled_rows, Dataset* test, double* probabilities, int* predictions) {
+    double** rows = scaled_rows ? scaled_rows : allocate_matrix(n_train, dataset->cols);
+    int* labels = (int*)safe_malloc((n_train > 0 ? n_train : 1) * sizeof(int));
+    for (int i = 0; i < n_train; i++) {
+        memcpy(rows[i], dataset->data[train_rows[i]], dataset->cols * sizeof(double));
+        labels[i] = dataset->labels[train_rows[i]];
+    }
+    Dataset train = {rows, labels, n_train, dataset->cols};
+    Scaler* scaler = fit_scaler(&train);
+    transform_dataset(&train, scaler);
+
+    LogisticRegression* model = create_logistic_regression(dataset->cols, config->learning_rate, config->max_iterations);
+    model->penalty = config->penalty;
+    model->lambda = config->lambda;
+    model->l1_ratio = config->l1_ratio;
+    model->math_mode = config->math_mode;
+    model->verbose = 0;
+    train_logistic_regression(model, &train);
+
+    LogisticRegression* raw = export_raw_logistic_regression(model, scaler);
+    score_logistic_regression(raw, test, 0.5, probabilities, predictions, NULL);
+
+    free_logistic_regression(raw);
+    free_logistic_regression(model);
+    free_scaler(scaler);
+    safe_free(labels);
+    if (!scaled_rows) free_matrix(rows, n_train);
+}
+
+/**
+ * Fonction : fit_score_tree_rows
+ * Rôle     : Entraîne un arbre sur des lignes du dataset à partir du pré-tri partagé (ni copie ni tri ;
+ *            seuils insensibles à la normalisation) et score la vue de test (seuil 0.5)
+ * Param    : config (hyperparamètres), dataset (dataset imputé, lu seulement), presort (pré-tri de dataset),
+ *            train_rows (index [n_train]), n_train (nombre de lignes d'entraînement),
+ *            test (vue de test), probabilities, predictions (sorties [test->rows])
+ * Retour   : void
+ */
+void fit_score_tree_rows(DecisionTree* config, Dataset* dataset, TreePresort* presort, const int* train_rows, int n_train,
+                         Dataset* test, double* probabilities, int* predictions) {
+    DecisionTree* tree = create_decision_tree(config->max_depth, config->min_samples_split,
+                                              config->min_samples_leaf, config->criterion);
+    train_decision_tree_rows(tree, dataset, presort, train_rows, n_train);
+    score_tree_dataset(tree, test, 0.5, probabilities, predictions);
+    free_decision_tree(tree);
+}
+
+/* **************************************************
+ * # --- ÉVALUATION D'UN FOLD --- #
+ * ************************************************** */
+
+/**
+ * Fonction : fit_and_score_fold
+ * Rôle     : Sépare les lignes du fold (test, en vue) des autres (train, en index), ajuste et score le modèle,
+ *            puis range les métriques et probabilités hors fold dans le rapport
+ * Param    : job (travail partagé), buffers (mémoire du thread), fold (index du fold)
+ * Retour   : void
+ */
+static void fit_and_score_fold(CVJob* job, FoldBuffers* buffers, int fold) {
+    Dataset* dataset = job->dataset;
+    Folds* folds = job->folds;
+    int test_start = folds->offsets[fold];
+    int test_end = folds->offsets[fold + 1];
+
+    int n_train = 0, n_test = 0;
+    for (int k = 0; k < folds->n_samples; k++) {
+        int row = folds->indices[k];
+        if (k >= test_start && k < test_end) {
+            buffers->test.data[n_test] = dataset->data[row];
+            buffers->test.labels[n_test++] = dataset->labels[row];
+        } else {
+            buffers->train_index[n_train++] = row;
+        }
+    }
+    buffers->test.rows = n_test;
+
+    if (job->model_type == CV_LOGISTIC) {
+        fit_score_logistic_rows(job->logistic, dataset, buffers->train_index, n_train, buffers->scaled_rows,
+                                &buffers->test, buffers->probabilities, buffers->predictions);
+    } else {
+        fit_score_tree_rows(job->tree, dataset, job->presort, buffers->train_index, n_train,
+                            &buffers->test, buffers->probabilities, buffers->predictions);
+    }
+
+    CrossValidationReport* report = job->report;
+    report->folds[fold] = compute_metrics_report(buffers->test.labels, buffers->predictions, n_test);
+    report->folds[fold].auc_roc = compute_auc_roc(buffers->probabilities, buffers->test.labels, n_test);
+    for (int k = 0; k < n_test; k++) {
+        report->oof_probabilities[folds->indices[test_start + k]] = buffers->probabilities[k];
+    }
+}
+
+/**
+ * Fonction : cv_worker_task
+ * Rôle     : Tâche parallèle : un thread traite les folds worker, worker + n_workers, ... avec les mêmes buffers
+ * Param    : worker (index du thread), context (CVJob partagé)
+ * Retour   : void
+ */
+static void cv_worker_task(int worker, void* context) {
+    CVJob* job = (CVJob*)context;
+    Folds* folds = job->folds;
+
+    int max_test = 1, min_test = folds->n_samples;
+    for (int f = 0; f < folds->n_folds; f++) {
+        int size = folds->offsets[f + 1] - folds->offsets[f];
+        if (size > max_test) max_test = size;
+        if (size < min_test) min_test = size;
+    }
+    int max_train = folds->n_samples - min_test > 0 ? folds->n_samples - min_test : 1;
+
+    FoldBuffers buffers;
+    buffers.train_index = (int*)safe_malloc(max_train * sizeof(int));
+    buffers.scaled_rows = job->model_type == CV_LOGISTIC ? allocate_matrix(max_train, job->dataset->cols) : NULL;
+    buffers.test.cols = job->dataset->cols;
+    buffers.test.data = (double**)safe_malloc(max_test * sizeof(double*));
+    buffers.test.labels = (int*)safe_malloc(max_test * sizeof(int));
+    buffers.probabilities = (double*)safe_malloc(max_test * sizeof(double));
+    buffers.predictions = (int*)safe_malloc(max_test * sizeof(int));
+
+    for (int fold = worker; fold < folds->n_folds; fold += job->n_workers) {
+        fit_and_score_fold(job, &buffers, fold);
+    }
+
+    safe_free(buffers.train_index);
+    if (buffers.scaled_rows) free_matrix(buffers.scaled_rows, max_train);
+    safe_free(buffers.test.data);
+    safe_free(buffers.test.labels);
+    safe_free(buffers.probabilities);
+    safe_free(buffers.predictions);
+}
+
+/* **************************************************
+ * # --- VALIDATION CROISÉE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : summarize
+ * Rôle     : Moyenne et écart-type (n - 1) d'une métrique sur les folds
+ * Param    : values (valeur par fold [n]), n (nombre de folds)
+ * Retour   : MetricSummary (moyenne et écart-type)
+ */
+static MetricSummary summarize(const double* values, int n) {
+    MetricSummary summary = {0.0, 0.0};
+    for (int f = 0; f < n; f++) summary.mean += values[f] / n;
+    for (int f = 0; f < n; f++) summary.std += (values[f] - summary.mean) * (values[f] - summary.mean);
+    summary.std = n > 1 ? sqrt(summary.std / (n - 1)) : 0.0;
+    return summary;
+}
+
+/**
+ * Fonction : run_cross_validation
+ * Rôle     : Évalue tous les folds en parallèle (un jeu de buffers par thread) puis agrège les métriques
+ * Param    : job (travail préparé par cross_validate_logistic ou cross_validate_tree)
+ * Retour   : CrossValidationReport* (métriques par fold, moyennes et écarts-types, probabilités hors fold)
+ */
+static CrossValidationReport* run_cross_validation(CVJob* job) {
+    int n_folds = job->folds->n_folds;
+    CrossValidationReport* report = (CrossValidationReport*)safe_malloc(sizeof(CrossValidationReport));
+    report->n_folds = n_folds;
+    report->folds = (MetricsReport*)safe_malloc(n_folds * sizeof(MetricsReport));
+    report->oof_probabilities = (double*)safe_malloc(job->folds->n_samples * sizeof(double));
+    job->report = report;
+
+    job->n_workers = get_num_threads();
+    if (job->n_workers > n_folds) job->n_workers = n_folds;
+    parallel_for(job->n_workers, cv_worker_task, job);
+
+    double* values = (double*)safe_malloc(n_folds * sizeof(double));
+    for (int f = 0; f < n_folds; f++) values[f] = report->folds[f].accuracy;
+    report->accuracy = summarize(values, n_folds);
+    for (int f = 0; f < n_folds; f++) values[f] = report->folds[f].precision;
+    report->precision = summarize(values, n_folds);
+    for (int f = 0; f < n_folds; f++) values[f] = report->folds[f].recall;
+    report->recall = summarize(values, n_folds);
+    for (int f = 0; f < n_folds; f++) values[f] = report->folds[f].f1_score;
+    report->f1_score = summarize(values, n_folds);
+    for (int f = 0; f < n_folds; f++) values[f] = report->folds[f].auc_roc;
+    report->auc_roc = summarize(values, n_folds);
+    safe_free(values);
+
+    return report;
+}
+
+/**
+ * Fonction : cross_validate_logistic
+ * Rôle     : Validation croisée d'une régression logistique : par fold, scaler et modèle ajustés sur le train
+ *            du fold uniquement, test scoré en espace brut
+ * Param    : dataset (dataset imputé, non normalisé), folds (partition des lignes),
+ *            config (hyperparamètres : learning_rate, max_iterations, pénalité, math_mode ; poids ignorés)
+ * Retour   : CrossValidationReport* (rapport, NULL si folds et dataset ne correspondent pas)
+ */
+CrossValidationReport* cross_validate_logistic(Dataset* dataset, Folds* folds, LogisticRegression* config) {
+    if (!folds || folds->n_samples != dataset->rows) {
+        fprintf(stderr, "Folds do not match dataset (%d rows)\n", dataset->rows);
+        return NULL;
+    }
+    CVJob job = {dataset, folds, CV_LOGISTIC, config, NULL, NULL, 0, NULL};
+    return run_cross_validation(&job);
+}
+
+/**
+ * Fonction : cross_validate_tree
+ * Rôle     : Validation croisée d'un arbre de décision : le dataset est pré-trié une fois et chaque fold
+ *            entraîne sur ses lignes par filtrage du pré-tri (seuils insensibles à la normalisation)
+ * Param    : dataset (dataset imputé), folds (partition des lignes), config (hyperparamètres de l'arbre)
+ * Retour   : CrossValidationReport* (rapport, NULL si folds et dataset ne correspondent pas)
+ */
+CrossValidationReport* cross_validate_tree(Dataset* dataset, Folds* folds, DecisionTree* config) {
+    if (!folds || folds->n_samples != dataset->rows) {
+        fprintf(stderr, "Folds do not match dataset (%d rows)\n", dataset->rows);
+        return NULL;
+    }
+    CVJob job = {dataset, folds, CV_TREE, NULL, config, presort_dataset(dataset), 0, NULL};
+    CrossValidationReport* report = run_cross_validation(&job);
+    free_tree_presort(job.presort);
+    return report;
+}
+
+/**
+ * Fonction : print_cross_validation_report
+ * Rôle     : Affiche les métriques de chaque fold puis moyenne ± écart-type
+ * Param    : name (nom du modèle), report (rapport de validation croisée)
+ * Retour   : void
+ */
+void print_cross_validation_report(const char* name, CrossValidationReport* report) {
+    printf("%s - %d-fold cross-validation:\n", name, report->n_folds);
+    for (int f = 0; f < report->n_folds; f++) {
+        MetricsReport* fold = &report->folds[f];
+        printf("  Fold %d: Accuracy=%.4f  F1=%.4f  AUC=%.4f\n", f + 1, fold->accuracy, fold->f1_score, fold->auc_roc);
+    }
+    printf("  Accuracy:  %.4f ± %.4f\n", report->accuracy.mean, report->accuracy.std);
+    printf("  Precision: %.4f ± %.4f\n", report->precision.mean, report->precision.std);
+    printf("  Recall:    %.4f ± %.4f\n", report->recall.mean, report->recall.std);
+    printf("  F1-Score:  %.4f ± %.4f\n", report->f1_score.mean, report->f1_score.std);
+    printf("  AUC-ROC:   %.4f ± %.4f\n", report->auc_roc.mean, report->auc_roc.std);
+}
+
+/**
+ * Fonction : free_cross_validation_report
+ * Rôle     : Libère complètement la mémoire allouée pour un rapport de validation croisée
+ * Param    : report (rapport à libérer)
+ * Retour   : void
+ */
+void free_cross_validation_report(CrossValidationReport* report) {
+    if (report) {
+        safe_free(report->folds);
+        safe_free(report->oof_probabilities);
+        safe_free(report);
+    }
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/cross_validation.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour la validation croisée (k-fold et stratifiée)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef CROSS_VALIDATION_H
+#define CROSS_VALIDATION_H
+
+#include <stdint.h>
+#include "metrics.h"
+#include "../models/logistic_regression.h"
+#include "../models/decision_tree.h"
+
+/*
+ * Partition des lignes en folds, sous forme d'index (aucune ligne copiée) :
+ * le fold f est indices[offsets[f] .. offsets[f + 1]).
+ */
+typedef struct {
+    int n_folds;
+    int n_samples;
+    int* indices;    // [n_samples] lignes regroupées par fold
+    int* offsets;    // [n_folds + 1]
+} Folds;
+
+typedef struct {
+    double mean;
+    double std;
+} MetricSummary;
+
+typedef struct {
+    int n_folds;
+    MetricsReport* folds;          // [n_folds] métriques de test de chaque fold (seuil 0.5, auc_roc renseignée)
+    double* oof_probabilities;     // [n_samples] probabilité de chaque ligne par le modèle qui ne l'a pas vue
+    MetricSummary accuracy;
+    MetricSummary precision;
+    MetricSummary recall;
+    MetricSummary f1_score;
+    MetricSummary auc_roc;
+} CrossValidationReport;
+
+Folds* make_kfolds(int n_samples, int n_folds, uint64_t seed);
+Folds* make_stratified_folds(int* labels, int n_samples, int n_folds, uint64_t seed);
+void free_folds(Folds* folds);
+
+void fit_score_logistic_rows(LogisticRegression* config, Dataset* dataset, const int* train_rows, int n_train,
+                             double** scaled_rows, Dataset* test, double* probabilities, int* predictions);
+void fit_score_tree_rows(DecisionTree* config, Dataset* dataset, TreePresort* presort, const int* train_rows, int n_train,
+                         Dataset* test, double* probabilities, int* predictions);
+
+CrossValidationReport* cross_validate_logistic(Dataset* dataset, Folds* folds, LogisticRegression* config);
+CrossValidationReport* cross_validate_tree(Dataset* dataset, Folds* folds, DecisionTree* config);
+void print_cross_validation_report(const char* name, CrossValidationReport* report);
+void free_cross_validation_report(CrossValidationReport* report);
+
+#endif
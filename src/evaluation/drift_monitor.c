@@ -0,0 +1,411 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/drift_monitor.c
+
+Rôle : Suivi de dérive en flux : distributions de référence par déciles du train, PSI/CSI et KS des lots de production
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "drift_monitor.h"
+#include "../utils/memory_manager.h"
+#include <math.h>
+#include <string.h>
+
+#define DRIFT_MIN_PROPORTION 1e-4   // Plancher des proportions dans le PSI (intervalle vide d'un côté)
+
+/* **************************************************
+ * # --- CONSTRUCTION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : allocate_counts
+ * Rôle     : Alloue des compteurs nuls pour chaque feature d'un binner (n_bins + 1 cases, NaN en dernier)
+ * Param    : binner (binner ajusté)
+ * Retour   : long** (compteurs [n_features][n_bins + 1])
+ */
+static long** allocate_counts(Binner* binner) {
+    long** counts = (long**)safe_malloc(binner->n_features * sizeof(long*));
+    for (int j = 0; j < binner->n_features; j++) {
+        counts[j] = (long*)safe_calloc(binner->n_bins[j] + 1, sizeof(long));
+    }
+    return counts;
+}
+
+/**
+ * Fonction : create_drift_monitor
+ * Rôle     : Crée un moniteur dont la référence est la distribution des features du train, découpées en
+ *            n_bins intervalles à effectifs égaux (la référence de score s'ajoute par drift_monitor_fit_scores)
+ * Param    : reference (dataset d'entraînement, dans l'espace des lots à surveiller), n_bins (DRIFT_DEFAULT_BINS si <= 0)
+ * Retour   : DriftMonitor* (moniteur sans lot accumulé)
+ */
+DriftMonitor* create_drift_monitor(Dataset* reference, int n_bins) {
+    DriftMonitor* monitor = (DriftMonitor*)safe_malloc(sizeof(DriftMonitor));
+    monitor->n_features = reference->cols;
+    monitor->feature_binner = create_binner(n_bins > 0 ? n_bins : DRIFT_DEFAULT_BINS, 0);
+    fit_binner(monitor->feature_binner, reference);
+    monitor->reference = allocate_counts(monitor->feature_binner);
+    monitor->current = allocate_counts(monitor->feature_binner);
+    binner_histogram(monitor->feature_binner, reference, monitor->reference);
+
+    monitor->score_binner = NULL;
+    monitor->reference_scores = NULL;
+    monitor->current_scores = NULL;
+    monitor->current_rows = 0;
+    return monitor;
+}
+
+/**
+ * Fonction : drift_monitor_fit_scores
+ * Rôle     : Ajoute la distribution de référence des scores (probabilités du modèle sur le train), découpée comme
+ *            les features ; les scores sont vus comme un dataset d'une colonne sans copie
+ * Param    : monitor (moniteur), scores (scores du train [n]), n_samples (nombre de scores)
+ * Retour   : void
+ */
+void drift_monitor_fit_scores(DriftMonitor* monitor, const double* scores, int n_samples) {
+    Dataset view;
+    view.rows = n_samples;
+    view.cols = 1;
+    view.labels = NULL;
+    view.data = (double**)safe_malloc((n_samples > 0 ? n_samples : 1) * sizeof(double*));
+    for (int i = 0; i < n_samples; i++) {
+        view.data[i] = (double*)&scores[i];
+    }
+
+    free_binner(monitor->score_binner);
+    monitor->score_binner = create_binner(monitor->feature_binner->max_bins, 0);
+    fit_binner(monitor->score_binner, &view);
+
+    long** counts = allocate_counts(monitor->score_binner);
+    binner_histogram(monitor->score_binner, &view, counts);
+    safe_free(monitor->reference_scores);
+    safe_free(monitor->current_scores);
+    monitor->reference_scores = counts[0];
+    monitor->current_scores = (long*)safe_calloc(monitor->score_binner->n_bins[0] + 1, sizeof(long));
+    safe_free(counts);
+    safe_free(view.data);
+}
+
+/* **************************************************
+ * # --- ACCUMULATION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : drift_monitor_update
+ * Rôle     : Accumule un lot de production : une passe par feature (en parallèle, recherche sans branchement
+ *            dans les bornes) qui incrémente directement les compteurs, puis les scores du lot
+ * Param    : monitor (moniteur), batch (lot, mêmes features que la référence),
+ *            scores (scores du lot [batch->rows], NULL pour ne suivre que les features)
+ * Retour   : void
+ */
+void drift_monitor_update(DriftMonitor* monitor, Dataset* batch, const double* scores) {
+    if (binner_histogram(monitor->feature_binner, batch, monitor->current) != 0) return;
+    monitor->current_rows += batch->rows;
+
+    if (!scores || !monitor->score_binner) return;
+    int missing = monitor->score_binner->n_bins[0];
+    for (int i = 0; i < batch->rows; i++) {
+        uint8_t code = bin_value(monitor->score_binner, 0, scores[i]);
+        monitor->current_scores[code == BIN_MISSING ? missing : code]++;
+    }
+}
+
+/**
+ * Fonction : drift_monitor_update_row
+ * Rôle     : Accumule une seule ligne scorée (scoring ligne à ligne d'un pipeline, sans lot à constituer)
+ * Param    : monitor (moniteur), row (features de la ligne [n_features]),
+ *            score (score de la ligne, dans l'espace de la référence de score ; ignoré sans cette référence)
+ * Retour   : void
+ */
+void drift_monitor_update_row(DriftMonitor* monitor, const double* row, double score) {
+    Binner* binner = monitor->feature_binner;
+    for (int j = 0; j < monitor->n_features; j++) {
+        uint8_t code = bin_value(binner, j, row[j]);
+        monitor->current[j][code == BIN_MISSING ? binner->n_bins[j] : code]++;
+    }
+    monitor->current_rows++;
+
+    if (!monitor->score_binner) return;
+    uint8_t code = bin_value(monitor->score_binner, 0, score);
+    monitor->current_scores[code == BIN_MISSING ? monitor->score_binner->n_bins[0] : code]++;
+}
+
+/**
+ * Fonction : drift_monitor_reset
+ * Rôle     : Remet à zéro les lots accumulés (début d'une nouvelle période), la référence est conservée
+ * Param    : monitor (moniteur)
+ * Retour   : void
+ */
+void drift_monitor_reset(DriftMonitor* monitor) {
+    for (int j = 0; j < monitor->n_features; j++) {
+        memset(monitor->current[j], 0, (monitor->feature_binner->n_bins[j] + 1) * sizeof(long));
+    }
+    if (monitor->current_scores) {
+        memset(monitor->current_scores, 0, (monitor->score_binner->n_bins[0] + 1) * sizeof(long));
+    }
+    monitor->current_rows = 0;
+}
+
+/* **************************************************
+ * # --- PSI ET KS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : compare_counts
+ * Rôle     : PSI = Σ (a - e) * ln(a / e) sur les proportions de chaque intervalle (planchers à DRIFT_MIN_PROPORTION),
+ *            et KS sur les fonctions de répartition cumulées dans l'ordre des intervalles
+ * Param    : expected (effectifs de référence), actual (effectifs courants), n_slots (n_bins + 1, NaN en dernier)
+ * Retour   : DriftStatistic (NaN si l'un des deux côtés est vide)
+ */
+static DriftStatistic compare_counts(const long* expected, const long* actual, int n_slots) {
+    DriftStatistic statistic = {NAN, NAN};
+    long total_expected = 0, total_actual = 0;
+    for (int b = 0; b < n_slots; b++) {
+        total_expected += expected[b];
+        total_actual += actual[b];
+    }
+    if (total_expected == 0 || total_actual == 0) return statistic;
+
+    statistic.psi = 0.0;
+    statistic.ks = 0.0;
+    double cdf_expected = 0.0, cdf_actual = 0.0;
+    for (int b = 0; b < n_slots; b++) {
+        double e = (double)expected[b] / total_expected;
+        double a = (double)actual[b] / total_actual;
+        cdf_expected += e;
+        cdf_actual += a;
+        double gap = fabs(cdf_expected - cdf_actual);
+        if (gap > statistic.ks) statistic.ks = gap;
+
+        e = e > DRIFT_MIN_PROPORTION ? e : DRIFT_MIN_PROPORTION;
+        a = a > DRIFT_MIN_PROPORTION ? a : DRIFT_MIN_PROPORTION;
+        statistic.psi += (a - e) * log(a / e);
+    }
+    return statistic;
+}
+
+/**
+ * Fonction : compute_drift_report
+ * Rôle     : Compare les lots accumulés à la référence : CSI et KS par feature, PSI et KS du score
+ * Param    : monitor (moniteur)
+ * Retour   : DriftReport* (statistiques de dérive)
+ */
+DriftReport* compute_drift_report(DriftMonitor* monitor) {
+    DriftReport* report = (DriftReport*)safe_malloc(sizeof(DriftReport));
+    report->n_features = monitor->n_features;
+    report->n_rows = monitor->current_rows;
+    report->features = (DriftStatistic*)safe_malloc(monitor->n_features * sizeof(DriftStatistic));
+    for (int j = 0; j < monitor->n_features; j++) {
+        report->features[j] = compare_counts(monitor->reference[j], monitor->current[j],
+                                             monitor->feature_binner->n_bins[j] + 1);
+    }
+
+    report->score.psi = NAN;
+    report->score.ks = NAN;
+    if (monitor->score_binner) {
+        report->score = compare_counts(monitor->reference_scores, monitor->current_scores,
+                                       monitor->score_binner->n_bins[0] + 1);
+    }
+    return report;
+}
+
+/**
+ * Fonction : drift_status
+ * Rôle     : Niveau d'alerte d'un PSI selon les seuils usuels (0.1 et 0.25)
+ * Param    : psi (indice de stabilité)
+ * Retour   : const char* (libellé)
+ */
+static const char* drift_status(double psi) {
+    if (isnan(psi)) return "n/a";
+    if (psi < DRIFT_PSI_MODERATE) return "stable";
+    if (psi < DRIFT_PSI_SIGNIFICANT) return "moderate";
+    return "SIGNIFICANT";
+}
+
+/**
+ * Fonction : print_drift_report
+ * Rôle     : Affiche CSI, KS et niveau d'alerte de chaque feature, puis PSI et KS du score
+ * Param    : report (rapport de dérive), feature_names (noms [n_features], NULL pour des indices)
+ * Retour   : void
+ */
+void print_drift_report(DriftReport* report, const char** feature_names) {
+    printf("Drift over %ld rows (PSI < %.2f stable, >= %.2f significant):\n",
+           report->n_rows, DRIFT_PSI_MODERATE, DRIFT_PSI_SIGNIFICANT);
+    printf("+----------------------------+----------+----------+-------------+\n");
+    printf("| Feature                    | CSI      | KS       | Status      |\n");
+    printf("+----------------------------+----------+----------+-------------+\n");
+    for (int j = 0; j < report->n_features; j++) {
+        DriftStatistic* statistic = &report->features[j];
+        if (feature_names) {
+            printf("| %-26.26s | %8.4f | %8.4f | %-11s |\n", feature_names[j],
+                   statistic->psi, statistic->ks, drift_status(statistic->psi));
+        } else {
+            printf("| feature %-18d | %8.4f | %8.4f | %-11s |\n", j,
+                   statistic->psi, statistic->ks, drift_status(statistic->psi));
+        }
+    }
+    printf("+----------------------------+----------+----------+-------------+\n");
+    printf("| Score (PSI)                | %8.4f | %8.4f | %-11s |\n",
+           report->score.psi, report->score.ks, drift_status(report->score.psi));
+    printf("+----------------------------+----------+----------+-------------+\n");
+}
+
+/**
+ * Fonction : copy_drift_monitor
+ * Rôle     : Duplique un moniteur (référence et lots accumulés)
+ * Param    : monitor (moniteur à copier)
+ * Retour   : DriftMonitor* (copie indépendante)
+ */
+DriftMonitor* copy_drift_monitor(DriftMonitor* monitor) {
+    DriftMonitor* copy = (DriftMonitor*)safe_malloc(sizeof(DriftMonitor));
+    copy->n_features = monitor->n_features;
+    copy->feature_binner = copy_binner(monitor->feature_binner);
+    copy->reference = allocate_counts(copy->feature_binner);
+    copy->current = allocate_counts(copy->feature_binner);
+    for (int j = 0; j < monitor->n_features; j++) {
+        int n_slots = monitor->feature_binner->n_bins[j] + 1;
+        memcpy(copy->reference[j], monitor->reference[j], n_slots * sizeof(long));
+        memcpy(copy->current[j], monitor->current[j], n_slots * sizeof(long));
+    }
+
+    copy->score_binner = NULL;
+    copy->reference_scores = NULL;
+    copy->current_scores = NULL;
+    if (monitor->score_binner) {
+        int n_slots = monitor->score_binner->n_bins[0] + 1;
+        copy->score_binner = copy_binner(monitor->score_binner);
+        copy->reference_scores = (long*)safe_malloc(n_slots * sizeof(long));
+        copy->current_scores = (long*)safe_malloc(n_slots * sizeof(long));
+        memcpy(copy->reference_scores, monitor->reference_scores, n_slots * sizeof(long));
+        memcpy(copy->current_scores, monitor->current_scores, n_slots * sizeof(long));
+    }
+    copy->current_rows = monitor->current_rows;
+    return copy;
+}
+
+/* **************************************************
+ * # --- SAUVEGARDE/CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : write_drift_monitor
+ * Rôle     : Écrit la référence du moniteur (bornes et effectifs du train) dans un fichier ouvert ;
+ *            les lots accumulés ne sont pas sauvegardés
+ * Param    : file (fichier de destination), monitor (moniteur)
+ * Retour   : void
+ */
+void write_drift_monitor(FILE* file, DriftMonitor* monitor) {
+    write_binner(file, monitor->feature_binner);
+    for (int j = 0; j < monitor->n_features; j++) {
+        fwrite(monitor->reference[j], sizeof(long), monitor->feature_binner->n_bins[j] + 1, file);
+    }
+
+    int has_scores = monitor->score_binner != NULL;
+    fwrite(&has_scores, sizeof(int), 1, file);
+    if (has_scores) {
+        write_binner(file, monitor->score_binner);
+        fwrite(monitor->reference_scores, sizeof(long), monitor->score_binner->n_bins[0] + 1, file);
+    }
+}
+
+/**
+ * Fonction : read_counts
+ * Rôle     : Lit des effectifs et vérifie qu'ils sont positifs
+ * Param    : file (fichier source), counts (destination), n (nombre d'effectifs)
+ * Retour   : int (1 si valides, 0 sinon)
+ */
+static int read_counts(FILE* file, long* counts, int n) {
+    if (fread(counts, sizeof(long), n, file) != (size_t)n) return 0;
+    for (int b = 0; b < n; b++) {
+        if (counts[b] < 0) return 0;
+    }
+    return 1;
+}
+
+/**
+ * Fonction : read_drift_monitor
+ * Rôle     : Lit un moniteur écrit par write_drift_monitor (aucun lot accumulé)
+ * Param    : file (fichier source)
+ * Retour   : DriftMonitor* (moniteur chargé, NULL en cas d'erreur)
+ */
+DriftMonitor* read_drift_monitor(FILE* file) {
+    Binner* binner = read_binner(file);
+    if (!binner) return NULL;
+
+    DriftMonitor* monitor = (DriftMonitor*)safe_malloc(sizeof(DriftMonitor));
+    monitor->n_features = binner->n_features;
+    monitor->feature_binner = binner;
+    monitor->reference = allocate_counts(binner);
+    monitor->current = allocate_counts(binner);
+    monitor->score_binner = NULL;
+    monitor->reference_scores = NULL;
+    monitor->current_scores = NULL;
+    monitor->current_rows = 0;
+
+    int valid = 1;
+    for (int j = 0; j < monitor->n_features && valid; j++) {
+        valid = read_counts(file, monitor->reference[j], binner->n_bins[j] + 1);
+    }
+
+    int has_scores = 0;
+    valid = valid && fread(&has_scores, sizeof(int), 1, file) == 1;
+    if (valid && has_scores) {
+        monitor->score_binner = read_binner(file);
+        valid = monitor->score_binner != NULL && monitor->score_binner->n_features == 1;
+        if (valid) {
+            int n_slots = monitor->score_binner->n_bins[0] + 1;
+            monitor->reference_scores = (long*)safe_calloc(n_slots, sizeof(long));
+            monitor->current_scores = (long*)safe_calloc(n_slots, sizeof(long));
+            valid = read_counts(file, monitor->reference_scores, n_slots);
+        }
+    }
+
+    if (!valid) {
+        free_drift_monitor(monitor);
+        return NULL;
+    }
+    return monitor;
+}
+
+/**
+ * Fonction : free_drift_report
+ * Rôle     : Libère complètement la mémoire allouée pour un rapport de dérive
+ * Param    : report (rapport à libérer)
+ * Retour   : void
+ */
+void free_drift_report(DriftReport* report) {
+    if (report) {
+        safe_free(report->features);
+        safe_free(report);
+    }
+}
+
+/**
+ * Fonction : free_drift_monitor
+ * Rôle     : Libère complètement la mémoire allouée pour un moniteur
+ * Param    : monitor (moniteur à libérer)
+ * Retour   : void
+ */
+void free_drift_monitor(DriftMonitor* monitor) {
+    if (monitor) {
+        for (int j = 0; j < monitor->n_features; j++) {
+            safe_free(monitor->reference[j]);
+            safe_free(monitor->current[j]);
+        }
+        safe_free(monitor->reference);
+        safe_free(monitor->current);
+        safe_free(monitor->reference_scores);
+        safe_free(monitor->current_scores);
+        free_binner(monitor->feature_binner);
+        free_binner(monitor->score_binner);
+        safe_free(monitor);
+    }
+}
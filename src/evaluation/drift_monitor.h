@@ -0,0 +1,70 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/drift_monitor.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le suivi de dérive (PSI, CSI, KS) des features et des scores
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef DRIFT_MONITOR_H
+#define DRIFT_MONITOR_H
+
+#include <stdio.h>
+#include "../preprocessing/binner.h"
+
+#define DRIFT_DEFAULT_BINS 10
+#define DRIFT_PSI_MODERATE 0.1     // PSI < 0.1 : population stable
+#define DRIFT_PSI_SIGNIFICANT 0.25 // PSI >= 0.25 : dérive significative, modèle à revoir
+
+/*
+ * Distributions de référence (train) et courantes (lots de production cumulés) sur les mêmes intervalles :
+ * déciles du train pour chaque feature et pour le score. counts[j] a n_bins + 1 cases, la dernière
+ * comptant les valeurs manquantes. Les lots ne font qu'incrémenter des compteurs : mémoire fixe, et
+ * deux moniteurs de même référence s'additionnent.
+ */
+typedef struct {
+    int n_features;
+    Binner* feature_binner;     // Quantiles des features du train
+    Binner* score_binner;       // Quantiles des scores du train (NULL sans référence de score)
+    long** reference;           // [n_features][n_bins + 1] effectifs du train
+    long** current;             // [n_features][n_bins + 1] effectifs cumulés des lots
+    long* reference_scores;     // [n_score_bins + 1]
+    long* current_scores;       // [n_score_bins + 1]
+    long current_rows;          // Lignes accumulées depuis le dernier reset
+} DriftMonitor;
+
+typedef struct {
+    double psi;      // Population Stability Index (CSI pour une feature)
+    double ks;       // Écart maximal entre fonctions de répartition, aux bornes des intervalles
+} DriftStatistic;
+
+typedef struct {
+    int n_features;
+    long n_rows;
+    DriftStatistic* features;   // [n_features]
+    DriftStatistic score;       // NaN sans référence de score
+} DriftReport;
+
+DriftMonitor* create_drift_monitor(Dataset* reference, int n_bins);
+void drift_monitor_fit_scores(DriftMonitor* monitor, const double* scores, int n_samples);
+void drift_monitor_update(DriftMonitor* monitor, Dataset* batch, const double* scores);
+void drift_monitor_update_row(DriftMonitor* monitor, const double* row, double score);
+void drift_monitor_reset(DriftMonitor* monitor);
+DriftReport* compute_drift_report(DriftMonitor* monitor);
+void print_drift_report(DriftReport* report, const char** feature_names);
+DriftMonitor* copy_drift_monitor(DriftMonitor* monitor);
+void write_drift_monitor(FILE* file, DriftMonitor* monitor);
+DriftMonitor* read_drift_monitor(FILE* file);
+void free_drift_report(DriftReport* report);
+void free_drift_monitor(DriftMonitor* monitor);
+
+#endif
@@ -0,0 +1,460 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/hyperparameter_search.c
+
+Rôle : Recherche d'hyperparamètres en grille ou aléatoire, essais parallèles élagués par successive halving
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "hyperparameter_search.h"
+#include "cross_validation.h"
+#include "metrics.h"
+#include "../utils/memory_manager.h"
+#include "../utils/parallel.h"
+#include "../utils/random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+/*
+ * Données partagées en lecture seule par les essais d'un palier : dataset imputé, pré-tri de l'arbre
+ * (calculé une fois pour toute la recherche) et vue de validation. Le palier courant entraîne chaque
+ * essai sur les budget premières lignes de pool, mélangé une fois : les sous-ensembles sont emboîtés.
+ */
+typedef struct {
+    Dataset* dataset;
+    TreePresort* presort;     // NULL pour la régression logistique
+    Dataset validation;       // Vue sur les lignes de validation
+    int* pool;                // [n_train] lignes d'entraînement mélangées
+    int budget;
+    SearchReport* report;
+    int* survivors;           // [n_survivors] essais évalués à ce palier
+} SearchJob;
+
+// Essai et score, pour le classement d'un palier
+typedef struct {
+    int trial;
+    double score;
+} RankedTrial;
+
+/* **************************************************
+ * # --- ESPACES DE RECHERCHE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : fixed_param
+ * Rôle     : Construit un paramètre fixé à une valeur (grille d'un seul élément)
+ * Param    : name (nom affiché), value (valeur)
+ * Retour   : SearchParam (paramètre fixe)
+ */
+static SearchParam fixed_param(const char* name, double value) {
+    SearchParam param;
+    param.name = name;
+    param.kind = PARAM_GRID;
+    param.n_values = 1;
+    param.values[0] = value;
+    param.low = value;
+    param.high = value;
+    return param;
+}
+
+/**
+ * Fonction : create_logistic_search_space
+ * Rôle     : Espace de la régression logistique, chaque paramètre fixé à la valeur par défaut du modèle
+ * Param    : Aucun
+ * Retour   : SearchSpace (espace à élargir par search_space_grid/search_space_range)
+ */
+SearchSpace create_logistic_search_space(void) {
+    SearchSpace space;
+    space.model = SEARCH_LOGISTIC;
+    space.n_params = 5;
+    space.params[LR_LEARNING_RATE] = fixed_param("learning_rate", 0.01);
+    space.params[LR_MAX_ITERATIONS] = fixed_param("max_iterations", 1000);
+    space.params[LR_PENALTY] = fixed_param("penalty", PENALTY_NONE);
+    space.params[LR_LAMBDA] = fixed_param("lambda", 0.0);
+    space.params[LR_L1_RATIO] = fixed_param("l1_ratio", 0.5);
+    return space;
+}
+
+/**
+ * Fonction : create_tree_search_space
+ * Rôle     : Espace de l'arbre de décision, chaque paramètre fixé à la configuration historique (7, 20, 10, GINI)
+ * Param    : Aucun
+ * Retour   : SearchSpace (espace à élargir par search_space_grid/search_space_range)
+ */
+SearchSpace create_tree_search_space(void) {
+    SearchSpace space;
+    space.model = SEARCH_TREE;
+    space.n_params = 4;
+    space.params[DT_MAX_DEPTH] = fixed_param("max_depth", 7);
+    space.params[DT_MIN_SAMPLES_SPLIT] = fixed_param("min_samples_split", 20);
+    space.params[DT_MIN_SAMPLES_LEAF] = fixed_param("min_samples_leaf", 10);
+    space.params[DT_CRITERION] = fixed_param("criterion", GINI);
+    return space;
+}
+
+/**
+ * Fonction : search_space_grid
+ * Rôle     : Remplace un paramètre par une grille de valeurs (au plus SEARCH_MAX_VALUES)
+ * Param    : space (espace), param (indice LR_* ou DT_*), n_values (taille de la grille), values (valeurs)
+ * Retour   : void
+ */
+void search_space_grid(SearchSpace* space, int param, int n_values, const double* values) {
+    if (param < 0 || param >= space->n_params || n_values < 1) return;
+    if (n_values > SEARCH_MAX_VALUES) n_values = SEARCH_MAX_VALUES;
+
+    SearchParam* p = &space->params[param];
+    p->kind = PARAM_GRID;
+    p->n_values = n_values;
+    p->low = p->high = values[0];
+    for (int v = 0; v < n_values; v++) {
+        p->values[v] = values[v];
+        if (values[v] < p->low) p->low = values[v];
+        if (values[v] > p->high) p->high = values[v];
+    }
+}
+
+/**
+ * Fonction : search_space_range
+ * Rôle     : Remplace un paramètre par une distribution (uniforme, log-uniforme ou entière)
+ * Param    : space (espace), param (indice LR_* ou DT_*), kind (PARAM_UNIFORM, PARAM_LOG_UNIFORM, PARAM_INT_UNIFORM),
+ *            low, high (bornes incluses)
+ * Retour   : void
+ */
+void search_space_range(SearchSpace* space, int param, ParamKind kind, double low, double high) {
+    if (param < 0 || param >= space->n_params || kind == PARAM_GRID) return;
+    SearchParam* p = &space->params[param];
+    p->kind = kind;
+    p->n_values = 0;
+    p->low = low < high ? low : high;
+    p->high = low < high ? high : low;
+}
+
+/**
+ * Fonction : default_search_options
+ * Rôle     : Options par défaut : grille complète, eta = 3, 500 lignes au premier palier, validation 20 %, graine 42
+ * Param    : Aucun
+ * Retour   : SearchOptions (options par défaut)
+ */
+SearchOptions default_search_options(void) {
+    SearchOptions options;
+    options.n_trials = 0;
+    options.eta = 3;
+    options.min_budget = 500;
+    options.validation_folds = 5;
+    options.seed = 42;
+    return options;
+}
+
+/* **************************************************
+ * # --- GÉNÉRATION DES ESSAIS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : sample_param
+ * Rôle     : Tire une valeur d'un paramètre (valeur de grille au hasard ou selon sa distribution)
+ * Param    : param (paramètre), rng (flux aléatoire de l'essai)
+ * Retour   : double (valeur tirée)
+ */
+static double sample_param(SearchParam* param, RandomStream* rng) {
+    switch (param->kind) {
+        case PARAM_GRID:
+            return param->values[random_index(rng, param->n_values)];
+        case PARAM_UNIFORM:
+            return param->low + random_uniform(rng) * (param->high - param->low);
+        case PARAM_LOG_UNIFORM:
+            return exp(log(param->low) + random_uniform(rng) * (log(param->high) - log(param->low)));
+        case PARAM_INT_UNIFORM:
+        default:
+            return param->low + random_index(rng, (int)(param->high - param->low) + 1);
+    }
+}
+
+/**
+ * Fonction : generate_trials
+ * Rôle     : Produit cartésien des grilles (n_trials <= 0) ou tirages aléatoires ; l'essai t utilise le flux
+ *            (seed, t + 1), donc les valeurs ne dépendent que de la graine et de l'indice de l'essai
+ * Param    : report (rapport dont n_trials et trials sont remplis), space (espace), options (options de recherche)
+ * Retour   : void
+ */
+static void generate_trials(SearchReport* report, SearchSpace* space, SearchOptions* options) {
+    int grid = options->n_trials <= 0;
+    int n_trials = options->n_trials;
+    if (grid) {
+        n_trials = 1;
+        for (int p = 0; p < space->n_params; p++) {
+            if (space->params[p].kind == PARAM_GRID) n_trials *= space->params[p].n_values;
+        }
+    }
+
+    report->n_trials = n_trials;
+    report->trials = (SearchTrial*)safe_calloc(n_trials, sizeof(SearchTrial));
+    for (int t = 0; t < n_trials; t++) {
+        RandomStream rng;
+        seed_random_stream(&rng, options->seed, (uint64_t)t + 1);
+        int rest = t;   // Indice en base mixte sur les grilles, dernier paramètre le plus rapide
+        for (int p = space->n_params - 1; p >= 0; p--) {
+            SearchParam* param = &space->params[p];
+            if (grid && param->kind == PARAM_GRID) {
+                report->trials[t].values[p] = param->values[rest % param->n_values];
+                rest /= param->n_values;
+            } else {
+                report->trials[t].values[p] = sample_param(param, &rng);
+            }
+        }
+    }
+}
+
+/* **************************************************
+ * # --- ÉVALUATION D'UN ESSAI --- #
+ * ************************************************** */
+
+/**
+ * Fonction : search_trial_task
+ * Rôle     : Tâche parallèle : entraîne un essai survivant sur le budget du palier et note son AUC de validation
+ * Param    : task (index dans survivors), context (SearchJob partagé)
+ * Retour   : void
+ */
+static void search_trial_task(int task, void* context) {
+    SearchJob* job = (SearchJob*)context;
+    SearchReport* report = job->report;
+    SearchTrial* trial = &report->trials[job->survivors[task]];
+    int n_validation = job->validation.rows;
+
+    double* probabilities = (double*)safe_malloc(n_validation * sizeof(double));
+    int* predictions = (int*)safe_malloc(n_validation * sizeof(int));
+
+    if (report->space.model == SEARCH_LOGISTIC) {
+        LogisticRegression* config = search_logistic_config(report, job->survivors[task], job->dataset->cols);
+        fit_score_logistic_rows(config, job->dataset, job->pool, job->budget, NULL,
+                                &job->validation, probabilities, predictions);
+        free_logistic_regression(config);
+    } else {
+        DecisionTree* config = search_tree_config(report, job->survivors[task]);
+        fit_score_tree_rows(config, job->dataset, job->presort, job->pool, job->budget,
+                            &job->validation, probabilities, predictions);
+        free_decision_tree(config);
+    }
+
+    trial->budget = job->budget;
+    trial->score = compute_auc_roc(probabilities, job->validation.labels, n_validation);
+    if (isnan(trial->score)) trial->score = -INFINITY;
+
+    safe_free(probabilities);
+    safe_free(predictions);
+}
+
+/**
+ * Fonction : compare_ranked
+ * Rôle     : Comparateur qsort : score décroissant, puis indice d'essai croissant (classement déterministe)
+ * Param    : a, b (RankedTrial*)
+ * Retour   : int (négatif si a passe avant b)
+ */
+static int compare_ranked(const void* a, const void* b) {
+    const RankedTrial* x = (const RankedTrial*)a;
+    const RankedTrial* y = (const RankedTrial*)b;
+    if (x->score > y->score) return -1;
+    if (x->score < y->score) return 1;
+    return x->trial - y->trial;
+}
+
+/* **************************************************
+ * # --- SUCCESSIVE HALVING --- #
+ * ************************************************** */
+
+/**
+ * Fonction : hyperparameter_search
+ * Rôle     : Réserve un fold stratifié pour la validation, puis successive halving : au palier k, les essais
+ *            survivants sont entraînés en parallèle sur n_train / eta^(R-1-k) lignes et seul le meilleur tiers
+ *            (1 / eta) passe au palier suivant ; le dernier palier entraîne sur tout le train.
+ *            Les essais partagent le dataset et le pré-tri en lecture seule.
+ * Param    : dataset (dataset imputé, non normalisé), space (espace de recherche), options (options, NULL pour
+ *            default_search_options)
+ * Retour   : SearchReport* (essais, palier atteint, score et meilleur essai)
+ */
+SearchReport* hyperparameter_search(Dataset* dataset, SearchSpace* space, SearchOptions* options) {
+    SearchOptions defaults = default_search_options();
+    if (!options) options = &defaults;
+    int eta = options->eta >= 2 ? options->eta : 2;
+
+    SearchReport* report = (SearchReport*)safe_calloc(1, sizeof(SearchReport));
+    report->space = *space;
+    generate_trials(report, space, options);
+
+    // Validation : fold 0 ; train : les autres folds, mélangés pour que chaque préfixe soit un tirage aléatoire
+    Folds* folds = make_stratified_folds(dataset->labels, dataset->rows,
+                                         options->validation_folds >= 2 ? options->validation_folds : 5, options->seed);
+    int n_validation = folds->offsets[1];
+    int n_train = dataset->rows - n_validation;
+
+    SearchJob job;
+    job.dataset = dataset;
+    job.report = report;
+    job.presort = space->model == SEARCH_TREE ? presort_dataset(dataset) : NULL;
+    job.validation.rows = n_validation;
+    job.validation.cols = dataset->cols;
+    job.validation.data = (double**)safe_malloc((n_validation > 0 ? n_validation : 1) * sizeof(double*));
+    job.validation.labels = (int*)safe_malloc((n_validation > 0 ? n_validation : 1) * sizeof(int));
+    for (int k = 0; k < n_validation; k++) {
+        job.validation.data[k] = dataset->data[folds->indices[k]];
+        job.validation.labels[k] = dataset->labels[folds->indices[k]];
+    }
+    job.pool = (int*)safe_malloc((n_train > 0 ? n_train : 1) * sizeof(int));
+    for (int k = 0; k < n_train; k++) {
+        job.pool[k] = folds->indices[n_validation + k];
+    }
+    RandomStream rng;
+    seed_random_stream(&rng, options->seed, 0);
+    random_shuffle(&rng, job.pool, n_train);
+    free_folds(folds);
+
+    // R paliers : assez pour ramener les essais à un seul, sans descendre sous min_budget lignes
+    int n_rungs = 1;
+    long reach = eta;
+    while (reach <= report->n_trials && n_train / reach >= options->min_budget) {
+        n_rungs++;
+        reach *= eta;
+    }
+    report->n_rungs = n_rungs;
+    report->n_train = n_train;
+    report->n_validation = n_validation;
+
+    int n_survivors = report->n_trials;
+    job.survivors = (int*)safe_malloc(n_survivors * sizeof(int));
+    RankedTrial* ranking = (RankedTrial*)safe_malloc(n_survivors * sizeof(RankedTrial));
+    for (int t = 0; t < n_survivors; t++) {
+        job.survivors[t] = t;
+    }
+
+    for (int rung = 0; rung < n_rungs; rung++) {
+        long divisor = 1;
+        for (int k = rung; k < n_rungs - 1; k++) divisor *= eta;
+        job.budget = (int)(n_train / divisor);
+
+        parallel_for(n_survivors, search_trial_task, &job);
+        report->n_fitted_rows += (long)n_survivors * job.budget;
+
+        for (int s = 0; s < n_survivors; s++) {
+            report->trials[job.survivors[s]].rung = rung;
+            ranking[s].trial = job.survivors[s];
+            ranking[s].score = report->trials[job.survivors[s]].score;
+        }
+        qsort(ranking, n_survivors, sizeof(RankedTrial), compare_ranked);
+
+        if (rung < n_rungs - 1) {
+            n_survivors = n_survivors / eta > 0 ? n_survivors / eta : 1;
+            for (int s = 0; s < n_survivors; s++) {
+                job.survivors[s] = ranking[s].trial;
+            }
+        }
+    }
+    report->best = ranking[0].trial;
+
+    safe_free(ranking);
+    safe_free(job.survivors);
+    safe_free(job.pool);
+    safe_free(job.validation.data);
+    safe_free(job.validation.labels);
+    free_tree_presort(job.presort);
+    return report;
+}
+
+/* **************************************************
+ * # --- CONFIGURATIONS ET AFFICHAGE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : search_logistic_config
+ * Rôle     : Crée une régression logistique non entraînée avec les hyperparamètres d'un essai
+ * Param    : report (rapport d'une recherche SEARCH_LOGISTIC), trial (indice de l'essai, report->best en général),
+ *            n_features (nombre de features)
+ * Retour   : LogisticRegression* (modèle configuré, NULL si le rapport porte sur un autre modèle)
+ */
+LogisticRegression* search_logistic_config(SearchReport* report, int trial, int n_features) {
+    if (report->space.model != SEARCH_LOGISTIC) return NULL;
+    double* values = report->trials[trial].values;
+    LogisticRegression* model = create_logistic_regression(n_features, values[LR_LEARNING_RATE],
+                                                           (int)values[LR_MAX_ITERATIONS]);
+    model->penalty = (Penalty)(int)values[LR_PENALTY];
+    model->lambda = values[LR_LAMBDA];
+    model->l1_ratio = values[LR_L1_RATIO];
+    return model;
+}
+
+/**
+ * Fonction : search_tree_config
+ * Rôle     : Crée un arbre de décision non entraîné avec les hyperparamètres d'un essai
+ * Param    : report (rapport d'une recherche SEARCH_TREE), trial (indice de l'essai, report->best en général)
+ * Retour   : DecisionTree* (arbre configuré, NULL si le rapport porte sur un autre modèle)
+ */
+DecisionTree* search_tree_config(SearchReport* report, int trial) {
+    if (report->space.model != SEARCH_TREE) return NULL;
+    double* values = report->trials[trial].values;
+    return create_decision_tree((int)values[DT_MAX_DEPTH], (int)values[DT_MIN_SAMPLES_SPLIT],
+                                (int)values[DT_MIN_SAMPLES_LEAF], (SplitCriterion)(int)values[DT_CRITERION]);
+}
+
+/**
+ * Fonction : print_search_report
+ * Rôle     : Affiche le déroulement de la recherche puis les meilleurs essais (palier atteint, puis score)
+ * Param    : name (nom du modèle), report (rapport de recherche), top (nombre d'essais affichés)
+ * Retour   : void
+ */
+void print_search_report(const char* name, SearchReport* report, int top) {
+    int n = report->n_trials;
+    RankedTrial* ranking = (RankedTrial*)safe_malloc(n * sizeof(RankedTrial));
+    for (int t = 0; t < n; t++) {
+        ranking[t].trial = t;
+        // Palier d'abord : un score sur plus de lignes prime sur un score de palier inférieur
+        ranking[t].score = report->trials[t].rung * 2.0 + report->trials[t].score;
+    }
+    qsort(ranking, n, sizeof(RankedTrial), compare_ranked);
+
+    double full_cost = (double)n * report->n_train;
+    printf("%s - %d trials, %d rungs, %d train / %d validation rows (%.1f%% of exhaustive training cost):\n",
+           name, n, report->n_rungs, report->n_train, report->n_validation,
+           full_cost > 0 ? 100.0 * report->n_fitted_rows / full_cost : 0.0);
+    if (top > n) top = n;
+    for (int r = 0; r < top; r++) {
+        SearchTrial* trial = &report->trials[ranking[r].trial];
+        printf("  %c AUC=%.4f  rung %d (%6d rows) ", ranking[r].trial == report->best ? '*' : ' ',
+               trial->score, trial->rung + 1, trial->budget);
+        for (int p = 0; p < report->space.n_params; p++) {
+            SearchParam* param = &report->space.params[p];
+            if (param->kind == PARAM_GRID && param->n_values == 1) continue;
+            int code = (int)trial->values[p];
+            if (report->space.model == SEARCH_TREE && p == DT_CRITERION) {
+                printf(" %s=%s", param->name, code == GINI ? "GINI" : "ENTROPY");
+            } else if (report->space.model == SEARCH_LOGISTIC && p == LR_PENALTY) {
+                static const char* penalties[] = {"NONE", "L2", "L1", "ELASTIC_NET"};
+                printf(" %s=%s", param->name, code >= 0 && code <= PENALTY_ELASTIC_NET ? penalties[code] : "?");
+            } else {
+                printf(" %s=%g", param->name, trial->values[p]);
+            }
+        }
+        printf("\n");
+    }
+    safe_free(ranking);
+}
+
+/**
+ * Fonction : free_search_report
+ * Rôle     : Libère complètement la mémoire allouée pour un rapport de recherche
+ * Param    : report (rapport à libérer)
+ * Retour   : void
+ */
+void free_search_report(SearchReport* report) {
+    if (report) {
+        safe_free(report->trials);
+        safe_free(report);
+    }
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/hyperparameter_search.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour la recherche d'hyperparamètres (grille, aléatoire, successive halving)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef HYPERPARAMETER_SEARCH_H
+#define HYPERPARAMETER_SEARCH_H
+
+#include <stdint.h>
+#include "../models/logistic_regression.h"
+#include "../models/decision_tree.h"
+
+#define SEARCH_MAX_PARAMS 5
+#define SEARCH_MAX_VALUES 8
+
+typedef enum {
+    SEARCH_LOGISTIC,
+    SEARCH_TREE
+} SearchModel;
+
+// Indices des paramètres dans SearchSpace.params, par modèle
+enum { LR_LEARNING_RATE, LR_MAX_ITERATIONS, LR_PENALTY, LR_LAMBDA, LR_L1_RATIO };
+enum { DT_MAX_DEPTH, DT_MIN_SAMPLES_SPLIT, DT_MIN_SAMPLES_LEAF, DT_CRITERION };
+
+typedef enum {
+    PARAM_GRID,          // values[0 .. n_values) (une seule valeur = paramètre fixe)
+    PARAM_UNIFORM,       // réel uniforme sur [low, high]
+    PARAM_LOG_UNIFORM,   // réel log-uniforme sur [low, high], low > 0
+    PARAM_INT_UNIFORM    // entier uniforme sur {low, ..., high}
+} ParamKind;
+
+typedef struct {
+    const char* name;
+    ParamKind kind;
+    int n_values;
+    double values[SEARCH_MAX_VALUES];
+    double low;
+    double high;
+} SearchParam;
+
+/*
+ * Espace de recherche d'un modèle : ses paramètres dans un ordre fixe (LR_* ou DT_*), chacun fixé,
+ * donné par une grille ou tiré d'une distribution. Les énumérations (pénalité, critère) sont codées
+ * par leur valeur entière.
+ */
+typedef struct {
+    SearchModel model;
+    int n_params;
+    SearchParam params[SEARCH_MAX_PARAMS];
+} SearchSpace;
+
+typedef struct {
+    int n_trials;          // <= 0 : produit cartésien des grilles ; sinon nombre de tirages aléatoires
+    int eta;               // Facteur de sélection : 1 essai sur eta passe au palier suivant
+    int min_budget;        // Lignes d'entraînement minimales au premier palier
+    int validation_folds;  // Validation = 1 fold stratifié sur validation_folds (5 : 20 % du dataset)
+    uint64_t seed;
+} SearchOptions;
+
+typedef struct {
+    double values[SEARCH_MAX_PARAMS];
+    int rung;        // Dernier palier atteint
+    int budget;      // Lignes d'entraînement à ce palier
+    double score;    // AUC de validation à ce palier
+} SearchTrial;
+
+typedef struct {
+    SearchSpace space;
+    int n_trials;
+    int n_rungs;
+    int n_train;         // Lignes d'entraînement au dernier palier
+    int n_validation;
+    long n_fitted_rows;  // Σ budgets entraînés (coût total, à comparer à n_trials * n_train)
+    SearchTrial* trials; // [n_trials]
+    int best;            // Essai de meilleur score au dernier palier
+} SearchReport;
+
+SearchSpace create_logistic_search_space(void);
+SearchSpace create_tree_search_space(void);
+void search_space_grid(SearchSpace* space, int param, int n_values, const double* values);
+void search_space_range(SearchSpace* space, int param, ParamKind kind, double low, double high);
+SearchOptions default_search_options(void);
+
+SearchReport* hyperparameter_search(Dataset* dataset, SearchSpace* space, SearchOptions* options);
+LogisticRegression* search_logistic_config(SearchReport* report, int trial, int n_features);
+DecisionTree* search_tree_config(SearchReport* report, int trial);
+void print_search_report(const char* name, SearchReport* report, int top);
+void free_search_report(SearchReport* report);
+
+#endif
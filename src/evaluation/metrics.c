@@ -19,6 +19,8 @@ Usage : Pour compiler : make
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include "../utils/radix_sort.h"
 
 /* **************************************************
  * # --- MÉTRIQUES DE CLASSIFICATION --- #
@@ -76,52 +78,103 @@ double compute_recall(int* y_true, int* y_pred, int n_samples) {
 
 /**
  * Fonction : compute_f1_score
- * Rôle     : Calcule le score F1 (moyenne harmonique de la précision et du rappel)
+ * Rôle     : Calcule le score F1 (moyenne harmonique de la précision et du rappel) en une passe
  * Param    : y_true (labels réels), y_pred (labels prédits), n_samples (nombre d'échantillons)
  * Retour   : double (F1-score entre 0 et 1)
  */
 double compute_f1_score(int* y_true, int* y_pred, int n_samples) {
-    double precision = compute_precision(y_true, y_pred, n_samples);
-    double recall = compute_recall(y_true, y_pred, n_samples);
-    
-    if (precision + recall == 0) return 0.0;
-    return 2 * (precision * recall) / (precision + recall);
+    return compute_metrics_report(y_true, y_pred, n_samples).f1_score;
 }
 
+/* **************************************************
+ * # --- RAPPORT DE MÉTRIQUES --- #
+ * ************************************************** */
+
 /**
- * Fonction : print_metrics
- * Rôle     : Affiche toutes les métriques de classification sur la sortie standard
+ * Fonction : compute_metrics_report
+ * Rôle     : Calcule la matrice de confusion en un seul balayage puis toutes les métriques qui s'en déduisent
  * Param    : y_true (labels réels), y_pred (labels prédits), n_samples (nombre d'échantillons)
+ * Retour   : MetricsReport (rapport complet, auc_roc à NaN)
+ */
+MetricsReport compute_metrics_report(int* y_true, int* y_pred, int n_samples) {
+    MetricsReport report;
+    fill_confusion_matrix(&report.cm, y_true, y_pred, n_samples);
+    
+    int tp = report.cm.tp, tn = report.cm.tn, fp = report.cm.fp, fn = report.cm.fn;
+    report.n_samples = n_samples;
+    report.accuracy = n_samples > 0 ? (double)(tp + tn) / n_samples : 0.0;
+    report.precision = (tp + fp) > 0 ? (double)tp / (tp + fp) : 0.0;
+    report.recall = (tp + fn) > 0 ? (double)tp / (tp + fn) : 0.0;
+    report.specificity = (tn + fp) > 0 ? (double)tn / (tn + fp) : 0.0;
+    report.f1_score = (report.precision + report.recall) > 0
+        ? 2 * (report.precision * report.recall) / (report.precision + report.recall) : 0.0;
+    report.auc_roc = NAN;
+    
+    return report;
+}
+
+/**
+ * Fonction : print_metrics_report
+ * Rôle     : Affiche les métriques d'un rapport sur la sortie standard (AUC-ROC si renseignée)
+ * Param    : report (rapport de métriques)
  * Retour   : void
  */
-void print_metrics(int* y_true, int* y_pred, int n_samples) {
-    printf("Accuracy:  %.4f\n", compute_accuracy(y_true, y_pred, n_samples));
-    printf("Precision: %.4f\n", compute_precision(y_true, y_pred, n_samples));
-    printf("Recall:    %.4f\n", compute_recall(y_true, y_pred, n_samples));
-    printf("F1-Score:  %.4f\n", compute_f1_score(y_true, y_pred, n_samples));
+void print_metrics_report(const MetricsReport* report) {
+    printf("Accuracy:  %.4f\n", report->accuracy);
+    printf("Precision: %.4f\n", report->precision);
+    printf("Recall:    %.4f\n", report->recall);
+    printf("F1-Score:  %.4f\n", report->f1_score);
+    if (!isnan(report->auc_roc)) {
+        printf("AUC-ROC:   %.4f\n", report->auc_roc);
+    }
 }
 
 /**
- * Fonction : save_metrics
- * Rôle     : Sauvegarde toutes les métriques de classification dans un fichier texte
- * Param    : filename (nom du fichier de destination), y_true (labels réels), y_pred (labels prédits), n_samples (nombre d'échantillons)
+ * Fonction : save_metrics_report
+ * Rôle     : Sauvegarde les métriques d'un rapport dans un fichier texte (AUC-ROC si renseignée)
+ * Param    : filename (nom du fichier de destination), report (rapport de métriques)
  * Retour   : void
  */
-void save_metrics(const char* filename, int* y_true, int* y_pred, int n_samples) {
+void save_metrics_report(const char* filename, const MetricsReport* report) {
     FILE* file = fopen(filename, "w");
     if (!file) {
         fprintf(stderr, "Cannot create file: %s\n", filename);
         return;
     }
     
-    fprintf(file, "Accuracy: %.6f\n", compute_accuracy(y_true, y_pred, n_samples));
-    fprintf(file, "Precision: %.6f\n", compute_precision(y_true, y_pred, n_samples));
-    fprintf(file, "Recall: %.6f\n", compute_recall(y_true, y_pred, n_samples));
-    fprintf(file, "F1-Score: %.6f\n", compute_f1_score(y_true, y_pred, n_samples));
+    fprintf(file, "Accuracy: %.6f\n", report->accuracy);
+    fprintf(file, "Precision: %.6f\n", report->precision);
+    fprintf(file, "Recall: %.6f\n", report->recall);
+    fprintf(file, "F1-Score: %.6f\n", report->f1_score);
+    if (!isnan(report->auc_roc)) {
+        fprintf(file, "AUC-ROC: %.6f\n", report->auc_roc);
+    }
     
     fclose(file);
 }
 
+/**
+ * Fonction : print_metrics
+ * Rôle     : Affiche toutes les métriques de classification sur la sortie standard
+ * Param    : y_true (labels réels), y_pred (labels prédits), n_samples (nombre d'échantillons)
+ * Retour   : void
+ */
+void print_metrics(int* y_true, int* y_pred, int n_samples) {
+    MetricsReport report = compute_metrics_report(y_true, y_pred, n_samples);
+    print_metrics_report(&report);
+}
+
+/**
+ * Fonction : save_metrics
+ * Rôle     : Sauvegarde toutes les métriques de classification dans un fichier texte
+ * Param    : filename (nom du fichier de destination), y_true (labels réels), y_pred (labels prédits), n_samples (nombre d'échantillons)
+ * Retour   : void
+ */
+void save_metrics(const char* filename, int* y_true, int* y_pred, int n_samples) {
+    MetricsReport report = compute_metrics_report(y_true, y_pred, n_samples);
+    save_metrics_report(filename, &report);
+}
+
 /**
  * Fonction : save_metrics_with_auc
  * Rôle     : Sauvegarde toutes les métriques de classification incluant l'AUC-ROC dans un fichier texte
@@ -129,122 +182,60 @@ void save_metrics(const char* filename, int* y_true, int* y_pred, int n_samples)
  * Retour   : void
  */
 void save_metrics_with_auc(const char* filename, int* y_true, int* y_pred, int n_samples, double auc_roc) {
-    FILE* file = fopen(filename, "w");
-    if (!file) {
-        fprintf(stderr, "Cannot create file: %s\n", filename);
-        return;
-    }
-    
-    fprintf(file, "Accuracy: %.6f\n", compute_accuracy(y_true, y_pred, n_samples));
-    fprintf(file, "Precision: %.6f\n", compute_precision(y_true, y_pred, n_samples));
-    fprintf(file, "Recall: %.6f\n", compute_recall(y_true, y_pred, n_samples));
-    fprintf(file, "F1-Score: %.6f\n", compute_f1_score(y_true, y_pred, n_samples));
-    fprintf(file, "AUC-ROC: %.6f\n", auc_roc);
-    
-    fclose(file);
+    MetricsReport report = compute_metrics_report(y_true, y_pred, n_samples);
+    report.auc_roc = auc_roc;
+    save_metrics_report(filename, &report);
 }
 
 /* **************************************************
  * # --- CALCUL AUC-ROC --- #
  * ************************************************** */
 
-typedef struct {
-    double probability;
-    int true_label;
-} PredictionPair;
-
-/**
- * Fonction : compare_predictions_desc
- * Rôle     : Fonction de comparaison pour trier les prédictions par probabilité décroissante
- * Param    : a (pointeur vers première paire), b (pointeur vers deuxième paire)
- * Retour   : int (négatif si a > b, positif si a < b, 0 si égal)
- */
-static int compare_predictions_desc(const void* a, const void* b) {
-    PredictionPair* pair_a = (PredictionPair*)a;
-    PredictionPair* pair_b = (PredictionPair*)b;
-    
-    if (pair_a->probability > pair_b->probability) return -1;
-    if (pair_a->probability < pair_b->probability) return 1;
-    return 0;
-}
-
 /**
  * Fonction : compute_auc_roc
- * Rôle     : Calcule l'aire sous la courbe ROC en triant les prédictions et calculant TPR/FPR pour chaque seuil
+ * Rôle     : Calcule l'aire sous la courbe ROC par la statistique de Mann-Whitney : probabilité qu'un positif
+ *            ait un score supérieur à un négatif, les ex aequo comptant pour 1/2. Les scores sont triés par
+ *            tri radix sur leurs motifs binaires, puis parcourus par groupes de scores égaux (aucun tableau TPR/FPR).
  * Param    : probabilities (probabilités de classe positive), y_true (labels réels), n_samples (nombre d'échantillons)
  * Retour   : double (AUC-ROC entre 0 et 1, 0.5 = performance aléatoire)
  */
 double compute_auc_roc(double* probabilities, int* y_true, int n_samples) {
-    /* Etape 1: Creer et trier les paires (probabilite, label) */
-    PredictionPair* pairs = (PredictionPair*)malloc(n_samples * sizeof(PredictionPair));
-    if (!pairs) {
+    uint64_t* keys = (uint64_t*)malloc((n_samples > 0 ? n_samples : 1) * sizeof(uint64_t));
+    int* labels = (int*)malloc((n_samples > 0 ? n_samples : 1) * sizeof(int));
+    if (!keys || !labels) {
         fprintf(stderr, "Erreur allocation memoire pour AUC-ROC\n");
+        free(keys);
+        free(labels);
         return 0.5;
     }
     
     for (int i = 0; i < n_samples; i++) {
-        pairs[i].probability = probabilities[i];
-        pairs[i].true_label = y_true[i];
+        keys[i] = double_sort_key(probabilities[i]);
+        labels[i] = (y_true[i] == 1);
     }
-    
-    qsort(pairs, n_samples, sizeof(PredictionPair), compare_predictions_desc);
-    
-    /* Etape 2: Compter le nombre de positifs et negatifs */
-    int n_positive = 0;
-    int n_negative = 0;
-    
-    for (int i = 0; i < n_samples; i++) {
-        if (y_true[i] == 1) n_positive++;
-        else n_negative++;
-    }
-    
-    /* Cas limite: pas de positifs ou pas de negatifs */
-    if (n_positive == 0 || n_negative == 0) {
-        free(pairs);
-        return 0.5;
-    }
-    
-    /* Etape 3: Allouer tableaux pour TPR et FPR */
-    double* tpr_values = (double*)malloc(n_samples * sizeof(double));
-    double* fpr_values = (double*)malloc(n_samples * sizeof(double));
-    
-    if (!tpr_values || !fpr_values) {
-        fprintf(stderr, "Erreur allocation memoire pour TPR/FPR\n");
-        free(pairs);
-        if (tpr_values) free(tpr_values);
-        if (fpr_values) free(fpr_values);
-        return 0.5;
-    }
-    
-    /* Etape 4: Calculer TPR et FPR pour chaque seuil */
-    int tp = 0;
-    int fp = 0;
-    
-    for (int i = 0; i < n_samples; i++) {
-        if (pairs[i].true_label == 1) {
-            tp++;
-        } else {
-            fp++;
+    radix_sort_pairs(keys, labels, n_samples);
+    
+    // Scores croissants : chaque positif l'emporte sur les négatifs déjà vus et fait jeu égal avec ceux de son groupe
+    double wins = 0.0;
+    long n_positive = 0, n_negative = 0;
+    int i = 0;
+    while (i < n_samples) {
+        long group_pos = 0, group_size = 0;
+        uint64_t key = keys[i];
+        for (; i < n_samples && keys[i] == key; i++) {
+            group_pos += labels[i];
+            group_size++;
         }
-        
-        tpr_values[i] = (double)tp / n_positive;
-        fpr_values[i] = (double)fp / n_negative;
-    }
-    
-    /* Etape 5: Calculer l'aire sous la courbe (methode des trapezes) */
-    double auc = 0.0;
-    
-    for (int i = 1; i < n_samples; i++) {
-        double width = fpr_values[i] - fpr_values[i-1];
-        double avg_height = (tpr_values[i] + tpr_values[i-1]) / 2.0;
-        auc += width * avg_height;
+        long group_neg = group_size - group_pos;
+        wins += group_pos * (n_negative + 0.5 * group_neg);
+        n_positive += group_pos;
+        n_negative += group_neg;
     }
     
-    /* Nettoyage */
-    free(pairs);
-    free(tpr_values);
-    free(fpr_values);
+    free(keys);
+    free(labels);
     
-    return auc;
+    /* Cas limite: pas de positifs ou pas de negatifs */
+    if (n_positive == 0 || n_negative == 0) return 0.5;
+    return wins / ((double)n_positive * n_negative);
 }
-
@@ -18,11 +18,31 @@ Usage : Pour compiler : make
 #ifndef METRICS_H
 #define METRICS_H
 
+#include "confusion_matrix.h"
+
+/*
+ * Rapport de classification rempli par un seul balayage des labels : matrice de confusion
+ * et toutes les métriques dérivées. Affichage et sauvegarde lisent ce rapport.
+ */
+typedef struct {
+    ConfusionMatrix cm;
+    int n_samples;
+    double accuracy;
+    double precision;
+    double recall;
+    double specificity;
+    double f1_score;
+    double auc_roc;      // NaN tant qu'elle n'est pas renseignée
+} MetricsReport;
+
 double compute_accuracy(int* y_true, int* y_pred, int n_samples);
 double compute_precision(int* y_true, int* y_pred, int n_samples);
 double compute_recall(int* y_true, int* y_pred, int n_samples);
 double compute_f1_score(int* y_true, int* y_pred, int n_samples);
 double compute_auc_roc(double* probabilities, int* y_true, int n_samples);
+MetricsReport compute_metrics_report(int* y_true, int* y_pred, int n_samples);
+void print_metrics_report(const MetricsReport* report);
+void save_metrics_report(const char* filename, const MetricsReport* report);
 void print_metrics(int* y_true, int* y_pred, int n_samples);
 void save_metrics(const char* filename, int* y_true, int* y_pred, int n_samples);
 void save_metrics_with_auc(const char* filename, int* y_true, int* y_pred, int n_samples, double auc_roc);
@@ -0,0 +1,288 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/permutation_importance.c
+
+Rôle : Importance des features par permutation (régression logistique et arbre), features et répétitions en parallèle
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "permutation_importance.h"
+#include "metrics.h"
+#include "../utils/memory_manager.h"
+#include "../utils/parallel.h"
+#include "../utils/random.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define IMPORTANCE_BLOCK 256   // Lignes assemblées puis scorées à la fois
+
+typedef enum {
+    IMPORTANCE_LOGISTIC,
+    IMPORTANCE_TREE
+} ImportanceModelType;
+
+typedef struct {
+    Dataset* dataset;
+    ImportanceModelType model_type;
+    LogisticRegression* logistic;   // Modèle entraîné (IMPORTANCE_LOGISTIC)
+    DecisionTree* tree;             // Modèle entraîné (IMPORTANCE_TREE)
+    uint64_t seed;
+    int n_workers;
+    PermutationImportance* importance;
+} ImportanceJob;
+
+/*
+ * Mémoire d'un thread, allouée une fois pour toutes ses permutations. Le dataset partagé n'est jamais
+ * modifié : la colonne j est lue à travers l'index permuté, et les lignes passent par un bloc de
+ * IMPORTANCE_BLOCK lignes (copie de la ligne, colonne j remplacée) juste avant le scoring par lot.
+ */
+typedef struct {
+    int* permutation;      // [rows] ligne d'où provient la valeur de la colonne permutée
+    double* block;         // [IMPORTANCE_BLOCK * cols] lignes assemblées
+    Dataset view;          // Vue sur block (labels inutiles au scoring)
+    double* probabilities; // [rows]
+} ImportanceBuffers;
+
+/* **************************************************
+ * # --- PERMUTATIONS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : score_view
+ * Rôle     : Score un bloc de lignes avec le prédicteur par lot du modèle du travail
+ * Param    : job (travail), view (lignes à scorer), probabilities (sortie [view->rows])
+ * Retour   : void
+ */
+static void score_view(ImportanceJob* job, Dataset* view, double* probabilities) {
+    if (job->model_type == IMPORTANCE_LOGISTIC) {
+        score_logistic_regression(job->logistic, view, 0.5, probabilities, NULL, NULL);
+    } else {
+        score_tree_dataset(job->tree, view, 0.5, probabilities, NULL);
+    }
+}
+
+/**
+ * Fonction : permute_and_score
+ * Rôle     : Permute la colonne d'une feature (flux aléatoire propre au couple feature, répétition),
+ *            score le dataset ainsi modifié bloc par bloc et enregistre la baisse d'AUC
+ * Param    : job (travail), buffers (mémoire du thread), task (j * n_repeats + r)
+ * Retour   : void
+ */
+static void permute_and_score(ImportanceJob* job, ImportanceBuffers* buffers, int task) {
+    Dataset* dataset = job->dataset;
+    int feature = task / job->importance->n_repeats;
+    int cols = dataset->cols;
+
+    RandomStream rng;
+    seed_random_stream(&rng, job->seed, (uint64_t)task);
+    for (int i = 0; i < dataset->rows; i++) buffers->permutation[i] = i;
+    random_shuffle(&rng, buffers->permutation, dataset->rows);
+
+    for (int start = 0; start < dataset->rows; start += IMPORTANCE_BLOCK) {
+        int count = (dataset->rows - start < IMPORTANCE_BLOCK) ? dataset->rows - start : IMPORTANCE_BLOCK;
+        for (int b = 0; b < count; b++) {
+            double* row = buffers->view.data[b];
+            memcpy(row, dataset->data[start + b], cols * sizeof(double));
+            row[feature] = dataset->data[buffers->permutation[start + b]][feature];
+        }
+        buffers->view.rows = count;
+        score_view(job, &buffers->view, buffers->probabilities + start);
+    }
+
+    double auc = compute_auc_roc(buffers->probabilities, dataset->labels, dataset->rows);
+    job->importance->drops[task] = job->importance->baseline - auc;
+}
+
+/**
+ * Fonction : importance_worker_task
+ * Rôle     : Tâche parallèle : un thread traite les permutations worker, worker + n_workers, ... avec les mêmes buffers
+ * Param    : worker (index du thread), context (ImportanceJob partagé)
+ * Retour   : void
+ */
+static void importance_worker_task(int worker, void* context) {
+    ImportanceJob* job = (ImportanceJob*)context;
+    Dataset* dataset = job->dataset;
+    int n_tasks = job->importance->n_features * job->importance->n_repeats;
+
+    ImportanceBuffers buffers;
+    buffers.permutation = (int*)safe_malloc(dataset->rows * sizeof(int));
+    buffers.block = (double*)safe_malloc(IMPORTANCE_BLOCK * dataset->cols * sizeof(double));
+    buffers.view.data = (double**)safe_malloc(IMPORTANCE_BLOCK * sizeof(double*));
+    for (int b = 0; b < IMPORTANCE_BLOCK; b++) buffers.view.data[b] = buffers.block + (size_t)b * dataset->cols;
+    buffers.view.labels = NULL;
+    buffers.view.rows = 0;
+    buffers.view.cols = dataset->cols;
+    buffers.probabilities = (double*)safe_malloc(dataset->rows * sizeof(double));
+
+    for (int task = worker; task < n_tasks; task += job->n_workers) {
+        permute_and_score(job, &buffers, task);
+    }
+
+    safe_free(buffers.permutation);
+    safe_free(buffers.block);
+    safe_free(buffers.view.data);
+    safe_free(buffers.probabilities);
+}
+
+/**
+ * Fonction : run_permutation_importance
+ * Rôle     : Score de référence, puis toutes les permutations en parallèle et agrégation par feature
+ * Param    : job (travail préparé par permutation_importance_logistic ou permutation_importance_tree),
+ *            n_repeats (permutations par feature)
+ * Retour   : PermutationImportance* (importances, NULL si le dataset est vide)
+ */
+static PermutationImportance* run_permutation_importance(ImportanceJob* job, int n_repeats) {
+    Dataset* dataset = job->dataset;
+    if (dataset->rows < 2 || n_repeats < 1) {
+        fprintf(stderr, "Permutation importance needs at least 2 rows and 1 repeat\n");
+        return NULL;
+    }
+
+    PermutationImportance* importance = (PermutationImportance*)safe_malloc(sizeof(PermutationImportance));
+    importance->n_features = dataset->cols;
+    importance->n_repeats = n_repeats;
+    importance->drops = (double*)safe_malloc(dataset->cols * n_repeats * sizeof(double));
+    importance->mean = (double*)safe_calloc(dataset->cols, sizeof(double));
+    importance->std = (double*)safe_calloc(dataset->cols, sizeof(double));
+    job->importance = importance;
+
+    double* probabilities = (double*)safe_malloc(dataset->rows * sizeof(double));
+    score_view(job, dataset, probabilities);
+    importance->baseline = compute_auc_roc(probabilities, dataset->labels, dataset->rows);
+    safe_free(probabilities);
+
+    int n_tasks = dataset->cols * n_repeats;
+    job->n_workers = get_num_threads();
+    if (job->n_workers > n_tasks) job->n_workers = n_tasks;
+    parallel_for(job->n_workers, importance_worker_task, job);
+
+    for (int j = 0; j < dataset->cols; j++) {
+        const double* drops = importance->drops + j * n_repeats;
+        for (int r = 0; r < n_repeats; r++) importance->mean[j] += drops[r] / n_repeats;
+        for (int r = 0; r < n_repeats; r++) {
+            importance->std[j] += (drops[r] - importance->mean[j]) * (drops[r] - importance->mean[j]);
+        }
+        importance->std[j] = n_repeats > 1 ? sqrt(importance->std[j] / (n_repeats - 1)) : 0.0;
+    }
+    return importance;
+}
+
+/**
+ * Fonction : permutation_importance_logistic
+ * Rôle     : Importance par permutation des features d'une régression logistique
+ * Param    : model (modèle entraîné, dans l'espace du dataset), dataset (données non vues à l'entraînement),
+ *            n_repeats (permutations par feature), seed (graine : résultats indépendants du nombre de threads)
+ * Retour   : PermutationImportance* (importances, NULL si dimensions incompatibles)
+ */
+PermutationImportance* permutation_importance_logistic(LogisticRegression* model, Dataset* dataset,
+                                                       int n_repeats, uint64_t seed) {
+    if (model->n_features != dataset->cols) {
+        fprintf(stderr, "Feature count mismatch: model has %d, dataset has %d\n", model->n_features, dataset->cols);
+        return NULL;
+    }
+    ImportanceJob job = {dataset, IMPORTANCE_LOGISTIC, model, NULL, seed, 0, NULL};
+    return run_permutation_importance(&job, n_repeats);
+}
+
+/**
+ * Fonction : permutation_importance_tree
+ * Rôle     : Importance par permutation des features d'un arbre de décision
+ * Param    : tree (arbre entraîné, dans l'espace du dataset), dataset (données non vues à l'entraînement),
+ *            n_repeats (permutations par feature), seed (graine)
+ * Retour   : PermutationImportance* (importances, NULL si dimensions incompatibles)
+ */
+PermutationImportance* permutation_importance_tree(DecisionTree* tree, Dataset* dataset, int n_repeats, uint64_t seed) {
+    if (tree->n_features != dataset->cols) {
+        fprintf(stderr, "Feature count mismatch: tree has %d, dataset has %d\n", tree->n_features, dataset->cols);
+        return NULL;
+    }
+    ImportanceJob job = {dataset, IMPORTANCE_TREE, NULL, tree, seed, 0, NULL};
+    return run_permutation_importance(&job, n_repeats);
+}
+
+/* **************************************************
+ * # --- AFFICHAGE ET SAUVEGARDE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : print_permutation_importance
+ * Rôle     : Affiche les features par importance décroissante (baisse d'AUC moyenne ± écart-type)
+ * Param    : importance (importances), feature_names (nom de chaque feature, NULL pour les numéroter)
+ * Retour   : void
+ */
+void print_permutation_importance(PermutationImportance* importance, const char** feature_names) {
+    int* order = (int*)safe_malloc(importance->n_features * sizeof(int));
+    for (int j = 0; j < importance->n_features; j++) {
+        int k = j;
+        for (; k > 0 && importance->mean[order[k - 1]] < importance->mean[j]; k--) order[k] = order[k - 1];
+        order[k] = j;
+    }
+
+    printf("permutation importance (AUC drop, %d repeats, baseline AUC %.4f):\n",
+           importance->n_repeats, importance->baseline);
+    printf("+----------------------------+-----------+-----------+\n");
+    printf("| Feature                    | Mean      | Std       |\n");
+    printf("+----------------------------+-----------+-----------+\n");
+    for (int k = 0; k < importance->n_features; k++) {
+        int j = order[k];
+        if (feature_names) {
+            printf("| %-26.26s | %9.5f | %9.5f |\n", feature_names[j], importance->mean[j], importance->std[j]);
+        } else {
+            printf("| feature %-18d | %9.5f | %9.5f |\n", j, importance->mean[j], importance->std[j]);
+        }
+    }
+    printf("+----------------------------+-----------+-----------+\n");
+    safe_free(order);
+}
+
+/**
+ * Fonction : save_feature_importance
+ * Rôle     : Sauvegarde une ligne par feature (séparateur tabulation, lue par scripts/plot_results.py) :
+ *            poids de la régression logistique et importances par permutation des deux modèles
+ * Param    : filename (fichier de destination), feature_names (noms [n_features]), weights (poids LR [n_features]),
+ *            logistic (importances LR), tree (importances de l'arbre, mêmes features)
+ * Retour   : void
+ */
+void save_feature_importance(const char* filename, const char** feature_names, const double* weights,
+                             PermutationImportance* logistic, PermutationImportance* tree) {
+    if (logistic->n_features != tree->n_features) {
+        fprintf(stderr, "Feature count mismatch: logistic has %d, tree has %d\n", logistic->n_features, tree->n_features);
+        return;
+    }
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+
+    fprintf(file, "feature\tweight\tlr_importance\tlr_importance_std\tdt_importance\tdt_importance_std\n");
+    for (int j = 0; j < logistic->n_features; j++) {
+        fprintf(file, "%s\t%.6f\t%.6f\t%.6f\t%.6f\t%.6f\n", feature_names[j], weights[j],
+                logistic->mean[j], logistic->std[j], tree->mean[j], tree->std[j]);
+    }
+    fclose(file);
+}
+
+/**
+ * Fonction : free_permutation_importance
+ * Rôle     : Libère les importances
+ * Param    : importance (importances à libérer, NULL accepté)
+ * Retour   : void
+ */
+void free_permutation_importance(PermutationImportance* importance) {
+    if (!importance) return;
+    safe_free(importance->drops);
+    safe_free(importance->mean);
+    safe_free(importance->std);
+    safe_free(importance);
+}
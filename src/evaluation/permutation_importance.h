@@ -0,0 +1,49 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/permutation_importance.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour l'importance des features par permutation
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef PERMUTATION_IMPORTANCE_H
+#define PERMUTATION_IMPORTANCE_H
+
+#include <stdint.h>
+#include "../models/logistic_regression.h"
+#include "../models/decision_tree.h"
+
+#define IMPORTANCE_DEFAULT_REPEATS 5
+
+/*
+ * Importance d'une feature : baisse d'AUC du modèle quand seule sa colonne est permutée (lien avec la
+ * cible rompu, distribution conservée), moyennée sur n_repeats permutations. Le modèle n'est pas
+ * réentraîné : mesure valable pour tout modèle, arbre compris, sur des données non vues.
+ */
+typedef struct {
+    int n_features;
+    int n_repeats;
+    double baseline;     // AUC sur les données intactes
+    double* drops;       // [n_features * n_repeats] baisse d'AUC de la répétition r en j * n_repeats + r
+    double* mean;        // [n_features] baisse moyenne
+    double* std;         // [n_features] écart-type (n - 1) entre répétitions
+} PermutationImportance;
+
+PermutationImportance* permutation_importance_logistic(LogisticRegression* model, Dataset* dataset,
+                                                       int n_repeats, uint64_t seed);
+PermutationImportance* permutation_importance_tree(DecisionTree* tree, Dataset* dataset, int n_repeats, uint64_t seed);
+void print_permutation_importance(PermutationImportance* importance, const char** feature_names);
+void save_feature_importance(const char* filename, const char** feature_names, const double* weights,
+                             PermutationImportance* logistic, PermutationImportance* tree);
+void free_permutation_importance(PermutationImportance* importance);
+
+#endif
@@ -0,0 +1,324 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/score_histogram.c
+
+Rôle : Accumulateur d'histogrammes de scores à mémoire fixe et fusionnable : AUC, Gini et KS en flux
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "score_histogram.h"
+#include "../utils/memory_manager.h"
+#include "../utils/parallel.h"
+#include <stdio.h>
+#include <math.h>
+
+#define SCORE_HISTOGRAM_MAX_BINS (1 << 24)
+
+// Partage d'un lot de scores en tranches contiguës, une par thread, chacune dans son propre histogramme
+typedef struct {
+    double* probabilities;
+    int* y_true;
+    int n_samples;
+    int n_tasks;
+    ScoreHistogram** partials;
+} HistogramJob;
+
+/* **************************************************
+ * # --- CRÉATION ET MISE À JOUR --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_score_histogram
+ * Rôle     : Crée un accumulateur vide
+ * Param    : n_bins (nombre d'intervalles sur [0, 1], SCORE_HISTOGRAM_DEFAULT_BINS si <= 0)
+ * Retour   : ScoreHistogram* (accumulateur vide)
+ */
+ScoreHistogram* create_score_histogram(int n_bins) {
+    if (n_bins <= 0) n_bins = SCORE_HISTOGRAM_DEFAULT_BINS;
+    ScoreHistogram* histogram = (ScoreHistogram*)safe_malloc(sizeof(ScoreHistogram));
+    histogram->n_bins = n_bins;
+    histogram->positives = (long*)safe_calloc(n_bins, sizeof(long));
+    histogram->negatives = (long*)safe_calloc(n_bins, sizeof(long));
+    histogram->n_positive = 0;
+    histogram->n_negative = 0;
+    histogram->n_ignored = 0;
+    return histogram;
+}
+
+/**
+ * Fonction : score_histogram_add
+ * Rôle     : Ajoute un score ; les valeurs hors de [0, 1] sont ramenées dans le premier ou le dernier intervalle
+ * Param    : histogram (accumulateur), probability (score), label (1 = classe positive)
+ * Retour   : void
+ */
+void score_histogram_add(ScoreHistogram* histogram, double probability, int label) {
+    if (isnan(probability)) {
+        histogram->n_ignored++;
+        return;
+    }
+    int bin = 0;
+    if (probability >= 1.0) bin = histogram->n_bins - 1;
+    else if (probability > 0.0) bin = (int)(probability * histogram->n_bins);
+
+    if (label == 1) {
+        histogram->positives[bin]++;
+        histogram->n_positive++;
+    } else {
+        histogram->negatives[bin]++;
+        histogram->n_negative++;
+    }
+}
+
+/**
+ * Fonction : histogram_chunk_task
+ * Rôle     : Tâche parallèle : accumule une tranche contiguë du lot dans un histogramme privé
+ * Param    : task (index de la tranche), context (HistogramJob partagé)
+ * Retour   : void
+ */
+static void histogram_chunk_task(int task, void* context) {
+    HistogramJob* job = (HistogramJob*)context;
+    long start = (long)job->n_samples * task / job->n_tasks;
+    long end = (long)job->n_samples * (task + 1) / job->n_tasks;
+    ScoreHistogram* partial = job->partials[task];
+    for (long i = start; i < end; i++) {
+        score_histogram_add(partial, job->probabilities[i], job->y_true[i]);
+    }
+}
+
+/**
+ * Fonction : score_histogram_update
+ * Rôle     : Ajoute un lot de scores ; chaque thread remplit son propre histogramme, fusionné ensuite
+ *            (compteurs entiers : résultat indépendant du nombre de threads)
+ * Param    : histogram (accumulateur), probabilities (scores [n]), y_true (labels [n]), n_samples (taille du lot)
+ * Retour   : void
+ */
+void score_histogram_update(ScoreHistogram* histogram, double* probabilities, int* y_true, int n_samples) {
+    if (n_samples <= 0) return;
+
+    HistogramJob job;
+    job.probabilities = probabilities;
+    job.y_true = y_true;
+    job.n_samples = n_samples;
+    job.n_tasks = get_num_threads();
+    // Pas de tranche plus petite que la remise à zéro d'un histogramme privé
+    if (job.n_tasks > n_samples / histogram->n_bins) job.n_tasks = n_samples / histogram->n_bins;
+    if (job.n_tasks < 1) job.n_tasks = 1;
+
+    if (job.n_tasks == 1) {
+        for (int i = 0; i < n_samples; i++) {
+            score_histogram_add(histogram, probabilities[i], y_true[i]);
+        }
+        return;
+    }
+
+    job.partials = (ScoreHistogram**)safe_malloc(job.n_tasks * sizeof(ScoreHistogram*));
+    for (int t = 0; t < job.n_tasks; t++) {
+        job.partials[t] = create_score_histogram(histogram->n_bins);
+    }
+
+    parallel_for(job.n_tasks, histogram_chunk_task, &job);
+
+    for (int t = 0; t < job.n_tasks; t++) {
+        score_histogram_merge(histogram, job.partials[t]);
+        free_score_histogram(job.partials[t]);
+    }
+    safe_free(job.partials);
+}
+
+/**
+ * Fonction : score_histogram_merge
+ * Rôle     : Ajoute les compteurs de src à dst (opération associative et commutative)
+ * Param    : dst (accumulateur enrichi), src (accumulateur lu)
+ * Retour   : int (0 en cas de succès, -1 si les nombres d'intervalles diffèrent)
+ */
+int score_histogram_merge(ScoreHistogram* dst, ScoreHistogram* src) {
+    if (dst->n_bins != src->n_bins) {
+        fprintf(stderr, "Cannot merge score histograms with %d and %d bins\n", dst->n_bins, src->n_bins);
+        return -1;
+    }
+    for (int b = 0; b < dst->n_bins; b++) {
+        dst->positives[b] += src->positives[b];
+        dst->negatives[b] += src->negatives[b];
+    }
+    dst->n_positive += src->n_positive;
+    dst->n_negative += src->n_negative;
+    dst->n_ignored += src->n_ignored;
+    return 0;
+}
+
+/* **************************************************
+ * # --- AUC, GINI ET KS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : score_histogram_auc
+ * Rôle     : AUC de Mann-Whitney sur les intervalles : chaque positif l'emporte sur les négatifs des intervalles
+ *            inférieurs et fait jeu égal (1/2) avec ceux de son intervalle
+ * Param    : histogram (accumulateur)
+ * Retour   : double (AUC, 0.5 si une classe est absente)
+ */
+double score_histogram_auc(ScoreHistogram* histogram) {
+    if (histogram->n_positive == 0 || histogram->n_negative == 0) return 0.5;
+
+    double wins = 0.0;
+    long negatives_below = 0;
+    for (int b = 0; b < histogram->n_bins; b++) {
+        wins += histogram->positives[b] * (negatives_below + 0.5 * histogram->negatives[b]);
+        negatives_below += histogram->negatives[b];
+    }
+    return wins / ((double)histogram->n_positive * histogram->n_negative);
+}
+
+/**
+ * Fonction : score_histogram_auc_error
+ * Rôle     : Borne de l'écart entre score_histogram_auc et l'AUC exacte : seules les paires positif/négatif
+ *            d'un même intervalle peuvent être mal comptées, et chacune d'au plus 1/2
+ * Param    : histogram (accumulateur)
+ * Retour   : double (écart maximal, 0 si une classe est absente)
+ */
+double score_histogram_auc_error(ScoreHistogram* histogram) {
+    if (histogram->n_positive == 0 || histogram->n_negative == 0) return 0.0;
+
+    double shared = 0.0;
+    for (int b = 0; b < histogram->n_bins; b++) {
+        shared += (double)histogram->positives[b] * histogram->negatives[b];
+    }
+    return 0.5 * shared / ((double)histogram->n_positive * histogram->n_negative);
+}
+
+/**
+ * Fonction : score_histogram_gini
+ * Rôle     : Coefficient de Gini (Accuracy Ratio) : 2 * AUC - 1
+ * Param    : histogram (accumulateur)
+ * Retour   : double (Gini entre -1 et 1, erreur au plus 2 * score_histogram_auc_error)
+ */
+double score_histogram_gini(ScoreHistogram* histogram) {
+    return 2.0 * score_histogram_auc(histogram) - 1.0;
+}
+
+/**
+ * Fonction : score_histogram_ks
+ * Rôle     : Statistique de Kolmogorov-Smirnov : écart maximal entre les fonctions de répartition des scores
+ *            des deux classes, évalué aux bornes des intervalles
+ * Param    : histogram (accumulateur)
+ * Retour   : double (KS entre 0 et 1, 0 si une classe est absente ; au plus score_histogram_ks_error sous le KS exact)
+ */
+double score_histogram_ks(ScoreHistogram* histogram) {
+    if (histogram->n_positive == 0 || histogram->n_negative == 0) return 0.0;
+
+    double ks = 0.0;
+    long cum_positive = 0, cum_negative = 0;
+    for (int b = 0; b < histogram->n_bins; b++) {
+        cum_positive += histogram->positives[b];
+        cum_negative += histogram->negatives[b];
+        double gap = fabs((double)cum_negative / histogram->n_negative - (double)cum_positive / histogram->n_positive);
+        if (gap > ks) ks = gap;
+    }
+    return ks;
+}
+
+/**
+ * Fonction : score_histogram_ks_error
+ * Rôle     : Borne de l'écart entre score_histogram_ks et le KS exact : à l'intérieur d'un intervalle, chaque
+ *            fonction de répartition ne progresse que de la masse de sa classe dans l'intervalle, si bien que
+ *            le maximum atteint entre deux bornes dépasse la valeur aux bornes d'au plus pos_b/n_pos + neg_b/n_neg
+ * Param    : histogram (accumulateur)
+ * Retour   : double (écart maximal, 0 si une classe est absente)
+ */
+double score_histogram_ks_error(ScoreHistogram* histogram) {
+    if (histogram->n_positive == 0 || histogram->n_negative == 0) return 0.0;
+
+    double error = 0.0;
+    for (int b = 0; b < histogram->n_bins; b++) {
+        double mass = (double)histogram->positives[b] / histogram->n_positive +
+                      (double)histogram->negatives[b] / histogram->n_negative;
+        if (mass > error) error = mass;
+    }
+    return error;
+}
+
+/* **************************************************
+ * # --- SAUVEGARDE/CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : save_score_histogram
+ * Rôle     : Sauvegarde un accumulateur dans un fichier binaire (fusion entre processus)
+ * Param    : filename (nom du fichier de destination), histogram (accumulateur à sauvegarder)
+ * Retour   : void
+ */
+void save_score_histogram(const char* filename, ScoreHistogram* histogram) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+
+    fwrite(&histogram->n_bins, sizeof(int), 1, file);
+    fwrite(&histogram->n_ignored, sizeof(long), 1, file);
+    fwrite(histogram->positives, sizeof(long), histogram->n_bins, file);
+    fwrite(histogram->negatives, sizeof(long), histogram->n_bins, file);
+
+    fclose(file);
+}
+
+/**
+ * Fonction : load_score_histogram
+ * Rôle     : Charge un accumulateur depuis un fichier binaire (totaux recalculés à partir des intervalles)
+ * Param    : filename (nom du fichier source)
+ * Retour   : ScoreHistogram* (accumulateur chargé, NULL en cas d'erreur)
+ */
+ScoreHistogram* load_score_histogram(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+
+    int n_bins;
+    if (fread(&n_bins, sizeof(int), 1, file) != 1 || n_bins <= 0 || n_bins > SCORE_HISTOGRAM_MAX_BINS) {
+        fclose(file);
+        return NULL;
+    }
+
+    ScoreHistogram* histogram = create_score_histogram(n_bins);
+    int valid = fread(&histogram->n_ignored, sizeof(long), 1, file) == 1 &&
+                fread(histogram->positives, sizeof(long), n_bins, file) == (size_t)n_bins &&
+                fread(histogram->negatives, sizeof(long), n_bins, file) == (size_t)n_bins;
+    fclose(file);
+
+    for (int b = 0; b < n_bins && valid; b++) {
+        valid = histogram->positives[b] >= 0 && histogram->negatives[b] >= 0;
+        histogram->n_positive += histogram->positives[b];
+        histogram->n_negative += histogram->negatives[b];
+    }
+
+    if (!valid) {
+        free_score_histogram(histogram);
+        return NULL;
+    }
+    return histogram;
+}
+
+/**
+ * Fonction : free_score_histogram
+ * Rôle     : Libère complètement la mémoire allouée pour un accumulateur
+ * Param    : histogram (accumulateur à libérer)
+ * Retour   : void
+ */
+void free_score_histogram(ScoreHistogram* histogram) {
+    if (histogram) {
+        safe_free(histogram->positives);
+        safe_free(histogram->negatives);
+        safe_free(histogram);
+    }
+}
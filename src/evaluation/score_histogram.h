@@ -0,0 +1,52 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/score_histogram.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour l'accumulateur d'histogrammes de scores (AUC, Gini, KS en flux)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef SCORE_HISTOGRAM_H
+#define SCORE_HISTOGRAM_H
+
+#define SCORE_HISTOGRAM_DEFAULT_BINS 4096
+
+/*
+ * Histogrammes des probabilités par classe sur [0, 1] découpé en n_bins intervalles égaux.
+ * Mémoire fixe quel que soit le nombre de lignes ; deux accumulateurs de même n_bins se fusionnent
+ * par simple addition des compteurs (threads, lots ou processus distincts, résultat identique).
+ * Les scores d'un même intervalle sont traités comme ex aequo : l'écart à l'AUC exacte est borné par
+ * score_histogram_auc_error, et celui du KS par score_histogram_ks_error (masse du plus gros intervalle).
+ */
+typedef struct {
+    int n_bins;
+    long* positives;      // [n_bins] effectifs de la classe 1 par intervalle
+    long* negatives;      // [n_bins] effectifs de la classe 0 par intervalle
+    long n_positive;
+    long n_negative;
+    long n_ignored;       // Scores NaN écartés
+} ScoreHistogram;
+
+ScoreHistogram* create_score_histogram(int n_bins);
+void score_histogram_add(ScoreHistogram* histogram, double probability, int label);
+void score_histogram_update(ScoreHistogram* histogram, double* probabilities, int* y_true, int n_samples);
+int score_histogram_merge(ScoreHistogram* dst, ScoreHistogram* src);
+double score_histogram_auc(ScoreHistogram* histogram);
+double score_histogram_auc_error(ScoreHistogram* histogram);
+double score_histogram_gini(ScoreHistogram* histogram);
+double score_histogram_ks(ScoreHistogram* histogram);
+double score_histogram_ks_error(ScoreHistogram* histogram);
+void save_score_histogram(const char* filename, ScoreHistogram* histogram);
+ScoreHistogram* load_score_histogram(const char* filename);
+void free_score_histogram(ScoreHistogram* histogram);
+
+#endif
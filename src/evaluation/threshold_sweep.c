@@ -0,0 +1,244 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/threshold_sweep.c
+
+Rôle : Balayage de tous les seuils en un tri et un parcours : courbes ROC et précision-rappel, gains et lift par décile
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "threshold_sweep.h"
+#include "../utils/memory_manager.h"
+#include "../utils/radix_sort.h"
+#include <stdio.h>
+#include <math.h>
+
+/* **************************************************
+ * # --- POINTS DE COURBE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : make_point
+ * Rôle     : Construit un point de courbe à partir des comptes cumulés au-dessus du seuil
+ * Param    : threshold (seuil), tp, fp (positifs et négatifs au-dessus du seuil), n_positive, n_negative (totaux)
+ * Retour   : ThresholdPoint (point complet)
+ */
+static ThresholdPoint make_point(double threshold, int tp, int fp, int n_positive, int n_negative) {
+    ThresholdPoint point;
+    point.threshold = threshold;
+    point.cm.tp = tp;
+    point.cm.fp = fp;
+    point.cm.fn = n_positive - tp;
+    point.cm.tn = n_negative - fp;
+    point.tpr = n_positive > 0 ? (double)tp / n_positive : 0.0;
+    point.fpr = n_negative > 0 ? (double)fp / n_negative : 0.0;
+    point.precision = tp + fp > 0 ? (double)tp / (tp + fp) : 1.0;
+    point.population = n_positive + n_negative > 0 ? (double)(tp + fp) / (n_positive + n_negative) : 0.0;
+    return point;
+}
+
+/* **************************************************
+ * # --- BALAYAGE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : compute_threshold_sweep
+ * Rôle     : Trie les scores une fois (tri radix) puis les parcourt par ordre décroissant : chaque groupe de scores
+ *            égaux donne un point (matrice de confusion, ROC, précision, gains), et les déciles de population
+ *            sont remplis au passage. AUC (trapèzes) et précision moyenne portent sur tous les seuils.
+ *            Les scores NaN sont écartés et comptés dans n_ignored.
+ * Param    : probabilities (scores [n]), y_true (labels [n]), n_samples (nombre d'échantillons),
+ *            max_points (nombre maximal de points gardés, <= 0 pour tous)
+ * Retour   : ThresholdSweep* (courbes et table de lift)
+ */
+ThresholdSweep* compute_threshold_sweep(double* probabilities, int* y_true, int n_samples, int max_points) {
+    ThresholdSweep* sweep = (ThresholdSweep*)safe_calloc(1, sizeof(ThresholdSweep));
+    int* order = radix_argsort(probabilities, n_samples);
+
+    // Scores NaN écartés (NaN n'est égal à rien : un groupe d'ex aequo ne s'y arrêterait jamais)
+    int n_scored = 0;
+    for (int k = 0; k < n_samples; k++) {
+        if (isnan(probabilities[order[k]])) continue;
+        order[n_scored++] = order[k];
+        sweep->n_positive += (y_true[order[k]] == 1);
+    }
+    sweep->n_ignored = n_samples - n_scored;
+    n_samples = n_scored;
+    sweep->n_samples = n_samples;
+    sweep->n_negative = n_samples - sweep->n_positive;
+    int n_positive = sweep->n_positive;
+    int n_negative = sweep->n_negative;
+
+    int capacity = (max_points > 0 && max_points < n_samples + 1 ? max_points : n_samples + 1);
+    if (capacity < 2) capacity = 2;
+    sweep->points = (ThresholdPoint*)safe_malloc(capacity * sizeof(ThresholdPoint));
+
+    // Pas minimal entre deux points gardés : la courbe ROC mesure au plus 2 en distance L1
+    double min_step = max_points > 2 ? 2.0 / (max_points - 2) : 0.0;
+
+    sweep->points[sweep->n_points++] = make_point(INFINITY, 0, 0, n_positive, n_negative);
+    ThresholdPoint last_kept = sweep->points[0];
+    ThresholdPoint previous = sweep->points[0];
+
+    int tp = 0, fp = 0;
+    int decile = 0;
+    int decile_end = (int)((long)n_samples * 1 / SWEEP_DECILES);
+    double overall_rate = n_samples > 0 ? (double)n_positive / n_samples : 0.0;
+
+    int rank = n_samples - 1;
+    while (rank >= 0) {
+        double score = probabilities[order[rank]];
+        // Groupe de scores égaux : un seul seuil ; les déciles coupent en revanche au rang exact
+        for (; rank >= 0 && probabilities[order[rank]] == score; rank--) {
+            int label = (y_true[order[rank]] == 1);
+            tp += label;
+            fp += 1 - label;
+
+            int seen = n_samples - rank;
+            while (decile < SWEEP_DECILES && seen > decile_end) {
+                decile++;
+                decile_end = (int)((long)n_samples * (decile + 1) / SWEEP_DECILES);
+            }
+            if (decile < SWEEP_DECILES) {
+                DecileRow* row = &sweep->deciles[decile];
+                if (row->n_samples == 0) row->max_score = score;
+                row->min_score = score;
+                row->n_samples++;
+                row->n_positive += label;
+            }
+        }
+
+        ThresholdPoint point = make_point(score, tp, fp, n_positive, n_negative);
+        sweep->auc_roc += (point.fpr - previous.fpr) * (point.tpr + previous.tpr) / 2.0;
+        sweep->average_precision += (point.tpr - previous.tpr) * point.precision;
+        previous = point;
+
+        int last = rank < 0;
+        double step = fabs(point.tpr - last_kept.tpr) + fabs(point.fpr - last_kept.fpr);
+        if (last || step >= min_step) {
+            if (sweep->n_points == capacity) sweep->n_points--;   // le dernier point remplace l'avant-dernier
+            sweep->points[sweep->n_points++] = point;
+            last_kept = point;
+        }
+    }
+    safe_free(order);
+
+    if (n_positive == 0 || n_negative == 0) sweep->auc_roc = 0.5;
+
+    int cumulative_positive = 0;
+    for (int d = 0; d < SWEEP_DECILES; d++) {
+        DecileRow* row = &sweep->deciles[d];
+        cumulative_positive += row->n_positive;
+        row->response_rate = row->n_samples > 0 ? (double)row->n_positive / row->n_samples : 0.0;
+        row->lift = overall_rate > 0.0 ? row->response_rate / overall_rate : 0.0;
+        row->cumulative_gain = n_positive > 0 ? (double)cumulative_positive / n_positive : 0.0;
+    }
+    return sweep;
+}
+
+/**
+ * Fonction : threshold_sweep_at
+ * Rôle     : Point de fonctionnement d'un seuil donné : le point de plus petit seuil >= threshold
+ *            (exact si le balayage n'est pas sous-échantillonné)
+ * Param    : sweep (balayage), threshold (seuil de décision, prédiction positive si score >= threshold)
+ * Retour   : ThresholdPoint (matrice de confusion et taux au seuil)
+ */
+ThresholdPoint threshold_sweep_at(ThresholdSweep* sweep, double threshold) {
+    // Seuils décroissants : recherche dichotomique du dernier point de seuil >= threshold
+    int low = 0, high = sweep->n_points - 1;
+    while (low < high) {
+        int mid = (low + high + 1) / 2;
+        if (sweep->points[mid].threshold >= threshold) low = mid;
+        else high = mid - 1;
+    }
+    return sweep->points[low];
+}
+
+/* **************************************************
+ * # --- AFFICHAGE ET SAUVEGARDE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : print_lift_table
+ * Rôle     : Affiche la table de lift et de gains cumulés par décile
+ * Param    : sweep (balayage)
+ * Retour   : void
+ */
+void print_lift_table(ThresholdSweep* sweep) {
+    printf("+--------+-------+----------+----------+--------+----------+\n");
+    printf("| Decile | Count | Positive | Rate     | Lift   | Cum Gain |\n");
+    printf("+--------+-------+----------+----------+--------+----------+\n");
+    for (int d = 0; d < SWEEP_DECILES; d++) {
+        DecileRow* row = &sweep->deciles[d];
+        printf("| %6d | %5d | %8d | %.4f   | %.3f  | %.4f   |\n",
+               d + 1, row->n_samples, row->n_positive, row->response_rate, row->lift, row->cumulative_gain);
+    }
+    printf("+--------+-------+----------+----------+--------+----------+\n");
+}
+
+/**
+ * Fonction : save_threshold_sweep
+ * Rôle     : Sauvegarde les points du balayage en CSV (ROC, précision-rappel, gains, matrice de confusion)
+ * Param    : filename (nom du fichier de destination), sweep (balayage)
+ * Retour   : void
+ */
+void save_threshold_sweep(const char* filename, ThresholdSweep* sweep) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+
+    fprintf(file, "threshold,fpr,tpr,precision,population,tp,fp,tn,fn\n");
+    for (int p = 0; p < sweep->n_points; p++) {
+        ThresholdPoint* point = &sweep->points[p];
+        fprintf(file, "%.10g,%.6f,%.6f,%.6f,%.6f,%d,%d,%d,%d\n", point->threshold, point->fpr, point->tpr,
+                point->precision, point->population, point->cm.tp, point->cm.fp, point->cm.tn, point->cm.fn);
+    }
+
+    fclose(file);
+}
+
+/**
+ * Fonction : save_lift_table
+ * Rôle     : Sauvegarde la table de lift par décile en CSV
+ * Param    : filename (nom du fichier de destination), sweep (balayage)
+ * Retour   : void
+ */
+void save_lift_table(const char* filename, ThresholdSweep* sweep) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+
+    fprintf(file, "decile,count,positive,min_score,max_score,response_rate,lift,cumulative_gain\n");
+    for (int d = 0; d < SWEEP_DECILES; d++) {
+        DecileRow* row = &sweep->deciles[d];
+        fprintf(file, "%d,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f\n", d + 1, row->n_samples, row->n_positive,
+                row->min_score, row->max_score, row->response_rate, row->lift, row->cumulative_gain);
+    }
+
+    fclose(file);
+}
+
+/**
+ * Fonction : free_threshold_sweep
+ * Rôle     : Libère complètement la mémoire allouée pour un balayage
+ * Param    : sweep (balayage à libérer)
+ * Retour   : void
+ */
+void free_threshold_sweep(ThresholdSweep* sweep) {
+    if (sweep) {
+        safe_free(sweep->points);
+        safe_free(sweep);
+    }
+}
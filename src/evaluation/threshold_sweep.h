@@ -0,0 +1,71 @@
+/*****************************************************************************************************
+
+Nom : src/evaluation/threshold_sweep.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le balayage des seuils (ROC, PR, gains, lift)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef THRESHOLD_SWEEP_H
+#define THRESHOLD_SWEEP_H
+
+#include "confusion_matrix.h"
+
+#define SWEEP_DECILES 10
+
+// Un point de courbe : prédiction positive pour score >= threshold
+typedef struct {
+    double threshold;
+    ConfusionMatrix cm;
+    double tpr;           // Recall, aussi gain cumulé (part des positifs captés)
+    double fpr;
+    double precision;     // 1 au premier point (aucune prédiction positive)
+    double population;    // Part de la population au-dessus du seuil (abscisse des gains)
+} ThresholdPoint;
+
+// Une tranche de 10 % de la population, scores décroissants
+typedef struct {
+    int n_samples;
+    int n_positive;
+    double max_score;
+    double min_score;
+    double response_rate;     // n_positive / n_samples
+    double lift;              // response_rate / taux global
+    double cumulative_gain;   // Part des positifs captés jusqu'à cette tranche incluse
+} DecileRow;
+
+/*
+ * Résultat d'un tri unique des scores suivi d'un parcours linéaire : un point par score distinct
+ * (ex aequo regroupés), du seuil +INF (rien de prédit positif) au plus petit score (tout positif).
+ * Avec max_points > 0, un point n'est gardé que si la courbe ROC a avancé d'au moins
+ * 2 / (max_points - 2) en distance L1 depuis le précédent ; le premier et le dernier point sont conservés.
+ */
+typedef struct {
+    int n_samples;                        // Scores pris en compte (NaN exclus)
+    int n_positive;
+    int n_negative;
+    int n_ignored;                        // Scores NaN écartés
+    int n_points;
+    ThresholdPoint* points;               // [n_points] seuils décroissants
+    DecileRow deciles[SWEEP_DECILES];
+    double auc_roc;                       // Trapèzes sur tous les seuils (avant sous-échantillonnage)
+    double average_precision;             // Σ Δrecall * precision
+} ThresholdSweep;
+
+ThresholdSweep* compute_threshold_sweep(double* probabilities, int* y_true, int n_samples, int max_points);
+ThresholdPoint threshold_sweep_at(ThresholdSweep* sweep, double threshold);
+void print_lift_table(ThresholdSweep* sweep);
+void save_threshold_sweep(const char* filename, ThresholdSweep* sweep);
+void save_lift_table(const char* filename, ThresholdSweep* sweep);
+void free_threshold_sweep(ThresholdSweep* sweep);
+
+#endif
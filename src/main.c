@@ -19,12 +19,23 @@ Usage : Pour compiler : make
 #include <stdlib.h>
 // #include "data/data_loader.h"
 #include "data/data_splitter.h"
+#include "data/schema.h"
 #include "preprocessing/preprocessing.h"
 #include "preprocessing/scaler.h"
+#include "preprocessing/imputer.h"
 #include "models/logistic_regression.h"
 #include "models/decision_tree.h"
+#include "models/pipeline.h"
+#include "models/calibration.h"
 #include "evaluation/metrics.h"
 #include "evaluation/confusion_matrix.h"
+#include "evaluation/score_histogram.h"
+#include "evaluation/threshold_sweep.h"
+#include "evaluation/bootstrap.h"
+#include "evaluation/cross_validation.h"
+#include "evaluation/hyperparameter_search.h"
+#include "evaluation/drift_monitor.h"
+#include "evaluation/permutation_importance.h"
 
 /**
  * Fonction : main
@@ -43,12 +54,24 @@ int main(int argc, char* argv[]) {
      * ************************************************** */
     
     printf("Loading dataset...\n");
-    Dataset* dataset = load_csv("data/raw/credit_risk_dataset.csv", 1, 8);
+    Schema* schema = load_schema("data/schema/credit_risk.schema");
+    LoadReport report;
+    Dataset* dataset = schema ? load_csv_with_schema("data/raw/credit_risk_dataset.csv", schema, &report) : NULL;
     if (!dataset) {
         fprintf(stderr, "Error loading dataset\n");
+        free_schema(schema);
+        return 1;
+    }
+    // Termes croisés résolus par nom dans le schéma : un schéma réordonné garde les bonnes colonnes
+    Interactions* interactions = credit_risk_interactions(schema);
+    if (!interactions) {
+        free_dataset(dataset);
+        free_schema(schema);
         return 1;
     }
     printf("Dataset loaded: %d samples, %d features\n", dataset->rows, dataset->cols);
+    printf("Missing values: %ld, unseen categories: %ld, ignored columns: %d, rows without valid label: %ld\n",
+           report.n_missing, report.n_unseen, report.n_ignored_columns, report.n_invalid_labels);
     
     // Afficher statistiques des classes
     int class_0 = 0, class_1 = 0;
@@ -60,13 +83,6 @@ int main(int argc, char* argv[]) {
            class_0, 100.0 * class_0 / dataset->rows,
            class_1, 100.0 * class_1 / dataset->rows);
     
-    /* **************************************************
-     * # --- PRÉTRAITEMENT --- #
-     * ************************************************** */
-    
-    printf("Preprocessing data...\n");
-    preprocess_dataset(dataset);
-    
     /* **************************************************
      * # --- DIVISION TRAIN/TEST --- #
      * ************************************************** */
@@ -77,14 +93,85 @@ int main(int argc, char* argv[]) {
     printf("Train set: %d samples\n", split->train->rows);
     printf("Test set: %d samples\n\n", split->test->rows);
     
+    /* **************************************************
+     * # --- PRÉTRAITEMENT --- #
+     * ************************************************** */
+    
+    // Médiane ajustée sur le train uniquement (revenus et montants à queue lourde)
+    printf("Preprocessing data (median imputation fitted on train)...\n");
+    Imputer* imputer = create_imputer(IMPUTE_MEDIAN, 0.5, 0.0, 0);
+    fit_imputer(imputer, split->train);
+    transform_imputer(imputer, split->train);
+    transform_imputer(imputer, split->test);
+    save_imputer("models/imputer.bin", imputer);
+    
+    /* **************************************************
+     * # --- RECHERCHE D'HYPERPARAMÈTRES --- #
+     * ************************************************** */
+    
+    // Grilles élaguées par successive halving (eta = 3) sur le train imputé, 20 % réservés à la validation
+    printf("\nSearching hyperparameters (grid + successive halving)...\n");
+    SearchOptions search_options = default_search_options();
+    
+    SearchSpace lr_space = create_logistic_search_space();
+    const double learning_rates[] = {0.01, 0.05, 0.1, 0.5};
+    const double iterations[] = {500, 1000, 2000};
+    const double lambdas[] = {0.0, 0.001, 0.01, 0.1};
+    search_space_grid(&lr_space, LR_LEARNING_RATE, 4, learning_rates);
+    search_space_grid(&lr_space, LR_MAX_ITERATIONS, 3, iterations);
+    const double penalties[] = {PENALTY_L2};
+    search_space_grid(&lr_space, LR_PENALTY, 1, penalties);
+    search_space_grid(&lr_space, LR_LAMBDA, 4, lambdas);
+    SearchReport* lr_search = hyperparameter_search(split->train, &lr_space, &search_options);
+    print_search_report("Logistic Regression", lr_search, 5);
+    
+    SearchSpace dt_space = create_tree_search_space();
+    const double depths[] = {4, 5, 6, 7, 8, 10};
+    const double splits[] = {10, 20, 50};
+    const double leaves[] = {5, 10, 20};
+    const double criteria[] = {GINI, ENTROPY};
+    search_space_grid(&dt_space, DT_MAX_DEPTH, 6, depths);
+    search_space_grid(&dt_space, DT_MIN_SAMPLES_SPLIT, 3, splits);
+    search_space_grid(&dt_space, DT_MIN_SAMPLES_LEAF, 3, leaves);
+    search_space_grid(&dt_space, DT_CRITERION, 2, criteria);
+    SearchReport* dt_search = hyperparameter_search(split->train, &dt_space, &search_options);
+    print_search_report("Decision Tree", dt_search, 5);
+    
+    /* **************************************************
+     * # --- VALIDATION CROISÉE --- #
+     * ************************************************** */
+    
+    // 5 folds stratifiés sur le train imputé (~22 % de défauts par fold), scaler ajusté dans chaque fold
+    printf("\nCross-validating on the training set (5 stratified folds)...\n");
+    Folds* folds = make_stratified_folds(split->train->labels, split->train->rows, 5, 42);
+    LogisticRegression* cv_logistic = search_logistic_config(lr_search, lr_search->best, split->train->cols);
+    DecisionTree* cv_tree = search_tree_config(dt_search, dt_search->best);
+    CrossValidationReport* lr_cv = cross_validate_logistic(split->train, folds, cv_logistic);
+    CrossValidationReport* dt_cv = cross_validate_tree(split->train, folds, cv_tree);
+    print_cross_validation_report("Logistic Regression", lr_cv);
+    print_cross_validation_report("Decision Tree", dt_cv);
+    
+    // Calibrateurs ajustés sur les probabilités hors fold : Platt pour la régression, isotonique pour les feuilles de l'arbre
+    Calibrator* lr_calibrator = fit_platt_calibrator(lr_cv->oof_probabilities, split->train->labels, split->train->rows);
+    Calibrator* dt_calibrator = fit_isotonic_calibrator(dt_cv->oof_probabilities, split->train->labels, split->train->rows);
+    free_cross_validation_report(lr_cv);
+    free_cross_validation_report(dt_cv);
+    free_logistic_regression(cv_logistic);
+    free_decision_tree(cv_tree);
+    free_folds(folds);
+    
+    // Références de dérive : déciles des features imputées du train, avant normalisation (espace des lignes scorées)
+    DriftMonitor* lr_monitor = create_drift_monitor(split->train, DRIFT_DEFAULT_BINS);
+    DriftMonitor* dt_monitor = create_drift_monitor(split->train, DRIFT_DEFAULT_BINS);
+    
     /* **************************************************
      * # --- NORMALISATION --- #
      * ************************************************** */
     
-    printf("Fitting scaler...\n");
+    printf("\nFitting scaler...\n");
     Scaler* scaler = fit_scaler(split->train);
     transform_dataset(split->train, scaler);
-    transform_dataset(split->test, scaler);
+    // Le test set reste brut : il est scoré par les modèles exportés avec le scaler intégré
     save_scaler("data/processed/scaler_params.txt", scaler);
     
     /* **************************************************
@@ -92,108 +179,244 @@ int main(int argc, char* argv[]) {
      * ************************************************** */
     
     printf("\nTraining Logistic Regression...\n");
-    LogisticRegression* model = create_logistic_regression(
-        split->train->cols, 
-        0.01,    // learning rate
-        1000     // max iterations
-    );
+    LogisticRegression* model = search_logistic_config(lr_search, lr_search->best, split->train->cols);
+    printf("learning_rate=%g, max_iterations=%d, lambda=%g (L2)\n", model->learning_rate, model->max_iterations, model->lambda);
     train_logistic_regression(model, split->train);
     
     // Save model
     save_model("models/logistic_model.bin", model);
     printf("\nModel saved to models/logistic_model.bin\n");
     
+    // Modèle de service : normalisation intégrée aux poids, scoring direct des données brutes
+    LogisticRegression* raw_model = export_raw_logistic_regression(model, scaler);
+    save_model("models/logistic_model_raw.bin", raw_model);
+    
     /* **************************************************
      * # --- ÉVALUATION RÉGRESSION LOGISTIQUE --- #
      * ************************************************** */
     
     printf("\n--- Training Set Evaluation ---\n");
     int* train_predictions = predict(model, split->train);
-    print_metrics(split->train->labels, train_predictions, split->train->rows);
-    save_metrics("results/metrics/train_metrics.txt", split->train->labels, train_predictions, split->train->rows);
-    
-    ConfusionMatrix* train_cm = compute_confusion_matrix(split->train->labels, train_predictions, split->train->rows);
-    print_confusion_matrix(train_cm);
+    // Un seul balayage des labels par rapport : matrice de confusion et métriques dérivées
+    MetricsReport lr_train = compute_metrics_report(split->train->labels, train_predictions, split->train->rows);
+    print_metrics_report(&lr_train);
+    save_metrics_report("results/metrics/train_metrics.txt", &lr_train);
+    print_confusion_matrix(&lr_train.cm);
     
     // Evaluate on test set
     printf("\n--- Test Set Evaluation ---\n");
-    int* test_predictions = predict(model, split->test);
-    print_metrics(split->test->labels, test_predictions, split->test->rows);
-    
-    // Compute AUC-ROC
-    double* test_probabilities = predict_proba(model, split->test);
-    double lr_auc_roc = compute_auc_roc(test_probabilities, split->test->labels, split->test->rows);
-    printf("AUC-ROC:   %.4f\n", lr_auc_roc);
-    
-    save_metrics_with_auc("results/metrics/test_metrics.txt", split->test->labels, test_predictions, split->test->rows, lr_auc_roc);
+    int* test_predictions = (int*)malloc(split->test->rows * sizeof(int));
+    double* test_probabilities = (double*)malloc(split->test->rows * sizeof(double));
+    score_logistic_regression(raw_model, split->test, 0.5, test_probabilities, test_predictions, NULL);
+    MetricsReport lr_test = compute_metrics_report(split->test->labels, test_predictions, split->test->rows);
+    lr_test.auc_roc = compute_auc_roc(test_probabilities, split->test->labels, split->test->rows);
+    print_metrics_report(&lr_test);
+    save_metrics_report("results/metrics/test_metrics.txt", &lr_test);
+    print_confusion_matrix(&lr_test.cm);
+    save_confusion_matrix("results/metrics/confusion_matrix.txt", &lr_test.cm);
     
-    ConfusionMatrix* test_cm = compute_confusion_matrix(split->test->labels, test_predictions, split->test->rows);
-    print_confusion_matrix(test_cm);
-    save_confusion_matrix("results/metrics/confusion_matrix.txt", test_cm);
+    /* **************************************************
+     * # --- RÉGRESSION LOGISTIQUE AVEC INTERACTIONS --- #
+     * ************************************************** */
     
-    double lr_train_acc = compute_accuracy(split->train->labels, train_predictions, split->train->rows);
-    double lr_test_acc = compute_accuracy(split->test->labels, test_predictions, split->test->rows);
-    double lr_test_f1 = compute_f1_score(split->test->labels, test_predictions, split->test->rows);
+    // income x loan_percent_income et grade x int_rate, calculés à la volée dans le noyau (aucune colonne matérialisée).
+    // Mêmes hyperparamètres que la régression retenue : seul l'apport des interactions est comparé
+    printf("\n\n=== LOGISTIC REGRESSION + INTERACTIONS ===\n");
+    LogisticRegression* ix_model = search_logistic_config(lr_search, lr_search->best, interactions_output_size(interactions));
+    train_logistic_regression_interactions(ix_model, split->train, interactions);
+    save_interactions("models/interactions.bin", interactions);
+    save_model("models/logistic_interactions_model.bin", ix_model);
+    
+    Dataset* scaled_test = transform_dataset_copy(split->test, scaler);
+    int* ix_test_pred = (int*)malloc(split->test->rows * sizeof(int));
+    double* ix_test_proba = (double*)malloc(split->test->rows * sizeof(double));
+    score_logistic_regression_interactions(ix_model, scaled_test, interactions, 0.5, ix_test_proba, ix_test_pred, NULL);
+    MetricsReport ix_test = compute_metrics_report(split->test->labels, ix_test_pred, split->test->rows);
+    ix_test.auc_roc = compute_auc_roc(ix_test_proba, split->test->labels, split->test->rows);
+    printf("Test AUC-ROC: %.4f\n", ix_test.auc_roc);
     
     /* **************************************************
      * # --- ENTRAÎNEMENT ARBRE DE DÉCISION --- #
      * ************************************************** */
     
     printf("\n\n=== DECISION TREE ===\n");
-    printf("Training Decision Tree (max_depth=7, min_samples_split=20, min_samples_leaf=10, criterion=GINI)...\n");
-    DecisionTree* dt = create_decision_tree(7, 20, 10, GINI);
+    DecisionTree* dt = search_tree_config(dt_search, dt_search->best);
+    printf("Training Decision Tree (max_depth=%d, min_samples_split=%d, min_samples_leaf=%d, criterion=%s)...\n",
+           dt->max_depth, dt->min_samples_split, dt->min_samples_leaf, dt->criterion == GINI ? "GINI" : "ENTROPY");
     train_decision_tree(dt, split->train);
     
     printf("Decision Tree trained successfully!\n");
     printf("Actual tree depth: %d\n", get_tree_depth(dt));
     printf("Total nodes: %d\n\n", count_tree_nodes(dt));
     
+    DecisionTree* raw_dt = export_raw_decision_tree(dt, scaler);
+    
     /* **************************************************
      * # --- ÉVALUATION ARBRE DE DÉCISION --- #
      * ************************************************** */
     
     printf("--- Decision Tree: Training Set ---\n");
     int* dt_train_pred = predict_tree_dataset(dt, split->train);
-    print_metrics(split->train->labels, dt_train_pred, split->train->rows);
+    MetricsReport dt_train = compute_metrics_report(split->train->labels, dt_train_pred, split->train->rows);
+    print_metrics_report(&dt_train);
     
     // Evaluate Decision Tree on test set
     printf("\n--- Decision Tree: Test Set ---\n");
-    int* dt_test_pred = predict_tree_dataset(dt, split->test);
-    print_metrics(split->test->labels, dt_test_pred, split->test->rows);
+    int* dt_test_pred = (int*)malloc(split->test->rows * sizeof(int));
+    double* dt_test_proba = (double*)malloc(split->test->rows * sizeof(double));
+    score_tree_dataset(raw_dt, split->test, 0.5, dt_test_proba, dt_test_pred);
+    MetricsReport dt_test = compute_metrics_report(split->test->labels, dt_test_pred, split->test->rows);
+    dt_test.auc_roc = compute_auc_roc(dt_test_proba, split->test->labels, split->test->rows);
+    print_metrics_report(&dt_test);
+    save_metrics_report("results/metrics/dt_test_metrics.txt", &dt_test);
+    print_confusion_matrix(&dt_test.cm);
+    save_confusion_matrix("results/metrics/dt_confusion_matrix.txt", &dt_test.cm);
+    
+    save_decision_tree("models/decision_tree_model.bin", dt);
+    
+    /* **************************************************
+     * # --- CALIBRATION DES PROBABILITÉS --- #
+     * ************************************************** */
     
-    double* dt_test_proba = get_tree_probabilities(dt, split->test);
-    double dt_auc_roc = compute_auc_roc(dt_test_proba, split->test->labels, split->test->rows);
-    printf("AUC-ROC:   %.4f\n", dt_auc_roc);
+    // Probabilités de défaut servies au moteur de tarification : score de Brier du test avant et après calibration
+    double* calibrated = (double*)malloc(split->test->rows * sizeof(double));
+    printf("\n--- Probability Calibration (Brier score on test set) ---\n");
+    calibrate_probabilities(lr_calibrator, test_probabilities, calibrated, split->test->rows);
+    printf("Logistic Regression (Platt, a=%.4f, b=%.4f): %.5f -> %.5f\n", lr_calibrator->a, lr_calibrator->b,
+           compute_brier_score(test_probabilities, split->test->labels, split->test->rows),
+           compute_brier_score(calibrated, split->test->labels, split->test->rows));
+    calibrate_probabilities(dt_calibrator, dt_test_proba, calibrated, split->test->rows);
+    printf("Decision Tree (isotonic, %d knots): %.5f -> %.5f\n", dt_calibrator->n_knots,
+           compute_brier_score(dt_test_proba, split->test->labels, split->test->rows),
+           compute_brier_score(calibrated, split->test->labels, split->test->rows));
+    free(calibrated);
     
-    save_metrics_with_auc("results/metrics/dt_test_metrics.txt", split->test->labels, dt_test_pred, split->test->rows, dt_auc_roc);
+    /* **************************************************
+     * # --- SUIVI DE DÉRIVE --- #
+     * ************************************************** */
     
-    ConfusionMatrix* dt_test_cm = compute_confusion_matrix(split->test->labels, dt_test_pred, split->test->rows);
-    print_confusion_matrix(dt_test_cm);
-    save_confusion_matrix("results/metrics/dt_confusion_matrix.txt", dt_test_cm);
+    // Référence des scores sur le train, puis le test accumulé comme un lot de production, sans passe ni export supplémentaire.
+    // Probabilités avant calibration : ce sont celles que pipeline_score accumule, le calibrateur ne crée pas de fausse dérive
+    double* lr_train_proba = predict_proba(model, split->train);
+    double* dt_train_proba = get_tree_probabilities(dt, split->train);
+    drift_monitor_fit_scores(lr_monitor, lr_train_proba, split->train->rows);
+    drift_monitor_fit_scores(dt_monitor, dt_train_proba, split->train->rows);
+    drift_monitor_update(lr_monitor, split->test, test_probabilities);
+    drift_monitor_update(dt_monitor, split->test, dt_test_proba);
+    
+    const char** feature_names = (const char**)malloc(schema->n_features * sizeof(const char*));
+    for (int c = 0; c < schema->n_columns; c++) {
+        int feature = schema->columns[c].feature_index;
+        if (feature >= 0) feature_names[feature] = schema->columns[c].name;
+    }
+    printf("\n--- Drift Monitoring (test set vs training reference) ---\n");
+    DriftReport* lr_drift = compute_drift_report(lr_monitor);
+    DriftReport* dt_drift = compute_drift_report(dt_monitor);
+    print_drift_report(lr_drift, feature_names);
+    printf("Decision Tree score: PSI=%.4f, KS=%.4f\n", dt_drift->score.psi, dt_drift->score.ks);
+    free_drift_report(lr_drift);
+    free_drift_report(dt_drift);
     
-    save_decision_tree("models/decision_tree_model.bin", dt);
+    /* **************************************************
+     * # --- IMPORTANCE DES FEATURES --- #
+     * ************************************************** */
+    
+    // Baisse d'AUC du test quand une seule colonne est permutée : mêmes modèles de service, même lecture pour les deux
+    printf("\n--- Feature Importance (test set) ---\nLogistic Regression ");
+    PermutationImportance* lr_importance = permutation_importance_logistic(raw_model, split->test,
+                                                                           IMPORTANCE_DEFAULT_REPEATS, 42);
+    print_permutation_importance(lr_importance, feature_names);
+    printf("\nDecision Tree ");
+    PermutationImportance* dt_importance = permutation_importance_tree(raw_dt, split->test,
+                                                                       IMPORTANCE_DEFAULT_REPEATS, 42);
+    print_permutation_importance(dt_importance, feature_names);
+    save_feature_importance("results/plots/feature_importance.txt", feature_names, model->weights,
+                            lr_importance, dt_importance);
+    free_permutation_importance(lr_importance);
+    free_permutation_importance(dt_importance);
+    free(feature_names);
+    free(lr_train_proba);
+    free(dt_train_proba);
+    
+    // Les artefacts n'embarquent que la référence : chaque service accumule ensuite ses propres lots
+    drift_monitor_reset(lr_monitor);
+    drift_monitor_reset(dt_monitor);
+    
+    /* **************************************************
+     * # --- PIPELINES DE SCORING --- #
+     * ************************************************** */
     
-    double dt_train_acc = compute_accuracy(split->train->labels, dt_train_pred, split->train->rows);
-    double dt_test_acc = compute_accuracy(split->test->labels, dt_test_pred, split->test->rows);
-    double dt_test_f1 = compute_f1_score(split->test->labels, dt_test_pred, split->test->rows);
+    // Artefacts autonomes : encodage, imputation, normalisation et modèle en un seul fichier
+    // Colonnes dans l'ordre du schéma (sans colonne drop), dictionnaires copiés depuis le schéma
+    Pipeline* pipeline = create_pipeline(schema->n_columns, schema->label_column, imputer->values, scaler);
+    for (int c = 0; c < schema->n_columns; c++) {
+        if (schema->columns[c].dictionary) pipeline_set_dictionary(pipeline, c, schema->columns[c].dictionary);
+    }
+    pipeline_set_logistic(pipeline, model);
+    pipeline_set_calibrator(pipeline, lr_calibrator);
+    pipeline_set_drift_monitor(pipeline, lr_monitor);
+    save_pipeline("models/pipeline_logistic.bin", pipeline);
+    pipeline_set_tree(pipeline, dt);
+    pipeline_set_calibrator(pipeline, dt_calibrator);
+    pipeline_set_drift_monitor(pipeline, dt_monitor);
+    save_pipeline("models/pipeline_tree.bin", pipeline);
+    free_pipeline(pipeline);
+    printf("\nScoring pipelines saved to models/pipeline_logistic.bin and models/pipeline_tree.bin\n");
     
     /* **************************************************
      * # --- COMPARAISON DES MODÈLES --- #
      * ************************************************** */
     
+    // Gini et KS lus par le comité crédit, depuis les histogrammes de scores (mêmes calculs qu'en monitoring)
+    ScoreHistogram* lr_hist = create_score_histogram(SCORE_HISTOGRAM_DEFAULT_BINS);
+    ScoreHistogram* ix_hist = create_score_histogram(SCORE_HISTOGRAM_DEFAULT_BINS);
+    ScoreHistogram* dt_hist = create_score_histogram(SCORE_HISTOGRAM_DEFAULT_BINS);
+    score_histogram_update(lr_hist, test_probabilities, split->test->labels, split->test->rows);
+    score_histogram_update(ix_hist, ix_test_proba, split->test->labels, split->test->rows);
+    score_histogram_update(dt_hist, dt_test_proba, split->test->labels, split->test->rows);
+    
     printf("\n\n=== MODEL COMPARISON ===\n");
-    printf("+-----------------------+----------+----------+----------+\n");
-    printf("| Model                 | Accuracy | F1-Score | AUC-ROC  |\n");
-    printf("+-----------------------+----------+----------+----------+\n");
-    printf("| Logistic Regression   | %.4f   | %.4f   | %.4f   |\n", lr_test_acc, lr_test_f1, lr_auc_roc);
-    printf("| Decision Tree         | %.4f   | %.4f   | %.4f   |\n", dt_test_acc, dt_test_f1, dt_auc_roc);
-    printf("+-----------------------+----------+----------+----------+\n");
+    printf("+-----------------------+----------+----------+----------+----------+----------+\n");
+    printf("| Model                 | Accuracy | F1-Score | AUC-ROC  | Gini     | KS       |\n");
+    printf("+-----------------------+----------+----------+----------+----------+----------+\n");
+    printf("| Logistic Regression   | %.4f   | %.4f   | %.4f   | %.4f   | %.4f   |\n", lr_test.accuracy, lr_test.f1_score,
+           lr_test.auc_roc, score_histogram_gini(lr_hist), score_histogram_ks(lr_hist));
+    printf("| LR + Interactions     | %.4f   | %.4f   | %.4f   | %.4f   | %.4f   |\n", ix_test.accuracy, ix_test.f1_score,
+           ix_test.auc_roc, score_histogram_gini(ix_hist), score_histogram_ks(ix_hist));
+    printf("| Decision Tree         | %.4f   | %.4f   | %.4f   | %.4f   | %.4f   |\n", dt_test.accuracy, dt_test.f1_score,
+           dt_test.auc_roc, score_histogram_gini(dt_hist), score_histogram_ks(dt_hist));
+    printf("+-----------------------+----------+----------+----------+----------+----------+\n");
     
     printf("\nTrain vs Test Accuracy:\n");
     printf("Logistic Regression: Train=%.4f, Test=%.4f, Gap=%.4f\n", 
-           lr_train_acc, lr_test_acc, lr_train_acc - lr_test_acc);
+           lr_train.accuracy, lr_test.accuracy, lr_train.accuracy - lr_test.accuracy);
     printf("Decision Tree:       Train=%.4f, Test=%.4f, Gap=%.4f\n", 
-           dt_train_acc, dt_test_acc, dt_train_acc - dt_test_acc);
+           dt_train.accuracy, dt_test.accuracy, dt_train.accuracy - dt_test.accuracy);
+    
+    /* **************************************************
+     * # --- COURBES DE DÉCISION ET LIFT --- #
+     * ************************************************** */
+    
+    // Un tri et un parcours par modèle : ROC, précision-rappel, gains et lift (lus par scripts/plot_results.py)
+    ThresholdSweep* lr_sweep = compute_threshold_sweep(test_probabilities, split->test->labels, split->test->rows, 500);
+    ThresholdSweep* dt_sweep = compute_threshold_sweep(dt_test_proba, split->test->labels, split->test->rows, 500);
+    save_threshold_sweep("results/plots/roc_data.csv", lr_sweep);
+    save_threshold_sweep("results/plots/dt_roc_data.csv", dt_sweep);
+    save_lift_table("results/plots/lift_table.csv", lr_sweep);
+    save_lift_table("results/plots/dt_lift_table.csv", dt_sweep);
+    
+    printf("\nLogistic Regression lift by decile (test set, average precision %.4f):\n", lr_sweep->average_precision);
+    print_lift_table(lr_sweep);
+    
+    // Intervalles de confiance exigés par la validation de modèle (graine fixe : intervalles reproductibles)
+    printf("\nLogistic Regression test metrics, ");
+    BootstrapReport lr_boot = bootstrap_metrics(test_probabilities, split->test->labels, test_predictions,
+                                                split->test->rows, 1000, 0.95, 42);
+    print_bootstrap_report(&lr_boot);
+    printf("\nDecision Tree test metrics, ");
+    BootstrapReport dt_boot = bootstrap_metrics(dt_test_proba, split->test->labels, dt_test_pred,
+                                                split->test->rows, 1000, 0.95, 42);
+    print_bootstrap_report(&dt_boot);
     
     printf("\n\nResults saved in results/ and models/ directories\n");
     
@@ -207,14 +430,31 @@ int main(int argc, char* argv[]) {
     free(dt_train_pred);
     free(dt_test_pred);
     free(dt_test_proba);
-    free_confusion_matrix(train_cm);
-    free_confusion_matrix(test_cm);
-    free_confusion_matrix(dt_test_cm);
+    free(ix_test_pred);
+    free(ix_test_proba);
+    free_score_histogram(lr_hist);
+    free_score_histogram(ix_hist);
+    free_score_histogram(dt_hist);
+    free_threshold_sweep(lr_sweep);
+    free_threshold_sweep(dt_sweep);
+    free_calibrator(lr_calibrator);
+    free_calibrator(dt_calibrator);
+    free_drift_monitor(lr_monitor);
+    free_drift_monitor(dt_monitor);
+    free_search_report(lr_search);
+    free_search_report(dt_search);
     free_decision_tree(dt);
+    free_decision_tree(raw_dt);
     free_logistic_regression(model);
+    free_logistic_regression(raw_model);
+    free_logistic_regression(ix_model);
+    free_interactions(interactions);
+    free_dataset(scaled_test);
     free_scaler(scaler);
+    free_imputer(imputer);
     free_split_data(split);
     free_dataset(dataset);
+    free_schema(schema);
     
     return 0;
 }
@@ -0,0 +1,430 @@
+/*****************************************************************************************************
+
+Nom : src/models/calibration.c
+
+Rôle : Calibration des probabilités : Platt (sigmoïde sur le logit) et isotonique (PAV en O(n) après tri radix)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "calibration.h"
+#include "../utils/memory_manager.h"
+#include "../utils/radix_sort.h"
+#include <math.h>
+#include <string.h>
+
+#define CALIBRATION_EPSILON 1e-12
+#define PLATT_MAX_ITERATIONS 100
+
+/* **************************************************
+ * # --- CONSTRUCTION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : allocate_calibrator
+ * Rôle     : Alloue un calibrateur (identité pour PLATT, nœuds non initialisés pour ISOTONIC)
+ * Param    : method (méthode), n_knots (nombre de nœuds, 0 pour PLATT)
+ * Retour   : Calibrator* (calibrateur alloué)
+ */
+static Calibrator* allocate_calibrator(CalibrationMethod method, int n_knots) {
+    Calibrator* calibrator = (Calibrator*)safe_malloc(sizeof(Calibrator));
+    calibrator->method = method;
+    calibrator->a = 1.0;
+    calibrator->b = 0.0;
+    calibrator->n_knots = n_knots;
+    calibrator->x = n_knots > 0 ? (double*)safe_malloc(n_knots * sizeof(double)) : NULL;
+    calibrator->y = n_knots > 0 ? (double*)safe_malloc(n_knots * sizeof(double)) : NULL;
+    return calibrator;
+}
+
+/**
+ * Fonction : safe_logit
+ * Rôle     : Logit d'une probabilité ramenée dans [epsilon, 1 - epsilon] (les feuilles pures valent 0 ou 1)
+ * Param    : probability (probabilité brute)
+ * Retour   : double (log(p / (1 - p)))
+ */
+static double safe_logit(double probability) {
+    double p = probability < CALIBRATION_EPSILON ? CALIBRATION_EPSILON : probability;
+    p = p > 1.0 - CALIBRATION_EPSILON ? 1.0 - CALIBRATION_EPSILON : p;
+    return log(p / (1.0 - p));
+}
+
+/* **************************************************
+ * # --- PLATT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : platt_objective
+ * Rôle     : Cross-entropie (forme stable) des cibles lissées sous p' = sigmoid(a * z + b)
+ * Param    : z (logits [n]), targets (cibles lissées [n]), n (nombre d'échantillons), a, b (paramètres)
+ * Retour   : double (perte totale)
+ */
+static double platt_objective(const double* z, const double* targets, int n, double a, double b) {
+    double total = 0.0;
+    for (int i = 0; i < n; i++) {
+        double m = a * z[i] + b;
+        total += log1p(exp(-fabs(m))) + (m > 0.0 ? m : 0.0) - targets[i] * m;
+    }
+    return total;
+}
+
+/**
+ * Fonction : fit_platt_calibrator
+ * Rôle     : Ajuste p' = sigmoid(a * logit(p) + b) par Newton avec recherche linéaire (Lin, Lin et Weng),
+ *            sur les cibles lissées de Platt (N+ + 1) / (N+ + 2) et 1 / (N- + 2) contre le surapprentissage
+ * Param    : probabilities (probabilités brutes [n]), labels (labels 0/1 [n]), n_samples (nombre d'échantillons)
+ * Retour   : Calibrator* (calibrateur de Platt, NULL si aucun échantillon)
+ */
+Calibrator* fit_platt_calibrator(const double* probabilities, const int* labels, int n_samples) {
+    if (n_samples <= 0) {
+        fprintf(stderr, "Cannot fit calibrator: no samples\n");
+        return NULL;
+    }
+
+    int n_positive = 0;
+    for (int i = 0; i < n_samples; i++) {
+        n_positive += (labels[i] == 1);
+    }
+    double high = (n_positive + 1.0) / (n_positive + 2.0);
+    double low = 1.0 / (n_samples - n_positive + 2.0);
+
+    double* z = (double*)safe_malloc(n_samples * sizeof(double));
+    double* targets = (double*)safe_malloc(n_samples * sizeof(double));
+    for (int i = 0; i < n_samples; i++) {
+        z[i] = safe_logit(probabilities[i]);
+        targets[i] = labels[i] == 1 ? high : low;
+    }
+
+    // Départ à l'identité (a = 1, b = 0) : un modèle déjà calibré bouge peu ; la perte est convexe
+    double a = 1.0, b = 0.0;
+    double loss = platt_objective(z, targets, n_samples, a, b);
+    for (int iteration = 0; iteration < PLATT_MAX_ITERATIONS; iteration++) {
+        double g_a = 0.0, g_b = 0.0, h_aa = CALIBRATION_EPSILON, h_ab = 0.0, h_bb = CALIBRATION_EPSILON;
+        for (int i = 0; i < n_samples; i++) {
+            double p = 1.0 / (1.0 + exp(-(a * z[i] + b)));
+            double r = p - targets[i];
+            double w = p * (1.0 - p);
+            g_a += r * z[i];
+            g_b += r;
+            h_aa += w * z[i] * z[i];
+            h_ab += w * z[i];
+            h_bb += w;
+        }
+        if (fabs(g_a) < 1e-6 && fabs(g_b) < 1e-6) break;
+
+        double det = h_aa * h_bb - h_ab * h_ab;
+        if (det <= 0.0) break;
+        double d_a = -(h_bb * g_a - h_ab * g_b) / det;
+        double d_b = -(h_aa * g_b - h_ab * g_a) / det;
+
+        // Recherche linéaire : pas divisé par deux jusqu'à décroissance suffisante (Armijo)
+        double step = 1.0;
+        double slope = g_a * d_a + g_b * d_b;
+        while (step > 1e-10) {
+            double candidate = platt_objective(z, targets, n_samples, a + step * d_a, b + step * d_b);
+            if (candidate <= loss + 1e-4 * step * slope) {
+                loss = candidate;
+                break;
+            }
+            step /= 2.0;
+        }
+        if (step <= 1e-10) break;
+        a += step * d_a;
+        b += step * d_b;
+    }
+
+    safe_free(z);
+    safe_free(targets);
+
+    Calibrator* calibrator = allocate_calibrator(CALIBRATION_PLATT, 0);
+    calibrator->a = a;
+    calibrator->b = b;
+    return calibrator;
+}
+
+/* **************************************************
+ * # --- ISOTONIQUE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : fit_isotonic_calibrator
+ * Rôle     : Régression isotonique par Pool Adjacent Violators : après un tri radix, les scores égaux forment un
+ *            bloc initial, puis une pile fusionne chaque nouveau bloc avec ses prédécesseurs tant que leurs
+ *            moyennes ne croissent pas strictement (O(n) amorti). Chaque palier [min, max] donne deux nœuds.
+ * Param    : probabilities (probabilités brutes [n]), labels (labels 0/1 [n]), n_samples (nombre d'échantillons)
+ * Retour   : Calibrator* (calibrateur isotonique, NULL si aucun score valide)
+ */
+Calibrator* fit_isotonic_calibrator(const double* probabilities, const int* labels, int n_samples) {
+    if (n_samples <= 0) {
+        fprintf(stderr, "Cannot fit calibrator: no samples\n");
+        return NULL;
+    }
+    int* order = radix_argsort(probabilities, n_samples);
+
+    // Pile de blocs : somme des labels, effectif, plus petit et plus grand score couverts
+    double* sums = (double*)safe_malloc(n_samples * sizeof(double));
+    double* weights = (double*)safe_malloc(n_samples * sizeof(double));
+    double* lows = (double*)safe_malloc(n_samples * sizeof(double));
+    double* highs = (double*)safe_malloc(n_samples * sizeof(double));
+    int n_blocks = 0;
+
+    int rank = 0;
+    while (rank < n_samples) {
+        double score = probabilities[order[rank]];
+        double sum = 0.0, weight = 0.0;
+        for (; rank < n_samples && probabilities[order[rank]] == score; rank++) {
+            sum += (labels[order[rank]] == 1);
+            weight += 1.0;
+        }
+        if (isnan(score)) {
+            rank++;   // NaN n'est égal à rien : écarté un par un
+            continue;
+        }
+
+        sums[n_blocks] = sum;
+        weights[n_blocks] = weight;
+        lows[n_blocks] = score;
+        highs[n_blocks] = score;
+        n_blocks++;
+
+        // Moyennes entières comparées par produit croisé : sum[k-1] / w[k-1] >= sum[k] / w[k]
+        while (n_blocks >= 2 &&
+               sums[n_blocks - 2] * weights[n_blocks - 1] >= sums[n_blocks - 1] * weights[n_blocks - 2]) {
+            sums[n_blocks - 2] += sums[n_blocks - 1];
+            weights[n_blocks - 2] += weights[n_blocks - 1];
+            highs[n_blocks - 2] = highs[n_blocks - 1];
+            n_blocks--;
+        }
+    }
+    safe_free(order);
+
+    Calibrator* calibrator = NULL;
+    if (n_blocks == 0) {
+        fprintf(stderr, "Cannot fit calibrator: no samples\n");
+    } else {
+        int n_knots = 0;
+        for (int k = 0; k < n_blocks; k++) {
+            n_knots += (highs[k] > lows[k]) ? 2 : 1;
+        }
+        calibrator = allocate_calibrator(CALIBRATION_ISOTONIC, n_knots);
+        int knot = 0;
+        for (int k = 0; k < n_blocks; k++) {
+            double value = sums[k] / weights[k];
+            calibrator->x[knot] = lows[k];
+            calibrator->y[knot++] = value;
+            if (highs[k] > lows[k]) {
+                calibrator->x[knot] = highs[k];
+                calibrator->y[knot++] = value;
+            }
+        }
+    }
+
+    safe_free(sums);
+    safe_free(weights);
+    safe_free(lows);
+    safe_free(highs);
+    return calibrator;
+}
+
+/* **************************************************
+ * # --- APPLICATION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : interpolate_knots
+ * Rôle     : Évalue l'application affine par morceaux : recherche dichotomique sans branchement du dernier nœud
+ *            x[k] <= p (le choix de moitié est une sélection conditionnelle, pas un saut), puis interpolation
+ *            avec t borné dans [0, 1] (constante hors des nœuds)
+ * Param    : calibrator (calibrateur isotonique), probability (probabilité brute)
+ * Retour   : double (probabilité calibrée)
+ */
+static double interpolate_knots(const Calibrator* calibrator, double probability) {
+    const double* x = calibrator->x;
+    const double* base = x;
+    int n = calibrator->n_knots;
+    while (n > 1) {
+        int half = n / 2;
+        base = (base[half] <= probability) ? base + half : base;
+        n -= half;
+    }
+
+    int k = (int)(base - x);
+    int next = (k + 1 < calibrator->n_knots) ? k + 1 : k;
+    double width = x[next] - x[k];
+    double t = (width > 0.0) ? (probability - x[k]) / width : 0.0;
+    t = (t > 0.0) ? t : 0.0;
+    t = (t < 1.0) ? t : 1.0;
+    return calibrator->y[k] + t * (calibrator->y[next] - calibrator->y[k]);
+}
+
+/**
+ * Fonction : calibrate_probability
+ * Rôle     : Applique le calibrateur à une probabilité brute
+ * Param    : calibrator (calibrateur), probability (probabilité brute)
+ * Retour   : double (probabilité calibrée)
+ */
+double calibrate_probability(const Calibrator* calibrator, double probability) {
+    if (calibrator->method == CALIBRATION_ISOTONIC) {
+        return interpolate_knots(calibrator, probability);
+    }
+    return 1.0 / (1.0 + exp(-(calibrator->a * safe_logit(probability) + calibrator->b)));
+}
+
+/**
+ * Fonction : calibrate_probabilities
+ * Rôle     : Applique le calibrateur à un lot de probabilités (calibrated peut être égal à probabilities)
+ * Param    : calibrator (calibrateur), probabilities (probabilités brutes [n]), calibrated (sortie [n]),
+ *            n_samples (taille du lot)
+ * Retour   : void
+ */
+void calibrate_probabilities(const Calibrator* calibrator, const double* probabilities, double* calibrated, int n_samples) {
+    for (int i = 0; i < n_samples; i++) {
+        calibrated[i] = calibrate_probability(calibrator, probabilities[i]);
+    }
+}
+
+/**
+ * Fonction : compute_brier_score
+ * Rôle     : Score de Brier : erreur quadratique moyenne entre probabilité et label (plus bas = mieux calibré)
+ * Param    : probabilities (probabilités [n]), labels (labels 0/1 [n]), n_samples (nombre d'échantillons)
+ * Retour   : double (score de Brier, 0 si aucun échantillon)
+ */
+double compute_brier_score(const double* probabilities, const int* labels, int n_samples) {
+    if (n_samples <= 0) return 0.0;
+    double total = 0.0;
+    for (int i = 0; i < n_samples; i++) {
+        double error = probabilities[i] - (labels[i] == 1);
+        total += error * error;
+    }
+    return total / n_samples;
+}
+
+/* **************************************************
+ * # --- SAUVEGARDE/CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : copy_calibrator
+ * Rôle     : Duplique un calibrateur
+ * Param    : calibrator (calibrateur à copier)
+ * Retour   : Calibrator* (copie indépendante)
+ */
+Calibrator* copy_calibrator(const Calibrator* calibrator) {
+    Calibrator* copy = allocate_calibrator(calibrator->method, calibrator->n_knots);
+    copy->a = calibrator->a;
+    copy->b = calibrator->b;
+    if (calibrator->n_knots > 0) {
+        memcpy(copy->x, calibrator->x, calibrator->n_knots * sizeof(double));
+        memcpy(copy->y, calibrator->y, calibrator->n_knots * sizeof(double));
+    }
+    return copy;
+}
+
+/**
+ * Fonction : write_calibrator
+ * Rôle     : Écrit le calibrateur au format binaire dans un fichier ouvert
+ * Param    : file (fichier de destination), calibrator (calibrateur)
+ * Retour   : void
+ */
+void write_calibrator(FILE* file, Calibrator* calibrator) {
+    int method = (int)calibrator->method;
+    fwrite(&method, sizeof(int), 1, file);
+    fwrite(&calibrator->a, sizeof(double), 1, file);
+    fwrite(&calibrator->b, sizeof(double), 1, file);
+    fwrite(&calibrator->n_knots, sizeof(int), 1, file);
+    if (calibrator->n_knots > 0) {
+        fwrite(calibrator->x, sizeof(double), calibrator->n_knots, file);
+        fwrite(calibrator->y, sizeof(double), calibrator->n_knots, file);
+    }
+}
+
+/**
+ * Fonction : read_calibrator
+ * Rôle     : Lit un calibrateur écrit par write_calibrator (nœuds vérifiés strictement croissants)
+ * Param    : file (fichier source)
+ * Retour   : Calibrator* (calibrateur chargé, NULL en cas d'erreur)
+ */
+Calibrator* read_calibrator(FILE* file) {
+    int method, n_knots;
+    double a, b;
+    if (fread(&method, sizeof(int), 1, file) != 1 ||
+        fread(&a, sizeof(double), 1, file) != 1 ||
+        fread(&b, sizeof(double), 1, file) != 1 ||
+        fread(&n_knots, sizeof(int), 1, file) != 1 ||
+        (method != CALIBRATION_PLATT && method != CALIBRATION_ISOTONIC) ||
+        n_knots < 0 || n_knots > CALIBRATION_MAX_KNOTS ||
+        (method == CALIBRATION_ISOTONIC && n_knots == 0)) {
+        return NULL;
+    }
+
+    Calibrator* calibrator = allocate_calibrator((CalibrationMethod)method, n_knots);
+    calibrator->a = a;
+    calibrator->b = b;
+    int valid = n_knots == 0 ||
+                (fread(calibrator->x, sizeof(double), n_knots, file) == (size_t)n_knots &&
+                 fread(calibrator->y, sizeof(double), n_knots, file) == (size_t)n_knots);
+    for (int k = 1; k < n_knots && valid; k++) {
+        valid = calibrator->x[k] > calibrator->x[k - 1];
+    }
+
+    if (!valid) {
+        free_calibrator(calibrator);
+        return NULL;
+    }
+    return calibrator;
+}
+
+/**
+ * Fonction : save_calibrator
+ * Rôle     : Sauvegarde un calibrateur dans un fichier binaire
+ * Param    : filename (nom du fichier de destination), calibrator (calibrateur à sauvegarder)
+ * Retour   : void
+ */
+void save_calibrator(const char* filename, Calibrator* calibrator) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+    write_calibrator(file, calibrator);
+    fclose(file);
+}
+
+/**
+ * Fonction : load_calibrator
+ * Rôle     : Charge un calibrateur depuis un fichier binaire
+ * Param    : filename (nom du fichier source)
+ * Retour   : Calibrator* (calibrateur chargé, NULL en cas d'erreur)
+ */
+Calibrator* load_calibrator(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+    Calibrator* calibrator = read_calibrator(file);
+    fclose(file);
+    return calibrator;
+}
+
+/**
+ * Fonction : free_calibrator
+ * Rôle     : Libère complètement la mémoire allouée pour un calibrateur
+ * Param    : calibrator (calibrateur à libérer)
+ * Retour   : void
+ */
+void free_calibrator(Calibrator* calibrator) {
+    if (calibrator) {
+        safe_free(calibrator->x);
+        safe_free(calibrator->y);
+        safe_free(calibrator);
+    }
+}
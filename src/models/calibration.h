@@ -0,0 +1,57 @@
+/*****************************************************************************************************
+
+Nom : src/models/calibration.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour la calibration des probabilités (Platt, isotonique)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdio.h>
+
+#define CALIBRATION_MAX_KNOTS (1 << 24)
+
+typedef enum {
+    CALIBRATION_PLATT,
+    CALIBRATION_ISOTONIC
+} CalibrationMethod;
+
+/*
+ * Application croissante des probabilités brutes vers des probabilités calibrées, ajustée sur des scores
+ * non vus à l'entraînement (probabilités hors fold de la validation croisée par exemple).
+ * Platt : p' = sigmoid(a * logit(p) + b). Isotonique : application affine par morceaux entre n_knots nœuds
+ * (x strictement croissants), constante hors de [x[0], x[n_knots - 1]] ; deux nœuds par palier du PAV.
+ */
+typedef struct {
+    CalibrationMethod method;
+    double a;           // Pente sur le logit (PLATT)
+    double b;           // Ordonnée à l'origine (PLATT)
+    int n_knots;        // 0 pour PLATT
+    double* x;          // [n_knots] probabilités brutes
+    double* y;          // [n_knots] probabilités calibrées
+} Calibrator;
+
+Calibrator* fit_platt_calibrator(const double* probabilities, const int* labels, int n_samples);
+Calibrator* fit_isotonic_calibrator(const double* probabilities, const int* labels, int n_samples);
+double calibrate_probability(const Calibrator* calibrator, double probability);
+void calibrate_probabilities(const Calibrator* calibrator, const double* probabilities, double* calibrated, int n_samples);
+double compute_brier_score(const double* probabilities, const int* labels, int n_samples);
+Calibrator* copy_calibrator(const Calibrator* calibrator);
+void write_calibrator(FILE* file, Calibrator* calibrator);
+Calibrator* read_calibrator(FILE* file);
+void save_calibrator(const char* filename, Calibrator* calibrator);
+Calibrator* load_calibrator(const char* filename);
+void free_calibrator(Calibrator* calibrator);
+
+#endif
@@ -17,6 +17,7 @@ Usage : Pour compiler : make
 
 #include "decision_tree.h"
 #include "../utils/memory_manager.h"
+#include "../utils/radix_sort.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -34,21 +35,14 @@ typedef struct {
 
 /**
  * Fonction : compute_gini
- * Rôle     : Calcule l'impureté de Gini pour un ensemble de labels
- * Param    : labels (tableau de labels), n_samples (nombre d'échantillons)
+ * Rôle     : Calcule l'impureté de Gini à partir des effectifs des deux classes
+ * Param    : count_class_0, count_class_1 (effectifs des classes 0 et 1)
  * Retour   : double (valeur d'impureté de Gini entre 0 et 1)
  */
-static double compute_gini(int* labels, int n_samples) {
+static double compute_gini(int count_class_0, int count_class_1) {
+    int n_samples = count_class_0 + count_class_1;
     if (n_samples == 0) return 0.0;
     
-    int count_class_0 = 0;
-    int count_class_1 = 0;
-    
-    for (int i = 0; i < n_samples; i++) {
-        if (labels[i] == 0) count_class_0++;
-        else count_class_1++;
-    }
-    
     double p0 = (double)count_class_0 / n_samples;
     double p1 = (double)count_class_1 / n_samples;
     
@@ -57,21 +51,14 @@ static double compute_gini(int* labels, int n_samples) {
 
 /**
  * Fonction : compute_entropy
- * Rôle     : Calcule l'entropie pour un ensemble de labels
- * Param    : labels (tableau de labels), n_samples (nombre d'échantillons)
+ * Rôle     : Calcule l'entropie à partir des effectifs des deux classes
+ * Param    : count_class_0, count_class_1 (effectifs des classes 0 et 1)
  * Retour   : double (valeur d'entropie en bits)
  */
-static double compute_entropy(int* labels, int n_samples) {
+static double compute_entropy(int count_class_0, int count_class_1) {
+    int n_samples = count_class_0 + count_class_1;
     if (n_samples == 0) return 0.0;
     
-    int count_class_0 = 0;
-    int count_class_1 = 0;
-    
-    for (int i = 0; i < n_samples; i++) {
-        if (labels[i] == 0) count_class_0++;
-        else count_class_1++;
-    }
-    
     double p0 = (double)count_class_0 / n_samples;
     double p1 = (double)count_class_1 / n_samples;
     
@@ -85,71 +72,95 @@ static double compute_entropy(int* labels, int n_samples) {
 /**
  * Fonction : compute_impurity
  * Rôle     : Calcule l'impureté selon le critère spécifié (Gini ou Entropy)
- * Param    : labels (tableau de labels), n_samples (nombre d'échantillons), criterion (critère de division)
+ * Param    : count_class_0, count_class_1 (effectifs des classes 0 et 1), criterion (critère de division)
  * Retour   : double (valeur d'impureté)
  */
-static double compute_impurity(int* labels, int n_samples, SplitCriterion criterion) {
+static double compute_impurity(int count_class_0, int count_class_1, SplitCriterion criterion) {
     if (criterion == GINI) {
-        return compute_gini(labels, n_samples);
+        return compute_gini(count_class_0, count_class_1);
     } else {
-        return compute_entropy(labels, n_samples);
+        return compute_entropy(count_class_0, count_class_1);
     }
 }
 
+/* **************************************************
+ * # --- PRÉ-TRI DES FEATURES --- #
+ * ************************************************** */
+
 /**
- * Fonction : majority_class
- * Rôle     : Détermine la classe majoritaire dans un ensemble de labels
- * Param    : labels (tableau de labels), n_samples (nombre d'échantillons)
- * Retour   : int (classe majoritaire, 0 ou 1)
+ * Fonction : presort_dataset
+ * Rôle     : Trie une fois les lignes du dataset selon chaque feature (tri radix). Le résultat est en lecture
+ *            seule : plusieurs entraînements (folds, essais d'hyperparamètres) peuvent le partager en parallèle.
+ * Param    : dataset (dataset d'entraînement)
+ * Retour   : TreePresort* (ordres triés par feature)
  */
-static int majority_class(int* labels, int n_samples) {
-    int count_0 = 0;
-    int count_1 = 0;
-    
-    for (int i = 0; i < n_samples; i++) {
-        if (labels[i] == 0) count_0++;
-        else count_1++;
+TreePresort* presort_dataset(Dataset* dataset) {
+    TreePresort* presort = (TreePresort*)safe_malloc(sizeof(TreePresort));
+    presort->n_rows = dataset->rows;
+    presort->n_features = dataset->cols;
+    presort->order = (int*)safe_malloc(((size_t)dataset->rows * dataset->cols + 1) * sizeof(int));
+    
+    double* column = (double*)safe_malloc((dataset->rows + 1) * sizeof(double));
+    for (int f = 0; f < dataset->cols; f++) {
+        for (int i = 0; i < dataset->rows; i++) {
+            column[i] = dataset->data[i][f];
+        }
+        int* order = radix_argsort(column, dataset->rows);
+        memcpy(presort->order + (size_t)f * dataset->rows, order, dataset->rows * sizeof(int));
+        safe_free(order);
     }
-    
-    return (count_1 >= count_0) ? 1 : 0;
+    safe_free(column);
+    return presort;
 }
 
 /**
- * Fonction : class_probability
- * Rôle     : Calcule la probabilité de la classe positive dans un ensemble de labels
- * Param    : labels (tableau de labels), n_samples (nombre d'échantillons)
- * Retour   : double (probabilité entre 0 et 1)
+ * Fonction : free_tree_presort
+ * Rôle     : Libère complètement la mémoire allouée pour un pré-tri
+ * Param    : presort (pré-tri à libérer)
+ * Retour   : void
  */
-static double class_probability(int* labels, int n_samples) {
-    if (n_samples == 0) return 0.0;
-    
-    int count_1 = 0;
-    for (int i = 0; i < n_samples; i++) {
-        if (labels[i] == 1) count_1++;
+void free_tree_presort(TreePresort* presort) {
+    if (presort) {
+        safe_free(presort->order);
+        safe_free(presort);
     }
-    
-    return (double)count_1 / n_samples;
 }
 
 /* **************************************************
  * # --- CONSTRUCTION DE L'ARBRE --- #
  * ************************************************** */
 
+/*
+ * État d'une construction. Chaque nœud possède le même segment [start, start + n) de sorted[f] pour
+ * toutes les features, trié par valeur de f : la recherche de seuil est un parcours linéaire, et la
+ * division partitionne chaque segment de façon stable (l'ordre trié est conservé chez les enfants).
+ */
+typedef struct {
+    double** data;
+    int* labels;
+    int n_features;
+    int** sorted;          // [n_features][n] lignes du nœud triées par feature
+    int* buffer;           // [n] partie droite pendant la partition
+    uint8_t* goes_left;    // [dataset->rows] côté de chaque ligne pour la division en cours
+    DecisionTree* tree;
+} TreeBuilder;
+
 /**
  * Fonction : create_leaf_node
  * Rôle     : Crée un nœud feuille avec la classe majoritaire et sa probabilité
- * Param    : labels (tableau de labels), n_samples (nombre d'échantillons), criterion (critère d'impureté)
+ * Param    : count_class_0, count_class_1 (effectifs des classes dans le nœud), criterion (critère d'impureté)
  * Retour   : DecisionNode* (nœud feuille créé)
  */
-static DecisionNode* create_leaf_node(int* labels, int n_samples, SplitCriterion criterion) {
+static DecisionNode* create_leaf_node(int count_class_0, int count_class_1, SplitCriterion criterion) {
+    int n_samples = count_class_0 + count_class_1;
     DecisionNode* node = (DecisionNode*)safe_malloc(sizeof(DecisionNode));
     node->is_leaf = 1;
-    node->predicted_class = majority_class(labels, n_samples);
-    node->class_probability = class_probability(labels, n_samples);
+    node->predicted_class = (count_class_1 >= count_class_0) ? 1 : 0;
+    node->class_probability = n_samples > 0 ? (double)count_class_1 / n_samples : 0.0;
     node->feature_index = -1;
     node->threshold = 0.0;
     node->n_samples = n_samples;
-    node->impurity = compute_impurity(labels, n_samples, criterion);
+    node->impurity = compute_impurity(count_class_0, count_class_1, criterion);
     node->left = NULL;
     node->right = NULL;
     return node;
@@ -178,58 +189,31 @@ static DecisionNode* create_internal_node(int feature_idx, double threshold, int
 /**
  * Fonction : find_best_split
  * Rôle     : Trouve la meilleure division en testant toutes les features et tous les seuils possibles
- * Param    : data (matrice de données), labels (tableau de labels), n_samples (nombre d'échantillons), n_features (nombre de features), criterion (critère de division)
+ *            (milieux entre valeurs distinctes consécutives), en un parcours des lignes pré-triées par feature
+ * Param    : builder (état de construction), start, n_samples (segment du nœud), count_class_1 (positifs du nœud),
+ *            parent_impurity (impureté du nœud)
  * Retour   : BestSplit (meilleure division trouvée avec gain maximal)
  */
-static BestSplit find_best_split(double** data, int* labels, int n_samples, int n_features, SplitCriterion criterion) {
+static BestSplit find_best_split(TreeBuilder* builder, int start, int n_samples, int count_class_1, double parent_impurity) {
     BestSplit best = {-1, 0.0, -1.0};
-    double parent_impurity = compute_impurity(labels, n_samples, criterion);
+    SplitCriterion criterion = builder->tree->criterion;
     
-    for (int feature = 0; feature < n_features; feature++) {
-        double* values = (double*)safe_malloc(n_samples * sizeof(double));
-        int* indices = (int*)safe_malloc(n_samples * sizeof(int));
-        
-        for (int i = 0; i < n_samples; i++) {
-            values[i] = data[i][feature];
-            indices[i] = i;
-        }
-        
-        for (int i = 0; i < n_samples - 1; i++) {
-            for (int j = i + 1; j < n_samples; j++) {
-                if (values[i] > values[j]) {
-                    double temp_val = values[i];
-                    values[i] = values[j];
-                    values[j] = temp_val;
-                    
-                    int temp_idx = indices[i];
-                    indices[i] = indices[j];
-                    indices[j] = temp_idx;
-                }
-            }
-        }
+    for (int feature = 0; feature < builder->n_features; feature++) {
+        const int* rows = builder->sorted[feature] + start;
+        int left_class_1 = 0;
         
         for (int i = 0; i < n_samples - 1; i++) {
-            if (values[i] == values[i + 1]) continue;
-            
-            double threshold = (values[i] + values[i + 1]) / 2.0;
+            left_class_1 += builder->labels[rows[i]];
+            double value = builder->data[rows[i]][feature];
+            double next = builder->data[rows[i + 1]][feature];
+            if (value == next) continue;
             
             int n_left = i + 1;
             int n_right = n_samples - n_left;
+            int right_class_1 = count_class_1 - left_class_1;
             
-            if (n_left == 0 || n_right == 0) continue;
-            
-            int* left_labels = (int*)safe_malloc(n_left * sizeof(int));
-            int* right_labels = (int*)safe_malloc(n_right * sizeof(int));
-            
-            for (int j = 0; j <= i; j++) {
-                left_labels[j] = labels[indices[j]];
-            }
-            for (int j = i + 1; j < n_samples; j++) {
-                right_labels[j - i - 1] = labels[indices[j]];
-            }
-            
-            double left_impurity = compute_impurity(left_labels, n_left, criterion);
-            double right_impurity = compute_impurity(right_labels, n_right, criterion);
+            double left_impurity = compute_impurity(n_left - left_class_1, left_class_1, criterion);
+            double right_impurity = compute_impurity(n_right - right_class_1, right_class_1, criterion);
             
             double weighted_impurity = (n_left * left_impurity + n_right * right_impurity) / n_samples;
             double gain = parent_impurity - weighted_impurity;
@@ -237,15 +221,9 @@ static BestSplit find_best_split(double** data, int* labels, int n_samples, int
             if (gain > best.gain) {
                 best.gain = gain;
                 best.feature_index = feature;
-                best.threshold = threshold;
+                best.threshold = (value + next) / 2.0;
             }
-            
-            safe_free(left_labels);
-            safe_free(right_labels);
         }
-        
-        safe_free(values);
-        safe_free(indices);
     }
     
     return best;
@@ -254,60 +232,55 @@ static BestSplit find_best_split(double** data, int* labels, int n_samples, int
 /**
  * Fonction : build_tree
  * Rôle     : Construit récursivement l'arbre de décision en appliquant les critères d'arrêt
- * Param    : data (matrice de données), labels (tableau de labels), n_samples (nombre d'échantillons), n_features (nombre de features), depth (profondeur actuelle), tree (arbre contenant les hyperparamètres)
- * Retour   : DecisionNode* (racine de l'arbre construit)
+ * Param    : builder (état de construction), start, n_samples (segment du nœud dans les ordres triés), depth (profondeur actuelle)
+ * Retour   : DecisionNode* (racine du sous-arbre construit)
  */
-static DecisionNode* build_tree(double** data, int* labels, int n_samples, int n_features, 
-                                int depth, DecisionTree* tree) {
-    double impurity = compute_impurity(labels, n_samples, tree->criterion);
+static DecisionNode* build_tree(TreeBuilder* builder, int start, int n_samples, int depth) {
+    DecisionTree* tree = builder->tree;
+    int count_class_1 = 0;
+    for (int i = 0; i < n_samples; i++) {
+        count_class_1 += builder->labels[builder->sorted[0][start + i]];
+    }
+    int count_class_0 = n_samples - count_class_1;
+    double impurity = compute_impurity(count_class_0, count_class_1, tree->criterion);
     
     if (depth >= tree->max_depth || n_samples < tree->min_samples_split || impurity == 0.0) {
-        return create_leaf_node(labels, n_samples, tree->criterion);
+        return create_leaf_node(count_class_0, count_class_1, tree->criterion);
     }
     
-    BestSplit best = find_best_split(data, labels, n_samples, n_features, tree->criterion);
+    BestSplit best = find_best_split(builder, start, n_samples, count_class_1, impurity);
     
     if (best.gain <= 0.0) {
-        return create_leaf_node(labels, n_samples, tree->criterion);
+        return create_leaf_node(count_class_0, count_class_1, tree->criterion);
     }
     
-    double** left_data = (double**)safe_malloc(n_samples * sizeof(double*));
-    double** right_data = (double**)safe_malloc(n_samples * sizeof(double*));
-    int* left_labels = (int*)safe_malloc(n_samples * sizeof(int));
-    int* right_labels = (int*)safe_malloc(n_samples * sizeof(int));
-    
     int n_left = 0;
-    int n_right = 0;
-    
     for (int i = 0; i < n_samples; i++) {
-        if (data[i][best.feature_index] <= best.threshold) {
-            left_data[n_left] = data[i];
-            left_labels[n_left] = labels[i];
-            n_left++;
-        } else {
-            right_data[n_right] = data[i];
-            right_labels[n_right] = labels[i];
-            n_right++;
-        }
+        int row = builder->sorted[0][start + i];
+        builder->goes_left[row] = builder->data[row][best.feature_index] <= best.threshold;
+        n_left += builder->goes_left[row];
     }
+    int n_right = n_samples - n_left;
     
     if (n_left < tree->min_samples_leaf || n_right < tree->min_samples_leaf) {
-        safe_free(left_data);
-        safe_free(right_data);
-        safe_free(left_labels);
-        safe_free(right_labels);
-        return create_leaf_node(labels, n_samples, tree->criterion);
+        return create_leaf_node(count_class_0, count_class_1, tree->criterion);
     }
     
-    DecisionNode* node = create_internal_node(best.feature_index, best.threshold, n_samples, impurity);
+    // Partition stable de chaque ordre trié : gauche en tête du segment, droite à la suite
+    for (int f = 0; f < builder->n_features; f++) {
+        int* rows = builder->sorted[f] + start;
+        int n_kept = 0, n_moved = 0;
+        for (int i = 0; i < n_samples; i++) {
+            if (builder->goes_left[rows[i]]) rows[n_kept++] = rows[i];
+            else builder->buffer[n_moved++] = rows[i];
+        }
+        memcpy(rows + n_kept, builder->buffer, n_moved * sizeof(int));
+    }
     
-    node->left = build_tree(left_data, left_labels, n_left, n_features, depth + 1, tree);
-    node->right = build_tree(right_data, right_labels, n_right, n_features, depth + 1, tree);
+    DecisionNode* node = create_internal_node(best.feature_index, best.threshold, n_samples, impurity);
     
-    safe_free(left_data);
-    safe_free(right_data);
-    safe_free(left_labels);
-    safe_free(right_labels);
+    node->left = build_tree(builder, start, n_left, depth + 1);
+    node->right = build_tree(builder, start + n_left, n_right, depth + 1);
     
     return node;
 }
@@ -316,22 +289,27 @@ static DecisionNode* build_tree(double** data, int* labels, int n_samples, int n
  * # --- PRÉDICTION --- #
  * ************************************************** */
 
+/**
+ * Fonction : find_leaf
+ * Rôle     : Descend l'arbre jusqu'à la feuille correspondant à un échantillon
+ * Param    : node (nœud racine de l'arbre), sample (vecteur de features de l'échantillon)
+ * Retour   : DecisionNode* (feuille atteinte)
+ */
+static DecisionNode* find_leaf(DecisionNode* node, double* sample) {
+    while (!node->is_leaf) {
+        node = (sample[node->feature_index] <= node->threshold) ? node->left : node->right;
+    }
+    return node;
+}
+
 /**
  * Fonction : predict_single
- * Rôle     : Prédit la classe d'un échantillon unique en parcourant l'arbre récursivement
+ * Rôle     : Prédit la classe d'un échantillon unique en parcourant l'arbre
  * Param    : node (nœud racine de l'arbre), sample (vecteur de features de l'échantillon)
  * Retour   : int (classe prédite, 0 ou 1)
  */
 static int predict_single(DecisionNode* node, double* sample) {
-    if (node->is_leaf) {
-        return node->predicted_class;
-    }
-    
-    if (sample[node->feature_index] <= node->threshold) {
-        return predict_single(node->left, sample);
-    } else {
-        return predict_single(node->right, sample);
-    }
+    return find_leaf(node, sample)->predicted_class;
 }
 
 /**
@@ -341,15 +319,7 @@ static int predict_single(DecisionNode* node, double* sample) {
  * Retour   : double (probabilité entre 0 et 1)
  */
 static double predict_proba_single(DecisionNode* node, double* sample) {
-    if (node->is_leaf) {
-        return node->class_probability;
-    }
-    
-    if (sample[node->feature_index] <= node->threshold) {
-        return predict_proba_single(node->left, sample);
-    } else {
-        return predict_proba_single(node->right, sample);
-    }
+    return find_leaf(node, sample)->class_probability;
 }
 
 /**
@@ -466,6 +436,26 @@ static DecisionNode* load_tree_recursive(FILE* file) {
     return node;
 }
 
+/**
+ * Fonction : copy_tree_unscaled
+ * Rôle     : Copie récursivement l'arbre en ramenant chaque seuil dans l'espace brut (t' = t * std + mean)
+ * Param    : node (nœud à copier), scaler (scaler utilisé à l'entraînement)
+ * Retour   : DecisionNode* (copie du sous-arbre)
+ */
+static DecisionNode* copy_tree_unscaled(DecisionNode* node, Scaler* scaler) {
+    if (node == NULL) return NULL;
+    
+    DecisionNode* copy = (DecisionNode*)safe_malloc(sizeof(DecisionNode));
+    *copy = *node;
+    if (!node->is_leaf) {
+        int f = node->feature_index;
+        copy->threshold = node->threshold * scaler->std[f] + scaler->mean[f];
+    }
+    copy->left = copy_tree_unscaled(node->left, scaler);
+    copy->right = copy_tree_unscaled(node->right, scaler);
+    return copy;
+}
+
 /**
  * Fonction : free_tree_recursive
  * Rôle     : Libère récursivement toute la mémoire allouée pour l'arbre
@@ -508,8 +498,56 @@ DecisionTree* create_decision_tree(int max_depth, int min_samples_split, int min
  * Retour   : void
  */
 void train_decision_tree(DecisionTree* tree, Dataset* dataset) {
+    TreePresort* presort = presort_dataset(dataset);
+    train_decision_tree_rows(tree, dataset, presort, NULL, dataset->rows);
+    free_tree_presort(presort);
+}
+
+/**
+ * Fonction : train_decision_tree_rows
+ * Rôle     : Entraîne l'arbre sur un sous-ensemble de lignes à partir d'un pré-tri partagé : les ordres du
+ *            sous-ensemble sont extraits du pré-tri par filtrage (aucun tri), le dataset n'est que lu
+ * Param    : tree (arbre à entraîner), dataset (dataset complet), presort (pré-tri de dataset),
+ *            rows (lignes d'entraînement, NULL = toutes), n_rows (nombre de lignes d'entraînement)
+ * Retour   : void
+ */
+void train_decision_tree_rows(DecisionTree* tree, Dataset* dataset, TreePresort* presort, const int* rows, int n_rows) {
     tree->n_features = dataset->cols;
-    tree->root = build_tree(dataset->data, dataset->labels, dataset->rows, dataset->cols, 0, tree);
+    
+    TreeBuilder builder;
+    builder.data = dataset->data;
+    builder.labels = dataset->labels;
+    builder.n_features = dataset->cols;
+    builder.tree = tree;
+    builder.buffer = (int*)safe_malloc((n_rows + 1) * sizeof(int));
+    builder.goes_left = (uint8_t*)safe_calloc(dataset->rows + 1, sizeof(uint8_t));
+    builder.sorted = (int**)safe_malloc(dataset->cols * sizeof(int*));
+    
+    // goes_left sert d'abord de masque d'appartenance au sous-ensemble
+    if (rows) {
+        for (int i = 0; i < n_rows; i++) builder.goes_left[rows[i]] = 1;
+    }
+    for (int f = 0; f < dataset->cols; f++) {
+        builder.sorted[f] = (int*)safe_malloc((n_rows + 1) * sizeof(int));
+        const int* order = presort->order + (size_t)f * presort->n_rows;
+        if (rows) {
+            int k = 0;
+            for (int i = 0; i < presort->n_rows; i++) {
+                if (builder.goes_left[order[i]]) builder.sorted[f][k++] = order[i];
+            }
+        } else {
+            memcpy(builder.sorted[f], order, n_rows * sizeof(int));
+        }
+    }
+    
+    tree->root = build_tree(&builder, 0, n_rows, 0);
+    
+    for (int f = 0; f < dataset->cols; f++) {
+        safe_free(builder.sorted[f]);
+    }
+    safe_free(builder.sorted);
+    safe_free(builder.buffer);
+    safe_free(builder.goes_left);
 }
 
 /**
@@ -554,6 +592,43 @@ double* get_tree_probabilities(DecisionTree* tree, Dataset* dataset) {
     return probabilities;
 }
 
+/**
+ * Fonction : score_tree_dataset
+ * Rôle     : Calcule en un seul parcours de l'arbre par échantillon les probabilités et les classes
+ *            dans des buffers fournis par l'appelant (chaque buffer peut être NULL)
+ * Param    : tree (arbre entraîné), dataset (dataset à prédire), threshold (seuil de décision : classe 1 si
+ *            probabilité >= threshold, quel que soit le seuil), probas (sortie [rows] ou NULL), labels (sortie [rows] ou NULL)
+ * Retour   : void
+ */
+void score_tree_dataset(DecisionTree* tree, Dataset* dataset, double threshold, double* probas, int* labels) {
+    for (int i = 0; i < dataset->rows; i++) {
+        DecisionNode* leaf = find_leaf(tree->root, dataset->data[i]);
+        if (probas) probas[i] = leaf->class_probability;
+        if (labels) labels[i] = leaf->class_probability >= threshold ? 1 : 0;
+    }
+}
+
+/**
+ * Fonction : export_raw_decision_tree
+ * Rôle     : Produit une copie de l'arbre dont les seuils s'appliquent aux données brutes
+ *            ((x - mean) / std <= t équivaut à x <= t * std + mean, std > 0)
+ * Param    : tree (arbre entraîné sur données normalisées), scaler (scaler utilisé à l'entraînement)
+ * Retour   : DecisionTree* (nouvel arbre pour données brutes, NULL si dimensions incompatibles)
+ */
+DecisionTree* export_raw_decision_tree(DecisionTree* tree, Scaler* scaler) {
+    if (scaler->n_features != tree->n_features) {
+        fprintf(stderr, "Feature count mismatch: tree has %d, scaler has %d\n",
+                tree->n_features, scaler->n_features);
+        return NULL;
+    }
+    
+    DecisionTree* raw = create_decision_tree(tree->max_depth, tree->min_samples_split,
+                                             tree->min_samples_leaf, tree->criterion);
+    raw->n_features = tree->n_features;
+    raw->root = copy_tree_unscaled(tree->root, scaler);
+    return raw;
+}
+
 /**
  * Fonction : get_tree_depth
  * Rôle     : Retourne la profondeur maximale de l'arbre
@@ -19,6 +19,7 @@ Usage : Pour compiler : make
 #define DECISION_TREE_H
 
 #include "../utils/csv_parser.h"
+#include "../preprocessing/scaler.h"
 
 typedef enum {
     GINI,
@@ -46,11 +47,26 @@ typedef struct {
     int n_features;
 } DecisionTree;
 
+/*
+ * Lignes d'un dataset triées par valeur pour chaque feature : order[f * n_rows + k] est la k-ième
+ * plus petite valeur de la feature f. Calculé une fois, partagé en lecture seule entre entraînements.
+ */
+typedef struct {
+    int n_rows;
+    int n_features;
+    int* order;    // [n_features * n_rows]
+} TreePresort;
+
 DecisionTree* create_decision_tree(int max_depth, int min_samples_split, int min_samples_leaf, SplitCriterion criterion);
+TreePresort* presort_dataset(Dataset* dataset);
+void free_tree_presort(TreePresort* presort);
 void train_decision_tree(DecisionTree* tree, Dataset* dataset);
+void train_decision_tree_rows(DecisionTree* tree, Dataset* dataset, TreePresort* presort, const int* rows, int n_rows);
 int predict_tree_single(DecisionTree* tree, double* sample);
 int* predict_tree_dataset(DecisionTree* tree, Dataset* dataset);
 double* get_tree_probabilities(DecisionTree* tree, Dataset* dataset);
+void score_tree_dataset(DecisionTree* tree, Dataset* dataset, double threshold, double* probas, int* labels);
+DecisionTree* export_raw_decision_tree(DecisionTree* tree, Scaler* scaler);
 int get_tree_depth(DecisionTree* tree);
 int count_tree_nodes(DecisionTree* tree);
 void print_tree(DecisionTree* tree);
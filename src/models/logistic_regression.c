@@ -21,6 +21,8 @@ Usage : Pour compiler : make
 #include <math.h>
 #include <stdio.h>
 
+#define SCORING_BLOCK 256
+
 /* **************************************************
  * # --- FONCTIONS MATHÉMATIQUES --- #
  * ************************************************** */
@@ -35,6 +37,48 @@ double sigmoid(double z) {
     return 1.0 / (1.0 + exp(-z));
 }
 
+/**
+ * Fonction : compute_margins
+ * Rôle     : Calcule les marges z = bias + w.x pour un bloc de lignes consécutives ; avec des interactions,
+ *            les termes croisés sont calculés à la volée depuis la ligne brute (rien n'est matérialisé)
+ * Param    : model (modèle), rows (pointeur vers la première ligne du bloc), count (nombre de lignes), margins (sortie [count]),
+ *            interactions (termes croisés fusionnés, NULL pour le modèle linéaire simple)
+ * Retour   : void
+ */
+static void compute_margins(LogisticRegression* model, double** rows, int count, double* margins,
+                            const Interactions* interactions) {
+    int n_input = interactions ? interactions->n_input : model->n_features;
+    
+    for (int b = 0; b < count; b++) {
+        const double* x = rows[b];
+        double z = model->bias;
+        for (int j = 0; j < n_input; j++) {
+            z += model->weights[j] * x[j];
+        }
+        if (interactions) {
+            const double* w = model->weights + n_input;
+            for (int p = 0; p < interactions->n_pairs; p++) {
+                z += w[p] * (x[interactions->left[p]] * x[interactions->right[p]]);
+            }
+        }
+        margins[b] = z;
+    }
+}
+
+/**
+ * Fonction : penalty_l1_ratio
+ * Rôle     : Retourne la part L1 (alpha) effective d'une pénalité
+ * Param    : penalty (type de pénalité), l1_ratio (part L1 demandée pour ELASTIC_NET)
+ * Retour   : double (0 = L2 pur, 1 = L1 pur)
+ */
+double penalty_l1_ratio(Penalty penalty, double l1_ratio) {
+    switch (penalty) {
+        case PENALTY_L1: return 1.0;
+        case PENALTY_ELASTIC_NET: return l1_ratio;
+        default: return 0.0;
+    }
+}
+
 /* **************************************************
  * # --- CRÉATION ET INITIALISATION --- #
  * ************************************************** */
@@ -50,6 +94,12 @@ LogisticRegression* create_logistic_regression(int n_features, double learning_r
     model->n_features = n_features;
     model->learning_rate = learning_rate;
     model->max_iterations = max_iterations;
+    model->warm_start = 0;
+    model->penalty = PENALTY_NONE;
+    model->lambda = 0.0;
+    model->l1_ratio = 0.5;
+    model->math_mode = MATH_EXACT;
+    model->verbose = 1;
     model->weights = allocate_vector(n_features);
     model->bias = 0.0;
     
@@ -66,53 +116,161 @@ LogisticRegression* create_logistic_regression(int n_features, double learning_r
  * ************************************************** */
 
 /**
- * Fonction : train_logistic_regression
- * Rôle     : Entraîne le modèle de régression logistique par descente de gradient
- * Param    : model (modèle à entraîner), dataset (dataset d'entraînement)
- * Retour   : void
+ * Fonction : apply_gradient
+ * Rôle     : Met à jour poids et biais à partir des gradients accumulés (pénalité L2 dans le gradient,
+ *            L1 par seuillage proximal)
+ * Param    : model (modèle à mettre à jour), gradients (somme des gradients par feature), bias_gradient (somme des gradients du biais), n_samples (nombre d'échantillons)
+ * Retour   : double (valeur de la pénalité avant la mise à jour)
  */
-void train_logistic_regression(LogisticRegression* model, Dataset* dataset) {
+static double apply_gradient(LogisticRegression* model, double* gradients, double bias_gradient, int n_samples) {
+    double lambda = (model->penalty == PENALTY_NONE) ? 0.0 : model->lambda;
+    double alpha = penalty_l1_ratio(model->penalty, model->l1_ratio);
+    double l2 = lambda * (1.0 - alpha);
+    double l1_step = model->learning_rate * lambda * alpha;
+    double penalty_cost = 0.0;
+    
+    for (int j = 0; j < model->n_features; j++) {
+        double w = model->weights[j];
+        penalty_cost += lambda * (alpha * fabs(w) + 0.5 * (1.0 - alpha) * w * w);
+        
+        w -= model->learning_rate * (gradients[j] / n_samples + l2 * w);
+        if (w > l1_step) w -= l1_step;
+        else if (w < -l1_step) w += l1_step;
+        else w = 0.0;
+        model->weights[j] = w;
+    }
+    model->bias -= model->learning_rate * bias_gradient / n_samples;
+    
+    return penalty_cost;
+}
+
+/**
+ * Fonction : gradient_step
+ * Rôle     : Effectue une itération de descente de gradient sur un dataset à partir des poids courants
+ * Param    : model (modèle à mettre à jour), dataset (dataset utilisé pour le gradient), gradients (buffer de taille model->n_features),
+ *            interactions (termes croisés fusionnés, NULL pour le modèle linéaire simple)
+ * Retour   : double (coût moyen cross-entropy + pénalité avant la mise à jour)
+ */
+static double gradient_step(LogisticRegression* model, Dataset* dataset, double* gradients,
+                            const Interactions* interactions) {
     int n_samples = dataset->rows;
     int n_features = dataset->cols;
+    double bias_gradient = 0.0;
+    double cost = 0.0;
     
-    for (int iter = 0; iter < model->max_iterations; iter++) {
-        double* gradients = allocate_vector(n_features);
-        double bias_gradient = 0.0;
-        double cost = 0.0;
+    for (int j = 0; j < model->n_features; j++) {
+        gradients[j] = 0.0;
+    }
+    
+    // Compute gradients, par blocs : marges, puis sigmoïde et log-loss vectorisées
+    double margins[SCORING_BLOCK];
+    double predictions[SCORING_BLOCK];
+    
+    for (int start = 0; start < n_samples; start += SCORING_BLOCK) {
+        int count = (n_samples - start < SCORING_BLOCK) ? n_samples - start : SCORING_BLOCK;
         
-        // Compute gradients
-        for (int i = 0; i < n_samples; i++) {
-            double z = model->bias;
-            for (int j = 0; j < n_features; j++) {
-                z += model->weights[j] * dataset->data[i][j];
-            }
-            
-            double prediction = sigmoid(z);
-            double error = prediction - dataset->labels[i];
+        compute_margins(model, dataset->data + start, count, margins, interactions);
+        sigmoid_batch(margins, predictions, count, model->math_mode);
+        
+        for (int b = 0; b < count; b++) {
+            const double* x = dataset->data[start + b];
+            double error = predictions[b] - dataset->labels[start + b];
             
             // Accumulate gradients
             for (int j = 0; j < n_features; j++) {
-                gradients[j] += error * dataset->data[i][j];
+                gradients[j] += error * x[j];
+            }
+            if (interactions) {
+                double* g = gradients + n_features;
+                for (int p = 0; p < interactions->n_pairs; p++) {
+                    g[p] += error * (x[interactions->left[p]] * x[interactions->right[p]]);
+                }
             }
             bias_gradient += error;
-            
-            // Compute cost
-            double y = dataset->labels[i];
-            cost += -(y * log(prediction + 1e-15) + (1 - y) * log(1 - prediction + 1e-15));
         }
         
-        // Update weights
-        for (int j = 0; j < n_features; j++) {
-            model->weights[j] -= model->learning_rate * gradients[j] / n_samples;
+        // Compute cost
+        cost += log_loss_batch(predictions, dataset->labels + start, count, model->math_mode);
+    }
+    
+    return cost / n_samples + apply_gradient(model, gradients, bias_gradient, n_samples);
+}
+
+/**
+ * Fonction : run_gradient_descent
+ * Rôle     : Boucle de descente de gradient commune aux modèles linéaires simple et à interactions fusionnées
+ * Param    : model (modèle à entraîner), dataset (dataset d'entraînement), interactions (termes croisés ou NULL)
+ * Retour   : void
+ */
+static void run_gradient_descent(LogisticRegression* model, Dataset* dataset, const Interactions* interactions) {
+    if (!model->warm_start) {
+        for (int j = 0; j < model->n_features; j++) {
+            model->weights[j] = 0.0;
         }
-        model->bias -= model->learning_rate * bias_gradient / n_samples;
-        
-        free_vector(gradients);
+        model->bias = 0.0;
+    }
+    
+    double* gradients = allocate_vector(model->n_features);
+    
+    for (int iter = 0; iter < model->max_iterations; iter++) {
+        double cost = gradient_step(model, dataset, gradients, interactions);
         
-        if (iter % 100 == 0) {
-            printf("Iteration %d, Cost: %.6f\n", iter, cost / n_samples);
+        if (model->verbose && iter % 100 == 0) {
+            printf("Iteration %d, Cost: %.6f\n", iter, cost);
         }
     }
+    
+    free_vector(gradients);
+}
+
+/**
+ * Fonction : train_logistic_regression
+ * Rôle     : Entraîne le modèle de régression logistique par descente de gradient
+ *            (repart de poids nuls sauf si model->warm_start est activé)
+ * Param    : model (modèle à entraîner), dataset (dataset d'entraînement)
+ * Retour   : void
+ */
+void train_logistic_regression(LogisticRegression* model, Dataset* dataset) {
+    run_gradient_descent(model, dataset, NULL);
+}
+
+/**
+ * Fonction : train_logistic_regression_interactions
+ * Rôle     : Entraîne le modèle sur les features d'origine et leurs interactions calculées à la volée :
+ *            mêmes poids qu'un entraînement sur materialize_interactions, sans le dataset étendu en mémoire
+ * Param    : model (modèle à interactions_output_size(interactions) features), dataset (dataset d'origine, n_input colonnes),
+ *            interactions (termes croisés)
+ * Retour   : void
+ */
+void train_logistic_regression_interactions(LogisticRegression* model, Dataset* dataset, Interactions* interactions) {
+    if (dataset->cols != interactions->n_input || model->n_features != interactions_output_size(interactions)) {
+        fprintf(stderr, "Feature count mismatch: model has %d, dataset has %d, interactions expect %d + %d\n",
+                model->n_features, dataset->cols, interactions->n_input, interactions->n_pairs);
+        return;
+    }
+    run_gradient_descent(model, dataset, interactions);
+}
+
+/**
+ * Fonction : partial_fit_logistic_regression
+ * Rôle     : Poursuit l'entraînement sur un lot de nouvelles observations (une passe de gradient)
+ *            en partant des poids et du biais courants du modèle
+ * Param    : model (modèle déjà entraîné ou chargé), batch (lot de nouvelles observations)
+ * Retour   : double (coût moyen sur le lot avant la mise à jour, -1 en cas d'erreur)
+ */
+double partial_fit_logistic_regression(LogisticRegression* model, Dataset* batch) {
+    if (batch->cols != model->n_features) {
+        fprintf(stderr, "Feature count mismatch: model has %d, batch has %d\n",
+                model->n_features, batch->cols);
+        return -1.0;
+    }
+    if (batch->rows == 0) return 0.0;
+    
+    double* gradients = allocate_vector(batch->cols);
+    double cost = gradient_step(model, batch, gradients, NULL);
+    free_vector(gradients);
+    
+    return cost;
 }
 
 /* **************************************************
@@ -122,18 +280,20 @@ void train_logistic_regression(LogisticRegression* model, Dataset* dataset) {
 /**
  * Fonction : predict
  * Rôle     : Prédit les classes binaires (0 ou 1) pour un dataset en utilisant un seuil de 0.5
+ *            (sigmoid(z) >= 0.5 équivaut à z >= 0 : aucune exponentielle n'est calculée)
  * Param    : model (modèle entraîné), dataset (dataset à prédire)
  * Retour   : int* (tableau de prédictions binaires)
  */
 int* predict(LogisticRegression* model, Dataset* dataset) {
     int* predictions = (int*)safe_malloc(dataset->rows * sizeof(int));
+    double margins[SCORING_BLOCK];
     
-    for (int i = 0; i < dataset->rows; i++) {
-        double z = model->bias;
-        for (int j = 0; j < model->n_features; j++) {
-            z += model->weights[j] * dataset->data[i][j];
+    for (int start = 0; start < dataset->rows; start += SCORING_BLOCK) {
+        int count = (dataset->rows - start < SCORING_BLOCK) ? dataset->rows - start : SCORING_BLOCK;
+        compute_margins(model, dataset->data + start, count, margins, NULL);
+        for (int b = 0; b < count; b++) {
+            predictions[start + b] = margins[b] >= 0.0 ? 1 : 0;
         }
-        predictions[i] = sigmoid(z) >= 0.5 ? 1 : 0;
     }
     
     return predictions;
@@ -148,15 +308,220 @@ int* predict(LogisticRegression* model, Dataset* dataset) {
 double* predict_proba(LogisticRegression* model, Dataset* dataset) {
     double* probas = allocate_vector(dataset->rows);
     
-    for (int i = 0; i < dataset->rows; i++) {
+    for (int start = 0; start < dataset->rows; start += SCORING_BLOCK) {
+        int count = (dataset->rows - start < SCORING_BLOCK) ? dataset->rows - start : SCORING_BLOCK;
+        compute_margins(model, dataset->data + start, count, probas + start, NULL);
+        sigmoid_batch(probas + start, probas + start, count, model->math_mode);
+    }
+    
+    return probas;
+}
+
+/**
+ * Fonction : score_blocks
+ * Rôle     : Calcule par blocs les marges, probabilités et classes d'un dataset (interactions fusionnées optionnelles)
+ * Param    : model (modèle entraîné), dataset (dataset à prédire), threshold (seuil de décision sur la probabilité),
+ *            probas, labels, margins (sorties [rows] ou NULL), interactions (termes croisés ou NULL)
+ * Retour   : void
+ */
+static void score_blocks(LogisticRegression* model, Dataset* dataset, double threshold,
+                         double* probas, int* labels, double* margins, const Interactions* interactions) {
+    double block_margins[SCORING_BLOCK];
+    double block_probas[SCORING_BLOCK];
+    int need_probas = (probas != NULL) || (labels != NULL && threshold != 0.5);
+    
+    for (int start = 0; start < dataset->rows; start += SCORING_BLOCK) {
+        int count = (dataset->rows - start < SCORING_BLOCK) ? dataset->rows - start : SCORING_BLOCK;
+        double* z = margins ? margins + start : block_margins;
+        double* p = probas ? probas + start : block_probas;
+        
+        compute_margins(model, dataset->data + start, count, z, interactions);
+        if (need_probas) {
+            sigmoid_batch(z, p, count, model->math_mode);
+        }
+        
+        if (labels) {
+            if (need_probas) {
+                for (int b = 0; b < count; b++) {
+                    labels[start + b] = p[b] >= threshold ? 1 : 0;
+                }
+            } else {
+                // Seuil 0.5 : sigmoid(z) >= 0.5 équivaut à z >= 0
+                for (int b = 0; b < count; b++) {
+                    labels[start + b] = z[b] >= 0.0 ? 1 : 0;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Fonction : score_logistic_regression
+ * Rôle     : Calcule en une seule passe les marges, probabilités et classes d'un dataset
+ *            dans des buffers fournis par l'appelant (chaque buffer peut être NULL)
+ * Param    : model (modèle entraîné), dataset (dataset à prédire), threshold (seuil de décision sur la probabilité),
+ *            probas (sortie [rows] ou NULL), labels (sortie [rows] ou NULL), margins (sortie [rows] ou NULL)
+ * Retour   : void
+ */
+void score_logistic_regression(LogisticRegression* model, Dataset* dataset, double threshold,
+                               double* probas, int* labels, double* margins) {
+    score_blocks(model, dataset, threshold, probas, labels, margins, NULL);
+}
+
+/**
+ * Fonction : score_logistic_regression_interactions
+ * Rôle     : Comme score_logistic_regression, pour un modèle entraîné avec des interactions fusionnées
+ * Param    : model (modèle à interactions), dataset (dataset d'origine, n_input colonnes), interactions (termes croisés),
+ *            threshold (seuil), probas, labels, margins (sorties [rows] ou NULL)
+ * Retour   : void
+ */
+void score_logistic_regression_interactions(LogisticRegression* model, Dataset* dataset, Interactions* interactions,
+                                            double threshold, double* probas, int* labels, double* margins) {
+    if (dataset->cols != interactions->n_input || model->n_features != interactions_output_size(interactions)) {
+        fprintf(stderr, "Feature count mismatch: model has %d, dataset has %d, interactions expect %d + %d\n",
+                model->n_features, dataset->cols, interactions->n_input, interactions->n_pairs);
+        return;
+    }
+    score_blocks(model, dataset, threshold, probas, labels, margins, interactions);
+}
+
+/* **************************************************
+ * # --- DONNÉES CREUSES (CSR) --- #
+ * ************************************************** */
+
+/**
+ * Fonction : compute_sparse_margins
+ * Rôle     : Calcule les marges z = bias + w.x d'un bloc de lignes CSR en ne lisant que les valeurs non nulles
+ * Param    : model (modèle), dataset (dataset creux), start (première ligne), count (nombre de lignes), margins (sortie [count])
+ * Retour   : void
+ */
+static void compute_sparse_margins(LogisticRegression* model, SparseDataset* dataset, int start, int count, double* margins) {
+    for (int b = 0; b < count; b++) {
         double z = model->bias;
+        for (int k = dataset->row_ptr[start + b]; k < dataset->row_ptr[start + b + 1]; k++) {
+            z += model->weights[dataset->col_idx[k]] * dataset->values[k];
+        }
+        margins[b] = z;
+    }
+}
+
+/**
+ * Fonction : train_logistic_regression_sparse
+ * Rôle     : Entraîne le modèle par descente de gradient sur un dataset creux (mêmes règles que
+ *            train_logistic_regression : warm start, pénalité, mode de calcul)
+ * Param    : model (modèle à entraîner, n_features = dataset->cols), dataset (dataset creux d'entraînement)
+ * Retour   : void
+ */
+void train_logistic_regression_sparse(LogisticRegression* model, SparseDataset* dataset) {
+    if (dataset->cols != model->n_features) {
+        fprintf(stderr, "Feature count mismatch: model has %d, dataset has %d\n",
+                model->n_features, dataset->cols);
+        return;
+    }
+    
+    if (!model->warm_start) {
         for (int j = 0; j < model->n_features; j++) {
-            z += model->weights[j] * dataset->data[i][j];
+            model->weights[j] = 0.0;
         }
-        probas[i] = sigmoid(z);
+        model->bias = 0.0;
     }
     
-    return probas;
+    int n_samples = dataset->rows;
+    double* gradients = allocate_vector(model->n_features);
+    double margins[SCORING_BLOCK];
+    double predictions[SCORING_BLOCK];
+    
+    for (int iter = 0; iter < model->max_iterations; iter++) {
+        double bias_gradient = 0.0;
+        double cost = 0.0;
+        for (int j = 0; j < model->n_features; j++) {
+            gradients[j] = 0.0;
+        }
+        
+        for (int start = 0; start < n_samples; start += SCORING_BLOCK) {
+            int count = (n_samples - start < SCORING_BLOCK) ? n_samples - start : SCORING_BLOCK;
+            
+            compute_sparse_margins(model, dataset, start, count, margins);
+            sigmoid_batch(margins, predictions, count, model->math_mode);
+            
+            for (int b = 0; b < count; b++) {
+                int i = start + b;
+                double error = predictions[b] - dataset->labels[i];
+                for (int k = dataset->row_ptr[i]; k < dataset->row_ptr[i + 1]; k++) {
+                    gradients[dataset->col_idx[k]] += error * dataset->values[k];
+                }
+                bias_gradient += error;
+            }
+            
+            cost += log_loss_batch(predictions, dataset->labels + start, count, model->math_mode);
+        }
+        
+        cost = cost / n_samples + apply_gradient(model, gradients, bias_gradient, n_samples);
+        
+        if (model->verbose && iter % 100 == 0) {
+            printf("Iteration %d, Cost: %.6f\n", iter, cost);
+        }
+    }
+    
+    free_vector(gradients);
+}
+
+/**
+ * Fonction : score_logistic_regression_sparse
+ * Rôle     : Équivalent creux de score_logistic_regression (une passe, buffers fournis, chacun pouvant être NULL)
+ * Param    : model (modèle entraîné), dataset (dataset creux), threshold (seuil de décision),
+ *            probas (sortie [rows] ou NULL), labels (sortie [rows] ou NULL), margins (sortie [rows] ou NULL)
+ * Retour   : void
+ */
+void score_logistic_regression_sparse(LogisticRegression* model, SparseDataset* dataset, double threshold,
+                                      double* probas, int* labels, double* margins) {
+    double block_margins[SCORING_BLOCK];
+    double block_probas[SCORING_BLOCK];
+    
+    for (int start = 0; start < dataset->rows; start += SCORING_BLOCK) {
+        int count = (dataset->rows - start < SCORING_BLOCK) ? dataset->rows - start : SCORING_BLOCK;
+        double* z = margins ? margins + start : block_margins;
+        double* p = probas ? probas + start : block_probas;
+        
+        compute_sparse_margins(model, dataset, start, count, z);
+        if (probas || labels) {
+            sigmoid_batch(z, p, count, model->math_mode);
+        }
+        if (labels) {
+            for (int b = 0; b < count; b++) {
+                labels[start + b] = p[b] >= threshold ? 1 : 0;
+            }
+        }
+    }
+}
+
+/* **************************************************
+ * # --- EXPORT POUR DONNÉES BRUTES --- #
+ * ************************************************** */
+
+/**
+ * Fonction : export_raw_logistic_regression
+ * Rôle     : Intègre la normalisation dans les poids pour scorer directement des données brutes :
+ *            w.((x - mean) / std) + b = (w / std).x + (b - somme w * mean / std)
+ * Param    : model (modèle entraîné sur données normalisées), scaler (scaler utilisé à l'entraînement)
+ * Retour   : LogisticRegression* (nouveau modèle pour données brutes, NULL si dimensions incompatibles)
+ */
+LogisticRegression* export_raw_logistic_regression(LogisticRegression* model, Scaler* scaler) {
+    if (scaler->n_features != model->n_features) {
+        fprintf(stderr, "Feature count mismatch: model has %d, scaler has %d\n",
+                model->n_features, scaler->n_features);
+        return NULL;
+    }
+    
+    LogisticRegression* raw = create_logistic_regression(model->n_features, model->learning_rate, model->max_iterations);
+    raw->math_mode = model->math_mode;
+    raw->bias = model->bias;
+    for (int j = 0; j < model->n_features; j++) {
+        raw->weights[j] = model->weights[j] / scaler->std[j];
+        raw->bias -= raw->weights[j] * scaler->mean[j];
+    }
+    
+    return raw;
 }
 
 /* **************************************************
@@ -198,6 +563,16 @@ LogisticRegression* load_model(const char* filename) {
     
     LogisticRegression* model = (LogisticRegression*)safe_malloc(sizeof(LogisticRegression));
     
+    // Hyperparamètres non sérialisés : valeurs par défaut du pipeline
+    model->learning_rate = 0.01;
+    model->max_iterations = 1000;
+    model->warm_start = 0;
+    model->penalty = PENALTY_NONE;
+    model->lambda = 0.0;
+    model->l1_ratio = 0.5;
+    model->math_mode = MATH_EXACT;
+    model->verbose = 1;
+    
     if (fread(&model->n_features, sizeof(int), 1, file) != 1 ||
         fread(&model->bias, sizeof(double), 1, file) != 1) {
         fclose(file);
@@ -19,6 +19,17 @@ Usage : Pour compiler : make
 #define LOGISTIC_REGRESSION_H
 
 #include "../utils/csv_parser.h"
+#include "../utils/fast_math.h"
+#include "../utils/sparse_matrix.h"
+#include "../preprocessing/scaler.h"
+#include "../preprocessing/interactions.h"
+
+typedef enum {
+    PENALTY_NONE,
+    PENALTY_L2,
+    PENALTY_L1,
+    PENALTY_ELASTIC_NET
+} Penalty;
 
 typedef struct {
     double* weights;
@@ -26,12 +37,30 @@ typedef struct {
     int n_features;
     double learning_rate;
     int max_iterations;
+    int warm_start;  // 1 = train_logistic_regression repart des poids courants
+    Penalty penalty;
+    double lambda;   // Force de régularisation
+    double l1_ratio; // Part L1 pour ELASTIC_NET (0 = L2 pur, 1 = L1 pur)
+    MathMode math_mode; // MATH_EXACT (libm) ou MATH_FAST (approximations, voir fast_math.h)
+    int verbose;     // 1 = affiche le coût toutes les 100 itérations (0 pour les entraînements en parallèle)
 } LogisticRegression;
 
+double sigmoid(double z);
 LogisticRegression* create_logistic_regression(int n_features, double learning_rate, int max_iterations);
 void train_logistic_regression(LogisticRegression* model, Dataset* dataset);
+void train_logistic_regression_interactions(LogisticRegression* model, Dataset* dataset, Interactions* interactions);
+double partial_fit_logistic_regression(LogisticRegression* model, Dataset* batch);
+double penalty_l1_ratio(Penalty penalty, double l1_ratio);
 int* predict(LogisticRegression* model, Dataset* dataset);
 double* predict_proba(LogisticRegression* model, Dataset* dataset);
+void score_logistic_regression(LogisticRegression* model, Dataset* dataset, double threshold,
+                               double* probas, int* labels, double* margins);
+void score_logistic_regression_interactions(LogisticRegression* model, Dataset* dataset, Interactions* interactions,
+                                            double threshold, double* probas, int* labels, double* margins);
+void train_logistic_regression_sparse(LogisticRegression* model, SparseDataset* dataset);
+void score_logistic_regression_sparse(LogisticRegression* model, SparseDataset* dataset, double threshold,
+                                      double* probas, int* labels, double* margins);
+LogisticRegression* export_raw_logistic_regression(LogisticRegression* model, Scaler* scaler);
 void save_model(const char* filename, LogisticRegression* model);
 LogisticRegression* load_model(const char* filename);
 void free_logistic_regression(LogisticRegression* model);
@@ -0,0 +1,661 @@
+/*****************************************************************************************************
+
+Nom : src/models/pipeline.c
+
+Rôle : Pipeline de scoring bout-en-bout (encodage, imputation, normalisation, modèle) sérialisé en un seul fichier
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "pipeline.h"
+#include "../utils/memory_manager.h"
+#include "../utils/utils.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Sections du fichier : tag (int), taille du contenu en octets (int), contenu
+#define SECTION_END 0
+#define SECTION_COLUMNS 1
+#define SECTION_IMPUTE 2
+#define SECTION_SCALER 3
+#define SECTION_LOGISTIC 4
+#define SECTION_TREE 5
+#define SECTION_CALIBRATION 6
+#define SECTION_DRIFT 7
+
+#define PIPELINE_STACK_FEATURES 64
+
+/* **************************************************
+ * # --- CONSTRUCTION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : allocate_pipeline
+ * Rôle     : Alloue un pipeline vide (sans dictionnaire, scaler ni modèle)
+ * Param    : n_columns (colonnes du CSV brut), label_col (colonne label, -1 si absente)
+ * Retour   : Pipeline* (pipeline vide)
+ */
+static Pipeline* allocate_pipeline(int n_columns, int label_col) {
+    Pipeline* pipeline = (Pipeline*)safe_malloc(sizeof(Pipeline));
+    pipeline->n_columns = n_columns;
+    pipeline->label_col = label_col;
+    pipeline->n_features = (label_col >= 0 && label_col < n_columns) ? n_columns - 1 : n_columns;
+    pipeline->dictionaries = (CategoryDictionary**)safe_calloc(n_columns, sizeof(CategoryDictionary*));
+    pipeline->impute_values = (double*)safe_calloc(pipeline->n_features, sizeof(double));
+    pipeline->scaler = NULL;
+    pipeline->model_type = PIPELINE_LOGISTIC;
+    pipeline->logistic = NULL;
+    pipeline->tree = NULL;
+    pipeline->calibrator = NULL;
+    pipeline->monitor = NULL;
+    return pipeline;
+}
+
+/**
+ * Fonction : copy_scaler
+ * Rôle     : Duplique un scaler
+ * Param    : scaler (scaler à copier)
+ * Retour   : Scaler* (copie indépendante)
+ */
+static Scaler* copy_scaler(Scaler* scaler) {
+    Scaler* copy = (Scaler*)safe_malloc(sizeof(Scaler));
+    copy->n_features = scaler->n_features;
+    copy->mean = allocate_vector(scaler->n_features);
+    copy->std = allocate_vector(scaler->n_features);
+    memcpy(copy->mean, scaler->mean, scaler->n_features * sizeof(double));
+    memcpy(copy->std, scaler->std, scaler->n_features * sizeof(double));
+    return copy;
+}
+
+/**
+ * Fonction : create_pipeline
+ * Rôle     : Crée un pipeline à partir du format du CSV brut, des valeurs d'imputation et du scaler (copiés)
+ * Param    : n_columns (colonnes du CSV brut, label inclus), label_col (colonne label, -1 si absente),
+ *            impute_values (valeur d'imputation de chaque feature), scaler (scaler ajusté sur l'entraînement)
+ * Retour   : Pipeline* (pipeline sans modèle, NULL si dimensions incompatibles)
+ */
+Pipeline* create_pipeline(int n_columns, int label_col, double* impute_values, Scaler* scaler) {
+    Pipeline* pipeline = allocate_pipeline(n_columns, label_col);
+
+    if (scaler->n_features != pipeline->n_features) {
+        fprintf(stderr, "Feature count mismatch: pipeline has %d, scaler has %d\n",
+                pipeline->n_features, scaler->n_features);
+        free_pipeline(pipeline);
+        return NULL;
+    }
+
+    memcpy(pipeline->impute_values, impute_values, pipeline->n_features * sizeof(double));
+    pipeline->scaler = copy_scaler(scaler);
+    return pipeline;
+}
+
+/**
+ * Fonction : pipeline_set_dictionary
+ * Rôle     : Associe (copie) un dictionnaire de modalités à une colonne du CSV brut
+ * Param    : pipeline (pipeline), column (index de colonne dans le CSV brut),
+ *            dict (dictionnaire, reste à l'appelant ; NULL pour une colonne numérique)
+ * Retour   : void
+ */
+void pipeline_set_dictionary(Pipeline* pipeline, int column, CategoryDictionary* dict) {
+    if (column < 0 || column >= pipeline->n_columns || column == pipeline->label_col) {
+        fprintf(stderr, "Invalid pipeline column: %d\n", column);
+        return;
+    }
+    free_category_dictionary(pipeline->dictionaries[column]);
+    pipeline->dictionaries[column] = dict ? copy_category_dictionary(dict) : NULL;
+}
+
+/**
+ * Fonction : pipeline_set_logistic
+ * Rôle     : Installe une régression logistique entraînée sur données normalisées (copiée en espace brut) ;
+ *            le calibrateur et le moniteur du modèle précédent sont retirés
+ * Param    : pipeline (pipeline), model (modèle entraîné avec le scaler du pipeline)
+ * Retour   : void
+ */
+void pipeline_set_logistic(Pipeline* pipeline, LogisticRegression* model) {
+    LogisticRegression* raw = export_raw_logistic_regression(model, pipeline->scaler);
+    if (!raw) return;
+
+    free_logistic_regression(pipeline->logistic);
+    free_decision_tree(pipeline->tree);
+    free_calibrator(pipeline->calibrator);
+    free_drift_monitor(pipeline->monitor);
+    pipeline->tree = NULL;
+    pipeline->calibrator = NULL;
+    pipeline->monitor = NULL;
+    pipeline->logistic = raw;
+    pipeline->model_type = PIPELINE_LOGISTIC;
+}
+
+/**
+ * Fonction : pipeline_set_tree
+ * Rôle     : Installe un arbre de décision entraîné sur données normalisées (copié en espace brut) ;
+ *            le calibrateur et le moniteur du modèle précédent sont retirés
+ * Param    : pipeline (pipeline), tree (arbre entraîné avec le scaler du pipeline)
+ * Retour   : void
+ */
+void pipeline_set_tree(Pipeline* pipeline, DecisionTree* tree) {
+    DecisionTree* raw = export_raw_decision_tree(tree, pipeline->scaler);
+    if (!raw) return;
+
+    free_logistic_regression(pipeline->logistic);
+    free_decision_tree(pipeline->tree);
+    free_calibrator(pipeline->calibrator);
+    free_drift_monitor(pipeline->monitor);
+    pipeline->logistic = NULL;
+    pipeline->calibrator = NULL;
+    pipeline->monitor = NULL;
+    pipeline->tree = raw;
+    pipeline->model_type = PIPELINE_TREE;
+}
+
+/**
+ * Fonction : pipeline_set_calibrator
+ * Rôle     : Installe (copie) le calibrateur du modèle courant, ajusté sur ses probabilités brutes hors échantillon
+ * Param    : pipeline (pipeline avec modèle), calibrator (calibrateur, reste à l'appelant ;
+ *            NULL pour revenir aux probabilités brutes)
+ * Retour   : void
+ */
+void pipeline_set_calibrator(Pipeline* pipeline, Calibrator* calibrator) {
+    free_calibrator(pipeline->calibrator);
+    pipeline->calibrator = calibrator ? copy_calibrator(calibrator) : NULL;
+}
+
+/**
+ * Fonction : pipeline_set_drift_monitor
+ * Rôle     : Associe (copie) la référence de dérive du modèle courant
+ * Param    : pipeline (pipeline avec modèle), monitor (moniteur créé sur les features brutes imputées du train,
+ *            référence de score sur les probabilités du modèle avant calibration, reste à l'appelant ;
+ *            NULL pour le retirer)
+ * Retour   : void
+ */
+void pipeline_set_drift_monitor(Pipeline* pipeline, DriftMonitor* monitor) {
+    if (monitor && monitor->n_features != pipeline->n_features) {
+        fprintf(stderr, "Feature count mismatch: pipeline has %d, monitor has %d\n",
+                pipeline->n_features, monitor->n_features);
+        return;
+    }
+    free_drift_monitor(pipeline->monitor);
+    pipeline->monitor = monitor ? copy_drift_monitor(monitor) : NULL;
+}
+
+/* **************************************************
+ * # --- SCORING --- #
+ * ************************************************** */
+
+/**
+ * Fonction : parse_field
+ * Rôle     : Convertit un champ CSV brut en valeur de feature (dictionnaire, nombre ou imputation).
+ *            Une modalité inconnue d'un dictionnaire sans code par défaut (CATEGORY_UNSEEN) est imputée.
+ * Param    : pipeline (pipeline), column (colonne brute), feature (index de feature), field (début du champ),
+ *            length (longueur), n_unseen (compteur de modalités inconnues, peut être NULL)
+ * Retour   : double (valeur de la feature)
+ */
+static double parse_field(Pipeline* pipeline, int column, int feature, const char* field, int length, int* n_unseen) {
+    CategoryDictionary* dict = pipeline->dictionaries[column];
+    if (dict) {
+        int found;
+        int code = lookup_category(dict, field, length, &found);
+        if (found) return (double)code;
+
+        if (n_unseen) (*n_unseen)++;
+        return (code == CATEGORY_UNSEEN) ? pipeline->impute_values[feature] : (double)code;
+    }
+
+    if (length == 0) return pipeline->impute_values[feature];
+
+    // Même règle que load_csv_with_schema : un champ partiellement numérique ("12abc") est manquant
+    char* end;
+    double value = strtod(field, &end);
+    if (end != field + length || isnan(value)) return pipeline->impute_values[feature];
+    return value;
+}
+
+/**
+ * Fonction : pipeline_score
+ * Rôle     : Score une ligne CSV brute en une passe : chaque champ est lu, encodé ou imputé puis
+ *            directement accumulé dans le produit scalaire (régression) ou la ligne de features (arbre).
+ *            La ligne peut contenir la colonne label (ignorée) ou non. Avec un moniteur de dérive, la ligne
+ *            imputée et la probabilité du modèle avant calibration (espace de la référence) y sont accumulées :
+ *            c'est la seule modification du pipeline, les appels concurrents doivent alors être sérialisés.
+ * Param    : pipeline (pipeline chargé), line (ligne CSV brute, séparateur ','),
+ *            n_unseen (sortie : nombre de modalités absentes des dictionnaires, peut être NULL)
+ * Retour   : double (probabilité de défaut, calibrée si le pipeline a un calibrateur, -1 si la ligne ou
+ *            le pipeline est invalide)
+ */
+double pipeline_score(Pipeline* pipeline, const char* line, int* n_unseen) {
+    if (n_unseen) *n_unseen = 0;
+
+    if (!pipeline->logistic && !pipeline->tree) {
+        fprintf(stderr, "Pipeline has no model\n");
+        return -1.0;
+    }
+
+    int n_fields = 1;
+    for (const char* c = line; *c && *c != '\n' && *c != '\r'; c++) {
+        if (*c == ',') n_fields++;
+    }
+
+    int has_label = (n_fields == pipeline->n_columns);
+    if (!has_label && n_fields != pipeline->n_features) {
+        fprintf(stderr, "Invalid field count: %d (expected %d or %d)\n",
+                n_fields, pipeline->n_columns, pipeline->n_features);
+        return -1.0;
+    }
+
+    LogisticRegression* logistic = pipeline->logistic;
+    DriftMonitor* monitor = pipeline->monitor;
+    double stack_row[PIPELINE_STACK_FEATURES];
+    double* row = NULL;
+    if (!logistic || monitor) {
+        row = pipeline->n_features <= PIPELINE_STACK_FEATURES
+            ? stack_row : (double*)safe_malloc(pipeline->n_features * sizeof(double));
+    }
+
+    double z = logistic ? logistic->bias : 0.0;
+    const char* field = line;
+    int feature = 0;
+
+    for (int k = 0; k < n_fields; k++) {
+        const char* end = field;
+        while (*end && *end != ',' && *end != '\n' && *end != '\r') end++;
+
+        // Sans label, les champs après label_col sont décalés d'une colonne
+        int column = (!has_label && pipeline->label_col >= 0 && k >= pipeline->label_col) ? k + 1 : k;
+        if (column != pipeline->label_col) {
+            double value = parse_field(pipeline, column, feature, field, (int)(end - field), n_unseen);
+            if (logistic) z += logistic->weights[feature] * value;
+            if (row) row[feature] = value;
+            feature++;
+        }
+
+        field = (*end == ',') ? end + 1 : end;
+    }
+
+    double probability;
+    if (logistic) {
+        probability = sigmoid(z);
+    } else {
+        DecisionNode* node = pipeline->tree->root;
+        while (node && !node->is_leaf) {
+            node = (row[node->feature_index] <= node->threshold) ? node->left : node->right;
+        }
+        probability = node ? node->class_probability : -1.0;
+    }
+
+    if (monitor && probability >= 0.0) drift_monitor_update_row(monitor, row, probability);
+    if (row && row != stack_row) safe_free(row);
+    if (probability < 0.0) return -1.0;
+
+    return pipeline->calibrator ? calibrate_probability(pipeline->calibrator, probability) : probability;
+}
+
+/**
+ * Fonction : pipeline_drift_report
+ * Rôle     : Rapport de dérive des lignes scorées par pipeline_score depuis le chargement (ou le dernier
+ *            drift_monitor_reset sur pipeline->monitor), par rapport à la référence du train
+ * Param    : pipeline (pipeline)
+ * Retour   : DriftReport* (rapport à libérer par free_drift_report, NULL si le pipeline n'a pas de moniteur)
+ */
+DriftReport* pipeline_drift_report(Pipeline* pipeline) {
+    if (!pipeline->monitor) return NULL;
+    return compute_drift_report(pipeline->monitor);
+}
+
+/* **************************************************
+ * # --- SAUVEGARDE/CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : begin_section
+ * Rôle     : Écrit l'en-tête d'une section (tag et taille provisoire)
+ * Param    : file (fichier de destination), tag (identifiant de section)
+ * Retour   : long (position de la taille à compléter par end_section)
+ */
+static long begin_section(FILE* file, int tag) {
+    int size = 0;
+    fwrite(&tag, sizeof(int), 1, file);
+    long position = ftell(file);
+    fwrite(&size, sizeof(int), 1, file);
+    return position;
+}
+
+/**
+ * Fonction : end_section
+ * Rôle     : Complète la taille d'une section une fois son contenu écrit
+ * Param    : file (fichier de destination), position (valeur retournée par begin_section)
+ * Retour   : void
+ */
+static void end_section(FILE* file, long position) {
+    long end = ftell(file);
+    int size = (int)(end - position - (long)sizeof(int));
+    fseek(file, position, SEEK_SET);
+    fwrite(&size, sizeof(int), 1, file);
+    fseek(file, end, SEEK_SET);
+}
+
+/**
+ * Fonction : write_tree_recursive
+ * Rôle     : Écrit récursivement les nœuds de l'arbre (parcours préfixe, format binaire)
+ * Param    : file (fichier de destination), node (nœud à écrire)
+ * Retour   : void
+ */
+static void write_tree_recursive(FILE* file, DecisionNode* node) {
+    fwrite(&node->is_leaf, sizeof(int), 1, file);
+    fwrite(&node->predicted_class, sizeof(int), 1, file);
+    fwrite(&node->class_probability, sizeof(double), 1, file);
+    fwrite(&node->feature_index, sizeof(int), 1, file);
+    fwrite(&node->threshold, sizeof(double), 1, file);
+    fwrite(&node->n_samples, sizeof(int), 1, file);
+    fwrite(&node->impurity, sizeof(double), 1, file);
+
+    if (!node->is_leaf) {
+        write_tree_recursive(file, node->left);
+        write_tree_recursive(file, node->right);
+    }
+}
+
+/**
+ * Fonction : free_nodes
+ * Rôle     : Libère récursivement un sous-arbre partiellement chargé
+ * Param    : node (racine du sous-arbre)
+ * Retour   : void
+ */
+static void free_nodes(DecisionNode* node) {
+    if (node == NULL) return;
+    free_nodes(node->left);
+    free_nodes(node->right);
+    safe_free(node);
+}
+
+/**
+ * Fonction : read_tree_recursive
+ * Rôle     : Lit récursivement les nœuds écrits par write_tree_recursive
+ * Param    : file (fichier source), depth (profondeur courante, bornée contre les fichiers corrompus),
+ *            n_features (nombre de features du pipeline, borne des indices de split)
+ * Retour   : DecisionNode* (sous-arbre chargé, NULL en cas d'erreur ou d'indice de feature invalide)
+ */
+static DecisionNode* read_tree_recursive(FILE* file, int depth, int n_features) {
+    if (depth > 1000) return NULL;
+
+    DecisionNode* node = (DecisionNode*)safe_malloc(sizeof(DecisionNode));
+    node->left = NULL;
+    node->right = NULL;
+
+    if (fread(&node->is_leaf, sizeof(int), 1, file) != 1 ||
+        fread(&node->predicted_class, sizeof(int), 1, file) != 1 ||
+        fread(&node->class_probability, sizeof(double), 1, file) != 1 ||
+        fread(&node->feature_index, sizeof(int), 1, file) != 1 ||
+        fread(&node->threshold, sizeof(double), 1, file) != 1 ||
+        fread(&node->n_samples, sizeof(int), 1, file) != 1 ||
+        fread(&node->impurity, sizeof(double), 1, file) != 1) {
+        safe_free(node);
+        return NULL;
+    }
+
+    if (!node->is_leaf) {
+        // pipeline_score lit row[feature_index] : un indice hors bornes est un fichier corrompu
+        if (node->feature_index < 0 || node->feature_index >= n_features) {
+            safe_free(node);
+            return NULL;
+        }
+        node->left = read_tree_recursive(file, depth + 1, n_features);
+        node->right = node->left ? read_tree_recursive(file, depth + 1, n_features) : NULL;
+        if (!node->left || !node->right) {
+            free_nodes(node);
+            return NULL;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * Fonction : save_pipeline
+ * Rôle     : Sauvegarde le pipeline complet dans un fichier binaire unique
+ * Param    : filename (nom du fichier de destination), pipeline (pipeline à sauvegarder)
+ * Retour   : void
+ */
+void save_pipeline(const char* filename, Pipeline* pipeline) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+
+    int header[2] = {PIPELINE_MAGIC, PIPELINE_VERSION};
+    fwrite(header, sizeof(int), 2, file);
+
+    // Colonnes : format du CSV brut et dictionnaires (-1 = colonne numérique)
+    long section = begin_section(file, SECTION_COLUMNS);
+    fwrite(&pipeline->n_columns, sizeof(int), 1, file);
+    fwrite(&pipeline->label_col, sizeof(int), 1, file);
+    for (int c = 0; c < pipeline->n_columns; c++) {
+        CategoryDictionary* dict = pipeline->dictionaries[c];
+        int n_values = dict ? dict->n_values : -1;
+        fwrite(&n_values, sizeof(int), 1, file);
+        if (!dict) continue;
+
+        fwrite(&dict->default_code, sizeof(int), 1, file);
+        for (int k = 0; k < dict->n_values; k++) {
+            int length = (int)strlen(dict->values[k]);
+            fwrite(&length, sizeof(int), 1, file);
+            fwrite(dict->values[k], 1, length, file);
+            fwrite(&dict->codes[k], sizeof(int), 1, file);
+        }
+    }
+    end_section(file, section);
+
+    section = begin_section(file, SECTION_IMPUTE);
+    fwrite(pipeline->impute_values, sizeof(double), pipeline->n_features, file);
+    end_section(file, section);
+
+    section = begin_section(file, SECTION_SCALER);
+    fwrite(pipeline->scaler->mean, sizeof(double), pipeline->n_features, file);
+    fwrite(pipeline->scaler->std, sizeof(double), pipeline->n_features, file);
+    end_section(file, section);
+
+    if (pipeline->logistic) {
+        section = begin_section(file, SECTION_LOGISTIC);
+        fwrite(&pipeline->logistic->bias, sizeof(double), 1, file);
+        fwrite(pipeline->logistic->weights, sizeof(double), pipeline->n_features, file);
+        end_section(file, section);
+    } else if (pipeline->tree) {
+        DecisionTree* tree = pipeline->tree;
+        section = begin_section(file, SECTION_TREE);
+        int params[4] = {tree->max_depth, tree->min_samples_split, tree->min_samples_leaf, (int)tree->criterion};
+        fwrite(params, sizeof(int), 4, file);
+        write_tree_recursive(file, tree->root);
+        end_section(file, section);
+    }
+
+    // Après le modèle : un lecteur antérieur ignore la section et sert les probabilités brutes
+    if (pipeline->calibrator) {
+        section = begin_section(file, SECTION_CALIBRATION);
+        write_calibrator(file, pipeline->calibrator);
+        end_section(file, section);
+    }
+
+    if (pipeline->monitor) {
+        section = begin_section(file, SECTION_DRIFT);
+        write_drift_monitor(file, pipeline->monitor);
+        end_section(file, section);
+    }
+
+    int end_tag = SECTION_END;
+    fwrite(&end_tag, sizeof(int), 1, file);
+
+    fclose(file);
+}
+
+/**
+ * Fonction : read_columns_section
+ * Rôle     : Lit la section des colonnes et crée le pipeline correspondant
+ * Param    : file (fichier source)
+ * Retour   : Pipeline* (pipeline sans scaler ni modèle, NULL en cas d'erreur)
+ */
+static Pipeline* read_columns_section(FILE* file) {
+    int n_columns, label_col;
+    if (fread(&n_columns, sizeof(int), 1, file) != 1 ||
+        fread(&label_col, sizeof(int), 1, file) != 1 ||
+        n_columns <= 0 || n_columns > 100000) {
+        return NULL;
+    }
+
+    Pipeline* pipeline = allocate_pipeline(n_columns, label_col);
+
+    for (int c = 0; c < n_columns; c++) {
+        int n_values, default_code;
+        if (fread(&n_values, sizeof(int), 1, file) != 1) goto error;
+        if (n_values < 0) continue;
+        if (fread(&default_code, sizeof(int), 1, file) != 1) goto error;
+
+        CategoryDictionary* dict = create_category_dictionary(default_code);
+        pipeline->dictionaries[c] = dict;
+
+        for (int k = 0; k < n_values; k++) {
+            int length, code;
+            if (fread(&length, sizeof(int), 1, file) != 1 || length < 0 || length > 4096) goto error;
+            char* value = (char*)safe_malloc(length + 1);
+            if (fread(value, 1, length, file) != (size_t)length ||
+                fread(&code, sizeof(int), 1, file) != 1) {
+                safe_free(value);
+                goto error;
+            }
+            value[length] = '\0';
+            int added = add_category(dict, value, code);
+            safe_free(value);
+            if (!added) goto error;
+        }
+        if (!compile_category_dictionary(dict)) goto error;
+    }
+
+    return pipeline;
+
+error:
+    free_pipeline(pipeline);
+    return NULL;
+}
+
+/**
+ * Fonction : load_pipeline
+ * Rôle     : Charge un pipeline complet depuis un fichier binaire (les sections inconnues sont ignorées)
+ * Param    : filename (nom du fichier source)
+ * Retour   : Pipeline* (pipeline prêt pour pipeline_score, NULL en cas d'erreur)
+ */
+Pipeline* load_pipeline(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+
+    int header[2];
+    if (fread(header, sizeof(int), 2, file) != 2 || header[0] != PIPELINE_MAGIC || header[1] > PIPELINE_VERSION) {
+        fprintf(stderr, "Invalid pipeline file: %s\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    Pipeline* pipeline = NULL;
+    int tag, size;
+
+    while (fread(&tag, sizeof(int), 1, file) == 1 && tag != SECTION_END) {
+        if (fread(&size, sizeof(int), 1, file) != 1 || size < 0) goto error;
+        long start = ftell(file);
+
+        // La section des colonnes fixe les dimensions : elle doit précéder les autres
+        if (tag != SECTION_COLUMNS && !pipeline) goto error;
+        int n = pipeline ? pipeline->n_features : 0;
+
+        if (tag == SECTION_COLUMNS) {
+            if (pipeline) goto error;
+            pipeline = read_columns_section(file);
+            if (!pipeline) goto error;
+        } else if (tag == SECTION_IMPUTE) {
+            if (fread(pipeline->impute_values, sizeof(double), n, file) != (size_t)n) goto error;
+        } else if (tag == SECTION_SCALER) {
+            Scaler* scaler = (Scaler*)safe_malloc(sizeof(Scaler));
+            scaler->n_features = n;
+            scaler->mean = allocate_vector(n);
+            scaler->std = allocate_vector(n);
+            free_scaler(pipeline->scaler);
+            pipeline->scaler = scaler;
+            if (fread(scaler->mean, sizeof(double), n, file) != (size_t)n ||
+                fread(scaler->std, sizeof(double), n, file) != (size_t)n) goto error;
+        } else if (tag == SECTION_LOGISTIC) {
+            LogisticRegression* model = create_logistic_regression(n, 0.01, 1000);
+            free_logistic_regression(pipeline->logistic);
+            pipeline->logistic = model;
+            pipeline->model_type = PIPELINE_LOGISTIC;
+            if (fread(&model->bias, sizeof(double), 1, file) != 1 ||
+                fread(model->weights, sizeof(double), n, file) != (size_t)n) goto error;
+        } else if (tag == SECTION_TREE) {
+            int params[4];
+            if (fread(params, sizeof(int), 4, file) != 4) goto error;
+            DecisionTree* tree = create_decision_tree(params[0], params[1], params[2], (SplitCriterion)params[3]);
+            tree->n_features = n;
+            free_decision_tree(pipeline->tree);
+            pipeline->tree = tree;
+            pipeline->model_type = PIPELINE_TREE;
+            tree->root = read_tree_recursive(file, 0, n);
+            if (!tree->root) goto error;
+        } else if (tag == SECTION_CALIBRATION) {
+            free_calibrator(pipeline->calibrator);
+            pipeline->calibrator = read_calibrator(file);
+            if (!pipeline->calibrator) goto error;
+        } else if (tag == SECTION_DRIFT) {
+            free_drift_monitor(pipeline->monitor);
+            pipeline->monitor = read_drift_monitor(file);
+            if (!pipeline->monitor || pipeline->monitor->n_features != n) goto error;
+        } else {
+            if (fseek(file, size, SEEK_CUR) != 0) goto error;
+        }
+
+        // Chaque section doit consommer exactement la taille annoncée par son en-tête
+        if (ftell(file) - start != size) goto error;
+    }
+
+    if (!pipeline || !pipeline->scaler || (!pipeline->logistic && !pipeline->tree)) goto error;
+
+    fclose(file);
+    return pipeline;
+
+error:
+    fprintf(stderr, "Invalid pipeline file: %s\n", filename);
+    free_pipeline(pipeline);
+    fclose(file);
+    return NULL;
+}
+
+/**
+ * Fonction : free_pipeline
+ * Rôle     : Libère complètement la mémoire allouée pour un pipeline
+ * Param    : pipeline (pipeline à libérer)
+ * Retour   : void
+ */
+void free_pipeline(Pipeline* pipeline) {
+    if (pipeline) {
+        for (int c = 0; c < pipeline->n_columns; c++) {
+            free_category_dictionary(pipeline->dictionaries[c]);
+        }
+        safe_free(pipeline->dictionaries);
+        safe_free(pipeline->impute_values);
+        free_scaler(pipeline->scaler);
+        free_logistic_regression(pipeline->logistic);
+        free_decision_tree(pipeline->tree);
+        free_calibrator(pipeline->calibrator);
+        free_drift_monitor(pipeline->monitor);
+        safe_free(pipeline);
+    }
+}
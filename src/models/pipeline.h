@@ -0,0 +1,71 @@
+/*****************************************************************************************************
+
+Nom : src/models/pipeline.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le pipeline de scoring bout-en-bout (artefact unique)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "logistic_regression.h"
+#include "decision_tree.h"
+#include "calibration.h"
+#include "../evaluation/drift_monitor.h"
+#include "../preprocessing/encoder.h"
+#include "../preprocessing/scaler.h"
+
+#define PIPELINE_MAGIC 0x4C505243  // "CRPL"
+#define PIPELINE_VERSION 1
+
+typedef enum {
+    PIPELINE_LOGISTIC,
+    PIPELINE_TREE
+} PipelineModelType;
+
+/*
+ * Artefact de scoring : description des colonnes du CSV brut, dictionnaires des colonnes
+ * catégorielles, valeurs d'imputation, scaler et modèle. Le modèle est stocké en espace brut
+ * (scaler intégré) : le scoring d'une ligne CSV se fait en une seule passe sur les champs.
+ * Un calibrateur optionnel, propre au modèle installé, est appliqué à la probabilité en sortie ;
+ * un moniteur de dérive optionnel conserve les distributions du train (features et probabilités du modèle
+ * avant calibration) et accumule celles des lignes scorées.
+ * Tous les setters copient leur argument, qui reste à l'appelant (y compris en cas d'erreur).
+ */
+typedef struct {
+    int n_columns;                      // Colonnes du CSV brut (label inclus)
+    int label_col;                      // Index de la colonne label (-1 si absente)
+    int n_features;                     // n_columns moins la colonne label
+    CategoryDictionary** dictionaries;  // [n_columns], NULL pour une colonne numérique
+    double* impute_values;              // [n_features]
+    Scaler* scaler;
+    PipelineModelType model_type;
+    LogisticRegression* logistic;       // Modèle en espace brut (PIPELINE_LOGISTIC)
+    DecisionTree* tree;                 // Arbre en espace brut (PIPELINE_TREE)
+    Calibrator* calibrator;             // NULL : probabilité brute du modèle
+    DriftMonitor* monitor;              // Référence de dérive (NULL si absente)
+} Pipeline;
+
+Pipeline* create_pipeline(int n_columns, int label_col, double* impute_values, Scaler* scaler);
+void pipeline_set_dictionary(Pipeline* pipeline, int column, CategoryDictionary* dict);
+void pipeline_set_logistic(Pipeline* pipeline, LogisticRegression* model);
+void pipeline_set_tree(Pipeline* pipeline, DecisionTree* tree);
+void pipeline_set_calibrator(Pipeline* pipeline, Calibrator* calibrator);
+void pipeline_set_drift_monitor(Pipeline* pipeline, DriftMonitor* monitor);
+double pipeline_score(Pipeline* pipeline, const char* line, int* n_unseen);
+DriftReport* pipeline_drift_report(Pipeline* pipeline);
+void save_pipeline(const char* filename, Pipeline* pipeline);
+Pipeline* load_pipeline(const char* filename);
+void free_pipeline(Pipeline* pipeline);
+
+#endif
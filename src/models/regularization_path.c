@@ -0,0 +1,453 @@
+/*****************************************************************************************************
+
+Nom : src/models/regularization_path.c
+
+Rôle : Régression logistique régularisée (L1/L2/elastic-net) par descente de coordonnées cyclique,
+       chemin de régularisation avec warm start et filtrage de l'ensemble actif (approche glmnet)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "regularization_path.h"
+#include "../utils/memory_manager.h"
+#include "../utils/utils.h"
+#include <math.h>
+#include <stdio.h>
+
+#define CD_TOLERANCE 1e-7
+#define CD_MAX_PASSES 10000
+#define IRLS_MAX_ITERATIONS 100
+#define MIN_IRLS_WEIGHT 1e-5
+
+/*
+ * Objectif minimisé pour un lambda donné :
+ *   -(1/n) log-vraisemblance + lambda * (alpha * |w|_1 + (1 - alpha) / 2 * |w|_2^2)
+ * Chaque itération IRLS remplace la log-vraisemblance par son approximation quadratique,
+ * résolue par descente de coordonnées sur les features de l'ensemble éligible.
+ */
+typedef struct {
+    double* x;        // Données en colonnes [n_features * n_samples]
+    int* y;
+    int n;
+    int p;
+    double* beta;
+    double beta0;
+    double* prob;     // Probabilités courantes
+    double* w;        // Poids IRLS p(1-p)
+    double* r;        // Résidu de travail du problème quadratique
+    double* xwx;      // (1/n) somme w * x^2 par feature
+    double* beta_prev;
+    int* eligible;    // Ensemble fort (strong rules) + features déjà actives
+} CDState;
+
+/* **************************************************
+ * # --- ÉTAT DU SOLVEUR --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_cd_state
+ * Rôle     : Alloue l'état du solveur et recopie les données en stockage par colonnes
+ * Param    : dataset (dataset d'entraînement)
+ * Retour   : CDState* (état initialisé avec des poids nuls et un biais égal au log-odds moyen)
+ */
+static CDState* create_cd_state(Dataset* dataset) {
+    CDState* st = (CDState*)safe_malloc(sizeof(CDState));
+    int n = dataset->rows;
+    int p = dataset->cols;
+    st->n = n;
+    st->p = p;
+    st->y = dataset->labels;
+    st->x = (double*)safe_malloc((size_t)n * p * sizeof(double));
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < p; j++) {
+            st->x[(size_t)j * n + i] = dataset->data[i][j];
+        }
+    }
+
+    st->beta = (double*)safe_calloc(p, sizeof(double));
+    st->beta_prev = allocate_vector(p);
+    st->xwx = allocate_vector(p);
+    st->eligible = (int*)safe_calloc(p, sizeof(int));
+    st->prob = allocate_vector(n);
+    st->w = allocate_vector(n);
+    st->r = allocate_vector(n);
+
+    int n_positive = 0;
+    for (int i = 0; i < n; i++) {
+        if (st->y[i] == 1) n_positive++;
+    }
+    double y_mean = (double)n_positive / n;
+    if (y_mean < 1e-6) y_mean = 1e-6;
+    if (y_mean > 1.0 - 1e-6) y_mean = 1.0 - 1e-6;
+    st->beta0 = log(y_mean / (1.0 - y_mean));
+
+    return st;
+}
+
+/**
+ * Fonction : free_cd_state
+ * Rôle     : Libère l'état du solveur
+ * Param    : st (état à libérer)
+ * Retour   : void
+ */
+static void free_cd_state(CDState* st) {
+    safe_free(st->x);
+    safe_free(st->beta);
+    free_vector(st->beta_prev);
+    free_vector(st->xwx);
+    safe_free(st->eligible);
+    free_vector(st->prob);
+    free_vector(st->w);
+    free_vector(st->r);
+    safe_free(st);
+}
+
+/**
+ * Fonction : update_probabilities
+ * Rôle     : Recalcule les probabilités à partir des poids courants (seules les colonnes non nulles sont lues)
+ * Param    : st (état du solveur)
+ * Retour   : void
+ */
+static void update_probabilities(CDState* st) {
+    int n = st->n;
+    for (int i = 0; i < n; i++) {
+        st->prob[i] = st->beta0;
+    }
+    for (int j = 0; j < st->p; j++) {
+        if (st->beta[j] == 0.0) continue;
+        double b = st->beta[j];
+        const double* col = st->x + (size_t)j * n;
+        for (int i = 0; i < n; i++) {
+            st->prob[i] += b * col[i];
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        st->prob[i] = sigmoid(st->prob[i]);
+    }
+}
+
+/**
+ * Fonction : loss_gradient
+ * Rôle     : Calcule la dérivée de la log-vraisemblance moyenne par rapport au poids j
+ * Param    : st (état du solveur, probabilités à jour), j (index de la feature)
+ * Retour   : double ((1/n) somme x_ij * (y_i - p_i))
+ */
+static double loss_gradient(CDState* st, int j) {
+    const double* col = st->x + (size_t)j * st->n;
+    double g = 0.0;
+    for (int i = 0; i < st->n; i++) {
+        g += col[i] * (st->y[i] - st->prob[i]);
+    }
+    return g / st->n;
+}
+
+/* **************************************************
+ * # --- DESCENTE DE COORDONNÉES --- #
+ * ************************************************** */
+
+/**
+ * Fonction : soft_threshold
+ * Rôle     : Opérateur de seuillage doux S(x, t) = signe(x) * max(|x| - t, 0)
+ * Param    : x (valeur), t (seuil)
+ * Retour   : double (valeur seuillée)
+ */
+static double soft_threshold(double x, double t) {
+    if (x > t) return x - t;
+    if (x < -t) return x + t;
+    return 0.0;
+}
+
+/**
+ * Fonction : cd_pass
+ * Rôle     : Effectue un cycle de descente de coordonnées sur le problème quadratique pondéré
+ * Param    : st (état du solveur), lambda (force de régularisation), alpha (part L1), only_active (1 = features non nulles uniquement)
+ * Retour   : double (plus grande variation pondérée xwx * delta^2 observée)
+ */
+static double cd_pass(CDState* st, double lambda, double alpha, int only_active) {
+    int n = st->n;
+    double l1 = lambda * alpha;
+    double l2 = lambda * (1.0 - alpha);
+    double max_change = 0.0;
+
+    for (int j = 0; j < st->p; j++) {
+        if (!st->eligible[j]) continue;
+        if (only_active && st->beta[j] == 0.0) continue;
+
+        const double* col = st->x + (size_t)j * n;
+        double g = 0.0;
+        for (int i = 0; i < n; i++) {
+            g += st->w[i] * col[i] * st->r[i];
+        }
+        g /= n;
+
+        double old = st->beta[j];
+        double denom = st->xwx[j] + l2;
+        double updated = (denom > 0.0) ? soft_threshold(g + st->xwx[j] * old, l1) / denom : 0.0;
+
+        if (updated != old) {
+            double delta = updated - old;
+            for (int i = 0; i < n; i++) {
+                st->r[i] -= delta * col[i];
+            }
+            st->beta[j] = updated;
+            double change = st->xwx[j] * delta * delta;
+            if (change > max_change) max_change = change;
+        }
+    }
+
+    // Biais non pénalisé
+    double sum_w = 0.0;
+    double sum_wr = 0.0;
+    for (int i = 0; i < n; i++) {
+        sum_w += st->w[i];
+        sum_wr += st->w[i] * st->r[i];
+    }
+    if (sum_w > 0.0) {
+        double delta0 = sum_wr / sum_w;
+        st->beta0 += delta0;
+        for (int i = 0; i < n; i++) {
+            st->r[i] -= delta0;
+        }
+        double change = sum_w / n * delta0 * delta0;
+        if (change > max_change) max_change = change;
+    }
+
+    return max_change;
+}
+
+/**
+ * Fonction : solve_eligible
+ * Rôle     : Résout le problème pour un lambda sur l'ensemble éligible (boucle IRLS + cycles sur l'ensemble actif)
+ * Param    : st (état du solveur, warm start depuis les poids courants), lambda (force de régularisation), alpha (part L1)
+ * Retour   : void
+ */
+static void solve_eligible(CDState* st, double lambda, double alpha) {
+    int n = st->n;
+
+    for (int irls = 0; irls < IRLS_MAX_ITERATIONS; irls++) {
+        update_probabilities(st);
+        for (int i = 0; i < n; i++) {
+            double p = st->prob[i];
+            double w = p * (1.0 - p);
+            if (w < MIN_IRLS_WEIGHT) w = MIN_IRLS_WEIGHT;
+            st->w[i] = w;
+            st->r[i] = (st->y[i] - p) / w;
+        }
+
+        for (int j = 0; j < st->p; j++) {
+            if (!st->eligible[j]) continue;
+            const double* col = st->x + (size_t)j * n;
+            double s = 0.0;
+            for (int i = 0; i < n; i++) {
+                s += st->w[i] * col[i] * col[i];
+            }
+            st->xwx[j] = s / n;
+            st->beta_prev[j] = st->beta[j];
+        }
+        double beta0_prev = st->beta0;
+
+        // Cycle complet, puis cycles sur les seules features actives jusqu'à convergence
+        int passes = 0;
+        while (passes < CD_MAX_PASSES) {
+            double change = cd_pass(st, lambda, alpha, 0);
+            passes++;
+            if (change < CD_TOLERANCE) break;
+
+            while (passes < CD_MAX_PASSES) {
+                change = cd_pass(st, lambda, alpha, 1);
+                passes++;
+                if (change < CD_TOLERANCE) break;
+            }
+        }
+
+        double max_change = 0.0;
+        for (int j = 0; j < st->p; j++) {
+            if (!st->eligible[j]) continue;
+            double delta = st->beta[j] - st->beta_prev[j];
+            double change = st->xwx[j] * delta * delta;
+            if (change > max_change) max_change = change;
+        }
+        double delta0 = st->beta0 - beta0_prev;
+        if (delta0 * delta0 * 0.25 > max_change) max_change = delta0 * delta0 * 0.25;
+
+        if (max_change < CD_TOLERANCE) break;
+    }
+}
+
+/**
+ * Fonction : fit_lambda
+ * Rôle     : Résout le problème pour un lambda avec filtrage par strong rules puis vérification des conditions KKT
+ * Param    : st (état du solveur), lambda (lambda courant), prev_lambda (lambda précédent du chemin), alpha (part L1)
+ * Retour   : void
+ */
+static void fit_lambda(CDState* st, double lambda, double prev_lambda, double alpha) {
+    // Strong rules : une feature nulle dont le gradient est sous le seuil restera probablement nulle
+    update_probabilities(st);
+    double strong_threshold = alpha * (2.0 * lambda - prev_lambda);
+    for (int j = 0; j < st->p; j++) {
+        st->eligible[j] = (st->beta[j] != 0.0) || fabs(loss_gradient(st, j)) >= strong_threshold;
+    }
+
+    while (1) {
+        solve_eligible(st, lambda, alpha);
+
+        // Vérification KKT des features écartées
+        update_probabilities(st);
+        int violations = 0;
+        for (int j = 0; j < st->p; j++) {
+            if (st->eligible[j]) continue;
+            if (fabs(loss_gradient(st, j)) > lambda * alpha * (1.0 + 1e-6)) {
+                st->eligible[j] = 1;
+                violations++;
+            }
+        }
+        if (violations == 0) break;
+    }
+}
+
+/* **************************************************
+ * # --- FONCTIONS PUBLIQUES --- #
+ * ************************************************** */
+
+/**
+ * Fonction : fit_regularization_path
+ * Rôle     : Calcule les modèles pour une grille décroissante de lambdas (de lambda_max, où tous les poids
+ *            sont nuls, à lambda_max * lambda_min_ratio), chaque solution servant de warm start à la suivante
+ * Param    : dataset (dataset d'entraînement normalisé), penalty (L1, L2 ou ELASTIC_NET ; NONE est traité comme L2),
+ *            l1_ratio (part L1 pour ELASTIC_NET), n_lambdas (nombre de points du chemin), lambda_min_ratio (ex : 1e-3)
+ * Retour   : RegularizationPath* (poids, biais et nombre de poids non nuls pour chaque lambda)
+ */
+RegularizationPath* fit_regularization_path(Dataset* dataset, Penalty penalty, double l1_ratio,
+                                            int n_lambdas, double lambda_min_ratio) {
+    if (n_lambdas < 1 || dataset->rows == 0) {
+        fprintf(stderr, "Invalid regularization path parameters\n");
+        return NULL;
+    }
+
+    double alpha = penalty_l1_ratio(penalty, l1_ratio);
+    CDState* st = create_cd_state(dataset);
+
+    // lambda_max : plus petit lambda pour lequel tous les poids sont nuls (modèle biais seul)
+    update_probabilities(st);
+    double max_gradient = 0.0;
+    for (int j = 0; j < st->p; j++) {
+        double g = fabs(loss_gradient(st, j));
+        if (g > max_gradient) max_gradient = g;
+    }
+    double lambda_max = max_gradient / (alpha > 1e-3 ? alpha : 1e-3);
+
+    RegularizationPath* path = (RegularizationPath*)safe_malloc(sizeof(RegularizationPath));
+    path->n_lambdas = n_lambdas;
+    path->n_features = st->p;
+    path->penalty = penalty;
+    path->l1_ratio = l1_ratio;
+    path->lambdas = allocate_vector(n_lambdas);
+    path->biases = allocate_vector(n_lambdas);
+    path->n_nonzero = (int*)safe_malloc(n_lambdas * sizeof(int));
+    path->weights = allocate_matrix(n_lambdas, st->p);
+
+    for (int k = 0; k < n_lambdas; k++) {
+        double t = (n_lambdas > 1) ? (double)k / (n_lambdas - 1) : 1.0;
+        path->lambdas[k] = lambda_max * pow(lambda_min_ratio, t);
+    }
+
+    double prev_lambda = lambda_max;
+    for (int k = 0; k < n_lambdas; k++) {
+        // A lambda_max, la solution est exactement le modèle biais seul (pas de bruit d'arrondi)
+        if (!(k == 0 && alpha >= 1e-3)) {
+            fit_lambda(st, path->lambdas[k], prev_lambda, alpha);
+        }
+        prev_lambda = path->lambdas[k];
+
+        path->biases[k] = st->beta0;
+        path->n_nonzero[k] = 0;
+        for (int j = 0; j < st->p; j++) {
+            path->weights[k][j] = st->beta[j];
+            if (st->beta[j] != 0.0) path->n_nonzero[k]++;
+        }
+    }
+
+    free_cd_state(st);
+    return path;
+}
+
+/**
+ * Fonction : path_to_model
+ * Rôle     : Extrait le modèle correspondant à un point du chemin de régularisation
+ * Param    : path (chemin calculé), index (indice du lambda choisi)
+ * Retour   : LogisticRegression* (modèle prêt pour predict/save_model, NULL si index invalide)
+ */
+LogisticRegression* path_to_model(RegularizationPath* path, int index) {
+    if (index < 0 || index >= path->n_lambdas) {
+        fprintf(stderr, "Invalid path index: %d\n", index);
+        return NULL;
+    }
+
+    LogisticRegression* model = create_logistic_regression(path->n_features, 0.01, 1000);
+    model->penalty = path->penalty;
+    model->lambda = path->lambdas[index];
+    model->l1_ratio = path->l1_ratio;
+    model->bias = path->biases[index];
+    for (int j = 0; j < path->n_features; j++) {
+        model->weights[j] = path->weights[index][j];
+    }
+    return model;
+}
+
+/**
+ * Fonction : train_logistic_regression_cd
+ * Rôle     : Entraîne un modèle par descente de coordonnées pour son propre lambda/penalty
+ *            (part des poids courants si model->warm_start est activé)
+ * Param    : model (modèle à entraîner), dataset (dataset d'entraînement normalisé)
+ * Retour   : void
+ */
+void train_logistic_regression_cd(LogisticRegression* model, Dataset* dataset) {
+    if (dataset->cols != model->n_features) {
+        fprintf(stderr, "Feature count mismatch: model has %d, dataset has %d\n",
+                model->n_features, dataset->cols);
+        return;
+    }
+
+    CDState* st = create_cd_state(dataset);
+    if (model->warm_start) {
+        st->beta0 = model->bias;
+        for (int j = 0; j < st->p; j++) {
+            st->beta[j] = model->weights[j];
+        }
+    }
+
+    double lambda = (model->penalty == PENALTY_NONE) ? 0.0 : model->lambda;
+    fit_lambda(st, lambda, lambda, penalty_l1_ratio(model->penalty, model->l1_ratio));
+
+    model->bias = st->beta0;
+    for (int j = 0; j < st->p; j++) {
+        model->weights[j] = st->beta[j];
+    }
+
+    free_cd_state(st);
+}
+
+/**
+ * Fonction : free_regularization_path
+ * Rôle     : Libère complètement la mémoire allouée pour un chemin de régularisation
+ * Param    : path (chemin à libérer)
+ * Retour   : void
+ */
+void free_regularization_path(RegularizationPath* path) {
+    if (path) {
+        free_vector(path->lambdas);
+        free_vector(path->biases);
+        safe_free(path->n_nonzero);
+        free_matrix(path->weights, path->n_lambdas);
+        safe_free(path);
+    }
+}
@@ -0,0 +1,41 @@
+/*****************************************************************************************************
+
+Nom : src/models/regularization_path.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le solveur par descente de coordonnées (chemin de régularisation)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef REGULARIZATION_PATH_H
+#define REGULARIZATION_PATH_H
+
+#include "../utils/csv_parser.h"
+#include "logistic_regression.h"
+
+typedef struct {
+    double* lambdas;     // Valeurs de lambda décroissantes [n_lambdas]
+    double** weights;    // Poids pour chaque lambda [n_lambdas][n_features]
+    double* biases;      // Biais pour chaque lambda [n_lambdas]
+    int* n_nonzero;      // Nombre de poids non nuls pour chaque lambda
+    int n_lambdas;
+    int n_features;
+    Penalty penalty;
+    double l1_ratio;
+} RegularizationPath;
+
+RegularizationPath* fit_regularization_path(Dataset* dataset, Penalty penalty, double l1_ratio,
+                                            int n_lambdas, double lambda_min_ratio);
+LogisticRegression* path_to_model(RegularizationPath* path, int index);
+void train_logistic_regression_cd(LogisticRegression* model, Dataset* dataset);
+void free_regularization_path(RegularizationPath* path);
+
+#endif
@@ -0,0 +1,515 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/binner.c
+
+Rôle : Discrétisation par quantiles (effectifs égaux ou sketch KLL) vers des codes uint8
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "binner.h"
+#include "../utils/memory_manager.h"
+#include "../utils/parallel.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define SKETCH_K 200
+
+typedef struct {
+    Binner* binner;
+    Dataset* dataset;
+    BinnedDataset* binned;
+    long** counts;        // binner_histogram : [n_features][n_bins + 1]
+} BinnerTask;
+
+/* **************************************************
+ * # --- BORNES --- #
+ * ************************************************** */
+
+/**
+ * Fonction : compare_doubles
+ * Rôle     : Comparateur de doubles pour qsort (ordre croissant)
+ * Param    : a, b (pointeurs vers les doubles à comparer)
+ * Retour   : int (-1, 0 ou 1)
+ */
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Fonction : set_feature_edges
+ * Rôle     : Installe les bornes d'une feature, complétées par +INF jusqu'à 2^s - 1 éléments
+ * Param    : binner (binner), feature (index de la feature), edges (bornes strictement croissantes), n_edges (nombre de bornes)
+ * Retour   : void
+ */
+static void set_feature_edges(Binner* binner, int feature, const double* edges, int n_edges) {
+    int padded = 0;
+    while (padded < n_edges) padded = 2 * padded + 1;
+
+    safe_free(binner->edges[feature]);
+    binner->edges[feature] = (double*)safe_malloc((padded > 0 ? padded : 1) * sizeof(double));
+    for (int b = 0; b < padded; b++) {
+        binner->edges[feature][b] = (b < n_edges) ? edges[b] : INFINITY;
+    }
+    binner->padded_size[feature] = padded;
+    binner->n_bins[feature] = n_edges + 1;
+}
+
+/**
+ * Fonction : append_edge
+ * Rôle     : Ajoute une borne candidate si elle est strictement croissante et laisse des valeurs au-dessus
+ * Param    : edges (bornes), n_edges (nombre de bornes, mis à jour), edge (candidate), max_value (plus grande valeur observée)
+ * Retour   : void
+ */
+static void append_edge(double* edges, int* n_edges, double edge, double max_value) {
+    if (isnan(edge) || edge >= max_value) return;
+    if (*n_edges > 0 && edge <= edges[*n_edges - 1]) return;
+    edges[(*n_edges)++] = edge;
+}
+
+/**
+ * Fonction : exact_edges_task
+ * Rôle     : Tâche parallèle : bornes à effectifs égaux d'une feature à partir de ses valeurs présentes triées
+ * Param    : feature (index de la feature), context (BinnerTask)
+ * Retour   : void
+ */
+static void exact_edges_task(int feature, void* context) {
+    BinnerTask* task = (BinnerTask*)context;
+    Binner* binner = task->binner;
+    Dataset* dataset = task->dataset;
+
+    double* sorted = (double*)safe_malloc((dataset->rows > 0 ? dataset->rows : 1) * sizeof(double));
+    int n = 0;
+    for (int i = 0; i < dataset->rows; i++) {
+        double value = dataset->data[i][feature];
+        if (!isnan(value)) sorted[n++] = value;
+    }
+    qsort(sorted, n, sizeof(double), compare_doubles);
+
+    double* edges = (double*)safe_malloc(binner->max_bins * sizeof(double));
+    int n_edges = 0;
+    for (int b = 1; b < binner->max_bins && n > 0; b++) {
+        long position = (long)b * n / binner->max_bins;
+        if (position > 0) append_edge(edges, &n_edges, sorted[position - 1], sorted[n - 1]);
+    }
+
+    set_feature_edges(binner, feature, edges, n_edges);
+    safe_free(edges);
+    safe_free(sorted);
+}
+
+/**
+ * Fonction : sketch_edges_task
+ * Rôle     : Tâche parallèle : alimente le sketch d'une feature avec un lot puis recalcule ses bornes
+ * Param    : feature (index de la feature), context (BinnerTask)
+ * Retour   : void
+ */
+static void sketch_edges_task(int feature, void* context) {
+    BinnerTask* task = (BinnerTask*)context;
+    Binner* binner = task->binner;
+    QuantileSketch* sketch = binner->sketches[feature];
+
+    for (int i = 0; i < task->dataset->rows; i++) {
+        sketch_update(sketch, task->dataset->data[i][feature]);
+    }
+
+    double* edges = (double*)safe_malloc(binner->max_bins * sizeof(double));
+    int n_edges = 0;
+    for (int b = 1; b < binner->max_bins && sketch->count > 0; b++) {
+        append_edge(edges, &n_edges, sketch_quantile(sketch, (double)b / binner->max_bins), sketch->max);
+    }
+
+    set_feature_edges(binner, feature, edges, n_edges);
+    safe_free(edges);
+}
+
+/* **************************************************
+ * # --- AJUSTEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_binner
+ * Rôle     : Crée un binner non ajusté
+ * Param    : max_bins (nombre maximal d'intervalles par feature, borné à [2, BINNER_MAX_BINS]),
+ *            approximate (1 = bornes issues d'un sketch KLL)
+ * Retour   : Binner* (binner vide)
+ */
+Binner* create_binner(int max_bins, int approximate) {
+    Binner* binner = (Binner*)safe_malloc(sizeof(Binner));
+    binner->max_bins = max_bins < 2 ? 2 : (max_bins > BINNER_MAX_BINS ? BINNER_MAX_BINS : max_bins);
+    binner->approximate = approximate;
+    binner->n_features = 0;
+    binner->n_bins = NULL;
+    binner->edges = NULL;
+    binner->padded_size = NULL;
+    binner->sketches = NULL;
+    return binner;
+}
+
+/**
+ * Fonction : reset_binner
+ * Rôle     : Libère l'état appris et le réalloue pour n_features features
+ * Param    : binner (binner), n_features (nombre de features)
+ * Retour   : void
+ */
+static void reset_binner(Binner* binner, int n_features) {
+    for (int j = 0; j < binner->n_features; j++) {
+        if (binner->edges) safe_free(binner->edges[j]);
+        if (binner->sketches) free_quantile_sketch(binner->sketches[j]);
+    }
+    safe_free(binner->edges);
+    safe_free(binner->sketches);
+    safe_free(binner->n_bins);
+    safe_free(binner->padded_size);
+
+    binner->n_features = n_features;
+    binner->n_bins = (int*)safe_calloc(n_features, sizeof(int));
+    binner->padded_size = (int*)safe_calloc(n_features, sizeof(int));
+    binner->edges = (double**)safe_calloc(n_features, sizeof(double*));
+    binner->sketches = NULL;
+    for (int j = 0; j < n_features; j++) {
+        set_feature_edges(binner, j, NULL, 0);
+    }
+}
+
+/**
+ * Fonction : fit_binner
+ * Rôle     : Calcule les bornes de chaque feature sur un dataset (à appeler sur le train uniquement).
+ *            Les features sont traitées en parallèle, une par tâche.
+ * Param    : binner (binner), dataset (dataset d'entraînement)
+ * Retour   : void
+ */
+void fit_binner(Binner* binner, Dataset* dataset) {
+    reset_binner(binner, dataset->cols);
+
+    if (binner->approximate) {
+        partial_fit_binner(binner, dataset);
+        return;
+    }
+
+    BinnerTask task = {binner, dataset, NULL, NULL};
+    parallel_for(dataset->cols, exact_edges_task, &task);
+}
+
+/**
+ * Fonction : partial_fit_binner
+ * Rôle     : Met à jour les sketches avec un lot de lignes et recalcule les bornes (données en flux ou hors mémoire)
+ * Param    : binner (binner en mode approché), batch (lot de lignes)
+ * Retour   : void
+ */
+void partial_fit_binner(Binner* binner, Dataset* batch) {
+    if (!binner->approximate) {
+        fprintf(stderr, "partial_fit_binner requires approximate mode\n");
+        return;
+    }
+    if (binner->n_features != batch->cols || !binner->edges) {
+        reset_binner(binner, batch->cols);
+    }
+    if (!binner->sketches) {
+        binner->sketches = (QuantileSketch**)safe_malloc(binner->n_features * sizeof(QuantileSketch*));
+        for (int j = 0; j < binner->n_features; j++) {
+            binner->sketches[j] = create_quantile_sketch(SKETCH_K);
+        }
+    }
+
+    BinnerTask task = {binner, batch, NULL, NULL};
+    parallel_for(binner->n_features, sketch_edges_task, &task);
+}
+
+/* **************************************************
+ * # --- TRANSFORMATION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : search_edges
+ * Rôle     : Recherche dichotomique sans branchement : nombre de bornes strictement inférieures à value.
+ *            Le tableau complété par +INF rend le nombre d'itérations fixe (log2(padded + 1)) et
+ *            l'incrément conditionnel se compile en cmov.
+ * Param    : edges (bornes complétées), padded (taille 2^s - 1), value (valeur non manquante)
+ * Retour   : int (code dans [0, n_bins - 1])
+ */
+static inline int search_edges(const double* edges, int padded, double value) {
+    int position = 0;
+    for (int step = (padded + 1) >> 1; step > 0; step >>= 1) {
+        position += (edges[position + step - 1] < value) ? step : 0;
+    }
+    return position;
+}
+
+/**
+ * Fonction : bin_value
+ * Rôle     : Code d'une valeur pour une feature
+ * Param    : binner (binner ajusté), feature (index de la feature), value (valeur brute)
+ * Retour   : uint8_t (code de l'intervalle, BIN_MISSING pour NaN)
+ */
+uint8_t bin_value(Binner* binner, int feature, double value) {
+    int code = search_edges(binner->edges[feature], binner->padded_size[feature], value);
+    return isnan(value) ? BIN_MISSING : (uint8_t)code;
+}
+
+/**
+ * Fonction : transform_feature_task
+ * Rôle     : Tâche parallèle : discrétise une colonne complète dans son bloc contigu de codes
+ * Param    : feature (index de la feature), context (BinnerTask)
+ * Retour   : void
+ */
+static void transform_feature_task(int feature, void* context) {
+    BinnerTask* task = (BinnerTask*)context;
+    const double* edges = task->binner->edges[feature];
+    int padded = task->binner->padded_size[feature];
+    double** data = task->dataset->data;
+    uint8_t* codes = task->binned->codes + (size_t)feature * task->binned->rows;
+
+    for (int i = 0; i < task->binned->rows; i++) {
+        double value = data[i][feature];
+        int code = search_edges(edges, padded, value);
+        codes[i] = isnan(value) ? BIN_MISSING : (uint8_t)code;
+    }
+}
+
+/**
+ * Fonction : binner_transform
+ * Rôle     : Discrétise un dataset en codes uint8 stockés par colonne (une feature par tâche parallèle)
+ * Param    : binner (binner ajusté), dataset (dataset à discrétiser, même nombre de features)
+ * Retour   : BinnedDataset* (dataset discrétisé, NULL si le nombre de features diffère)
+ */
+BinnedDataset* binner_transform(Binner* binner, Dataset* dataset) {
+    if (binner->n_features != dataset->cols) {
+        fprintf(stderr, "Feature count mismatch: binner has %d, dataset has %d\n",
+                binner->n_features, dataset->cols);
+        return NULL;
+    }
+
+    BinnedDataset* binned = (BinnedDataset*)safe_malloc(sizeof(BinnedDataset));
+    binned->rows = dataset->rows;
+    binned->cols = dataset->cols;
+    binned->codes = (uint8_t*)safe_malloc(((size_t)dataset->rows * dataset->cols + 1) * sizeof(uint8_t));
+    binned->labels = (int*)safe_malloc((dataset->rows > 0 ? dataset->rows : 1) * sizeof(int));
+    for (int i = 0; i < dataset->rows; i++) {
+        binned->labels[i] = dataset->labels[i];
+    }
+
+    BinnerTask task = {binner, dataset, binned, NULL};
+    parallel_for(dataset->cols, transform_feature_task, &task);
+    return binned;
+}
+
+/**
+ * Fonction : histogram_feature_task
+ * Rôle     : Tâche parallèle : compte les codes d'une colonne sans les stocker (NaN dans l'intervalle n_bins)
+ * Param    : feature (index de la feature), context (BinnerTask)
+ * Retour   : void
+ */
+static void histogram_feature_task(int feature, void* context) {
+    BinnerTask* task = (BinnerTask*)context;
+    const double* edges = task->binner->edges[feature];
+    int padded = task->binner->padded_size[feature];
+    int missing = task->binner->n_bins[feature];
+    double** data = task->dataset->data;
+    long* counts = task->counts[feature];
+
+    for (int i = 0; i < task->dataset->rows; i++) {
+        double value = data[i][feature];
+        int code = search_edges(edges, padded, value);
+        counts[isnan(value) ? missing : code]++;
+    }
+}
+
+/**
+ * Fonction : binner_histogram
+ * Rôle     : Ajoute les effectifs par intervalle d'un dataset, en une passe et sans dataset discrétisé intermédiaire
+ *            (une feature par tâche parallèle, même recherche sans branchement que binner_transform)
+ * Param    : binner (binner ajusté), dataset (même nombre de features),
+ *            counts (sortie [n_features][n_bins + 1], la dernière case compte les NaN ; non remis à zéro)
+ * Retour   : int (0 en cas de succès, -1 si le nombre de features diffère)
+ */
+int binner_histogram(Binner* binner, Dataset* dataset, long** counts) {
+    if (binner->n_features != dataset->cols) {
+        fprintf(stderr, "Feature count mismatch: binner has %d, dataset has %d\n",
+                binner->n_features, dataset->cols);
+        return -1;
+    }
+
+    BinnerTask task = {binner, dataset, NULL, counts};
+    parallel_for(dataset->cols, histogram_feature_task, &task);
+    return 0;
+}
+
+/**
+ * Fonction : bin_upper_edge
+ * Rôle     : Borne supérieure d'un intervalle, utilisable comme seuil "x <= seuil" par un arbre ou une grille de score
+ * Param    : binner (binner ajusté), feature (index de la feature), code (code de l'intervalle)
+ * Retour   : double (borne supérieure, +INF pour le dernier intervalle, NaN pour BIN_MISSING)
+ */
+double bin_upper_edge(Binner* binner, int feature, int code) {
+    if (code == BIN_MISSING) return NAN;
+    if (code < 0 || code >= binner->n_bins[feature] - 1) return INFINITY;
+    return binner->edges[feature][code];
+}
+
+/* **************************************************
+ * # --- SAUVEGARDE/CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : write_binner
+ * Rôle     : Écrit le binner au format binaire dans un fichier ouvert (sketches inclus en mode approché)
+ * Param    : file (fichier de destination), binner (binner)
+ * Retour   : void
+ */
+void write_binner(FILE* file, Binner* binner) {
+    int header[3] = {binner->max_bins, binner->approximate, binner->n_features};
+    fwrite(header, sizeof(int), 3, file);
+    for (int j = 0; j < binner->n_features; j++) {
+        int n_edges = binner->n_bins[j] - 1;
+        fwrite(&n_edges, sizeof(int), 1, file);
+        fwrite(binner->edges[j], sizeof(double), n_edges, file);
+    }
+
+    int has_sketches = binner->sketches != NULL;
+    fwrite(&has_sketches, sizeof(int), 1, file);
+    for (int j = 0; j < binner->n_features && has_sketches; j++) {
+        write_quantile_sketch(file, binner->sketches[j]);
+    }
+}
+
+/**
+ * Fonction : read_binner
+ * Rôle     : Lit un binner écrit par write_binner
+ * Param    : file (fichier source)
+ * Retour   : Binner* (binner chargé, NULL en cas d'erreur)
+ */
+Binner* read_binner(FILE* file) {
+    int header[3];
+    if (fread(header, sizeof(int), 3, file) != 3 || header[2] <= 0 || header[2] > 100000) {
+        return NULL;
+    }
+
+    Binner* binner = create_binner(header[0], header[1]);
+    reset_binner(binner, header[2]);
+
+    double* edges = (double*)safe_malloc(BINNER_MAX_BINS * sizeof(double));
+    int valid = 1;
+    for (int j = 0; j < binner->n_features && valid; j++) {
+        int n_edges = 0;
+        valid = fread(&n_edges, sizeof(int), 1, file) == 1 && n_edges >= 0 && n_edges < BINNER_MAX_BINS &&
+                fread(edges, sizeof(double), n_edges, file) == (size_t)n_edges;
+        if (valid) set_feature_edges(binner, j, edges, n_edges);
+    }
+    safe_free(edges);
+
+    int has_sketches = 0;
+    valid = valid && fread(&has_sketches, sizeof(int), 1, file) == 1;
+    if (valid && has_sketches) {
+        binner->sketches = (QuantileSketch**)safe_calloc(binner->n_features, sizeof(QuantileSketch*));
+        for (int j = 0; j < binner->n_features && valid; j++) {
+            binner->sketches[j] = read_quantile_sketch(file);
+            valid = binner->sketches[j] != NULL;
+        }
+    }
+
+    if (!valid) {
+        free_binner(binner);
+        return NULL;
+    }
+    return binner;
+}
+
+/**
+ * Fonction : save_binner
+ * Rôle     : Sauvegarde un binner dans un fichier binaire (sketches inclus en mode approché)
+ * Param    : filename (nom du fichier de destination), binner (binner à sauvegarder)
+ * Retour   : void
+ */
+void save_binner(const char* filename, Binner* binner) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+    write_binner(file, binner);
+    fclose(file);
+}
+
+/**
+ * Fonction : load_binner
+ * Rôle     : Charge un binner depuis un fichier binaire
+ * Param    : filename (nom du fichier source)
+ * Retour   : Binner* (binner chargé, NULL en cas d'erreur)
+ */
+Binner* load_binner(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+    Binner* binner = read_binner(file);
+    fclose(file);
+    return binner;
+}
+
+/**
+ * Fonction : copy_binner
+ * Rôle     : Duplique un binner ajusté (bornes ; sketches du mode approché fusionnés dans des sketches vides)
+ * Param    : binner (binner à copier)
+ * Retour   : Binner* (copie indépendante)
+ */
+Binner* copy_binner(Binner* binner) {
+    Binner* copy = create_binner(binner->max_bins, binner->approximate);
+    reset_binner(copy, binner->n_features);
+    for (int j = 0; j < binner->n_features; j++) {
+        set_feature_edges(copy, j, binner->edges[j], binner->n_bins[j] - 1);
+    }
+    if (binner->sketches) {
+        copy->sketches = (QuantileSketch**)safe_malloc(binner->n_features * sizeof(QuantileSketch*));
+        for (int j = 0; j < binner->n_features; j++) {
+            copy->sketches[j] = create_quantile_sketch(binner->sketches[j]->k);
+            sketch_merge(copy->sketches[j], binner->sketches[j]);
+        }
+    }
+    return copy;
+}
+
+/**
+ * Fonction : free_binned_dataset
+ * Rôle     : Libère la mémoire d'un dataset discrétisé
+ * Param    : binned (dataset discrétisé à libérer)
+ * Retour   : void
+ */
+void free_binned_dataset(BinnedDataset* binned) {
+    if (binned) {
+        safe_free(binned->codes);
+        safe_free(binned->labels);
+        safe_free(binned);
+    }
+}
+
+/**
+ * Fonction : free_binner
+ * Rôle     : Libère complètement la mémoire allouée pour un binner
+ * Param    : binner (binner à libérer)
+ * Retour   : void
+ */
+void free_binner(Binner* binner) {
+    if (binner) {
+        for (int j = 0; j < binner->n_features; j++) {
+            if (binner->edges) safe_free(binner->edges[j]);
+            if (binner->sketches) free_quantile_sketch(binner->sketches[j]);
+        }
+        safe_free(binner->edges);
+        safe_free(binner->sketches);
+        safe_free(binner->n_bins);
+        safe_free(binner->padded_size);
+        safe_free(binner);
+    }
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/binner.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour la discrétisation par quantiles (codes uint8)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef BINNER_H
+#define BINNER_H
+
+#include <stdint.h>
+#include "../utils/csv_parser.h"
+#include "../utils/quantile_sketch.h"
+
+#define BINNER_MAX_BINS 255
+#define BIN_MISSING 255  // Code réservé aux valeurs manquantes (NaN)
+
+/*
+ * Discrétisation à effectifs égaux : chaque feature reçoit au plus max_bins intervalles dont les bornes
+ * supérieures (edges) sont des quantiles du train. Le code d'une valeur x est le nombre de bornes < x,
+ * donc x <= edges[b] <=> code <= b (même convention que les seuils de l'arbre de décision).
+ * Les bornes sont complétées par +INF jusqu'à une puissance de deux moins un pour une recherche
+ * dichotomique sans branchement à nombre d'itérations fixe.
+ */
+typedef struct {
+    int max_bins;                 // Nombre maximal d'intervalles par feature (<= BINNER_MAX_BINS)
+    int approximate;              // 1 = bornes issues d'un sketch KLL (ajustement par lots)
+    int n_features;
+    int* n_bins;                  // [n_features] nombre effectif d'intervalles
+    double** edges;               // [n_features][padded_size] bornes supérieures, complétées par +INF
+    int* padded_size;             // [n_features] taille du tableau de bornes (2^steps - 1)
+    QuantileSketch** sketches;    // [n_features] (mode approché, NULL sinon)
+} Binner;
+
+/*
+ * Dataset discrétisé stocké par colonne : codes[j * rows + i] est le code de la ligne i, feature j.
+ * Les passes d'histogramme parcourent ainsi une feature en un bloc contigu d'octets.
+ */
+typedef struct {
+    int rows;
+    int cols;
+    uint8_t* codes;               // [cols * rows]
+    int* labels;                  // [rows] copie des labels
+} BinnedDataset;
+
+Binner* create_binner(int max_bins, int approximate);
+void fit_binner(Binner* binner, Dataset* dataset);
+void partial_fit_binner(Binner* binner, Dataset* batch);
+uint8_t bin_value(Binner* binner, int feature, double value);
+BinnedDataset* binner_transform(Binner* binner, Dataset* dataset);
+int binner_histogram(Binner* binner, Dataset* dataset, long** counts);
+double bin_upper_edge(Binner* binner, int feature, int code);
+void write_binner(FILE* file, Binner* binner);
+Binner* read_binner(FILE* file);
+void save_binner(const char* filename, Binner* binner);
+Binner* load_binner(const char* filename);
+Binner* copy_binner(Binner* binner);
+void free_binned_dataset(BinnedDataset* binned);
+void free_binner(Binner* binner);
+
+#endif
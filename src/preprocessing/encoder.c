@@ -17,6 +17,9 @@ Usage : Pour compiler : make
 
 #include "encoder.h"
 #include "../utils/memory_manager.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* **************************************************
@@ -84,30 +87,38 @@ void free_label_encoder(LabelEncoder* encoder) {
 /**
  * Fonction : encode_home_ownership
  * Rôle     : Encode la variable catégorielle person_home_ownership en entier
+ *            (aiguillage sur le premier octet puis une seule comparaison)
  * Param    : value (chaîne de caractères à encoder : RENT, OWN, MORTGAGE, OTHER)
  * Retour   : int (0=RENT, 1=OWN, 2=MORTGAGE, 3=OTHER)
  */
 int encode_home_ownership(const char* value) {
-    if (strcmp(value, "RENT") == 0) return 0;
-    if (strcmp(value, "OWN") == 0) return 1;
-    if (strcmp(value, "MORTGAGE") == 0) return 2;
-    if (strcmp(value, "OTHER") == 0) return 3;
+    switch (value[0]) {
+        case 'R': if (strcmp(value, "RENT") == 0) return 0; break;
+        case 'M': if (strcmp(value, "MORTGAGE") == 0) return 2; break;
+        case 'O':
+            if (strcmp(value, "OWN") == 0) return 1;
+            if (strcmp(value, "OTHER") == 0) return 3;
+            break;
+    }
     return 0;  // Défaut : RENT
 }
 
 /**
  * Fonction : encode_loan_intent
  * Rôle     : Encode la variable catégorielle loan_intent en entier
+ *            (aiguillage sur le premier octet puis une seule comparaison)
  * Param    : value (chaîne de caractères à encoder : PERSONAL, EDUCATION, MEDICAL, VENTURE, HOMEIMPROVEMENT, DEBTCONSOLIDATION)
  * Retour   : int (0=PERSONAL, 1=EDUCATION, 2=MEDICAL, 3=VENTURE, 4=HOMEIMPROVEMENT, 5=DEBTCONSOLIDATION)
  */
 int encode_loan_intent(const char* value) {
-    if (strcmp(value, "PERSONAL") == 0) return 0;
-    if (strcmp(value, "EDUCATION") == 0) return 1;
-    if (strcmp(value, "MEDICAL") == 0) return 2;
-    if (strcmp(value, "VENTURE") == 0) return 3;
-    if (strcmp(value, "HOMEIMPROVEMENT") == 0) return 4;
-    if (strcmp(value, "DEBTCONSOLIDATION") == 0) return 5;
+    switch (value[0]) {
+        case 'P': if (strcmp(value, "PERSONAL") == 0) return 0; break;
+        case 'E': if (strcmp(value, "EDUCATION") == 0) return 1; break;
+        case 'M': if (strcmp(value, "MEDICAL") == 0) return 2; break;
+        case 'V': if (strcmp(value, "VENTURE") == 0) return 3; break;
+        case 'H': if (strcmp(value, "HOMEIMPROVEMENT") == 0) return 4; break;
+        case 'D': if (strcmp(value, "DEBTCONSOLIDATION") == 0) return 5; break;
+    }
     return 0;  // Défaut : PERSONAL
 }
 
@@ -118,13 +129,9 @@ int encode_loan_intent(const char* value) {
  * Retour   : int (1=A, 2=B, 3=C, 4=D, 5=E, 6=F, 7=G)
  */
 int encode_loan_grade(const char* value) {
-    if (strcmp(value, "A") == 0) return 1;
-    if (strcmp(value, "B") == 0) return 2;
-    if (strcmp(value, "C") == 0) return 3;
-    if (strcmp(value, "D") == 0) return 4;
-    if (strcmp(value, "E") == 0) return 5;
-    if (strcmp(value, "F") == 0) return 6;
-    if (strcmp(value, "G") == 0) return 7;
+    if (value[0] >= 'A' && value[0] <= 'G' && value[1] == '\0') {
+        return value[0] - 'A' + 1;
+    }
     return 3;  // Défaut : C (milieu de gamme)
 }
 
@@ -135,8 +142,881 @@ int encode_loan_grade(const char* value) {
  * Retour   : int (0=N, 1=Y)
  */
 int encode_default_on_file(const char* value) {
-    if (strcmp(value, "N") == 0) return 0;
-    if (strcmp(value, "Y") == 0) return 1;
+    if (value[0] == 'Y' && value[1] == '\0') return 1;
     return 0;  // Défaut : N (pas de défaut)
 }
 
+/* **************************************************
+ * # --- DICTIONNAIRES DE MODALITÉS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : category_hash
+ * Rôle     : Hash FNV-1a d'une modalité (sur length octets) avec graine, suivi d'un brassage final
+ * Param    : value (début de la modalité), length (longueur en octets), seed (graine)
+ * Retour   : unsigned int (hash)
+ */
+static unsigned int category_hash(const char* value, int length, unsigned int seed) {
+    unsigned int hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (int k = 0; k < length; k++) {
+        hash ^= (unsigned char)value[k];
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 15;
+    hash *= 0x2c1b3c6du;
+    hash ^= hash >> 12;
+    return hash;
+}
+
+/**
+ * Fonction : release_perfect_hash
+ * Rôle     : Libère la table de hachage parfait d'un dictionnaire (retour à la recherche linéaire)
+ * Param    : dict (dictionnaire)
+ * Retour   : void
+ */
+static void release_perfect_hash(CategoryDictionary* dict) {
+    safe_free(dict->slots);
+    safe_free(dict->displacements);
+    dict->slots = NULL;
+    dict->displacements = NULL;
+    dict->table_size = 0;
+    dict->n_buckets = 0;
+}
+
+/**
+ * Fonction : create_category_dictionary
+ * Rôle     : Crée un dictionnaire de modalités vide
+ * Param    : default_code (code retourné pour une modalité inconnue, CATEGORY_UNSEEN pour la signaler)
+ * Retour   : CategoryDictionary* (dictionnaire vide)
+ */
+CategoryDictionary* create_category_dictionary(int default_code) {
+    CategoryDictionary* dict = (CategoryDictionary*)safe_malloc(sizeof(CategoryDictionary));
+    dict->n_values = 0;
+    dict->capacity = 8;
+    dict->default_code = default_code;
+    dict->values = (char**)safe_malloc(dict->capacity * sizeof(char*));
+    dict->lengths = (int*)safe_malloc(dict->capacity * sizeof(int));
+    dict->codes = (int*)safe_malloc(dict->capacity * sizeof(int));
+    dict->slots = NULL;
+    dict->displacements = NULL;
+    dict->table_size = 0;
+    dict->n_buckets = 0;
+    return dict;
+}
+
+/**
+ * Fonction : add_category
+ * Rôle     : Ajoute une modalité et son code au dictionnaire (invalide la table compilée) ; une modalité
+ *            déjà présente est refusée (aucun hachage parfait ne sépare deux clés identiques)
+ * Param    : dict (dictionnaire), value (modalité), code (code associé)
+ * Retour   : int (1 si la modalité est ajoutée, 0 si elle existe déjà)
+ */
+int add_category(CategoryDictionary* dict, const char* value, int code) {
+    int length = (int)strlen(value);
+    for (int k = 0; k < dict->n_values; k++) {
+        if (dict->lengths[k] == length && memcmp(dict->values[k], value, length) == 0) {
+            fprintf(stderr, "Duplicate category: %s\n", value);
+            return 0;
+        }
+    }
+
+    if (dict->n_values >= dict->capacity) {
+        dict->capacity *= 2;
+        dict->values = (char**)safe_realloc(dict->values, dict->capacity * sizeof(char*));
+        dict->lengths = (int*)safe_realloc(dict->lengths, dict->capacity * sizeof(int));
+        dict->codes = (int*)safe_realloc(dict->codes, dict->capacity * sizeof(int));
+    }
+    dict->values[dict->n_values] = strdup(value);
+    dict->lengths[dict->n_values] = length;
+    dict->codes[dict->n_values] = code;
+    dict->n_values++;
+    release_perfect_hash(dict);
+    return 1;
+}
+
+/**
+ * Fonction : compare_bucket_sizes
+ * Rôle     : Comparateur qsort : buckets triés par taille décroissante
+ * Param    : a, b (pointeurs vers des paires {taille, bucket})
+ * Retour   : int (négatif si a doit précéder b)
+ */
+static int compare_bucket_sizes(const void* a, const void* b) {
+    const int* x = (const int*)a;
+    const int* y = (const int*)b;
+    if (x[0] != y[0]) return y[0] - x[0];
+    return x[1] - y[1];
+}
+
+/**
+ * Fonction : try_perfect_hash
+ * Rôle     : Tente de construire un hachage parfait (hash-and-displace) pour une taille de table donnée :
+ *            chaque modalité tombe dans un bucket (hash de graine 0), puis chaque bucket, du plus grand
+ *            au plus petit, reçoit la première graine plaçant toutes ses modalités dans des cases libres
+ * Param    : dict (dictionnaire), table_size (nombre de cases, >= n_values)
+ * Retour   : int (1 si la construction réussit, 0 sinon)
+ */
+static int try_perfect_hash(CategoryDictionary* dict, int table_size) {
+    int n = dict->n_values;
+    int n_buckets = n / 2 + 1;
+    int* bucket_start = (int*)safe_calloc(n_buckets + 1, sizeof(int));
+    int* bucket_of = (int*)safe_malloc(n * sizeof(int));
+    int* members = (int*)safe_malloc(n * sizeof(int));
+    int* order = (int*)safe_malloc(2 * n_buckets * sizeof(int));
+    int* slots = (int*)safe_malloc(table_size * sizeof(int));
+    int* displacements = (int*)safe_calloc(n_buckets, sizeof(int));
+    int success = 1;
+
+    // Regroupement des modalités par bucket (tri par comptage)
+    for (int k = 0; k < n; k++) {
+        bucket_of[k] = (int)(category_hash(dict->values[k], dict->lengths[k], 0) % (unsigned int)n_buckets);
+        bucket_start[bucket_of[k] + 1]++;
+    }
+    for (int b = 0; b < n_buckets; b++) {
+        order[2 * b] = bucket_start[b + 1];
+        order[2 * b + 1] = b;
+        bucket_start[b + 1] += bucket_start[b];
+    }
+    // Après ce remplissage, bucket_start[b + 1] pointe sur le début du bucket b
+    for (int k = n - 1; k >= 0; k--) {
+        members[--bucket_start[bucket_of[k] + 1]] = k;
+    }
+    qsort(order, n_buckets, 2 * sizeof(int), compare_bucket_sizes);
+
+    for (int s = 0; s < table_size; s++) slots[s] = -1;
+
+    for (int o = 0; o < n_buckets && success && order[2 * o] > 0; o++) {
+        int bucket = order[2 * o + 1];
+        int first = bucket_start[bucket + 1];
+        int count = order[2 * o];
+
+        success = 0;
+        for (unsigned int seed = 1; seed < 65536 && !success; seed++) {
+            int n_placed = 0;
+            for (; n_placed < count; n_placed++) {
+                int k = members[first + n_placed];
+                int slot = (int)(category_hash(dict->values[k], dict->lengths[k], seed) % (unsigned int)table_size);
+                if (slots[slot] >= 0) break;
+                slots[slot] = k;
+            }
+            if (n_placed == count) {
+                displacements[bucket] = (int)seed;
+                success = 1;
+            } else {
+                // Collision : annulation des placements de cette graine
+                for (int p = 0; p < n_placed; p++) {
+                    int k = members[first + p];
+                    slots[category_hash(dict->values[k], dict->lengths[k], seed) % (unsigned int)table_size] = -1;
+                }
+            }
+        }
+    }
+
+    safe_free(bucket_start);
+    safe_free(bucket_of);
+    safe_free(members);
+    safe_free(order);
+
+    if (!success) {
+        safe_free(slots);
+        safe_free(displacements);
+        return 0;
+    }
+
+    dict->slots = slots;
+    dict->displacements = displacements;
+    dict->table_size = table_size;
+    dict->n_buckets = n_buckets;
+    return 1;
+}
+
+/**
+ * Fonction : compile_category_dictionary
+ * Rôle     : Compile le dictionnaire en table de hachage parfait minimale (une case par modalité) ;
+ *            la table est agrandie si aucune graine ne convient, jusqu'à CATEGORY_MAX_TABLE_FACTOR fois le
+ *            nombre de modalités. Une recherche coûte alors deux hash et une seule comparaison. À rappeler
+ *            après une série d'add_category.
+ * Param    : dict (dictionnaire)
+ * Retour   : int (1 si la table est compilée, 0 en cas d'échec : le dictionnaire reste en recherche linéaire)
+ */
+int compile_category_dictionary(CategoryDictionary* dict) {
+    release_perfect_hash(dict);
+    if (dict->n_values == 0) return 1;
+
+    int table_size = dict->n_values;
+    while (!try_perfect_hash(dict, table_size)) {
+        table_size += table_size / 4 + 1;
+        if (table_size > CATEGORY_MAX_TABLE_FACTOR * dict->n_values) {
+            fprintf(stderr, "Cannot build perfect hash for %d categories\n", dict->n_values);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Fonction : lookup_category
+ * Rôle     : Recherche le code d'une modalité lue directement dans un buffer (sans copie ni terminateur).
+ *            Utilise la table compilée si elle existe, sinon une recherche linéaire.
+ * Param    : dict (dictionnaire), value (début de la modalité), length (longueur en octets), found (sortie : 1 si connue, peut être NULL)
+ * Retour   : int (code de la modalité, default_code si inconnue)
+ */
+int lookup_category(CategoryDictionary* dict, const char* value, int length, int* found) {
+    int match = -1;
+
+    if (dict->slots) {
+        unsigned int bucket = category_hash(value, length, 0) % (unsigned int)dict->n_buckets;
+        unsigned int seed = (unsigned int)dict->displacements[bucket];
+        int k = dict->slots[category_hash(value, length, seed) % (unsigned int)dict->table_size];
+        if (k >= 0 && dict->lengths[k] == length && memcmp(dict->values[k], value, length) == 0) {
+            match = k;
+        }
+    } else {
+        for (int k = 0; k < dict->n_values; k++) {
+            if (dict->lengths[k] == length && memcmp(dict->values[k], value, length) == 0) {
+                match = k;
+                break;
+            }
+        }
+    }
+
+    if (found) *found = (match >= 0);
+    return (match >= 0) ? dict->codes[match] : dict->default_code;
+}
+
+/**
+ * Fonction : compare_strings
+ * Rôle     : Comparateur qsort pour un tableau de chaînes
+ * Param    : a, b (pointeurs vers des const char*)
+ * Retour   : int (résultat de strcmp)
+ */
+static int compare_strings(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/**
+ * Fonction : fit_category_dictionary
+ * Rôle     : Apprend le dictionnaire d'une colonne catégorielle à partir des valeurs d'entraînement :
+ *            modalités distinctes codées 0..k-1 par ordre lexicographique, puis compilation
+ * Param    : values (modalités observées), n_samples (nombre de valeurs), default_code (code des modalités inconnues)
+ * Retour   : CategoryDictionary* (dictionnaire compilé)
+ */
+CategoryDictionary* fit_category_dictionary(const char** values, int n_samples, int default_code) {
+    CategoryDictionary* dict = create_category_dictionary(default_code);
+    if (n_samples <= 0) return dict;
+
+    const char** sorted = (const char**)safe_malloc(n_samples * sizeof(const char*));
+    memcpy(sorted, values, n_samples * sizeof(const char*));
+    qsort(sorted, n_samples, sizeof(const char*), compare_strings);
+
+    for (int i = 0; i < n_samples; i++) {
+        if (i == 0 || strcmp(sorted[i], sorted[i - 1]) != 0) {
+            add_category(dict, sorted[i], dict->n_values);
+        }
+    }
+
+    safe_free(sorted);
+    compile_category_dictionary(dict);
+    return dict;
+}
+
+/**
+ * Fonction : copy_category_dictionary
+ * Rôle     : Copie profonde d'un dictionnaire (recompilé si la source l'était)
+ * Param    : dict (dictionnaire source)
+ * Retour   : CategoryDictionary* (copie indépendante, NULL si dict est NULL)
+ */
+CategoryDictionary* copy_category_dictionary(CategoryDictionary* dict) {
+    if (!dict) return NULL;
+
+    CategoryDictionary* copy = create_category_dictionary(dict->default_code);
+    for (int k = 0; k < dict->n_values; k++) {
+        add_category(copy, dict->values[k], dict->codes[k]);
+    }
+    if (dict->slots) compile_category_dictionary(copy);
+    return copy;
+}
+
+/**
+ * Fonction : free_category_dictionary
+ * Rôle     : Libère complètement la mémoire allouée pour un dictionnaire de modalités
+ * Param    : dict (dictionnaire à libérer)
+ * Retour   : void
+ */
+void free_category_dictionary(CategoryDictionary* dict) {
+    if (dict) {
+        for (int k = 0; k < dict->n_values; k++) {
+            free(dict->values[k]);
+        }
+        safe_free(dict->values);
+        safe_free(dict->lengths);
+        safe_free(dict->codes);
+        release_perfect_hash(dict);
+        safe_free(dict);
+    }
+}
+
+/* **************************************************
+ * # --- ENCODAGE ONE-HOT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : category_code
+ * Rôle     : Convertit une valeur de feature en code catégoriel entier
+ * Param    : value (valeur du dataset)
+ * Retour   : int (code dans [0, CATEGORY_MAX_CODE], -1 si la valeur n'est pas un code valide)
+ */
+static int category_code(double value) {
+    if (isnan(value) || value < 0.0 || value > CATEGORY_MAX_CODE || value != floor(value)) return -1;
+    return (int)value;
+}
+
+/**
+ * Fonction : fit_code_positions
+ * Rôle     : Attribue une position de bloc à chaque code observé, par code croissant ; les codes absents
+ *            (0 pour loan_grade, trous entre modalités) n'occupent aucune colonne
+ * Param    : codes (codes valides observés), n_codes (nombre de codes, >= 1)
+ * Retour   : LabelEncoder* (mapping de taille code max + 1, -1 pour un code non observé)
+ */
+static LabelEncoder* fit_code_positions(const int* codes, int n_codes) {
+    LabelEncoder* encoder = (LabelEncoder*)safe_malloc(sizeof(LabelEncoder));
+    int max_code = 0;
+    for (int i = 0; i < n_codes; i++) {
+        if (codes[i] > max_code) max_code = codes[i];
+    }
+
+    encoder->n_classes = max_code + 1;
+    encoder->mapping = (int*)safe_malloc(encoder->n_classes * sizeof(int));
+    for (int k = 0; k < encoder->n_classes; k++) {
+        encoder->mapping[k] = -1;
+    }
+    for (int i = 0; i < n_codes; i++) {
+        encoder->mapping[codes[i]] = 0;
+    }
+
+    int position = 0;
+    for (int k = 0; k < encoder->n_classes; k++) {
+        if (encoder->mapping[k] == 0) encoder->mapping[k] = position++;
+    }
+    return encoder;
+}
+
+/**
+ * Fonction : one_hot_block_width
+ * Rôle     : Nombre de colonnes du bloc d'une colonne catégorielle (plus grande position + 1)
+ * Param    : labels (mapping code -> position)
+ * Retour   : int (largeur du bloc)
+ */
+static int one_hot_block_width(LabelEncoder* labels) {
+    int width = 0;
+    for (int k = 0; k < labels->n_classes; k++) {
+        if (labels->mapping[k] + 1 > width) width = labels->mapping[k] + 1;
+    }
+    return width;
+}
+
+/**
+ * Fonction : compute_one_hot_layout
+ * Rôle     : Calcule la disposition des colonnes de sortie : features numériques en tête (ordre d'origine),
+ *            puis un bloc d'une colonne par code observé pour chaque colonne catégorielle
+ * Param    : encoder (encodeur dont columns et encoders sont renseignés)
+ * Retour   : void
+ */
+static void compute_one_hot_layout(OneHotEncoder* encoder) {
+    for (int j = 0; j < encoder->n_input; j++) {
+        encoder->output_index[j] = 0;
+    }
+    for (int c = 0; c < encoder->n_columns; c++) {
+        encoder->output_index[encoder->columns[c]] = -1 - c;
+    }
+    
+    int next = 0;
+    for (int j = 0; j < encoder->n_input; j++) {
+        if (encoder->output_index[j] == 0) encoder->output_index[j] = next++;
+    }
+    for (int c = 0; c < encoder->n_columns; c++) {
+        encoder->offsets[c] = next;
+        next += one_hot_block_width(encoder->encoders[c]);
+    }
+    encoder->n_output = next;
+}
+
+/**
+ * Fonction : fit_one_hot_encoder
+ * Rôle     : Apprend les modalités de chaque colonne catégorielle (via un LabelEncoder par colonne)
+ *            et calcule la disposition des colonnes de sortie
+ * Param    : dataset (dataset d'entraînement, codes entiers), columns (colonnes catégorielles), n_columns (nombre de colonnes)
+ * Retour   : OneHotEncoder* (encodeur ajusté)
+ */
+OneHotEncoder* fit_one_hot_encoder(Dataset* dataset, const int* columns, int n_columns) {
+    OneHotEncoder* encoder = (OneHotEncoder*)safe_malloc(sizeof(OneHotEncoder));
+    encoder->n_input = dataset->cols;
+    encoder->n_columns = n_columns;
+    encoder->columns = (int*)safe_malloc(n_columns * sizeof(int));
+    encoder->encoders = (LabelEncoder**)safe_malloc(n_columns * sizeof(LabelEncoder*));
+    encoder->offsets = (int*)safe_malloc(n_columns * sizeof(int));
+    encoder->output_index = (int*)safe_malloc(dataset->cols * sizeof(int));
+    memcpy(encoder->columns, columns, n_columns * sizeof(int));
+    
+    int* codes = (int*)safe_malloc((dataset->rows > 0 ? dataset->rows : 1) * sizeof(int));
+    for (int c = 0; c < n_columns; c++) {
+        int n_codes = 0;
+        for (int i = 0; i < dataset->rows; i++) {
+            int code = category_code(dataset->data[i][columns[c]]);
+            if (code >= 0) codes[n_codes++] = code;
+        }
+        if (n_codes == 0) codes[n_codes++] = 0;
+        encoder->encoders[c] = fit_code_positions(codes, n_codes);
+    }
+    safe_free(codes);
+    
+    compute_one_hot_layout(encoder);
+    return encoder;
+}
+
+/**
+ * Fonction : one_hot_transform_row
+ * Rôle     : Encode une ligne en représentation creuse, indices croissants (une modalité inconnue n'active aucune colonne)
+ * Param    : encoder (encodeur ajusté), row (ligne de n_input features), indices (sortie, capacité n_input),
+ *            values (sortie, capacité n_input)
+ * Retour   : int (nombre d'entrées écrites)
+ */
+int one_hot_transform_row(OneHotEncoder* encoder, const double* row, int* indices, double* values) {
+    int count = 0;
+    
+    // Indices croissants : features numériques puis blocs one-hot
+    for (int j = 0; j < encoder->n_input; j++) {
+        if (encoder->output_index[j] >= 0) {
+            indices[count] = encoder->output_index[j];
+            values[count] = row[j];
+            count++;
+        }
+    }
+    
+    for (int c = 0; c < encoder->n_columns; c++) {
+        LabelEncoder* labels = encoder->encoders[c];
+        int code = category_code(row[encoder->columns[c]]);
+        if (code >= 0 && code < labels->n_classes && labels->mapping[code] >= 0) {
+            indices[count] = encoder->offsets[c] + labels->mapping[code];
+            values[count] = 1.0;
+            count++;
+        }
+    }
+    
+    return count;
+}
+
+/**
+ * Fonction : one_hot_transform
+ * Rôle     : Encode un dataset complet en dataset creux CSR de n_output colonnes
+ * Param    : encoder (encodeur ajusté), dataset (dataset à encoder, non modifié)
+ * Retour   : SparseDataset* (dataset creux encodé, labels copiés)
+ */
+SparseDataset* one_hot_transform(OneHotEncoder* encoder, Dataset* dataset) {
+    SparseDataset* sparse = create_sparse_dataset(encoder->n_output);
+    int* indices = (int*)safe_malloc(encoder->n_input * sizeof(int));
+    double* values = (double*)safe_malloc(encoder->n_input * sizeof(double));
+    
+    for (int i = 0; i < dataset->rows; i++) {
+        int count = one_hot_transform_row(encoder, dataset->data[i], indices, values);
+        sparse_add_row(sparse, indices, values, count, dataset->labels ? dataset->labels[i] : 0);
+    }
+    
+    safe_free(indices);
+    safe_free(values);
+    return sparse;
+}
+
+/**
+ * Fonction : save_one_hot_encoder
+ * Rôle     : Sauvegarde un encodeur one-hot dans un fichier binaire
+ * Param    : filename (nom du fichier de destination), encoder (encodeur à sauvegarder)
+ * Retour   : void
+ */
+void save_one_hot_encoder(const char* filename, OneHotEncoder* encoder) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+    
+    fwrite(&encoder->n_input, sizeof(int), 1, file);
+    fwrite(&encoder->n_columns, sizeof(int), 1, file);
+    fwrite(encoder->columns, sizeof(int), encoder->n_columns, file);
+    for (int c = 0; c < encoder->n_columns; c++) {
+        LabelEncoder* labels = encoder->encoders[c];
+        fwrite(&labels->n_classes, sizeof(int), 1, file);
+        fwrite(labels->mapping, sizeof(int), labels->n_classes, file);
+    }
+    
+    fclose(file);
+}
+
+/**
+ * Fonction : load_one_hot_encoder
+ * Rôle     : Charge un encodeur one-hot depuis un fichier binaire
+ * Param    : filename (nom du fichier source)
+ * Retour   : OneHotEncoder* (encodeur chargé, NULL en cas d'erreur)
+ */
+OneHotEncoder* load_one_hot_encoder(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+    
+    int n_input, n_columns;
+    if (fread(&n_input, sizeof(int), 1, file) != 1 || fread(&n_columns, sizeof(int), 1, file) != 1 ||
+        n_input <= 0 || n_columns < 0 || n_columns > n_input) {
+        fclose(file);
+        return NULL;
+    }
+    
+    OneHotEncoder* encoder = (OneHotEncoder*)safe_malloc(sizeof(OneHotEncoder));
+    encoder->n_input = n_input;
+    encoder->n_columns = n_columns;
+    encoder->columns = (int*)safe_malloc((n_columns > 0 ? n_columns : 1) * sizeof(int));
+    encoder->encoders = (LabelEncoder**)safe_calloc(n_columns > 0 ? n_columns : 1, sizeof(LabelEncoder*));
+    encoder->offsets = (int*)safe_malloc((n_columns > 0 ? n_columns : 1) * sizeof(int));
+    encoder->output_index = (int*)safe_malloc(n_input * sizeof(int));
+    encoder->n_output = 0;
+    
+    int valid = fread(encoder->columns, sizeof(int), n_columns, file) == (size_t)n_columns;
+    for (int c = 0; c < n_columns && valid; c++) {
+        int n_classes;
+        valid = fread(&n_classes, sizeof(int), 1, file) == 1 && n_classes > 0 && n_classes <= CATEGORY_MAX_CODE + 1 &&
+                encoder->columns[c] >= 0 && encoder->columns[c] < n_input;
+        if (!valid) break;
+        
+        LabelEncoder* labels = (LabelEncoder*)safe_malloc(sizeof(LabelEncoder));
+        labels->n_classes = n_classes;
+        labels->mapping = (int*)safe_malloc(n_classes * sizeof(int));
+        encoder->encoders[c] = labels;
+        valid = fread(labels->mapping, sizeof(int), n_classes, file) == (size_t)n_classes;
+        for (int k = 0; k < n_classes && valid; k++) {
+            valid = labels->mapping[k] >= -1 && labels->mapping[k] < n_classes;
+        }
+    }
+    fclose(file);
+    
+    if (!valid) {
+        free_one_hot_encoder(encoder);
+        return NULL;
+    }
+    
+    compute_one_hot_layout(encoder);
+    return encoder;
+}
+
+/**
+ * Fonction : free_one_hot_encoder
+ * Rôle     : Libère complètement la mémoire allouée pour un encodeur one-hot
+ * Param    : encoder (encodeur à libérer)
+ * Retour   : void
+ */
+void free_one_hot_encoder(OneHotEncoder* encoder) {
+    if (encoder) {
+        for (int c = 0; c < encoder->n_columns; c++) {
+            free_label_encoder(encoder->encoders[c]);
+        }
+        safe_free(encoder->encoders);
+        safe_free(encoder->columns);
+        safe_free(encoder->offsets);
+        safe_free(encoder->output_index);
+        safe_free(encoder);
+    }
+}
+
+/* **************************************************
+ * # --- ENCODAGE WOE / CIBLE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : target_statistic
+ * Rôle     : Calcule la valeur encodée d'une modalité à partir des effectifs bons (label 0) / mauvais (label 1)
+ * Param    : encoder (encodeur), good (bons de la modalité), bad (mauvais de la modalité),
+ *            total_good (bons au total), total_bad (mauvais au total), n_categories (nombre de modalités)
+ * Retour   : double (WoE lissé ou taux de défaut lissé ; valeur neutre si la modalité est absente)
+ */
+static double target_statistic(TargetEncoder* encoder, double good, double bad,
+                               double total_good, double total_bad, int n_categories) {
+    double total = total_good + total_bad;
+    double prior = (total > 0) ? total_bad / total : 0.0;
+    double a = encoder->smoothing;
+    
+    if (encoder->mode == TARGET_WOE) {
+        if (good + bad == 0 || total_good == 0 || total_bad == 0) return 0.0;
+        double good_share = (good + a) / (total_good + a * n_categories);
+        double bad_share = (bad + a) / (total_bad + a * n_categories);
+        return log(good_share / bad_share);
+    }
+    
+    return (bad + a * prior) / (good + bad + a);
+}
+
+/**
+ * Fonction : create_target_encoder
+ * Rôle     : Crée un encodeur WoE / cible non ajusté
+ * Param    : mode (TARGET_WOE ou TARGET_MEAN), columns (colonnes catégorielles), n_columns (nombre de colonnes),
+ *            smoothing (lissage, > 0 ; 0.5 si <= 0)
+ * Retour   : TargetEncoder* (encodeur vide)
+ */
+TargetEncoder* create_target_encoder(TargetEncoding mode, const int* columns, int n_columns, double smoothing) {
+    TargetEncoder* encoder = (TargetEncoder*)safe_malloc(sizeof(TargetEncoder));
+    encoder->mode = mode;
+    encoder->smoothing = (smoothing > 0) ? smoothing : 0.5;
+    encoder->n_input = 0;
+    encoder->n_columns = n_columns;
+    encoder->columns = (int*)safe_malloc(n_columns * sizeof(int));
+    encoder->n_categories = (int*)safe_calloc(n_columns, sizeof(int));
+    encoder->values = (double**)safe_calloc(n_columns, sizeof(double*));
+    encoder->default_value = (double*)safe_calloc(n_columns, sizeof(double));
+    memcpy(encoder->columns, columns, n_columns * sizeof(int));
+    return encoder;
+}
+
+/**
+ * Fonction : fit_target_encoder
+ * Rôle     : Ajuste les tables de l'encodeur sur tout le dataset (état utilisé au scoring)
+ * Param    : encoder (encodeur), dataset (dataset d'entraînement, codes entiers et labels 0/1 ; doit contenir
+ *            toutes les colonnes encodées, sa largeur devient n_input)
+ * Retour   : void
+ */
+void fit_target_encoder(TargetEncoder* encoder, Dataset* dataset) {
+    for (int c = 0; c < encoder->n_columns; c++) {
+        if (encoder->columns[c] < 0 || encoder->columns[c] >= dataset->cols) {
+            fprintf(stderr, "Feature count mismatch: target encoder column %d, dataset has %d\n",
+                    encoder->columns[c], dataset->cols);
+            return;
+        }
+    }
+    encoder->n_input = dataset->cols;
+    
+    double total_good = 0, total_bad = 0;
+    for (int i = 0; i < dataset->rows; i++) {
+        if (dataset->labels[i]) total_bad++;
+        else total_good++;
+    }
+    
+    for (int c = 0; c < encoder->n_columns; c++) {
+        int column = encoder->columns[c];
+        int n_categories = 1;
+        for (int i = 0; i < dataset->rows; i++) {
+            int code = category_code(dataset->data[i][column]);
+            if (code + 1 > n_categories) n_categories = code + 1;
+        }
+        
+        double* good = (double*)safe_calloc(n_categories, sizeof(double));
+        double* bad = (double*)safe_calloc(n_categories, sizeof(double));
+        for (int i = 0; i < dataset->rows; i++) {
+            int code = category_code(dataset->data[i][column]);
+            if (code < 0) continue;
+            if (dataset->labels[i]) bad[code]++;
+            else good[code]++;
+        }
+        
+        safe_free(encoder->values[c]);
+        encoder->n_categories[c] = n_categories;
+        encoder->values[c] = (double*)safe_malloc(n_categories * sizeof(double));
+        for (int k = 0; k < n_categories; k++) {
+            encoder->values[c][k] = target_statistic(encoder, good[k], bad[k], total_good, total_bad, n_categories);
+        }
+        encoder->default_value[c] = target_statistic(encoder, 0, 0, total_good, total_bad, n_categories);
+        
+        safe_free(good);
+        safe_free(bad);
+    }
+}
+
+/**
+ * Fonction : fit_transform_target_encoder
+ * Rôle     : Ajuste l'encodeur sur tout le dataset puis remplace les codes du dataset par des valeurs
+ *            hors-pli : la ligne i (pli i % n_folds) est encodée avec les effectifs des autres plis,
+ *            ce qui évite que le modèle apprenne sur une valeur calculée avec son propre label
+ * Param    : encoder (encodeur), dataset (dataset d'entraînement, modifié en place), n_folds (nombre de plis, >= 2)
+ * Retour   : void
+ */
+void fit_transform_target_encoder(TargetEncoder* encoder, Dataset* dataset, int n_folds) {
+    fit_target_encoder(encoder, dataset);
+    if (encoder->n_input != dataset->cols) return;
+    if (n_folds < 2) {
+        transform_target_encoder(encoder, dataset);
+        return;
+    }
+    
+    double* fold_good = (double*)safe_calloc(n_folds, sizeof(double));
+    double* fold_bad = (double*)safe_calloc(n_folds, sizeof(double));
+    double total_good = 0, total_bad = 0;
+    for (int i = 0; i < dataset->rows; i++) {
+        if (dataset->labels[i]) { fold_bad[i % n_folds]++; total_bad++; }
+        else { fold_good[i % n_folds]++; total_good++; }
+    }
+    
+    for (int c = 0; c < encoder->n_columns; c++) {
+        int column = encoder->columns[c];
+        int n_categories = encoder->n_categories[c];
+        
+        // Effectifs par (pli, modalité) ; effectifs hors-pli = total - pli
+        double* good = (double*)safe_calloc((size_t)(n_folds + 1) * n_categories, sizeof(double));
+        double* bad = (double*)safe_calloc((size_t)(n_folds + 1) * n_categories, sizeof(double));
+        double* all_good = good + (size_t)n_folds * n_categories;
+        double* all_bad = bad + (size_t)n_folds * n_categories;
+        
+        for (int i = 0; i < dataset->rows; i++) {
+            int code = category_code(dataset->data[i][column]);
+            if (code < 0) continue;
+            size_t cell = (size_t)(i % n_folds) * n_categories + code;
+            if (dataset->labels[i]) { bad[cell]++; all_bad[code]++; }
+            else { good[cell]++; all_good[code]++; }
+        }
+        
+        for (int i = 0; i < dataset->rows; i++) {
+            int fold = i % n_folds;
+            int code = category_code(dataset->data[i][column]);
+            double out_good = total_good - fold_good[fold];
+            double out_bad = total_bad - fold_bad[fold];
+            
+            if (code < 0) {
+                dataset->data[i][column] = target_statistic(encoder, 0, 0, out_good, out_bad, n_categories);
+                continue;
+            }
+            size_t cell = (size_t)fold * n_categories + code;
+            dataset->data[i][column] = target_statistic(encoder, all_good[code] - good[cell], all_bad[code] - bad[cell],
+                                                        out_good, out_bad, n_categories);
+        }
+        
+        safe_free(good);
+        safe_free(bad);
+    }
+    
+    safe_free(fold_good);
+    safe_free(fold_bad);
+}
+
+/**
+ * Fonction : target_encode_value
+ * Rôle     : Encode un code catégoriel d'une colonne avec les tables ajustées (scoring)
+ * Param    : encoder (encodeur ajusté), column (position de la colonne dans encoder->columns), code (code catégoriel)
+ * Retour   : double (valeur encodée, default_value si la modalité est inconnue)
+ */
+double target_encode_value(TargetEncoder* encoder, int column, double code) {
+    int k = category_code(code);
+    if (k < 0 || k >= encoder->n_categories[column]) return encoder->default_value[column];
+    return encoder->values[column][k];
+}
+
+/**
+ * Fonction : transform_target_encoder
+ * Rôle     : Remplace en place les codes catégoriels par leurs valeurs encodées (validation, test, scoring)
+ * Param    : encoder (encodeur ajusté), dataset (dataset à transformer, n_input features ; laissé intact sinon)
+ * Retour   : void
+ */
+void transform_target_encoder(TargetEncoder* encoder, Dataset* dataset) {
+    if (encoder->n_input != dataset->cols) {
+        fprintf(stderr, "Feature count mismatch: target encoder has %d, dataset has %d\n",
+                encoder->n_input, dataset->cols);
+        return;
+    }
+    
+    for (int i = 0; i < dataset->rows; i++) {
+        for (int c = 0; c < encoder->n_columns; c++) {
+            double* cell = &dataset->data[i][encoder->columns[c]];
+            *cell = target_encode_value(encoder, c, *cell);
+        }
+    }
+}
+
+/**
+ * Fonction : save_target_encoder
+ * Rôle     : Sauvegarde un encodeur WoE / cible dans un fichier binaire
+ * Param    : filename (nom du fichier de destination), encoder (encodeur à sauvegarder)
+ * Retour   : void
+ */
+void save_target_encoder(const char* filename, TargetEncoder* encoder) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+    
+    int mode = (int)encoder->mode;
+    fwrite(&mode, sizeof(int), 1, file);
+    fwrite(&encoder->smoothing, sizeof(double), 1, file);
+    fwrite(&encoder->n_input, sizeof(int), 1, file);
+    fwrite(&encoder->n_columns, sizeof(int), 1, file);
+    for (int c = 0; c < encoder->n_columns; c++) {
+        fwrite(&encoder->columns[c], sizeof(int), 1, file);
+        fwrite(&encoder->n_categories[c], sizeof(int), 1, file);
+        fwrite(&encoder->default_value[c], sizeof(double), 1, file);
+        fwrite(encoder->values[c], sizeof(double), encoder->n_categories[c], file);
+    }
+    
+    fclose(file);
+}
+
+/**
+ * Fonction : load_target_encoder
+ * Rôle     : Charge un encodeur WoE / cible depuis un fichier binaire
+ * Param    : filename (nom du fichier source)
+ * Retour   : TargetEncoder* (encodeur chargé, NULL en cas d'erreur)
+ */
+TargetEncoder* load_target_encoder(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+    
+    int mode, n_input, n_columns;
+    double smoothing;
+    if (fread(&mode, sizeof(int), 1, file) != 1 || fread(&smoothing, sizeof(double), 1, file) != 1 ||
+        fread(&n_input, sizeof(int), 1, file) != 1 || fread(&n_columns, sizeof(int), 1, file) != 1 ||
+        (mode != TARGET_WOE && mode != TARGET_MEAN) || n_input <= 0 || n_columns <= 0 || n_columns > n_input) {
+        fclose(file);
+        return NULL;
+    }
+    
+    int* columns = (int*)safe_calloc(n_columns, sizeof(int));
+    TargetEncoder* encoder = create_target_encoder((TargetEncoding)mode, columns, n_columns, smoothing);
+    safe_free(columns);
+    encoder->n_input = n_input;
+    
+    int valid = 1;
+    for (int c = 0; c < n_columns && valid; c++) {
+        int n_categories;
+        valid = fread(&encoder->columns[c], sizeof(int), 1, file) == 1 &&
+                encoder->columns[c] >= 0 && encoder->columns[c] < n_input &&
+                fread(&n_categories, sizeof(int), 1, file) == 1 && n_categories > 0 && n_categories <= CATEGORY_MAX_CODE + 1 &&
+                fread(&encoder->default_value[c], sizeof(double), 1, file) == 1;
+        if (!valid) break;
+        
+        encoder->n_categories[c] = n_categories;
+        encoder->values[c] = (double*)safe_malloc(n_categories * sizeof(double));
+        valid = fread(encoder->values[c], sizeof(double), n_categories, file) == (size_t)n_categories;
+    }
+    fclose(file);
+    
+    if (!valid) {
+        free_target_encoder(encoder);
+        return NULL;
+    }
+    return encoder;
+}
+
+/**
+ * Fonction : free_target_encoder
+ * Rôle     : Libère complètement la mémoire allouée pour un encodeur WoE / cible
+ * Param    : encoder (encodeur à libérer)
+ * Retour   : void
+ */
+void free_target_encoder(TargetEncoder* encoder) {
+    if (encoder) {
+        for (int c = 0; c < encoder->n_columns; c++) {
+            safe_free(encoder->values[c]);
+        }
+        safe_free(encoder->values);
+        safe_free(encoder->columns);
+        safe_free(encoder->n_categories);
+        safe_free(encoder->default_value);
+        safe_free(encoder);
+    }
+}
@@ -19,12 +19,67 @@ Usage : Pour compiler : make
 #define ENCODER_H
 
 #include "../utils/csv_parser.h"
+#include "../utils/sparse_matrix.h"
 
 typedef struct {
     int* mapping;
     int n_classes;
 } LabelEncoder;
 
+#define CATEGORY_UNSEEN -1
+#define CATEGORY_MAX_TABLE_FACTOR 8   // Taille maximale de la table de hachage parfait (en modalités)
+#define CATEGORY_MAX_CODE 65535       // Code catégoriel maximal (borne les tables indexées par code)
+
+/*
+ * Dictionnaire de modalités d'une colonne catégorielle (valeur -> code).
+ * Une fois compilé, la recherche passe par un hachage parfait minimal (hash-and-displace) :
+ * slot = h(valeur, displacements[h(valeur, 0) % n_buckets]) % table_size.
+ */
+typedef struct {
+    char** values;
+    int* lengths;
+    int* codes;
+    int n_values;
+    int capacity;
+    int default_code;    // Code retourné pour une modalité inconnue (CATEGORY_UNSEEN pour la signaler)
+    int* slots;          // [table_size] index de modalité ou -1, NULL si non compilé
+    int* displacements;  // [n_buckets] graine de chaque bucket
+    int table_size;
+    int n_buckets;
+} CategoryDictionary;
+
+/*
+ * One-hot des colonnes catégorielles (codes entiers dans [0, CATEGORY_MAX_CODE]) vers un dataset creux :
+ * features numériques conservées en tête, puis un bloc d'indicatrices par colonne encodée, avec une
+ * colonne par code observé à l'ajustement (loan_grade, codé 1..7, occupe 7 colonnes).
+ */
+typedef struct {
+    int n_input;              // Features du dataset d'entrée
+    int n_columns;            // Colonnes catégorielles encodées
+    int* columns;             // [n_columns] index des colonnes catégorielles
+    LabelEncoder** encoders;  // [n_columns] code -> position dans le bloc (-1 si non observé)
+    int* offsets;             // [n_columns] première colonne de sortie du bloc
+    int* output_index;        // [n_input] colonne de sortie (numérique) ou -1 - bloc (catégorielle)
+    int n_output;
+} OneHotEncoder;
+
+typedef enum {
+    TARGET_WOE,   // ln(%bons / %mauvais) de la modalité (weight of evidence)
+    TARGET_MEAN   // Taux de défaut lissé vers le taux global
+} TargetEncoding;
+
+// Remplacement de chaque code catégoriel par une statistique de la cible (une feature dense par colonne)
+typedef struct {
+    TargetEncoding mode;
+    double smoothing;        // Lissage additif (WoE) ou poids du taux global (moyenne)
+    int n_input;             // Features du dataset d'ajustement (0 avant fit_target_encoder)
+    int n_columns;
+    int* columns;            // [n_columns] index des colonnes catégorielles
+    int* n_categories;       // [n_columns] taille de la table (code max + 1)
+    double** values;         // [n_columns][n_categories] valeur encodée de chaque code
+    double* default_value;   // [n_columns] valeur d'une modalité inconnue
+} TargetEncoder;
+
 LabelEncoder* fit_label_encoder(int* labels, int n_samples);
 void encode_labels(int* labels, int n_samples, LabelEncoder* encoder);
 void free_label_encoder(LabelEncoder* encoder);
@@ -35,5 +90,29 @@ int encode_loan_intent(const char* value);
 int encode_loan_grade(const char* value);
 int encode_default_on_file(const char* value);
 
+CategoryDictionary* create_category_dictionary(int default_code);
+int add_category(CategoryDictionary* dict, const char* value, int code);
+int compile_category_dictionary(CategoryDictionary* dict);
+int lookup_category(CategoryDictionary* dict, const char* value, int length, int* found);
+CategoryDictionary* fit_category_dictionary(const char** values, int n_samples, int default_code);
+CategoryDictionary* copy_category_dictionary(CategoryDictionary* dict);
+void free_category_dictionary(CategoryDictionary* dict);
+
+OneHotEncoder* fit_one_hot_encoder(Dataset* dataset, const int* columns, int n_columns);
+int one_hot_transform_row(OneHotEncoder* encoder, const double* row, int* indices, double* values);
+SparseDataset* one_hot_transform(OneHotEncoder* encoder, Dataset* dataset);
+void save_one_hot_encoder(const char* filename, OneHotEncoder* encoder);
+OneHotEncoder* load_one_hot_encoder(const char* filename);
+void free_one_hot_encoder(OneHotEncoder* encoder);
+
+TargetEncoder* create_target_encoder(TargetEncoding mode, const int* columns, int n_columns, double smoothing);
+void fit_target_encoder(TargetEncoder* encoder, Dataset* dataset);
+void fit_transform_target_encoder(TargetEncoder* encoder, Dataset* dataset, int n_folds);
+double target_encode_value(TargetEncoder* encoder, int column, double code);
+void transform_target_encoder(TargetEncoder* encoder, Dataset* dataset);
+void save_target_encoder(const char* filename, TargetEncoder* encoder);
+TargetEncoder* load_target_encoder(const char* filename);
+void free_target_encoder(TargetEncoder* encoder);
+
 #endif
 
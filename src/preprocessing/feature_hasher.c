@@ -0,0 +1,139 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/feature_hasher.c
+
+Rôle : Hachage de features catégorielles "nom=valeur" vers un espace de taille fixe (hashing trick)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "feature_hasher.h"
+#include "../utils/memory_manager.h"
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+/* **************************************************
+ * # --- HACHAGE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : fnv1a_update
+ * Rôle     : Met à jour un hash FNV-1a 32 bits avec une chaîne
+ * Param    : hash (hash courant), text (chaîne à intégrer)
+ * Retour   : unsigned int (hash mis à jour)
+ */
+static unsigned int fnv1a_update(unsigned int hash, const char* text) {
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        hash ^= *c;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Fonction : create_feature_hasher
+ * Rôle     : Crée un hacheur de features
+ * Param    : n_dense (nombre de features numériques en tête), n_buckets (taille de l'espace haché),
+ *            alternate_sign (1 pour un signe ±1 dérivé du hash), seed (graine du hash)
+ * Retour   : FeatureHasher* (hacheur initialisé)
+ */
+FeatureHasher* create_feature_hasher(int n_dense, int n_buckets, int alternate_sign, unsigned int seed) {
+    FeatureHasher* hasher = (FeatureHasher*)safe_malloc(sizeof(FeatureHasher));
+    hasher->n_dense = n_dense;
+    hasher->n_buckets = n_buckets;
+    hasher->alternate_sign = alternate_sign;
+    hasher->seed = seed;
+    return hasher;
+}
+
+/**
+ * Fonction : hash_feature
+ * Rôle     : Calcule la colonne (et le signe) associée à la paire catégorielle "nom=valeur"
+ * Param    : hasher (hacheur), name (nom de la colonne), value (modalité), sign (sortie : +1 ou -1, peut être NULL)
+ * Retour   : int (index de colonne dans [n_dense, n_dense + n_buckets[)
+ */
+int hash_feature(FeatureHasher* hasher, const char* name, const char* value, double* sign) {
+    unsigned int hash = FNV_OFFSET ^ hasher->seed;
+    hash = fnv1a_update(hash, name);
+    hash ^= '=';
+    hash *= FNV_PRIME;
+    hash = fnv1a_update(hash, value);
+
+    // Brassage final pour décorréler l'index et le bit de signe
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+
+    if (sign) {
+        *sign = (hasher->alternate_sign && (hash & 0x80000000u)) ? -1.0 : 1.0;
+    }
+    return hasher->n_dense + (int)(hash % (unsigned int)hasher->n_buckets);
+}
+
+/**
+ * Fonction : hasher_add_row
+ * Rôle     : Ajoute à un dataset creux une ligne composée de features numériques et de catégories hachées
+ *            (les collisions au sein d'une même ligne sont additionnées)
+ * Param    : hasher (hacheur), dataset (dataset creux de n_dense + n_buckets colonnes), dense (valeurs numériques [n_dense] ou NULL),
+ *            names (noms des colonnes catégorielles), values (modalités), n_categorical (nombre de catégories), label (label de la ligne)
+ * Retour   : void
+ */
+void hasher_add_row(FeatureHasher* hasher, SparseDataset* dataset, const double* dense,
+                    const char** names, const char** values, int n_categorical, int label) {
+    int capacity = hasher->n_dense + n_categorical;
+    int* indices = (int*)safe_malloc((capacity > 0 ? capacity : 1) * sizeof(int));
+    double* row_values = (double*)safe_malloc((capacity > 0 ? capacity : 1) * sizeof(double));
+    int count = 0;
+
+    if (dense) {
+        for (int j = 0; j < hasher->n_dense; j++) {
+            indices[count] = j;
+            row_values[count] = dense[j];
+            count++;
+        }
+    }
+
+    int first_hashed = count;
+    for (int k = 0; k < n_categorical; k++) {
+        double sign;
+        int column = hash_feature(hasher, names[k], values[k], &sign);
+
+        int merged = 0;
+        for (int m = first_hashed; m < count; m++) {
+            if (indices[m] == column) {
+                row_values[m] += sign;
+                merged = 1;
+                break;
+            }
+        }
+        if (!merged) {
+            indices[count] = column;
+            row_values[count] = sign;
+            count++;
+        }
+    }
+
+    sparse_add_row(dataset, indices, row_values, count, label);
+
+    safe_free(indices);
+    safe_free(row_values);
+}
+
+/**
+ * Fonction : free_feature_hasher
+ * Rôle     : Libère la mémoire allouée pour un hacheur de features
+ * Param    : hasher (hacheur à libérer)
+ * Retour   : void
+ */
+void free_feature_hasher(FeatureHasher* hasher) {
+    safe_free(hasher);
+}
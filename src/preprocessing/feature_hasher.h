@@ -0,0 +1,36 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/feature_hasher.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le module de hachage de features (hashing trick)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef FEATURE_HASHER_H
+#define FEATURE_HASHER_H
+
+#include "../utils/sparse_matrix.h"
+
+typedef struct {
+    int n_dense;         // Features numériques placées aux colonnes [0, n_dense[
+    int n_buckets;       // Features hachées placées aux colonnes [n_dense, n_dense + n_buckets[
+    int alternate_sign;  // 1 = signe ±1 dérivé du hash (compense les collisions)
+    unsigned int seed;
+} FeatureHasher;
+
+FeatureHasher* create_feature_hasher(int n_dense, int n_buckets, int alternate_sign, unsigned int seed);
+int hash_feature(FeatureHasher* hasher, const char* name, const char* value, double* sign);
+void hasher_add_row(FeatureHasher* hasher, SparseDataset* dataset, const double* dense,
+                    const char** names, const char** values, int n_categorical, int label);
+void free_feature_hasher(FeatureHasher* hasher);
+
+#endif
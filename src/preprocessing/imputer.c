@@ -0,0 +1,316 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/imputer.c
+
+Rôle : Imputation des valeurs manquantes (moyenne, médiane, quantile, constante) ajustée sur le train
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "imputer.h"
+#include "../utils/memory_manager.h"
+#include "../utils/parallel.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define SKETCH_K 200
+
+typedef struct {
+    Imputer* imputer;
+    Dataset* dataset;
+} ImputerTask;
+
+/* **************************************************
+ * # --- AJUSTEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_imputer
+ * Rôle     : Crée un imputeur non ajusté
+ * Param    : strategy (stratégie), quantile (quantile imputé pour IMPUTE_QUANTILE), fill_value (valeur pour IMPUTE_CONSTANT),
+ *            approximate (1 = sketch KLL pour IMPUTE_MEDIAN / IMPUTE_QUANTILE)
+ * Retour   : Imputer* (imputeur vide)
+ */
+Imputer* create_imputer(ImputeStrategy strategy, double quantile, double fill_value, int approximate) {
+    Imputer* imputer = (Imputer*)safe_malloc(sizeof(Imputer));
+    imputer->strategy = strategy;
+    imputer->quantile = (strategy == IMPUTE_MEDIAN) ? 0.5 : quantile;
+    imputer->fill_value = fill_value;
+    imputer->approximate = approximate;
+    imputer->n_features = 0;
+    imputer->values = NULL;
+    imputer->sketches = NULL;
+    imputer->stats = NULL;
+    return imputer;
+}
+
+/**
+ * Fonction : reset_imputer
+ * Rôle     : Libère l'état appris et le réalloue pour n_features features
+ * Param    : imputer (imputeur), n_features (nombre de features)
+ * Retour   : void
+ */
+static void reset_imputer(Imputer* imputer, int n_features) {
+    if (imputer->sketches) {
+        for (int j = 0; j < imputer->n_features; j++) {
+            free_quantile_sketch(imputer->sketches[j]);
+        }
+        safe_free(imputer->sketches);
+        imputer->sketches = NULL;
+    }
+    free_running_stats(imputer->stats);
+    imputer->stats = NULL;
+    safe_free(imputer->values);
+
+    imputer->n_features = n_features;
+    imputer->values = (double*)safe_calloc(n_features, sizeof(double));
+}
+
+/**
+ * Fonction : exact_quantile_task
+ * Rôle     : Tâche parallèle : quantile exact des valeurs présentes d'une feature (sélection linéaire)
+ * Param    : feature (index de la feature), context (ImputerTask)
+ * Retour   : void
+ */
+static void exact_quantile_task(int feature, void* context) {
+    ImputerTask* task = (ImputerTask*)context;
+    Dataset* dataset = task->dataset;
+
+    double* buffer = (double*)safe_malloc((dataset->rows > 0 ? dataset->rows : 1) * sizeof(double));
+    int n = 0;
+    for (int i = 0; i < dataset->rows; i++) {
+        double value = dataset->data[i][feature];
+        if (!isnan(value)) buffer[n++] = value;
+    }
+
+    task->imputer->values[feature] = (n > 0) ? select_quantile(buffer, n, task->imputer->quantile) : 0.0;
+    safe_free(buffer);
+}
+
+/**
+ * Fonction : sketch_update_task
+ * Rôle     : Tâche parallèle : alimente le sketch d'une feature avec un lot puis met à jour sa valeur d'imputation
+ * Param    : feature (index de la feature), context (ImputerTask)
+ * Retour   : void
+ */
+static void sketch_update_task(int feature, void* context) {
+    ImputerTask* task = (ImputerTask*)context;
+    QuantileSketch* sketch = task->imputer->sketches[feature];
+
+    for (int i = 0; i < task->dataset->rows; i++) {
+        sketch_update(sketch, task->dataset->data[i][feature]);
+    }
+
+    double value = sketch_quantile(sketch, task->imputer->quantile);
+    task->imputer->values[feature] = isnan(value) ? 0.0 : value;
+}
+
+/**
+ * Fonction : fit_imputer
+ * Rôle     : Ajuste les valeurs d'imputation sur un dataset (à appeler sur le train uniquement).
+ *            Les quantiles sont calculés en parallèle, une feature par tâche.
+ * Param    : imputer (imputeur), dataset (dataset d'entraînement)
+ * Retour   : void
+ */
+void fit_imputer(Imputer* imputer, Dataset* dataset) {
+    reset_imputer(imputer, dataset->cols);
+
+    if (imputer->strategy == IMPUTE_CONSTANT) {
+        for (int j = 0; j < dataset->cols; j++) {
+            imputer->values[j] = imputer->fill_value;
+        }
+        return;
+    }
+
+    if (imputer->strategy == IMPUTE_MEAN || imputer->approximate) {
+        partial_fit_imputer(imputer, dataset);
+        return;
+    }
+
+    ImputerTask task = {imputer, dataset};
+    parallel_for(dataset->cols, exact_quantile_task, &task);
+}
+
+/**
+ * Fonction : partial_fit_imputer
+ * Rôle     : Met à jour l'imputeur avec un lot de lignes (données en flux ou hors mémoire) :
+ *            statistiques de Welford pour la moyenne, sketch KLL pour un quantile approché
+ * Param    : imputer (imputeur en mode moyenne ou approché), batch (lot de lignes)
+ * Retour   : void
+ */
+void partial_fit_imputer(Imputer* imputer, Dataset* batch) {
+    if (imputer->strategy == IMPUTE_CONSTANT) return;
+    if (imputer->strategy != IMPUTE_MEAN && !imputer->approximate) {
+        fprintf(stderr, "partial_fit_imputer requires IMPUTE_MEAN or approximate mode\n");
+        return;
+    }
+    if (imputer->n_features != batch->cols || !imputer->values) {
+        reset_imputer(imputer, batch->cols);
+    }
+
+    if (imputer->strategy == IMPUTE_MEAN) {
+        RunningStats* stats = compute_running_stats(batch);
+        if (imputer->stats) {
+            merge_running_stats(imputer->stats, stats);
+            free_running_stats(stats);
+        } else {
+            imputer->stats = stats;
+        }
+        for (int j = 0; j < imputer->n_features; j++) {
+            imputer->values[j] = (imputer->stats->count[j] > 0) ? imputer->stats->mean[j] : 0.0;
+        }
+        return;
+    }
+
+    if (!imputer->sketches) {
+        imputer->sketches = (QuantileSketch**)safe_malloc(imputer->n_features * sizeof(QuantileSketch*));
+        for (int j = 0; j < imputer->n_features; j++) {
+            imputer->sketches[j] = create_quantile_sketch(SKETCH_K);
+        }
+    }
+
+    ImputerTask task = {imputer, batch};
+    parallel_for(imputer->n_features, sketch_update_task, &task);
+}
+
+/* **************************************************
+ * # --- TRANSFORMATION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : transform_imputer
+ * Rôle     : Remplace les valeurs manquantes (NaN) par les valeurs d'imputation apprises
+ * Param    : imputer (imputeur ajusté), dataset (dataset à traiter, même nombre de features)
+ * Retour   : void
+ */
+void transform_imputer(Imputer* imputer, Dataset* dataset) {
+    if (imputer->n_features != dataset->cols) {
+        fprintf(stderr, "Feature count mismatch: imputer has %d, dataset has %d\n",
+                imputer->n_features, dataset->cols);
+        return;
+    }
+
+    for (int i = 0; i < dataset->rows; i++) {
+        double* row = dataset->data[i];
+        for (int j = 0; j < dataset->cols; j++) {
+            if (isnan(row[j])) row[j] = imputer->values[j];
+        }
+    }
+}
+
+/* **************************************************
+ * # --- SAUVEGARDE/CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : save_imputer
+ * Rôle     : Sauvegarde un imputeur dans un fichier binaire (sketches inclus en mode approché,
+ *            statistiques count/mean/M2 en mode moyenne)
+ * Param    : filename (nom du fichier de destination), imputer (imputeur à sauvegarder)
+ * Retour   : void
+ */
+void save_imputer(const char* filename, Imputer* imputer) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+
+    int header[3] = {(int)imputer->strategy, imputer->approximate, imputer->n_features};
+    int has_sketches = imputer->sketches != NULL;
+    fwrite(header, sizeof(int), 3, file);
+    fwrite(&imputer->quantile, sizeof(double), 1, file);
+    fwrite(&imputer->fill_value, sizeof(double), 1, file);
+    fwrite(imputer->values, sizeof(double), imputer->n_features, file);
+    fwrite(&has_sketches, sizeof(int), 1, file);
+    for (int j = 0; j < imputer->n_features && has_sketches; j++) {
+        write_quantile_sketch(file, imputer->sketches[j]);
+    }
+
+    // En fin de fichier : un fichier antérieur (sans statistiques) reste lisible
+    int has_stats = imputer->stats != NULL;
+    fwrite(&has_stats, sizeof(int), 1, file);
+    if (has_stats) write_running_stats(file, imputer->stats);
+
+    fclose(file);
+}
+
+/**
+ * Fonction : load_imputer
+ * Rôle     : Charge un imputeur depuis un fichier binaire
+ * Param    : filename (nom du fichier source)
+ * Retour   : Imputer* (imputeur chargé, NULL en cas d'erreur)
+ */
+Imputer* load_imputer(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+
+    int header[3];
+    double quantile, fill_value;
+    if (fread(header, sizeof(int), 3, file) != 3 || header[2] <= 0 || header[2] > 100000 ||
+        fread(&quantile, sizeof(double), 1, file) != 1 || fread(&fill_value, sizeof(double), 1, file) != 1) {
+        fclose(file);
+        return NULL;
+    }
+
+    Imputer* imputer = create_imputer((ImputeStrategy)header[0], quantile, fill_value, header[1]);
+    imputer->quantile = quantile;
+    reset_imputer(imputer, header[2]);
+
+    int has_sketches = 0;
+    int valid = fread(imputer->values, sizeof(double), imputer->n_features, file) == (size_t)imputer->n_features &&
+                fread(&has_sketches, sizeof(int), 1, file) == 1;
+
+    if (valid && has_sketches) {
+        imputer->sketches = (QuantileSketch**)safe_calloc(imputer->n_features, sizeof(QuantileSketch*));
+        for (int j = 0; j < imputer->n_features && valid; j++) {
+            imputer->sketches[j] = read_quantile_sketch(file);
+            valid = imputer->sketches[j] != NULL;
+        }
+    }
+
+    // Statistiques de Welford (IMPUTE_MEAN) : partial_fit_imputer reprend l'historique au lieu de repartir du lot
+    int has_stats = 0;
+    if (valid && fread(&has_stats, sizeof(int), 1, file) == 1 && has_stats) {
+        imputer->stats = read_running_stats(file);
+        valid = imputer->stats != NULL && imputer->stats->n_features == imputer->n_features;
+    }
+    fclose(file);
+
+    if (!valid) {
+        free_imputer(imputer);
+        return NULL;
+    }
+    return imputer;
+}
+
+/**
+ * Fonction : free_imputer
+ * Rôle     : Libère complètement la mémoire allouée pour un imputeur
+ * Param    : imputer (imputeur à libérer)
+ * Retour   : void
+ */
+void free_imputer(Imputer* imputer) {
+    if (imputer) {
+        if (imputer->sketches) {
+            for (int j = 0; j < imputer->n_features; j++) {
+                free_quantile_sketch(imputer->sketches[j]);
+            }
+            safe_free(imputer->sketches);
+        }
+        free_running_stats(imputer->stats);
+        safe_free(imputer->values);
+        safe_free(imputer);
+    }
+}
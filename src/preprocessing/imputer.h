@@ -0,0 +1,57 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/imputer.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le module d'imputation des valeurs manquantes
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef IMPUTER_H
+#define IMPUTER_H
+
+#include "../utils/csv_parser.h"
+#include "../utils/quantile_sketch.h"
+#include "scaler.h"
+
+typedef enum {
+    IMPUTE_MEAN,
+    IMPUTE_MEDIAN,
+    IMPUTE_QUANTILE,
+    IMPUTE_CONSTANT
+} ImputeStrategy;
+
+/*
+ * Imputeur ajusté sur le train uniquement puis appliqué au train, au test et au scoring.
+ * Mode exact : sélection linéaire (introselect) sur les valeurs présentes de chaque feature.
+ * Mode approché : un sketch KLL par feature, alimenté par lots (partial_fit_imputer) et fusionnable.
+ * La moyenne s'accumule par lots avec les statistiques de Welford.
+ */
+typedef struct {
+    ImputeStrategy strategy;
+    double quantile;              // Quantile imputé (IMPUTE_QUANTILE ; 0.5 pour IMPUTE_MEDIAN)
+    double fill_value;            // Valeur imputée (IMPUTE_CONSTANT)
+    int approximate;              // 1 = sketch KLL au lieu de la sélection exacte
+    int n_features;
+    double* values;               // [n_features] valeurs d'imputation apprises
+    QuantileSketch** sketches;    // [n_features] (mode approché, NULL sinon)
+    RunningStats* stats;          // Statistiques cumulées (IMPUTE_MEAN, NULL sinon)
+} Imputer;
+
+Imputer* create_imputer(ImputeStrategy strategy, double quantile, double fill_value, int approximate);
+void fit_imputer(Imputer* imputer, Dataset* dataset);
+void partial_fit_imputer(Imputer* imputer, Dataset* batch);
+void transform_imputer(Imputer* imputer, Dataset* dataset);
+void save_imputer(const char* filename, Imputer* imputer);
+Imputer* load_imputer(const char* filename);
+void free_imputer(Imputer* imputer);
+
+#endif
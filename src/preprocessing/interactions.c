@@ -0,0 +1,241 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/interactions.c
+
+Rôle : Features d'interaction (termes croisés et carrés), matérialisées ou calculées à la volée
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "interactions.h"
+#include "../utils/memory_manager.h"
+#include "../utils/utils.h"
+#include <stdio.h>
+
+/* **************************************************
+ * # --- DÉFINITION DES INTERACTIONS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_interactions
+ * Rôle     : Crée une liste d'interactions vide
+ * Param    : n_input (nombre de features d'origine)
+ * Retour   : Interactions* (liste vide)
+ */
+Interactions* create_interactions(int n_input) {
+    Interactions* interactions = (Interactions*)safe_malloc(sizeof(Interactions));
+    interactions->n_input = n_input;
+    interactions->n_pairs = 0;
+    interactions->capacity = 8;
+    interactions->left = (int*)safe_malloc(interactions->capacity * sizeof(int));
+    interactions->right = (int*)safe_malloc(interactions->capacity * sizeof(int));
+    return interactions;
+}
+
+/**
+ * Fonction : add_interaction
+ * Rôle     : Ajoute le terme croisé x[left] * x[right]
+ * Param    : interactions (liste), left, right (index des features d'origine, égaux pour un carré)
+ * Retour   : int (index de la colonne créée dans l'espace de sortie, -1 si un index est invalide)
+ */
+int add_interaction(Interactions* interactions, int left, int right) {
+    if (left < 0 || right < 0 || left >= interactions->n_input || right >= interactions->n_input) {
+        fprintf(stderr, "Invalid interaction (%d, %d) for %d features\n", left, right, interactions->n_input);
+        return -1;
+    }
+    if (interactions->n_pairs == interactions->capacity) {
+        interactions->capacity *= 2;
+        interactions->left = (int*)safe_realloc(interactions->left, interactions->capacity * sizeof(int));
+        interactions->right = (int*)safe_realloc(interactions->right, interactions->capacity * sizeof(int));
+    }
+    interactions->left[interactions->n_pairs] = left;
+    interactions->right[interactions->n_pairs] = right;
+    return interactions->n_input + interactions->n_pairs++;
+}
+
+/**
+ * Fonction : create_degree2_interactions
+ * Rôle     : Crée toutes les interactions de degré 2 (n(n-1)/2 paires, plus n carrés si demandé)
+ * Param    : n_input (nombre de features d'origine), include_squares (1 = ajoute les carrés x[j]^2)
+ * Retour   : Interactions* (liste complète)
+ */
+Interactions* create_degree2_interactions(int n_input, int include_squares) {
+    Interactions* interactions = create_interactions(n_input);
+    for (int a = 0; a < n_input; a++) {
+        for (int b = include_squares ? a : a + 1; b < n_input; b++) {
+            add_interaction(interactions, a, b);
+        }
+    }
+    return interactions;
+}
+
+/**
+ * Fonction : credit_risk_interactions
+ * Rôle     : Interactions demandées par les analystes sur les features Credit Risk :
+ *            person_income x loan_percent_income et loan_grade x loan_int_rate, colonnes retrouvées par
+ *            leur nom dans le schéma (un schéma réordonné garde les bons termes croisés)
+ * Param    : schema (schéma du dataset chargé)
+ * Retour   : Interactions* (2 interactions sur schema->n_features features, NULL si une colonne manque)
+ */
+Interactions* credit_risk_interactions(Schema* schema) {
+    static const char* pairs[][2] = {
+        {"person_income", "loan_percent_income"},
+        {"loan_grade", "loan_int_rate"}
+    };
+    int n_pairs = (int)(sizeof(pairs) / sizeof(pairs[0]));
+
+    Interactions* interactions = create_interactions(schema->n_features);
+    for (int p = 0; p < n_pairs; p++) {
+        int left = schema_feature_index(schema, pairs[p][0]);
+        int right = schema_feature_index(schema, pairs[p][1]);
+        if (left < 0 || right < 0) {
+            fprintf(stderr, "Missing schema feature for interaction: %s x %s\n", pairs[p][0], pairs[p][1]);
+            free_interactions(interactions);
+            return NULL;
+        }
+        add_interaction(interactions, left, right);
+    }
+    return interactions;
+}
+
+/**
+ * Fonction : interactions_output_size
+ * Rôle     : Nombre de colonnes de l'espace de sortie (features d'origine + interactions)
+ * Param    : interactions (liste)
+ * Retour   : int (n_input + n_pairs)
+ */
+int interactions_output_size(Interactions* interactions) {
+    return interactions->n_input + interactions->n_pairs;
+}
+
+/* **************************************************
+ * # --- MATÉRIALISATION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : expand_interactions_row
+ * Rôle     : Écrit une ligne étendue : features d'origine puis termes croisés
+ * Param    : interactions (liste), x (ligne d'origine [n_input]), out (sortie [n_input + n_pairs])
+ * Retour   : void
+ */
+void expand_interactions_row(Interactions* interactions, const double* x, double* out) {
+    for (int j = 0; j < interactions->n_input; j++) {
+        out[j] = x[j];
+    }
+    for (int p = 0; p < interactions->n_pairs; p++) {
+        out[interactions->n_input + p] = x[interactions->left[p]] * x[interactions->right[p]];
+    }
+}
+
+/**
+ * Fonction : materialize_interactions
+ * Rôle     : Construit un nouveau dataset contenant les features d'origine et les interactions
+ *            (degré 2 complet sur 11 features : 77 colonnes au lieu de 11)
+ * Param    : interactions (liste), dataset (dataset source, n_input colonnes)
+ * Retour   : Dataset* (dataset étendu, NULL si le nombre de features diffère)
+ */
+Dataset* materialize_interactions(Interactions* interactions, Dataset* dataset) {
+    if (dataset->cols != interactions->n_input) {
+        fprintf(stderr, "Feature count mismatch: interactions expect %d, dataset has %d\n",
+                interactions->n_input, dataset->cols);
+        return NULL;
+    }
+
+    Dataset* expanded = (Dataset*)safe_malloc(sizeof(Dataset));
+    expanded->rows = dataset->rows;
+    expanded->cols = interactions_output_size(interactions);
+    expanded->data = allocate_matrix(dataset->rows, expanded->cols);
+    expanded->labels = (int*)safe_malloc((dataset->rows > 0 ? dataset->rows : 1) * sizeof(int));
+    for (int i = 0; i < dataset->rows; i++) {
+        expand_interactions_row(interactions, dataset->data[i], expanded->data[i]);
+        expanded->labels[i] = dataset->labels[i];
+    }
+    return expanded;
+}
+
+/* **************************************************
+ * # --- SAUVEGARDE/CHARGEMENT --- #
+ * ************************************************** */
+
+/**
+ * Fonction : save_interactions
+ * Rôle     : Sauvegarde une liste d'interactions dans un fichier binaire
+ * Param    : filename (nom du fichier de destination), interactions (liste à sauvegarder)
+ * Retour   : void
+ */
+void save_interactions(const char* filename, Interactions* interactions) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+
+    fwrite(&interactions->n_input, sizeof(int), 1, file);
+    fwrite(&interactions->n_pairs, sizeof(int), 1, file);
+    fwrite(interactions->left, sizeof(int), interactions->n_pairs, file);
+    fwrite(interactions->right, sizeof(int), interactions->n_pairs, file);
+
+    fclose(file);
+}
+
+/**
+ * Fonction : load_interactions
+ * Rôle     : Charge une liste d'interactions depuis un fichier binaire
+ * Param    : filename (nom du fichier source)
+ * Retour   : Interactions* (liste chargée, NULL en cas d'erreur)
+ */
+Interactions* load_interactions(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+
+    int n_input, n_pairs;
+    if (fread(&n_input, sizeof(int), 1, file) != 1 || fread(&n_pairs, sizeof(int), 1, file) != 1 ||
+        n_input <= 0 || n_pairs < 0 || n_pairs > 1000000) {
+        fclose(file);
+        return NULL;
+    }
+
+    Interactions* interactions = create_interactions(n_input);
+    int* left = (int*)safe_malloc((n_pairs > 0 ? n_pairs : 1) * sizeof(int));
+    int* right = (int*)safe_malloc((n_pairs > 0 ? n_pairs : 1) * sizeof(int));
+    int valid = fread(left, sizeof(int), n_pairs, file) == (size_t)n_pairs &&
+                fread(right, sizeof(int), n_pairs, file) == (size_t)n_pairs;
+    fclose(file);
+
+    for (int p = 0; p < n_pairs && valid; p++) {
+        valid = add_interaction(interactions, left[p], right[p]) >= 0;
+    }
+    safe_free(left);
+    safe_free(right);
+
+    if (!valid) {
+        free_interactions(interactions);
+        return NULL;
+    }
+    return interactions;
+}
+
+/**
+ * Fonction : free_interactions
+ * Rôle     : Libère complètement la mémoire allouée pour une liste d'interactions
+ * Param    : interactions (liste à libérer)
+ * Retour   : void
+ */
+void free_interactions(Interactions* interactions) {
+    if (interactions) {
+        safe_free(interactions->left);
+        safe_free(interactions->right);
+        safe_free(interactions);
+    }
+}
@@ -0,0 +1,49 @@
+/*****************************************************************************************************
+
+Nom : src/preprocessing/interactions.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour les features d'interaction (termes croisés)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef INTERACTIONS_H
+#define INTERACTIONS_H
+
+#include "../utils/csv_parser.h"
+#include "../data/schema.h"
+
+/*
+ * Liste de termes croisés x[left[p]] * x[right[p]] (left == right pour un carré).
+ * Espace de sortie : les n_input features d'origine puis les n_pairs interactions, dans cet ordre.
+ * Les interactions peuvent être matérialisées (materialize_interactions) ou calculées à la volée
+ * depuis la ligne brute dans le noyau de la régression logistique (train/score_*_interactions).
+ */
+typedef struct {
+    int n_input;      // Nombre de features d'origine
+    int n_pairs;
+    int capacity;
+    int* left;        // [n_pairs]
+    int* right;       // [n_pairs]
+} Interactions;
+
+Interactions* create_interactions(int n_input);
+int add_interaction(Interactions* interactions, int left, int right);
+Interactions* create_degree2_interactions(int n_input, int include_squares);
+Interactions* credit_risk_interactions(Schema* schema);
+int interactions_output_size(Interactions* interactions);
+void expand_interactions_row(Interactions* interactions, const double* x, double* out);
+Dataset* materialize_interactions(Interactions* interactions, Dataset* dataset);
+void save_interactions(const char* filename, Interactions* interactions);
+Interactions* load_interactions(const char* filename);
+void free_interactions(Interactions* interactions);
+
+#endif
@@ -16,6 +16,7 @@ Usage : Pour compiler : make
 ******************************************************************************************************/
 
 #include "preprocessing.h"
+#include "../utils/memory_manager.h"
 #include <math.h>
 
 /* **************************************************
@@ -23,34 +24,52 @@ Usage : Pour compiler : make
  * ************************************************** */
 
 /**
- * Fonction : handle_missing_values
- * Rôle     : Remplace les valeurs manquantes (NaN) par la moyenne de chaque colonne
- * Param    : dataset (dataset à traiter)
- * Retour   : void
+ * Fonction : fit_missing_values
+ * Rôle     : Calcule la valeur d'imputation (moyenne des valeurs présentes) de chaque colonne
+ * Param    : dataset (dataset de référence)
+ * Retour   : double* (valeurs d'imputation [cols], 0 pour une colonne entièrement manquante)
  */
-void handle_missing_values(Dataset* dataset) {
-    // Replace NaN with column mean
+double* fit_missing_values(Dataset* dataset) {
+    // Moyennes des valeurs présentes (une passe parallèle, NaN ignorés)
+    RunningStats* stats = compute_running_stats(dataset);
+    double* impute_values = (double*)safe_malloc(dataset->cols * sizeof(double));
+    
     for (int j = 0; j < dataset->cols; j++) {
-        double sum = 0.0;
-        int count = 0;
-        
-        for (int i = 0; i < dataset->rows; i++) {
-            if (!isnan(dataset->data[i][j])) {
-                sum += dataset->data[i][j];
-                count++;
-            }
-        }
-        
-        double mean = (count > 0) ? sum / count : 0.0;
-        
-        for (int i = 0; i < dataset->rows; i++) {
+        impute_values[j] = (stats->count[j] > 0) ? stats->mean[j] : 0.0;
+    }
+    
+    free_running_stats(stats);
+    return impute_values;
+}
+
+/**
+ * Fonction : apply_missing_values
+ * Rôle     : Remplace les valeurs manquantes (NaN) par les valeurs d'imputation fournies
+ * Param    : dataset (dataset à traiter), impute_values (valeur d'imputation de chaque colonne)
+ * Retour   : void
+ */
+void apply_missing_values(Dataset* dataset, double* impute_values) {
+    for (int i = 0; i < dataset->rows; i++) {
+        for (int j = 0; j < dataset->cols; j++) {
             if (isnan(dataset->data[i][j])) {
-                dataset->data[i][j] = mean;
+                dataset->data[i][j] = impute_values[j];
             }
         }
     }
 }
 
+/**
+ * Fonction : handle_missing_values
+ * Rôle     : Remplace les valeurs manquantes (NaN) par la moyenne de chaque colonne
+ * Param    : dataset (dataset à traiter)
+ * Retour   : void
+ */
+void handle_missing_values(Dataset* dataset) {
+    double* impute_values = fit_missing_values(dataset);
+    apply_missing_values(dataset, impute_values);
+    safe_free(impute_values);
+}
+
 /**
  * Fonction : normalize_features
  * Rôle     : Normalise les features d'un dataset à l'aide d'un scaler préalablement ajusté
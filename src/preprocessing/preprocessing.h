@@ -22,6 +22,8 @@ Usage : Pour compiler : make
 #include "scaler.h"
 
 void handle_missing_values(Dataset* dataset);
+double* fit_missing_values(Dataset* dataset);
+void apply_missing_values(Dataset* dataset, double* impute_values);
 void normalize_features(Dataset* dataset, Scaler* scaler);
 Dataset* preprocess_dataset(Dataset* dataset);
 
@@ -18,9 +18,240 @@ Usage : Pour compiler : make
 #include "scaler.h"
 #include "../utils/memory_manager.h"
 #include "../utils/utils.h"
+#include "../utils/parallel.h"
 #include <math.h>
 #include <stdio.h>
 
+#define STATS_CHUNK_ROWS 4096
+#define TRANSFORM_CHUNK_ROWS 1024
+
+typedef struct {
+    Dataset* dataset;
+    RunningStats** partials;
+} StatsJob;
+
+typedef struct {
+    Dataset* dataset;
+    const double* mean;
+    double* inv_std;      // 1 / std, calculé une fois par transformation
+    double** out_rows;    // Lignes de sortie double (égales aux lignes d'entrée en place)
+    float* out_f32;       // Sortie float32 contiguë [rows * cols] (NULL sinon)
+} TransformJob;
+
+/* **************************************************
+ * # --- STATISTIQUES INCRÉMENTALES (WELFORD) --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_running_stats
+ * Rôle     : Crée un accumulateur de statistiques vide
+ * Param    : n_features (nombre de features)
+ * Retour   : RunningStats* (accumulateur initialisé à zéro)
+ */
+RunningStats* create_running_stats(int n_features) {
+    RunningStats* stats = (RunningStats*)safe_malloc(sizeof(RunningStats));
+    stats->n_features = n_features;
+    stats->count = (long*)safe_calloc(n_features, sizeof(long));
+    stats->mean = (double*)safe_calloc(n_features, sizeof(double));
+    stats->m2 = (double*)safe_calloc(n_features, sizeof(double));
+    return stats;
+}
+
+/**
+ * Fonction : update_running_stats
+ * Rôle     : Intègre un bloc de lignes dans l'accumulateur en une seule passe (algorithme de Welford, NaN ignorés)
+ * Param    : stats (accumulateur), rows (lignes à intégrer), n_rows (nombre de lignes)
+ * Retour   : void
+ */
+void update_running_stats(RunningStats* stats, double** rows, int n_rows) {
+    for (int i = 0; i < n_rows; i++) {
+        const double* row = rows[i];
+        for (int j = 0; j < stats->n_features; j++) {
+            double x = row[j];
+            if (isnan(x)) continue;
+            stats->count[j]++;
+            double delta = x - stats->mean[j];
+            stats->mean[j] += delta / stats->count[j];
+            stats->m2[j] += delta * (x - stats->mean[j]);
+        }
+    }
+}
+
+/**
+ * Fonction : merge_running_stats
+ * Rôle     : Fusionne deux accumulateurs (formule parallèle de Chan) ; le résultat est placé dans dst
+ * Param    : dst (accumulateur de destination), src (accumulateur à intégrer, inchangé)
+ * Retour   : void
+ */
+void merge_running_stats(RunningStats* dst, RunningStats* src) {
+    for (int j = 0; j < dst->n_features; j++) {
+        if (src->count[j] == 0) continue;
+        if (dst->count[j] == 0) {
+            dst->count[j] = src->count[j];
+            dst->mean[j] = src->mean[j];
+            dst->m2[j] = src->m2[j];
+            continue;
+        }
+        
+        double n_a = (double)dst->count[j];
+        double n_b = (double)src->count[j];
+        double n = n_a + n_b;
+        double delta = src->mean[j] - dst->mean[j];
+        
+        dst->mean[j] += delta * n_b / n;
+        dst->m2[j] += src->m2[j] + delta * delta * n_a * n_b / n;
+        dst->count[j] += src->count[j];
+    }
+}
+
+/**
+ * Fonction : stats_chunk_task
+ * Rôle     : Tâche parallèle : calcule les statistiques d'un bloc de STATS_CHUNK_ROWS lignes
+ * Param    : task (index du bloc), context (StatsJob partagé)
+ * Retour   : void
+ */
+static void stats_chunk_task(int task, void* context) {
+    StatsJob* job = (StatsJob*)context;
+    int start = task * STATS_CHUNK_ROWS;
+    int end = start + STATS_CHUNK_ROWS;
+    if (end > job->dataset->rows) end = job->dataset->rows;
+    
+    job->partials[task] = create_running_stats(job->dataset->cols);
+    update_running_stats(job->partials[task], job->dataset->data + start, end - start);
+}
+
+/**
+ * Fonction : compute_running_stats
+ * Rôle     : Calcule les statistiques d'un dataset par blocs traités en parallèle, fusionnés dans l'ordre
+ *            (résultat indépendant du nombre de threads)
+ * Param    : dataset (dataset à analyser)
+ * Retour   : RunningStats* (statistiques de toutes les lignes)
+ */
+RunningStats* compute_running_stats(Dataset* dataset) {
+    int n_chunks = (dataset->rows + STATS_CHUNK_ROWS - 1) / STATS_CHUNK_ROWS;
+    RunningStats* stats = create_running_stats(dataset->cols);
+    if (n_chunks == 0) return stats;
+    
+    StatsJob job;
+    job.dataset = dataset;
+    job.partials = (RunningStats**)safe_malloc(n_chunks * sizeof(RunningStats*));
+    
+    parallel_for(n_chunks, stats_chunk_task, &job);
+    
+    for (int c = 0; c < n_chunks; c++) {
+        merge_running_stats(stats, job.partials[c]);
+        free_running_stats(job.partials[c]);
+    }
+    
+    safe_free(job.partials);
+    return stats;
+}
+
+/**
+ * Fonction : scaler_from_running_stats
+ * Rôle     : Construit un scaler (moyenne, écart-type de population) à partir de statistiques accumulées
+ * Param    : stats (statistiques accumulées)
+ * Retour   : Scaler* (scaler ajusté)
+ */
+Scaler* scaler_from_running_stats(RunningStats* stats) {
+    Scaler* scaler = (Scaler*)safe_malloc(sizeof(Scaler));
+    scaler->n_features = stats->n_features;
+    scaler->mean = allocate_vector(stats->n_features);
+    scaler->std = allocate_vector(stats->n_features);
+    
+    for (int j = 0; j < stats->n_features; j++) {
+        scaler->mean[j] = stats->mean[j];
+        scaler->std[j] = stats->count[j] > 0 ? sqrt(stats->m2[j] / stats->count[j]) : 0.0;
+        if (scaler->std[j] < 1e-8) scaler->std[j] = 1.0;
+    }
+    
+    return scaler;
+}
+
+/**
+ * Fonction : write_running_stats
+ * Rôle     : Écrit des statistiques accumulées dans un flux ouvert (format texte : n_features puis
+ *            "count mean m2" par feature, %.17g pour une relecture exacte)
+ * Param    : file (flux de destination), stats (statistiques à écrire)
+ * Retour   : void
+ */
+void write_running_stats(FILE* file, RunningStats* stats) {
+    fprintf(file, "%d\n", stats->n_features);
+    for (int j = 0; j < stats->n_features; j++) {
+        fprintf(file, "%ld %.17g %.17g\n", stats->count[j], stats->mean[j], stats->m2[j]);
+    }
+}
+
+/**
+ * Fonction : read_running_stats
+ * Rôle     : Lit des statistiques écrites par write_running_stats depuis un flux ouvert
+ * Param    : file (flux source)
+ * Retour   : RunningStats* (statistiques lues, NULL en cas d'erreur)
+ */
+RunningStats* read_running_stats(FILE* file) {
+    int n_features;
+    if (fscanf(file, "%d", &n_features) != 1 || n_features < 0) return NULL;
+    
+    RunningStats* stats = create_running_stats(n_features);
+    for (int j = 0; j < n_features; j++) {
+        if (fscanf(file, "%ld %lf %lf", &stats->count[j], &stats->mean[j], &stats->m2[j]) != 3) {
+            free_running_stats(stats);
+            return NULL;
+        }
+    }
+    return stats;
+}
+
+/**
+ * Fonction : save_running_stats
+ * Rôle     : Sauvegarde des statistiques accumulées dans un fichier texte (pour fusion ultérieure)
+ * Param    : filename (nom du fichier de destination), stats (statistiques à sauvegarder)
+ * Retour   : void
+ */
+void save_running_stats(const char* filename, RunningStats* stats) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Cannot create file: %s\n", filename);
+        return;
+    }
+    
+    write_running_stats(file, stats);
+    fclose(file);
+}
+
+/**
+ * Fonction : load_running_stats
+ * Rôle     : Charge des statistiques accumulées depuis un fichier texte
+ * Param    : filename (nom du fichier source)
+ * Retour   : RunningStats* (statistiques chargées, NULL en cas d'erreur)
+ */
+RunningStats* load_running_stats(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open file: %s\n", filename);
+        return NULL;
+    }
+    
+    RunningStats* stats = read_running_stats(file);
+    fclose(file);
+    return stats;
+}
+
+/**
+ * Fonction : free_running_stats
+ * Rôle     : Libère la mémoire allouée pour un accumulateur de statistiques
+ * Param    : stats (accumulateur à libérer)
+ * Retour   : void
+ */
+void free_running_stats(RunningStats* stats) {
+    if (stats) {
+        safe_free(stats->count);
+        safe_free(stats->mean);
+        safe_free(stats->m2);
+        safe_free(stats);
+    }
+}
+
 /* **************************************************
  * # --- NORMALISATION STANDARDSCALER --- #
  * ************************************************** */
@@ -28,50 +259,131 @@ Usage : Pour compiler : make
 /**
  * Fonction : fit_scaler
  * Rôle     : Calcule la moyenne et l'écart-type de chaque feature pour la normalisation
+ *            (une seule passe par lignes, blocs traités en parallèle)
  * Param    : dataset (dataset d'entraînement pour calculer les statistiques)
  * Retour   : Scaler* (scaler ajusté contenant moyenne et écart-type)
  */
 Scaler* fit_scaler(Dataset* dataset) {
-    Scaler* scaler = (Scaler*)safe_malloc(sizeof(Scaler));
-    scaler->n_features = dataset->cols;
-    scaler->mean = allocate_vector(dataset->cols);
-    scaler->std = allocate_vector(dataset->cols);
+    RunningStats* stats = compute_running_stats(dataset);
+    Scaler* scaler = scaler_from_running_stats(stats);
+    free_running_stats(stats);
+    return scaler;
+}
+
+/**
+ * Fonction : standardize_row
+ * Rôle     : Normalise une ligne (x' = (x - mean) * inv_std), boucle sans dépendance vectorisable ; out peut valoir x
+ * Param    : x (ligne source), mean (moyennes), inv_std (inverses des écarts-types), out (ligne destination), cols (nombre de features)
+ * Retour   : void
+ */
+static inline void standardize_row(const double* x, const double* mean, const double* inv_std, double* out, int cols) {
+    for (int j = 0; j < cols; j++) {
+        out[j] = (x[j] - mean[j]) * inv_std[j];
+    }
+}
+
+/**
+ * Fonction : standardize_row_f32
+ * Rôle     : Normalise une ligne et la convertit en float32 dans la même passe
+ * Param    : x (ligne source), mean (moyennes), inv_std (inverses des écarts-types), out (ligne float32), cols (nombre de features)
+ * Retour   : void
+ */
+static inline void standardize_row_f32(const double* restrict x, const double* restrict mean,
+                                       const double* restrict inv_std, float* restrict out, int cols) {
+    for (int j = 0; j < cols; j++) {
+        out[j] = (float)((x[j] - mean[j]) * inv_std[j]);
+    }
+}
+
+/**
+ * Fonction : transform_chunk_task
+ * Rôle     : Tâche parallèle : normalise un bloc de TRANSFORM_CHUNK_ROWS lignes vers la sortie du job
+ * Param    : task (index du bloc), context (TransformJob partagé)
+ * Retour   : void
+ */
+static void transform_chunk_task(int task, void* context) {
+    TransformJob* job = (TransformJob*)context;
+    int cols = job->dataset->cols;
+    int start = task * TRANSFORM_CHUNK_ROWS;
+    int end = start + TRANSFORM_CHUNK_ROWS;
+    if (end > job->dataset->rows) end = job->dataset->rows;
     
-    // Calculate mean
-    for (int j = 0; j < dataset->cols; j++) {
-        double sum = 0.0;
-        for (int i = 0; i < dataset->rows; i++) {
-            sum += dataset->data[i][j];
+    for (int i = start; i < end; i++) {
+        if (job->out_f32) {
+            standardize_row_f32(job->dataset->data[i], job->mean, job->inv_std, job->out_f32 + (size_t)i * cols, cols);
+        } else {
+            standardize_row(job->dataset->data[i], job->mean, job->inv_std, job->out_rows[i], cols);
         }
-        scaler->mean[j] = sum / dataset->rows;
+    }
+}
+
+/**
+ * Fonction : run_transform
+ * Rôle     : Normalise toutes les lignes d'un dataset par blocs traités en parallèle
+ * Param    : dataset (dataset source), scaler (scaler ajusté), out_rows (lignes double de sortie ou NULL), out_f32 (sortie float32 ou NULL)
+ * Retour   : void
+ */
+static void run_transform(Dataset* dataset, Scaler* scaler, double** out_rows, float* out_f32) {
+    if (scaler->n_features != dataset->cols) {
+        fprintf(stderr, "Feature count mismatch: scaler has %d, dataset has %d\n",
+                scaler->n_features, dataset->cols);
+        return;
     }
     
-    // Calculate std
+    TransformJob job;
+    job.dataset = dataset;
+    job.mean = scaler->mean;
+    job.inv_std = allocate_vector(dataset->cols);
+    job.out_rows = out_rows;
+    job.out_f32 = out_f32;
     for (int j = 0; j < dataset->cols; j++) {
-        double sum_sq = 0.0;
-        for (int i = 0; i < dataset->rows; i++) {
-            double diff = dataset->data[i][j] - scaler->mean[j];
-            sum_sq += diff * diff;
-        }
-        scaler->std[j] = sqrt(sum_sq / dataset->rows);
-        if (scaler->std[j] < 1e-8) scaler->std[j] = 1.0;
+        job.inv_std[j] = 1.0 / scaler->std[j];
     }
     
-    return scaler;
+    int n_chunks = (dataset->rows + TRANSFORM_CHUNK_ROWS - 1) / TRANSFORM_CHUNK_ROWS;
+    parallel_for(n_chunks, transform_chunk_task, &job);
+    free_vector(job.inv_std);
 }
 
 /**
  * Fonction : transform_dataset
- * Rôle     : Applique la normalisation StandardScaler (x' = (x - mean) / std) à un dataset
+ * Rôle     : Applique la normalisation StandardScaler (x' = (x - mean) / std) à un dataset, en place
+ *            (blocs de lignes traités en parallèle)
  * Param    : dataset (dataset à normaliser), scaler (scaler préalablement ajusté)
  * Retour   : void
  */
 void transform_dataset(Dataset* dataset, Scaler* scaler) {
+    run_transform(dataset, scaler, dataset->data, NULL);
+}
+
+/**
+ * Fonction : transform_dataset_copy
+ * Rôle     : Normalise un dataset vers un nouveau dataset ; les données brutes restent intactes
+ * Param    : dataset (dataset source), scaler (scaler préalablement ajusté)
+ * Retour   : Dataset* (dataset normalisé à libérer avec free_dataset)
+ */
+Dataset* transform_dataset_copy(Dataset* dataset, Scaler* scaler) {
+    Dataset* scaled = (Dataset*)safe_malloc(sizeof(Dataset));
+    scaled->rows = dataset->rows;
+    scaled->cols = dataset->cols;
+    scaled->data = allocate_matrix(dataset->rows, dataset->cols);
+    scaled->labels = (int*)safe_malloc((dataset->rows > 0 ? dataset->rows : 1) * sizeof(int));
     for (int i = 0; i < dataset->rows; i++) {
-        for (int j = 0; j < dataset->cols; j++) {
-            dataset->data[i][j] = (dataset->data[i][j] - scaler->mean[j]) / scaler->std[j];
-        }
+        scaled->labels[i] = dataset->labels[i];
     }
+    
+    run_transform(dataset, scaler, scaled->data, NULL);
+    return scaled;
+}
+
+/**
+ * Fonction : transform_dataset_f32
+ * Rôle     : Normalise un dataset et le convertit en float32 dans la même passe (entrée des noyaux float32)
+ * Param    : dataset (dataset source, inchangé), scaler (scaler ajusté), out (buffer ligne par ligne [rows * cols])
+ * Retour   : void
+ */
+void transform_dataset_f32(Dataset* dataset, Scaler* scaler, float* out) {
+    run_transform(dataset, scaler, NULL, out);
 }
 
 /**
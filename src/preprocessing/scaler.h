@@ -26,8 +26,32 @@ typedef struct {
     int n_features;
 } Scaler;
 
+/*
+ * Statistiques par feature (Welford) fusionnables entre blocs, threads ou partitions (Chan et al.).
+ * Les valeurs NaN sont ignorées.
+ */
+typedef struct {
+    long* count;
+    double* mean;
+    double* m2;       // Somme des carrés des écarts à la moyenne
+    int n_features;
+} RunningStats;
+
+RunningStats* create_running_stats(int n_features);
+void update_running_stats(RunningStats* stats, double** rows, int n_rows);
+void merge_running_stats(RunningStats* dst, RunningStats* src);
+RunningStats* compute_running_stats(Dataset* dataset);
+Scaler* scaler_from_running_stats(RunningStats* stats);
+void write_running_stats(FILE* file, RunningStats* stats);
+RunningStats* read_running_stats(FILE* file);
+void save_running_stats(const char* filename, RunningStats* stats);
+RunningStats* load_running_stats(const char* filename);
+void free_running_stats(RunningStats* stats);
+
 Scaler* fit_scaler(Dataset* dataset);
 void transform_dataset(Dataset* dataset, Scaler* scaler);
+Dataset* transform_dataset_copy(Dataset* dataset, Scaler* scaler);
+void transform_dataset_f32(Dataset* dataset, Scaler* scaler, float* out);
 void save_scaler(const char* filename, Scaler* scaler);
 Scaler* load_scaler(const char* filename);
 void free_scaler(Scaler* scaler);
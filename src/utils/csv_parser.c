@@ -18,9 +18,9 @@ Usage : Pour compiler : make
 #include "csv_parser.h"
 #include "memory_manager.h"
 #include "utils.h"
-#include "../preprocessing/encoder.h"
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
 
 /* **************************************************
  * # --- PARSING CSV --- #
@@ -28,7 +28,8 @@ Usage : Pour compiler : make
 
 /**
  * Fonction : parse_csv_line
- * Rôle     : Parse une ligne CSV en tokens séparés par des virgules
+ * Rôle     : Parse une ligne CSV en tokens séparés par des virgules (les champs vides sont conservés
+ *            comme chaînes vides, sans décaler les colonnes suivantes)
  * Param    : line (ligne CSV à parser), count (pointeur pour stocker le nombre de tokens)
  * Retour   : char** (tableau de chaînes de caractères représentant les tokens)
  */
@@ -37,25 +38,24 @@ char** parse_csv_line(char* line, int* count) {
     char** tokens = (char**)safe_malloc(capacity * sizeof(char*));
     *count = 0;
     
-    char* token = strtok(line, ",");
+    // Remove newline
+    size_t len = strcspn(line, "\r\n");
+    line[len] = '\0';
+    if (len == 0) return tokens;
+    
+    char* token = line;
     while (token) {
         if (*count >= capacity) {
             capacity *= 2;
             tokens = (char**)safe_realloc(tokens, capacity * sizeof(char*));
         }
         
-        // Remove newline
-        size_t len = strlen(token);
-        if (len > 0 && token[len-1] == '\n') {
-            token[len-1] = '\0';
-        }
-        if (len > 1 && token[len-2] == '\r') {
-            token[len-2] = '\0';
-        }
+        char* comma = strchr(token, ',');
+        if (comma) *comma = '\0';
         
         tokens[*count] = strdup(token);
         (*count)++;
-        token = strtok(NULL, ",");
+        token = comma ? comma + 1 : NULL;
     }
     
     return tokens;
@@ -80,7 +80,8 @@ void free_parsed_line(char** tokens, int count) {
 
 /**
  * Fonction : load_csv
- * Rôle     : Charge un dataset depuis un fichier CSV avec encodage catégoriel intégré
+ * Rôle     : Charge un dataset numérique depuis un fichier CSV (les CSV bruts avec colonnes catégorielles
+ *            se chargent avec load_csv_with_schema, seule source des dictionnaires de modalités)
  * Param    : filename (nom du fichier CSV), has_header (1 si en-tête présent), label_col (index de la colonne label)
  * Retour   : Dataset* (structure Dataset contenant les données et labels)
  */
@@ -125,7 +126,7 @@ Dataset* load_csv(const char* filename, int has_header, int label_col) {
     dataset->data = allocate_matrix(dataset->rows, dataset->cols);
     dataset->labels = (int*)safe_malloc(dataset->rows * sizeof(int));
     
-    // Read data avec encodage catégoriel
+    // Read data
     int row = 0;
     while (fgets(buffer, sizeof(buffer), file) && row < dataset->rows) {
         int count;
@@ -136,23 +137,11 @@ Dataset* load_csv(const char* filename, int has_header, int label_col) {
             if (i == label_col) {
                 dataset->labels[row] = atoi(tokens[i]);
             } else {
-                // Encodage spécifique selon la colonne
-                if (i == 2) {
-                    // person_home_ownership (catégoriel)
-                    dataset->data[row][col_idx++] = (double)encode_home_ownership(tokens[i]);
-                } else if (i == 4) {
-                    // loan_intent (catégoriel)
-                    dataset->data[row][col_idx++] = (double)encode_loan_intent(tokens[i]);
-                } else if (i == 5) {
-                    // loan_grade (catégoriel ordinal)
-                    dataset->data[row][col_idx++] = (double)encode_loan_grade(tokens[i]);
-                } else if (i == 10) {
-                    // cb_person_default_on_file (catégoriel)
-                    dataset->data[row][col_idx++] = (double)encode_default_on_file(tokens[i]);
-                } else {
-                    // Colonne numérique standard
-                dataset->data[row][col_idx++] = atof(tokens[i]);
-                }
+                // Colonne numérique (champ vide ou non numérique -> NaN, imputé plus tard) ; les colonnes
+                // catégorielles brutes passent par le schéma (load_csv_with_schema)
+                char* end;
+                double value = strtod(tokens[i], &end);
+                dataset->data[row][col_idx++] = (end != tokens[i] && *end == '\0') ? value : NAN;
             }
         }
         
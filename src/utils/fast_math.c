@@ -0,0 +1,141 @@
+/*****************************************************************************************************
+
+Nom : src/utils/fast_math.c
+
+Rôle : Noyaux vectorisables pour la sigmoïde et la log-loss, avec approximations rapides de exp/log
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "fast_math.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+#define INV_LN2 1.44269504088896338700e+00
+#define SQRT2 1.41421356237309504880e+00
+
+/* **************************************************
+ * # --- APPROXIMATIONS EXP/LOG --- #
+ * ************************************************** */
+
+/*
+ * Les fonctions ci-dessous n'ont aucun branchement dépendant des données
+ * (bornes par min/max, exposant construit par manipulation de bits) afin que
+ * les boucles de sigmoid_batch/log_loss_batch soient vectorisables par le compilateur.
+ */
+
+/**
+ * Fonction : fast_exp
+ * Rôle     : Approxime exp(x) par réduction x = k*ln2 + r (|r| <= ln2/2) et polynôme de degré 6 en r
+ * Param    : x (valeur d'entrée, bornée à [-708, 708])
+ * Retour   : double (exp(x), erreur relative max 2e-7)
+ */
+double fast_exp(double x) {
+    x = x < -708.0 ? -708.0 : (x > 708.0 ? 708.0 : x);
+
+    double kf = floor(x * INV_LN2 + 0.5);
+    double r = (x - kf * LN2_HI) - kf * LN2_LO;
+
+    // Horner : 1 + r + r^2/2! + ... + r^6/6!
+    double p = 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    int64_t bits = ((int64_t)kf + 1023) << 52;
+    double scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+/**
+ * Fonction : fast_log
+ * Rôle     : Approxime log(x) par x = m * 2^e (m dans [sqrt(2)/2, sqrt(2)[) et série atanh de degré 9
+ * Param    : x (valeur strictement positive et normalisée)
+ * Retour   : double (log(x), erreur absolue max 1e-9)
+ */
+double fast_log(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    int64_t e = (int64_t)((bits >> 52) & 0x7ff) - 1023;
+    uint64_t mant_bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+    double m;
+    memcpy(&m, &mant_bits, sizeof(m));
+
+    // Ramène m dans [sqrt(2)/2, sqrt(2)[
+    int shift = m > SQRT2;
+    m = shift ? m * 0.5 : m;
+    e += shift;
+
+    // log(m) = 2 * atanh(s), s = (m - 1) / (m + 1), |s| <= 0.1716
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double p = 1.0 / 9.0;
+    p = p * s2 + 1.0 / 7.0;
+    p = p * s2 + 1.0 / 5.0;
+    p = p * s2 + 1.0 / 3.0;
+    p = p * s2 + 1.0;
+
+    return 2.0 * s * p + (double)e * LN2_HI + (double)e * LN2_LO;
+}
+
+/* **************************************************
+ * # --- NOYAUX PAR LOTS --- #
+ * ************************************************** */
+
+/**
+ * Fonction : sigmoid_batch
+ * Rôle     : Calcule la sigmoïde 1/(1+exp(-z)) pour un tableau de marges
+ * Param    : z (marges), out (sortie, peut être égal à z), n (nombre de valeurs), mode (MATH_EXACT ou MATH_FAST)
+ * Retour   : void
+ */
+void sigmoid_batch(const double* z, double* out, int n, MathMode mode) {
+    if (mode == MATH_FAST) {
+        for (int i = 0; i < n; i++) {
+            out[i] = 1.0 / (1.0 + fast_exp(-z[i]));
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            out[i] = 1.0 / (1.0 + exp(-z[i]));
+        }
+    }
+}
+
+/**
+ * Fonction : log_loss_batch
+ * Rôle     : Calcule la somme des cross-entropies -(y*log(p) + (1-y)*log(1-p)) avec un seul log par ligne
+ * Param    : probas (probabilités prédites), labels (labels 0/1), n (nombre de valeurs), mode (MATH_EXACT ou MATH_FAST)
+ * Retour   : double (somme des pertes, non moyennée)
+ */
+double log_loss_batch(const double* probas, const int* labels, int n, MathMode mode) {
+    double total = 0.0;
+
+    if (mode == MATH_FAST) {
+        for (int i = 0; i < n; i++) {
+            double q = labels[i] ? probas[i] : 1.0 - probas[i];
+            total -= fast_log(q + 1e-15);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            double q = labels[i] ? probas[i] : 1.0 - probas[i];
+            total -= log(q + 1e-15);
+        }
+    }
+
+    return total;
+}
@@ -0,0 +1,37 @@
+/*****************************************************************************************************
+
+Nom : src/utils/fast_math.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour les noyaux sigmoïde/log-loss (modes exact et rapide)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+/*
+ * MATH_FAST : approximations polynomiales sans appel à libm
+ *   fast_exp : erreur relative max 2e-7 sur [-708, 708]
+ *   fast_log : erreur absolue max 1e-9 sur ]0, +inf[
+ *   sigmoïde : erreur absolue max 5e-8
+ */
+typedef enum {
+    MATH_EXACT,
+    MATH_FAST
+} MathMode;
+
+double fast_exp(double x);
+double fast_log(double x);
+void sigmoid_batch(const double* z, double* out, int n, MathMode mode);
+double log_loss_batch(const double* probas, const int* labels, int n, MathMode mode);
+
+#endif
@@ -0,0 +1,149 @@
+/*****************************************************************************************************
+
+Nom : src/utils/parallel.c
+
+Rôle : Exécution parallèle de tâches indépendantes sur un ensemble de threads POSIX
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "parallel.h"
+#include "memory_manager.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static int configured_threads = 0;  // 0 = déterminé automatiquement
+static pthread_key_t region_key;    // Non NULL dans une tâche de parallel_for
+static pthread_once_t region_once = PTHREAD_ONCE_INIT;
+
+typedef struct {
+    ParallelTask task;
+    void* context;
+    int n_tasks;
+    int next_task;
+    pthread_mutex_t lock;
+} TaskQueue;
+
+/* **************************************************
+ * # --- CONFIGURATION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : get_num_threads
+ * Rôle     : Retourne le nombre de threads utilisés (set_num_threads, sinon variable CREDIT_RISK_THREADS,
+ *            sinon nombre de cœurs disponibles)
+ * Param    : aucun
+ * Retour   : int (nombre de threads, au moins 1)
+ */
+int get_num_threads(void) {
+    if (configured_threads > 0) return configured_threads;
+
+    const char* env = getenv("CREDIT_RISK_THREADS");
+    if (env && atoi(env) > 0) return atoi(env);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+}
+
+/**
+ * Fonction : set_num_threads
+ * Rôle     : Fixe le nombre de threads utilisés par parallel_for (0 = automatique)
+ * Param    : n_threads (nombre de threads)
+ * Retour   : void
+ */
+void set_num_threads(int n_threads) {
+    configured_threads = n_threads > 0 ? n_threads : 0;
+}
+
+/* **************************************************
+ * # --- EXÉCUTION --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_region_key
+ * Rôle     : Crée la clé de thread marquant l'exécution d'une tâche parallèle (appelée une seule fois)
+ * Param    : aucun
+ * Retour   : void
+ */
+static void create_region_key(void) {
+    pthread_key_create(&region_key, NULL);
+}
+
+/**
+ * Fonction : worker_loop
+ * Rôle     : Boucle d'un thread : récupère et exécute des tâches jusqu'à épuisement de la file
+ * Param    : arg (file de tâches partagée)
+ * Retour   : void* (NULL)
+ */
+static void* worker_loop(void* arg) {
+    TaskQueue* queue = (TaskQueue*)arg;
+
+    pthread_setspecific(region_key, queue);
+    while (1) {
+        pthread_mutex_lock(&queue->lock);
+        int task = queue->next_task++;
+        pthread_mutex_unlock(&queue->lock);
+
+        if (task >= queue->n_tasks) break;
+        queue->task(task, queue->context);
+    }
+    pthread_setspecific(region_key, NULL);
+
+    return NULL;
+}
+
+/**
+ * Fonction : parallel_for
+ * Rôle     : Exécute task(0..n_tasks-1, context) en parallèle ; retourne quand toutes les tâches sont terminées.
+ *            Les tâches doivent écrire dans des zones mémoire distinctes. Appelé depuis une tâche (ex. un fold
+ *            de validation croisée qui normalise ses données), il s'exécute en série dans le thread courant.
+ * Param    : n_tasks (nombre de tâches), task (fonction à exécuter), context (données partagées)
+ * Retour   : void
+ */
+void parallel_for(int n_tasks, ParallelTask task, void* context) {
+    if (n_tasks <= 0) return;
+
+    pthread_once(&region_once, create_region_key);
+    int n_threads = pthread_getspecific(region_key) ? 1 : get_num_threads();
+    if (n_threads > n_tasks) n_threads = n_tasks;
+
+    if (n_threads <= 1) {
+        for (int t = 0; t < n_tasks; t++) {
+            task(t, context);
+        }
+        return;
+    }
+
+    TaskQueue queue;
+    queue.task = task;
+    queue.context = context;
+    queue.n_tasks = n_tasks;
+    queue.next_task = 0;
+    pthread_mutex_init(&queue.lock, NULL);
+
+    // Le thread appelant participe : n_threads - 1 threads supplémentaires
+    pthread_t* threads = (pthread_t*)safe_malloc((n_threads - 1) * sizeof(pthread_t));
+    int started = 0;
+    for (int t = 0; t < n_threads - 1; t++) {
+        if (pthread_create(&threads[t], NULL, worker_loop, &queue) != 0) break;
+        started++;
+    }
+
+    worker_loop(&queue);
+
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    safe_free(threads);
+    pthread_mutex_destroy(&queue.lock);
+}
@@ -0,0 +1,27 @@
+/*****************************************************************************************************
+
+Nom : src/utils/parallel.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le module d'exécution parallèle (pthreads)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+typedef void (*ParallelTask)(int task, void* context);
+
+int get_num_threads(void);
+void set_num_threads(int n_threads);
+void parallel_for(int n_tasks, ParallelTask task, void* context);
+
+#endif
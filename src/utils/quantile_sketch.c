@@ -0,0 +1,445 @@
+/*****************************************************************************************************
+
+Nom : src/utils/quantile_sketch.c
+
+Rôle : Quantiles exacts par sélection en temps linéaire (introselect) et approchés par sketch KLL fusionnable
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "quantile_sketch.h"
+#include "memory_manager.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KLL_MIN_CAPACITY 2
+#define KLL_DECAY (2.0 / 3.0)
+
+/* **************************************************
+ * # --- SÉLECTION EXACTE (INTROSELECT) --- #
+ * ************************************************** */
+
+/**
+ * Fonction : swap_values
+ * Rôle     : Échange deux éléments d'un tableau
+ * Param    : values (tableau), i, j (positions)
+ * Retour   : void
+ */
+static void swap_values(double* values, int i, int j) {
+    double tmp = values[i];
+    values[i] = values[j];
+    values[j] = tmp;
+}
+
+/**
+ * Fonction : partition_values
+ * Rôle     : Partition en trois zones autour de la valeur pivot sur [left, right] (< pivot, == pivot, > pivot),
+ *            ce qui garde la sélection linéaire sur des données très répétées
+ * Param    : values (tableau), left, right (bornes incluses), pivot (valeur pivot),
+ *            equal_start, equal_end (sortie : bornes incluses de la zone égale au pivot)
+ * Retour   : void
+ */
+static void partition_values(double* values, int left, int right, double pivot, int* equal_start, int* equal_end) {
+    int lt = left;
+    int i = left;
+    int gt = right;
+    while (i <= gt) {
+        if (values[i] < pivot) {
+            swap_values(values, lt++, i++);
+        } else if (values[i] > pivot) {
+            swap_values(values, i, gt--);
+        } else {
+            i++;
+        }
+    }
+    *equal_start = lt;
+    *equal_end = gt;
+}
+
+/**
+ * Fonction : insertion_sort_range
+ * Rôle     : Tri par insertion de values[left..right] (petits intervalles)
+ * Param    : values (tableau), left, right (bornes incluses)
+ * Retour   : void
+ */
+static void insertion_sort_range(double* values, int left, int right) {
+    for (int i = left + 1; i <= right; i++) {
+        double v = values[i];
+        int j = i - 1;
+        while (j >= left && values[j] > v) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = v;
+    }
+}
+
+static int select_kth(double* values, int left, int right, int k, int depth_limit);
+
+/**
+ * Fonction : median_of_medians
+ * Rôle     : Pivot garanti (médiane des médianes de groupes de 5), utilisé quand quickselect dégénère
+ * Param    : values (tableau, réordonné), left, right (bornes incluses)
+ * Retour   : int (position du pivot)
+ */
+static int median_of_medians(double* values, int left, int right) {
+    int n = right - left + 1;
+    if (n <= 5) {
+        insertion_sort_range(values, left, right);
+        return left + n / 2;
+    }
+
+    // Médiane de chaque groupe de 5 rangée en tête de l'intervalle
+    int n_groups = 0;
+    for (int start = left; start <= right; start += 5) {
+        int end = (start + 4 < right) ? start + 4 : right;
+        insertion_sort_range(values, start, end);
+        swap_values(values, left + n_groups, start + (end - start) / 2);
+        n_groups++;
+    }
+
+    int mid = left + (n_groups - 1) / 2;
+    select_kth(values, left, left + n_groups - 1, mid, 0);
+    return mid;
+}
+
+/**
+ * Fonction : select_kth
+ * Rôle     : Place en position k l'élément de rang k de values[left..right] (éléments plus petits à gauche) :
+ *            quickselect avec pivot médiane de trois, puis médiane des médianes au-delà de depth_limit
+ * Param    : values (tableau, réordonné), left, right (bornes incluses), k (rang cherché), depth_limit (itérations avant repli)
+ * Retour   : int (k)
+ */
+static int select_kth(double* values, int left, int right, int k, int depth_limit) {
+    while (right > left) {
+        if (right - left < 16) {
+            insertion_sort_range(values, left, right);
+            return k;
+        }
+
+        int pivot_index;
+        if (depth_limit > 0) {
+            int mid = left + (right - left) / 2;
+            if (values[mid] < values[left]) swap_values(values, mid, left);
+            if (values[right] < values[left]) swap_values(values, right, left);
+            if (values[right] < values[mid]) swap_values(values, right, mid);
+            pivot_index = mid;
+            depth_limit--;
+        } else {
+            pivot_index = median_of_medians(values, left, right);
+        }
+
+        int equal_start, equal_end;
+        partition_values(values, left, right, values[pivot_index], &equal_start, &equal_end);
+        if (k >= equal_start && k <= equal_end) return k;
+        if (k < equal_start) right = equal_start - 1;
+        else left = equal_end + 1;
+    }
+    return k;
+}
+
+/**
+ * Fonction : select_quantile
+ * Rôle     : Quantile exact en O(n) sans tri complet (interpolation linéaire entre les rangs floor et ceil
+ *            de q * (n - 1), comme numpy). Le tableau est réordonné.
+ * Param    : values (valeurs, sans NaN), n (nombre de valeurs), q (quantile dans [0, 1])
+ * Retour   : double (quantile, NAN si n == 0)
+ */
+double select_quantile(double* values, int n, double q) {
+    if (n <= 0) return NAN;
+    if (q < 0.0) q = 0.0;
+    if (q > 1.0) q = 1.0;
+
+    double position = q * (n - 1);
+    int k = (int)floor(position);
+    double fraction = position - k;
+
+    int depth_limit = 2 * (int)ceil(log2((double)n + 1.0));
+    select_kth(values, 0, n - 1, k, depth_limit);
+    double lower = values[k];
+    if (fraction == 0.0 || k + 1 >= n) return lower;
+
+    // Rang k + 1 : minimum de la partie droite
+    double upper = values[k + 1];
+    for (int i = k + 2; i < n; i++) {
+        if (values[i] < upper) upper = values[i];
+    }
+    return lower + fraction * (upper - lower);
+}
+
+/* **************************************************
+ * # --- SKETCH KLL --- #
+ * ************************************************** */
+
+/**
+ * Fonction : level_capacity
+ * Rôle     : Capacité du niveau h : k * (2/3)^(profondeur sous le sommet), au moins 2
+ * Param    : sketch (sketch), level (niveau)
+ * Retour   : int (nombre maximal d'éléments du niveau)
+ */
+static int level_capacity(QuantileSketch* sketch, int level) {
+    int depth = sketch->n_levels - 1 - level;
+    int capacity = (int)ceil(sketch->k * pow(KLL_DECAY, depth));
+    return capacity > KLL_MIN_CAPACITY ? capacity : KLL_MIN_CAPACITY;
+}
+
+/**
+ * Fonction : add_level
+ * Rôle     : Ajoute un niveau vide au sommet du sketch
+ * Param    : sketch (sketch)
+ * Retour   : void
+ */
+static void add_level(QuantileSketch* sketch) {
+    int h = sketch->n_levels++;
+    sketch->levels = (double**)safe_realloc(sketch->levels, sketch->n_levels * sizeof(double*));
+    sketch->sizes = (int*)safe_realloc(sketch->sizes, sketch->n_levels * sizeof(int));
+    sketch->capacities = (int*)safe_realloc(sketch->capacities, sketch->n_levels * sizeof(int));
+    sketch->capacities[h] = sketch->k + 1;
+    sketch->levels[h] = (double*)safe_malloc(sketch->capacities[h] * sizeof(double));
+    sketch->sizes[h] = 0;
+}
+
+/**
+ * Fonction : push_value
+ * Rôle     : Ajoute une valeur à un niveau (agrandit le stockage si nécessaire)
+ * Param    : sketch (sketch), level (niveau), value (valeur)
+ * Retour   : void
+ */
+static void push_value(QuantileSketch* sketch, int level, double value) {
+    if (sketch->sizes[level] >= sketch->capacities[level]) {
+        sketch->capacities[level] *= 2;
+        sketch->levels[level] = (double*)safe_realloc(sketch->levels[level], sketch->capacities[level] * sizeof(double));
+    }
+    sketch->levels[level][sketch->sizes[level]++] = value;
+}
+
+/**
+ * Fonction : compare_doubles
+ * Rôle     : Comparateur qsort pour des doubles
+ * Param    : a, b (pointeurs vers des doubles)
+ * Retour   : int (-1, 0 ou 1)
+ */
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Fonction : compress_sketch
+ * Rôle     : Compacte les niveaux dépassant leur capacité : le niveau est trié et un élément sur deux
+ *            (positions paires ou impaires, au hasard) monte au niveau supérieur avec un poids doublé
+ * Param    : sketch (sketch)
+ * Retour   : void
+ */
+static void compress_sketch(QuantileSketch* sketch) {
+    for (int h = 0; h < sketch->n_levels; h++) {
+        if (sketch->sizes[h] < level_capacity(sketch, h)) continue;
+
+        if (h + 1 >= sketch->n_levels) add_level(sketch);
+
+        double* level = sketch->levels[h];
+        int size = sketch->sizes[h];
+        qsort(level, size, sizeof(double), compare_doubles);
+
+        // Un élément reste sur place si la taille est impaire
+        int kept = size % 2;
+        sketch->rng = sketch->rng * 1103515245u + 12345u;
+        int offset = (sketch->rng >> 16) & 1;
+        for (int i = kept + offset; i < size; i += 2) {
+            push_value(sketch, h + 1, level[i]);
+        }
+        sketch->sizes[h] = kept;
+    }
+}
+
+/**
+ * Fonction : create_quantile_sketch
+ * Rôle     : Crée un sketch KLL vide
+ * Param    : k (précision ; 200 donne une erreur de rang d'environ 1 %)
+ * Retour   : QuantileSketch* (sketch vide)
+ */
+QuantileSketch* create_quantile_sketch(int k) {
+    QuantileSketch* sketch = (QuantileSketch*)safe_malloc(sizeof(QuantileSketch));
+    sketch->k = (k > 8) ? k : 8;
+    sketch->n_levels = 0;
+    sketch->levels = NULL;
+    sketch->sizes = NULL;
+    sketch->capacities = NULL;
+    sketch->count = 0;
+    sketch->min = INFINITY;
+    sketch->max = -INFINITY;
+    sketch->rng = 2463534242u;
+    add_level(sketch);
+    return sketch;
+}
+
+/**
+ * Fonction : sketch_update
+ * Rôle     : Insère une valeur dans le sketch (NaN ignoré)
+ * Param    : sketch (sketch), value (valeur)
+ * Retour   : void
+ */
+void sketch_update(QuantileSketch* sketch, double value) {
+    if (isnan(value)) return;
+
+    sketch->count++;
+    if (value < sketch->min) sketch->min = value;
+    if (value > sketch->max) sketch->max = value;
+
+    push_value(sketch, 0, value);
+    if (sketch->sizes[0] >= level_capacity(sketch, 0)) {
+        compress_sketch(sketch);
+    }
+}
+
+/**
+ * Fonction : sketch_merge
+ * Rôle     : Fusionne src dans dst (niveau par niveau) puis recompacte ; src n'est pas modifié
+ * Param    : dst (sketch destination), src (sketch source)
+ * Retour   : void
+ */
+void sketch_merge(QuantileSketch* dst, QuantileSketch* src) {
+    while (dst->n_levels < src->n_levels) add_level(dst);
+
+    for (int h = 0; h < src->n_levels; h++) {
+        for (int i = 0; i < src->sizes[h]; i++) {
+            push_value(dst, h, src->levels[h][i]);
+        }
+    }
+
+    dst->count += src->count;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+    compress_sketch(dst);
+}
+
+/**
+ * Fonction : sketch_quantile
+ * Rôle     : Estime le quantile q à partir des éléments retenus pondérés par 2^niveau
+ * Param    : sketch (sketch), q (quantile dans [0, 1])
+ * Retour   : double (quantile estimé, NAN si le sketch est vide)
+ */
+double sketch_quantile(QuantileSketch* sketch, double q) {
+    if (sketch->count == 0) return NAN;
+    if (q <= 0.0) return sketch->min;
+    if (q >= 1.0) return sketch->max;
+
+    int total = 0;
+    for (int h = 0; h < sketch->n_levels; h++) total += sketch->sizes[h];
+
+    // Paires (valeur, poids) triées par valeur
+    double* items = (double*)safe_malloc(2 * total * sizeof(double));
+    int n = 0;
+    double total_weight = 0.0;
+    for (int h = 0; h < sketch->n_levels; h++) {
+        double weight = ldexp(1.0, h);
+        for (int i = 0; i < sketch->sizes[h]; i++) {
+            items[2 * n] = sketch->levels[h][i];
+            items[2 * n + 1] = weight;
+            total_weight += weight;
+            n++;
+        }
+    }
+    qsort(items, n, 2 * sizeof(double), compare_doubles);
+
+    double target = q * total_weight;
+    double cumulative = 0.0;
+    double result = items[2 * (n - 1)];
+    for (int i = 0; i < n; i++) {
+        cumulative += items[2 * i + 1];
+        if (cumulative >= target) {
+            result = items[2 * i];
+            break;
+        }
+    }
+
+    safe_free(items);
+    return result;
+}
+
+/**
+ * Fonction : write_quantile_sketch
+ * Rôle     : Écrit le sketch au format binaire dans un fichier ouvert
+ * Param    : file (fichier de destination), sketch (sketch)
+ * Retour   : void
+ */
+void write_quantile_sketch(FILE* file, QuantileSketch* sketch) {
+    fwrite(&sketch->k, sizeof(int), 1, file);
+    fwrite(&sketch->n_levels, sizeof(int), 1, file);
+    fwrite(&sketch->count, sizeof(long), 1, file);
+    fwrite(&sketch->min, sizeof(double), 1, file);
+    fwrite(&sketch->max, sizeof(double), 1, file);
+    fwrite(&sketch->rng, sizeof(unsigned int), 1, file);
+    for (int h = 0; h < sketch->n_levels; h++) {
+        fwrite(&sketch->sizes[h], sizeof(int), 1, file);
+        fwrite(sketch->levels[h], sizeof(double), sketch->sizes[h], file);
+    }
+}
+
+/**
+ * Fonction : read_quantile_sketch
+ * Rôle     : Lit un sketch écrit par write_quantile_sketch
+ * Param    : file (fichier source)
+ * Retour   : QuantileSketch* (sketch chargé, NULL en cas d'erreur)
+ */
+QuantileSketch* read_quantile_sketch(FILE* file) {
+    int k, n_levels;
+    if (fread(&k, sizeof(int), 1, file) != 1 || fread(&n_levels, sizeof(int), 1, file) != 1 ||
+        n_levels <= 0 || n_levels > 64) {
+        return NULL;
+    }
+
+    QuantileSketch* sketch = create_quantile_sketch(k);
+    while (sketch->n_levels < n_levels) add_level(sketch);
+
+    int valid = fread(&sketch->count, sizeof(long), 1, file) == 1 &&
+                fread(&sketch->min, sizeof(double), 1, file) == 1 &&
+                fread(&sketch->max, sizeof(double), 1, file) == 1 &&
+                fread(&sketch->rng, sizeof(unsigned int), 1, file) == 1;
+
+    for (int h = 0; h < n_levels && valid; h++) {
+        int size;
+        valid = fread(&size, sizeof(int), 1, file) == 1 && size >= 0 && size <= 1 << 24;
+        if (!valid) break;
+        while (sketch->capacities[h] < size) {
+            sketch->capacities[h] *= 2;
+        }
+        sketch->levels[h] = (double*)safe_realloc(sketch->levels[h], sketch->capacities[h] * sizeof(double));
+        sketch->sizes[h] = size;
+        valid = fread(sketch->levels[h], sizeof(double), size, file) == (size_t)size;
+    }
+
+    if (!valid) {
+        free_quantile_sketch(sketch);
+        return NULL;
+    }
+    return sketch;
+}
+
+/**
+ * Fonction : free_quantile_sketch
+ * Rôle     : Libère complètement la mémoire allouée pour un sketch
+ * Param    : sketch (sketch à libérer)
+ * Retour   : void
+ */
+void free_quantile_sketch(QuantileSketch* sketch) {
+    if (sketch) {
+        for (int h = 0; h < sketch->n_levels; h++) {
+            safe_free(sketch->levels[h]);
+        }
+        safe_free(sketch->levels);
+        safe_free(sketch->sizes);
+        safe_free(sketch->capacities);
+        safe_free(sketch);
+    }
+}
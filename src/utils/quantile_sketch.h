@@ -0,0 +1,50 @@
+/*****************************************************************************************************
+
+Nom : src/utils/quantile_sketch.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le sketch de quantiles KLL (sélection linéaire incluse)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <stdio.h>
+
+/*
+ * Sketch KLL (Karnin, Lang, Liberty) : pile de compacteurs, le niveau h contenant des éléments de poids 2^h.
+ * Mémoire O(k log(n / k)), erreur de rang ~ 1.7 / k, fusionnable entre blocs, threads ou partitions.
+ * Les valeurs NaN sont ignorées.
+ */
+typedef struct {
+    int k;               // Capacité du compacteur le plus haut (précision)
+    int n_levels;
+    double** levels;     // [n_levels] éléments retenus à chaque niveau
+    int* sizes;          // [n_levels]
+    int* capacities;     // [n_levels] taille allouée de chaque niveau
+    long count;          // Nombre de valeurs insérées
+    double min;
+    double max;
+    unsigned int rng;    // Générateur déterministe pour le choix pair/impair des compactions
+} QuantileSketch;
+
+QuantileSketch* create_quantile_sketch(int k);
+void sketch_update(QuantileSketch* sketch, double value);
+void sketch_merge(QuantileSketch* dst, QuantileSketch* src);
+double sketch_quantile(QuantileSketch* sketch, double q);
+void write_quantile_sketch(FILE* file, QuantileSketch* sketch);
+QuantileSketch* read_quantile_sketch(FILE* file);
+void free_quantile_sketch(QuantileSketch* sketch);
+
+double select_quantile(double* values, int n, double q);
+
+#endif
@@ -0,0 +1,129 @@
+/*****************************************************************************************************
+
+Nom : src/utils/radix_sort.c
+
+Rôle : Tri par base LSD (11 bits par passe) de clés 64 bits issues des doubles, avec charge utile entière
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "radix_sort.h"
+#include "memory_manager.h"
+#include <string.h>
+
+#define RADIX_BITS 11
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES 6   // 6 x 11 bits >= 64 bits
+
+/* **************************************************
+ * # --- CLÉS DE TRI --- #
+ * ************************************************** */
+
+/**
+ * Fonction : double_sort_key
+ * Rôle     : Transforme un double en clé entière de même ordre : bit de signe inversé pour les positifs,
+ *            tous les bits inversés pour les négatifs (l'ordre des entiers non signés suit alors celui des doubles)
+ * Param    : value (valeur à convertir)
+ * Retour   : uint64_t (clé de tri)
+ */
+uint64_t double_sort_key(double value) {
+    value += 0.0;  // -0.0 -> +0.0 : deux zéros égaux donnent la même clé
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t mask = (uint64_t)(-(int64_t)(bits >> 63)) | 0x8000000000000000ULL;
+    return bits ^ mask;
+}
+
+/* **************************************************
+ * # --- TRI PAR BASE --- #
+ * ************************************************** */
+
+/**
+ * Fonction : radix_sort_pairs
+ * Rôle     : Trie des clés par ordre croissant (stable) en déplaçant leur charge utile avec elles.
+ *            Les histogrammes des 6 passes sont calculés en une seule lecture ; une passe dont tous les
+ *            éléments partagent le même chiffre est sautée (fréquent pour des probabilités dans [0, 1]).
+ * Param    : keys (clés [n], triées en place), payload (charge utile [n] permutée avec les clés), n (nombre d'éléments)
+ * Retour   : void
+ */
+void radix_sort_pairs(uint64_t* keys, int* payload, int n) {
+    if (n < 2) return;
+
+    int* counts = (int*)safe_calloc(RADIX_PASSES * RADIX_SIZE, sizeof(int));
+    for (int i = 0; i < n; i++) {
+        uint64_t key = keys[i];
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            counts[pass * RADIX_SIZE + ((key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1))]++;
+        }
+    }
+
+    uint64_t* tmp_keys = (uint64_t*)safe_malloc(n * sizeof(uint64_t));
+    int* tmp_payload = (int*)safe_malloc(n * sizeof(int));
+    uint64_t* src_keys = keys;
+    int* src_payload = payload;
+    uint64_t* dst_keys = tmp_keys;
+    int* dst_payload = tmp_payload;
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        int* count = counts + pass * RADIX_SIZE;
+        int shift = pass * RADIX_BITS;
+        if (count[(src_keys[0] >> shift) & (RADIX_SIZE - 1)] == n) continue;
+
+        // Sommes préfixes exclusives : position de départ de chaque chiffre
+        int offset = 0;
+        for (int d = 0; d < RADIX_SIZE; d++) {
+            int c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+
+        for (int i = 0; i < n; i++) {
+            int position = count[(src_keys[i] >> shift) & (RADIX_SIZE - 1)]++;
+            dst_keys[position] = src_keys[i];
+            dst_payload[position] = src_payload[i];
+        }
+
+        uint64_t* swap_keys = src_keys;
+        src_keys = dst_keys;
+        dst_keys = swap_keys;
+        int* swap_payload = src_payload;
+        src_payload = dst_payload;
+        dst_payload = swap_payload;
+    }
+
+    if (src_keys != keys) {
+        memcpy(keys, src_keys, n * sizeof(uint64_t));
+        memcpy(payload, src_payload, n * sizeof(int));
+    }
+
+    safe_free(tmp_keys);
+    safe_free(tmp_payload);
+    safe_free(counts);
+}
+
+/**
+ * Fonction : radix_argsort
+ * Rôle     : Indices qui trient un tableau de doubles par ordre croissant (stable)
+ * Param    : values (valeurs [n]), n (nombre de valeurs)
+ * Retour   : int* (permutation [n] à libérer par l'appelant)
+ */
+int* radix_argsort(const double* values, int n) {
+    uint64_t* keys = (uint64_t*)safe_malloc((n > 0 ? n : 1) * sizeof(uint64_t));
+    int* order = (int*)safe_malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        keys[i] = double_sort_key(values[i]);
+        order[i] = i;
+    }
+
+    radix_sort_pairs(keys, order, n);
+    safe_free(keys);
+    return order;
+}
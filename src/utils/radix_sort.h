@@ -0,0 +1,27 @@
+/*****************************************************************************************************
+
+Nom : src/utils/radix_sort.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le tri par base (LSD) sur les motifs binaires des doubles
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <stdint.h>
+
+uint64_t double_sort_key(double value);
+void radix_sort_pairs(uint64_t* keys, int* payload, int n);
+int* radix_argsort(const double* values, int n);
+
+#endif
@@ -0,0 +1,88 @@
+/*****************************************************************************************************
+
+Nom : src/utils/random.c
+
+Rôle : Flux pseudo-aléatoires SplitMix64 indépendants et reproductibles, utilisables depuis plusieurs threads
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "random.h"
+
+#define SPLITMIX_GAMMA 0x9E3779B97F4A7C15ULL
+
+/**
+ * Fonction : mix64
+ * Rôle     : Fonction de mélange finale de SplitMix64 (bijection sur 64 bits)
+ * Param    : z (valeur à mélanger)
+ * Retour   : uint64_t (valeur mélangée)
+ */
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Fonction : seed_random_stream
+ * Rôle     : Initialise le flux numéro stream d'une graine (ex. une tâche, un réplicat ou un fold)
+ * Param    : rng (flux à initialiser), seed (graine de l'expérience), stream (identifiant du flux)
+ * Retour   : void
+ */
+void seed_random_stream(RandomStream* rng, uint64_t seed, uint64_t stream) {
+    rng->state = mix64(seed + SPLITMIX_GAMMA) ^ mix64(stream * SPLITMIX_GAMMA + 1);
+}
+
+/**
+ * Fonction : random_next
+ * Rôle     : Tire l'entier 64 bits suivant du flux
+ * Param    : rng (flux)
+ * Retour   : uint64_t (entier uniforme)
+ */
+uint64_t random_next(RandomStream* rng) {
+    rng->state += SPLITMIX_GAMMA;
+    return mix64(rng->state);
+}
+
+/**
+ * Fonction : random_uniform
+ * Rôle     : Tire un réel uniforme dans [0, 1) (53 bits de mantisse)
+ * Param    : rng (flux)
+ * Retour   : double (réel uniforme)
+ */
+double random_uniform(RandomStream* rng) {
+    return (random_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Fonction : random_index
+ * Rôle     : Tire un entier uniforme dans [0, n) par multiplication (sans division ni modulo)
+ * Param    : rng (flux), n (borne exclusive, > 0)
+ * Retour   : int (index uniforme)
+ */
+int random_index(RandomStream* rng, int n) {
+    return (int)(((random_next(rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+/**
+ * Fonction : random_shuffle
+ * Rôle     : Mélange un tableau d'entiers en place (Fisher-Yates)
+ * Param    : rng (flux), values (tableau [n]), n (nombre d'éléments)
+ * Retour   : void
+ */
+void random_shuffle(RandomStream* rng, int* values, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = random_index(rng, i + 1);
+        int tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+}
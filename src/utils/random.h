@@ -0,0 +1,38 @@
+/*****************************************************************************************************
+
+Nom : src/utils/random.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour les flux pseudo-aléatoires indépendants (un par tâche)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/*
+ * Flux SplitMix64 : état de 64 bits, aucun état global (contrairement à rand()), donc un flux par tâche
+ * parallèle. Le flux (seed, stream) est déterminé par ses deux entiers : les résultats ne dépendent ni
+ * du nombre de threads ni de l'ordre d'exécution des tâches.
+ */
+typedef struct {
+    uint64_t state;
+} RandomStream;
+
+void seed_random_stream(RandomStream* rng, uint64_t seed, uint64_t stream);
+uint64_t random_next(RandomStream* rng);
+double random_uniform(RandomStream* rng);
+int random_index(RandomStream* rng, int n);
+void random_shuffle(RandomStream* rng, int* values, int n);
+
+#endif
@@ -0,0 +1,117 @@
+/*****************************************************************************************************
+
+Nom : src/utils/sparse_matrix.c
+
+Rôle : Dataset creux au format CSR (construction ligne par ligne, conversion depuis un Dataset dense)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : N/A
+
+******************************************************************************************************/
+
+#include "sparse_matrix.h"
+#include "memory_manager.h"
+#include <stdio.h>
+
+/* **************************************************
+ * # --- CONSTRUCTION CSR --- #
+ * ************************************************** */
+
+/**
+ * Fonction : create_sparse_dataset
+ * Rôle     : Crée un dataset creux vide avec un nombre de colonnes fixé
+ * Param    : cols (nombre total de features)
+ * Retour   : SparseDataset* (dataset vide prêt à recevoir des lignes)
+ */
+SparseDataset* create_sparse_dataset(int cols) {
+    SparseDataset* dataset = (SparseDataset*)safe_malloc(sizeof(SparseDataset));
+    dataset->rows = 0;
+    dataset->cols = cols;
+    dataset->nnz = 0;
+    dataset->row_capacity = 64;
+    dataset->nnz_capacity = 256;
+    dataset->row_ptr = (int*)safe_malloc((dataset->row_capacity + 1) * sizeof(int));
+    dataset->labels = (int*)safe_malloc(dataset->row_capacity * sizeof(int));
+    dataset->col_idx = (int*)safe_malloc(dataset->nnz_capacity * sizeof(int));
+    dataset->values = (double*)safe_malloc(dataset->nnz_capacity * sizeof(double));
+    dataset->row_ptr[0] = 0;
+    return dataset;
+}
+
+/**
+ * Fonction : sparse_add_row
+ * Rôle     : Ajoute une ligne au dataset creux (les valeurs nulles sont ignorées)
+ * Param    : dataset (dataset creux), indices (colonnes des valeurs), values (valeurs), count (nombre de valeurs), label (label de la ligne)
+ * Retour   : void
+ */
+void sparse_add_row(SparseDataset* dataset, const int* indices, const double* values, int count, int label) {
+    if (dataset->rows >= dataset->row_capacity) {
+        dataset->row_capacity *= 2;
+        dataset->row_ptr = (int*)safe_realloc(dataset->row_ptr, (dataset->row_capacity + 1) * sizeof(int));
+        dataset->labels = (int*)safe_realloc(dataset->labels, dataset->row_capacity * sizeof(int));
+    }
+    while (dataset->nnz + count > dataset->nnz_capacity) {
+        dataset->nnz_capacity *= 2;
+        dataset->col_idx = (int*)safe_realloc(dataset->col_idx, dataset->nnz_capacity * sizeof(int));
+        dataset->values = (double*)safe_realloc(dataset->values, dataset->nnz_capacity * sizeof(double));
+    }
+
+    for (int k = 0; k < count; k++) {
+        if (values[k] == 0.0) continue;
+        if (indices[k] < 0 || indices[k] >= dataset->cols) {
+            fprintf(stderr, "Sparse column index out of range: %d\n", indices[k]);
+            continue;
+        }
+        dataset->col_idx[dataset->nnz] = indices[k];
+        dataset->values[dataset->nnz] = values[k];
+        dataset->nnz++;
+    }
+
+    dataset->labels[dataset->rows] = label;
+    dataset->rows++;
+    dataset->row_ptr[dataset->rows] = dataset->nnz;
+}
+
+/**
+ * Fonction : dense_to_sparse
+ * Rôle     : Convertit un Dataset dense en dataset creux CSR (seules les valeurs non nulles sont conservées)
+ * Param    : dataset (dataset dense)
+ * Retour   : SparseDataset* (dataset creux équivalent)
+ */
+SparseDataset* dense_to_sparse(Dataset* dataset) {
+    SparseDataset* sparse = create_sparse_dataset(dataset->cols);
+    int* indices = (int*)safe_malloc(dataset->cols * sizeof(int));
+    for (int j = 0; j < dataset->cols; j++) {
+        indices[j] = j;
+    }
+
+    for (int i = 0; i < dataset->rows; i++) {
+        sparse_add_row(sparse, indices, dataset->data[i], dataset->cols,
+                       dataset->labels ? dataset->labels[i] : 0);
+    }
+
+    safe_free(indices);
+    return sparse;
+}
+
+/**
+ * Fonction : free_sparse_dataset
+ * Rôle     : Libère complètement la mémoire allouée pour un dataset creux
+ * Param    : dataset (dataset creux à libérer)
+ * Retour   : void
+ */
+void free_sparse_dataset(SparseDataset* dataset) {
+    if (dataset) {
+        safe_free(dataset->row_ptr);
+        safe_free(dataset->col_idx);
+        safe_free(dataset->values);
+        safe_free(dataset->labels);
+        safe_free(dataset);
+    }
+}
@@ -0,0 +1,44 @@
+/*****************************************************************************************************
+
+Nom : src/utils/sparse_matrix.h
+
+Rôle : Déclarations de fonctions, structures et constantes pour le module de dataset creux (format CSR)
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./build/credit_risk_predictor
+
+******************************************************************************************************/
+
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include "csv_parser.h"
+
+/*
+ * Format CSR : les valeurs non nulles de la ligne i sont
+ * values[row_ptr[i] .. row_ptr[i+1]-1], aux colonnes col_idx[...].
+ */
+typedef struct {
+    int* row_ptr;     // [rows + 1]
+    int* col_idx;     // [nnz]
+    double* values;   // [nnz]
+    int* labels;      // [rows]
+    int rows;
+    int cols;
+    int nnz;
+    int row_capacity;
+    int nnz_capacity;
+} SparseDataset;
+
+SparseDataset* create_sparse_dataset(int cols);
+void sparse_add_row(SparseDataset* dataset, const int* indices, const double* values, int count, int label);
+SparseDataset* dense_to_sparse(Dataset* dataset);
+void free_sparse_dataset(SparseDataset* dataset);
+
+#endif
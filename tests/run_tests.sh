@@ -16,8 +16,8 @@ NC='\033[0m' # No Color
 
 # Flags de compilation
 CC=gcc
-CFLAGS="-Wall -Wextra -O2 -std=c99 -D_POSIX_C_SOURCE=200809L"
-LDFLAGS="-lm"
+CFLAGS="-Wall -Wextra -O2 -std=c99 -D_POSIX_C_SOURCE=200809L -pthread"
+LDFLAGS="-lm -lpthread"
 
 # Répertoires
 SRC_DIR="../src"
@@ -74,6 +74,8 @@ tests=(
     "test_preprocessing"
     "test_metrics"
     "test_logistic_regression"
+    "test_decision_tree"
+    "test_pipeline"
 )
 
 # Exécuter chaque test
@@ -18,8 +18,11 @@ Usage : Pour compiler : make
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <math.h>
 #include "../src/utils/csv_parser.h"
 #include "../src/data/data_loader.h"
+#include "../src/data/schema.h"
+#include "../src/preprocessing/interactions.h"
 
 void test_load_csv_basic() {
     printf("Test 1: Chargement CSV basique... ");
@@ -102,37 +105,201 @@ void test_save_dataset() {
 void test_categorical_encoding() {
     printf("Test 4: Encodage catégoriel... ");
     
-    // Créer un CSV avec des valeurs catégorielles
+    // Les modalités sont encodées par les dictionnaires du schéma Credit Risk, pas par des positions de colonnes
     FILE* f = fopen("test_cat.csv", "w");
-    fprintf(f, "age,income,home,emp,intent,grade,amnt,rate,status,percent,default,hist\n");
+    fprintf(f, "person_age,person_income,person_home_ownership,person_emp_length,loan_intent,loan_grade,"
+               "loan_amnt,loan_int_rate,loan_status,loan_percent_income,cb_person_default_on_file,"
+               "cb_person_cred_hist_length\n");
     fprintf(f, "25,50000,RENT,5.0,PERSONAL,A,10000,10.0,0,0.2,N,3\n");
     fprintf(f, "30,60000,OWN,10.0,EDUCATION,B,15000,12.0,1,0.25,Y,5\n");
     fclose(f);
     
-    Dataset* dataset = load_csv("test_cat.csv", 1, 8);
+    Schema* schema = load_schema("../data/schema/credit_risk.schema");
+    assert(schema != NULL);
+    Dataset* dataset = load_csv_with_schema("test_cat.csv", schema, NULL);
     
     assert(dataset != NULL);
-    assert(dataset->rows == 2);
+    assert(dataset->rows == 2 && dataset->cols == 11);
     
-    // Vérifier l'encodage (colonne 2 = home_ownership)
     // RENT=0, OWN=1
-    assert(dataset->data[0][2] == 0.0);  // RENT
-    assert(dataset->data[1][2] == 1.0);  // OWN
+    int home = schema_feature_index(schema, "person_home_ownership");
+    assert(dataset->data[0][home] == 0.0);
+    assert(dataset->data[1][home] == 1.0);
     
-    // Colonne 5 dans CSV = loan_grade (A=1, B=2), mais après retrait col 8, c'est col 5
-    assert(dataset->data[0][5] == 1.0);  // A
-    assert(dataset->data[1][5] == 2.0);  // B
+    // loan_grade : A=1, B=2
+    int grade = schema_feature_index(schema, "loan_grade");
+    assert(dataset->data[0][grade] == 1.0);
+    assert(dataset->data[1][grade] == 2.0);
     
-    // Colonne 10 dans CSV = default_on_file (N=0, Y=1), après retrait col 8, c'est col 9
-    assert(dataset->data[0][9] == 0.0);  // N
-    assert(dataset->data[1][9] == 1.0);  // Y
+    // default_on_file : N=0, Y=1
+    int flag = schema_feature_index(schema, "cb_person_default_on_file");
+    assert(dataset->data[0][flag] == 0.0);
+    assert(dataset->data[1][flag] == 1.0);
+    assert(dataset->labels[0] == 0 && dataset->labels[1] == 1);
+    free_dataset(dataset);
+    free_schema(schema);
     
+    // load_csv ne connaît que des colonnes numériques : une modalité brute est une valeur manquante
+    dataset = load_csv("test_cat.csv", 1, 8);
+    assert(dataset != NULL && dataset->rows == 2);
+    assert(isnan(dataset->data[0][2]) && dataset->data[0][1] == 50000.0);
     free_dataset(dataset);
     remove("test_cat.csv");
     
     printf("✓ PASSÉ\n");
 }
 
+void test_empty_fields() {
+    printf("Test 5: Champs vides conservés (NaN)... ");
+    
+    char line[] = "25,,RENT,,PERSONAL\r\n";
+    int count;
+    char** tokens = parse_csv_line(line, &count);
+    assert(count == 5);
+    assert(tokens[1][0] == '\0' && tokens[3][0] == '\0');
+    assert(tokens[4][0] == 'P' && tokens[4][8] == '\0');
+    free_parsed_line(tokens, count);
+    
+    FILE* f = fopen("test_empty.csv", "w");
+    fprintf(f, "age,income,home,emp,intent,grade,amnt,rate,status,percent,default,hist\n");
+    fprintf(f, "25,50000,RENT,,PERSONAL,A,10000,,1,0.2,N,3\n");
+    fclose(f);
+    
+    Dataset* dataset = load_csv("test_empty.csv", 1, 8);
+    assert(dataset != NULL && dataset->cols == 11);
+    assert(isnan(dataset->data[0][3]) && isnan(dataset->data[0][7]));
+    assert(dataset->labels[0] == 1 && dataset->data[0][8] == 0.2);
+    
+    free_dataset(dataset);
+    remove("test_empty.csv");
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_schema_loader() {
+    printf("Test 6: Chargement piloté par schéma... ");
+    
+    FILE* f = fopen("test.schema", "w");
+    fprintf(f, "# colonnes du test\n");
+    fprintf(f, "income    numeric\n");
+    fprintf(f, "home      categorical unseen RENT=0 OWN=1\n");
+    fprintf(f, "grade     categorical 3 A=1 B=2 C=3\n");
+    fprintf(f, "status    label\n");
+    fprintf(f, "comment   drop\n");
+    fprintf(f, "\n");
+    fprintf(f, "rate      numeric\n");
+    fclose(f);
+    
+    // Colonnes réordonnées, colonne supplémentaire, champs vides et modalités inconnues
+    f = fopen("test_schema.csv", "w");
+    fprintf(f, "rate,extra,status,grade,comment,home,income\r\n");
+    fprintf(f, "10.5,x,1,B,ok,OWN,50000\r\n");
+    fprintf(f, ",y,0,Z,,BOAT,\r\n");
+    fprintf(f, "7.25,z,1,A\r\n");
+    fprintf(f, "3.0,w,,C,ok,OWN,1000\r\n");
+    fprintf(f, "4.0,v,yes,C,ok,OWN,2000\r\n");
+    fprintf(f, "5.0,u,1,C,ok,RENT,12abc\r\n");
+    fclose(f);
+    
+    Schema* schema = load_schema("test.schema");
+    assert(schema != NULL);
+    assert(schema->n_columns == 6 && schema->n_features == 4 && schema->label_column == 3);
+    
+    LoadReport report;
+    Dataset* dataset = load_csv_with_schema("test_schema.csv", schema, &report);
+    assert(dataset != NULL && dataset->rows == 4 && dataset->cols == 4);
+    
+    // Features dans l'ordre du schéma : income, home, grade, rate
+    assert(dataset->data[0][0] == 50000.0 && dataset->data[0][1] == 1.0);
+    assert(dataset->data[0][2] == 2.0 && dataset->data[0][3] == 10.5);
+    assert(dataset->labels[0] == 1 && dataset->labels[1] == 0 && dataset->labels[2] == 1);
+    
+    // Ligne 2 : revenu et taux manquants, BOAT inconnu (unseen -> NaN), Z inconnu (défaut 3)
+    assert(isnan(dataset->data[1][0]) && isnan(dataset->data[1][3]));
+    assert(isnan(dataset->data[1][1]) && dataset->data[1][2] == 3.0);
+    
+    // Ligne 3 tronquée : colonnes manquantes traitées comme vides
+    assert(dataset->data[2][2] == 1.0 && dataset->data[2][3] == 7.25);
+    assert(isnan(dataset->data[2][0]) && isnan(dataset->data[2][1]));
+    
+    // Labels vide et non numérique : lignes écartées ; "12abc" n'est pas lu comme 12
+    assert(dataset->labels[3] == 1 && dataset->data[3][3] == 5.0);
+    assert(isnan(dataset->data[3][0]));
+    assert(report.n_invalid_labels == 2);
+    
+    assert(report.n_unseen == 2);
+    assert(report.n_missing == 5);
+    assert(report.n_ignored_columns == 2);
+    
+    // Colonne requise absente de l'en-tête
+    f = fopen("test_schema.csv", "w");
+    fprintf(f, "rate,status,grade,home\n1.0,0,A,RENT\n");
+    fclose(f);
+    assert(load_csv_with_schema("test_schema.csv", schema, NULL) == NULL);
+    
+    // Colonnes absentes du schéma : pas d'interactions Credit Risk
+    assert(schema_feature_index(schema, "rate") == 3 && schema_feature_index(schema, "status") == -1);
+    assert(credit_risk_interactions(schema) == NULL);
+    
+    free_dataset(dataset);
+    free_schema(schema);
+    remove("test.schema");
+    remove("test_schema.csv");
+    
+    // Schéma réordonné : les termes croisés suivent les noms, pas les positions
+    f = fopen("test.schema", "w");
+    fprintf(f, "loan_int_rate        numeric\n");
+    fprintf(f, "loan_status          label\n");
+    fprintf(f, "loan_percent_income  numeric\n");
+    fprintf(f, "loan_grade           categorical 3 A=1 B=2\n");
+    fprintf(f, "person_income        numeric\n");
+    fclose(f);
+    schema = load_schema("test.schema");
+    Interactions* interactions = credit_risk_interactions(schema);
+    assert(interactions != NULL && interactions->n_input == 4 && interactions->n_pairs == 2);
+    assert(interactions->left[0] == 3 && interactions->right[0] == 1);
+    assert(interactions->left[1] == 2 && interactions->right[1] == 0);
+    free_interactions(interactions);
+    free_schema(schema);
+    remove("test.schema");
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_duplicate_categories() {
+    printf("Test 7: Modalités dupliquées refusées... ");
+    
+    // Deux clés identiques ne se séparent par aucun hachage : la seconde est refusée, la compilation aboutit
+    CategoryDictionary* dict = create_category_dictionary(CATEGORY_UNSEEN);
+    assert(add_category(dict, "RENT", 0) == 1);
+    assert(add_category(dict, "OWN", 1) == 1);
+    assert(add_category(dict, "RENT", 2) == 0);
+    assert(dict->n_values == 2);
+    assert(compile_category_dictionary(dict) == 1);
+    int found;
+    assert(lookup_category(dict, "RENT", 4, &found) == 0 && found);
+    free_category_dictionary(dict);
+    
+    // Une ligne de schéma qui répète une modalité invalide le schéma
+    FILE* f = fopen("test_dup.schema", "w");
+    fprintf(f, "income    numeric\n");
+    fprintf(f, "home      categorical unseen RENT=0 OWN=1 RENT=2\n");
+    fprintf(f, "status    label\n");
+    fclose(f);
+    assert(load_schema("test_dup.schema") == NULL);
+    
+    // Un code au-delà de CATEGORY_MAX_CODE invalide aussi le schéma
+    f = fopen("test_dup.schema", "w");
+    fprintf(f, "income    numeric\n");
+    fprintf(f, "grade     categorical unseen A=1 B=1000000000\n");
+    fprintf(f, "status    label\n");
+    fclose(f);
+    assert(load_schema("test_dup.schema") == NULL);
+    remove("test_dup.schema");
+    
+    printf("✓ PASSÉ\n");
+}
+
 int main() {
     printf("\n=== TESTS DU DATA LOADER ===\n\n");
     
@@ -140,6 +307,9 @@ int main() {
     test_load_csv_without_header();
     test_save_dataset();
     test_categorical_encoding();
+    test_empty_fields();
+    test_schema_loader();
+    test_duplicate_categories();
     
     printf("\n✓ Tous les tests sont passés avec succès!\n\n");
     return 0;
@@ -304,9 +304,9 @@ void test_save_load() {
     
     int* pred_before = predict_tree_dataset(tree, data);
     
-    save_decision_tree("tests/test_tree.bin", tree);
+    save_decision_tree("test_tree.bin", tree);
     
-    DecisionTree* loaded = load_decision_tree("tests/test_tree.bin");
+    DecisionTree* loaded = load_decision_tree("test_tree.bin");
     assert(loaded != NULL);
     assert(loaded->max_depth == tree->max_depth);
     assert(loaded->criterion == tree->criterion);
@@ -332,6 +332,124 @@ void test_save_load() {
     printf("PASSE\n");
 }
 
+void test_score_tree_dataset() {
+    printf("Test 8: Scoring fusionne (probabilites + classes)... ");
+    
+    Dataset* data = (Dataset*)safe_malloc(sizeof(Dataset));
+    data->rows = 8;
+    data->cols = 1;
+    data->data = (double**)safe_malloc(8 * sizeof(double*));
+    data->labels = (int*)safe_malloc(8 * sizeof(int));
+    
+    int labels[] = {0, 0, 0, 1, 0, 1, 1, 1};
+    for (int i = 0; i < 8; i++) {
+        data->data[i] = (double*)safe_malloc(sizeof(double));
+        data->data[i][0] = i;
+        data->labels[i] = labels[i];
+    }
+    
+    DecisionTree* tree = create_decision_tree(1, 2, 1, GINI);
+    train_decision_tree(tree, data);
+    
+    int* predictions = predict_tree_dataset(tree, data);
+    double* probas = get_tree_probabilities(tree, data);
+    
+    int fused_pred[8];
+    double fused_proba[8];
+    score_tree_dataset(tree, data, 0.5, fused_proba, fused_pred);
+    for (int i = 0; i < 8; i++) {
+        assert(fused_pred[i] == predictions[i]);
+        assert(fused_pred[i] == (probas[i] >= 0.5 ? 1 : 0));
+        assert(fused_proba[i] == probas[i]);
+    }
+    
+    // Seuil strict : seules les feuilles pures sont positives
+    score_tree_dataset(tree, data, 0.99, NULL, fused_pred);
+    for (int i = 0; i < 8; i++) {
+        assert(fused_pred[i] == (probas[i] >= 0.99 ? 1 : 0));
+    }
+    
+    safe_free(probas);
+    safe_free(predictions);
+    for (int i = 0; i < 8; i++) {
+        safe_free(data->data[i]);
+    }
+    safe_free(data->data);
+    safe_free(data->labels);
+    safe_free(data);
+    free_decision_tree(tree);
+    
+    printf("PASSE\n");
+}
+
+void test_export_raw_tree() {
+    printf("Test 9: Export avec seuils ramenes dans l'espace brut... ");
+    
+    int n = 40;
+    Dataset* raw = (Dataset*)safe_malloc(sizeof(Dataset));
+    Dataset* scaled = (Dataset*)safe_malloc(sizeof(Dataset));
+    raw->rows = scaled->rows = n;
+    raw->cols = scaled->cols = 2;
+    raw->data = (double**)safe_malloc(n * sizeof(double*));
+    scaled->data = (double**)safe_malloc(n * sizeof(double*));
+    raw->labels = (int*)safe_malloc(n * sizeof(int));
+    scaled->labels = raw->labels;
+    
+    for (int i = 0; i < n; i++) {
+        raw->data[i] = (double*)safe_malloc(2 * sizeof(double));
+        scaled->data[i] = (double*)safe_malloc(2 * sizeof(double));
+        raw->data[i][0] = 20000.0 + 1000.0 * ((i * 7) % n);
+        raw->data[i][1] = (i * 3) % 11;
+        raw->labels[i] = (raw->data[i][0] < 35000.0 || raw->data[i][1] > 8) ? 1 : 0;
+        scaled->data[i][0] = raw->data[i][0];
+        scaled->data[i][1] = raw->data[i][1];
+    }
+    
+    Scaler* scaler = fit_scaler(scaled);
+    transform_dataset(scaled, scaler);
+    
+    DecisionTree* tree = create_decision_tree(4, 2, 1, GINI);
+    train_decision_tree(tree, scaled);
+    DecisionTree* raw_tree = export_raw_decision_tree(tree, scaler);
+    assert(raw_tree != NULL);
+    assert(count_tree_nodes(raw_tree) == count_tree_nodes(tree));
+    
+    double* expected = get_tree_probabilities(tree, scaled);
+    double* actual = get_tree_probabilities(raw_tree, raw);
+    for (int i = 0; i < n; i++) {
+        assert(expected[i] == actual[i]);
+    }
+    
+    // Scoring fusionne sur les lignes brutes : memes classes que l'arbre sur les lignes normalisees
+    int expected_pred[40], actual_pred[40];
+    score_tree_dataset(tree, scaled, 0.5, NULL, expected_pred);
+    score_tree_dataset(raw_tree, raw, 0.5, NULL, actual_pred);
+    for (int i = 0; i < n; i++) {
+        assert(expected_pred[i] == actual_pred[i]);
+    }
+    
+    // Scaler d'une autre dimension : export refuse
+    Scaler wide = {scaler->mean, scaler->std, 3};
+    assert(export_raw_decision_tree(tree, &wide) == NULL);
+    
+    safe_free(expected);
+    safe_free(actual);
+    for (int i = 0; i < n; i++) {
+        safe_free(raw->data[i]);
+        safe_free(scaled->data[i]);
+    }
+    safe_free(raw->data);
+    safe_free(scaled->data);
+    safe_free(raw->labels);
+    safe_free(raw);
+    safe_free(scaled);
+    free_scaler(scaler);
+    free_decision_tree(tree);
+    free_decision_tree(raw_tree);
+    
+    printf("PASSE\n");
+}
+
 int main() {
     printf("\n=== TESTS DECISION TREE ===\n\n");
     
@@ -342,6 +460,8 @@ int main() {
     test_max_depth_limit();
     test_min_samples_split();
     test_save_load();
+    test_score_tree_dataset();
+    test_export_raw_tree();
     
     printf("\nTous les tests sont passes avec succes!\n\n");
     return 0;
@@ -20,6 +20,7 @@ Usage : Pour compiler : make
 #include <assert.h>
 #include <math.h>
 #include "../src/models/logistic_regression.h"
+#include "../src/models/regularization_path.h"
 #include "../src/utils/csv_parser.h"
 #include "../src/utils/memory_manager.h"
 
@@ -155,6 +156,383 @@ void test_model_save_load() {
     printf("✓ PASSÉ\n");
 }
 
+void test_partial_fit_warm_start() {
+    printf("Test 5: Entraînement incrémental (partial_fit / warm start)... ");
+    
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = 4;
+    dataset->cols = 2;
+    dataset->data = (double**)safe_malloc(4 * sizeof(double*));
+    dataset->labels = (int*)safe_malloc(4 * sizeof(int));
+    
+    for (int i = 0; i < 4; i++) {
+        dataset->data[i] = (double*)safe_malloc(2 * sizeof(double));
+    }
+    
+    dataset->data[0][0] = 0.0; dataset->data[0][1] = 0.0; dataset->labels[0] = 0;
+    dataset->data[1][0] = 0.0; dataset->data[1][1] = 2.0; dataset->labels[1] = 1;
+    dataset->data[2][0] = 2.0; dataset->data[2][1] = 0.0; dataset->labels[2] = 1;
+    dataset->data[3][0] = 2.0; dataset->data[3][1] = 2.0; dataset->labels[3] = 1;
+    
+    // 200 itérations en une fois == 100 itérations + 100 passes incrémentales
+    LogisticRegression* full = create_logistic_regression(2, 0.1, 200);
+    train_logistic_regression(full, dataset);
+    
+    LogisticRegression* model = create_logistic_regression(2, 0.1, 100);
+    train_logistic_regression(model, dataset);
+    double previous_cost = partial_fit_logistic_regression(model, dataset);
+    for (int i = 1; i < 100; i++) {
+        double cost = partial_fit_logistic_regression(model, dataset);
+        assert(cost <= previous_cost + 1e-12);
+        previous_cost = cost;
+    }
+    
+    assert(fabs(model->bias - full->bias) < 1e-9);
+    assert(fabs(model->weights[0] - full->weights[0]) < 1e-9);
+    assert(fabs(model->weights[1] - full->weights[1]) < 1e-9);
+    
+    // Sans warm start, un nouvel entraînement repart de zéro
+    train_logistic_regression(model, dataset);
+    LogisticRegression* fresh = create_logistic_regression(2, 0.1, 100);
+    train_logistic_regression(fresh, dataset);
+    assert(fabs(model->weights[0] - fresh->weights[0]) < 1e-9);
+    
+    // Avec warm start, il poursuit depuis les poids courants
+    model->warm_start = 1;
+    train_logistic_regression(model, dataset);
+    assert(fabs(model->weights[0] - full->weights[0]) < 1e-9);
+    
+    // Lot incompatible
+    dataset->cols = 3;
+    assert(partial_fit_logistic_regression(model, dataset) < 0.0);
+    dataset->cols = 2;
+    
+    free_logistic_regression(full);
+    free_logistic_regression(fresh);
+    free_logistic_regression(model);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+static Dataset* make_noisy_dataset(int n) {
+    // x0 très informatif, x1 faiblement informatif, x2 bruit pur
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = n;
+    dataset->cols = 3;
+    dataset->data = (double**)safe_malloc(n * sizeof(double*));
+    dataset->labels = (int*)safe_malloc(n * sizeof(int));
+    
+    unsigned int seed = 12345;
+    for (int i = 0; i < n; i++) {
+        dataset->data[i] = (double*)safe_malloc(3 * sizeof(double));
+        for (int j = 0; j < 3; j++) {
+            seed = seed * 1103515245u + 12345u;
+            dataset->data[i][j] = ((seed >> 8) % 2000) / 1000.0 - 1.0;
+        }
+        seed = seed * 1103515245u + 12345u;
+        double noise = ((seed >> 8) % 2000) / 1000.0 - 1.0;
+        double z = 3.0 * dataset->data[i][0] + 0.5 * dataset->data[i][1] + noise;
+        dataset->labels[i] = z > 0.0 ? 1 : 0;
+    }
+    return dataset;
+}
+
+void test_regularization_path() {
+    printf("Test 6: Chemin de régularisation L1/elastic-net... ");
+    
+    Dataset* dataset = make_noisy_dataset(300);
+    RegularizationPath* path = fit_regularization_path(dataset, PENALTY_ELASTIC_NET, 0.9, 20, 1e-3);
+    
+    assert(path != NULL);
+    assert(path->n_lambdas == 20);
+    assert(path->n_nonzero[0] == 0);
+    assert(path->n_nonzero[19] == 3);
+    for (int k = 1; k < 20; k++) {
+        assert(path->lambdas[k] < path->lambdas[k - 1]);
+    }
+    
+    // x0 entre dans le modèle avant x1 et x2
+    int first_with_x0 = -1, first_with_x2 = -1;
+    for (int k = 0; k < 20; k++) {
+        if (first_with_x0 < 0 && path->weights[k][0] != 0.0) first_with_x0 = k;
+        if (first_with_x2 < 0 && path->weights[k][2] != 0.0) first_with_x2 = k;
+    }
+    assert(first_with_x0 >= 0 && first_with_x0 < first_with_x2);
+    
+    // Conditions d'optimalité (KKT) au point k = 10
+    LogisticRegression* model = path_to_model(path, 10);
+    double* probas = predict_proba(model, dataset);
+    double alpha = 0.9, lambda = path->lambdas[10];
+    for (int j = 0; j < 3; j++) {
+        double g = 0.0;
+        for (int i = 0; i < dataset->rows; i++) {
+            g += dataset->data[i][j] * (dataset->labels[i] - probas[i]);
+        }
+        g /= dataset->rows;
+        double w = model->weights[j];
+        if (w == 0.0) {
+            assert(fabs(g) <= lambda * alpha + 1e-4);
+        } else {
+            double sign = w > 0 ? 1.0 : -1.0;
+            assert(fabs(g - lambda * (1.0 - alpha) * w - lambda * alpha * sign) < 1e-4);
+        }
+    }
+    
+    assert(path_to_model(path, 20) == NULL);
+    
+    free(probas);
+    free_logistic_regression(model);
+    free_regularization_path(path);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_l2_coordinate_descent() {
+    printf("Test 7: Descente de coordonnées L2 vs gradient descent... ");
+    
+    Dataset* dataset = make_noisy_dataset(200);
+    
+    LogisticRegression* cd = create_logistic_regression(3, 0.5, 3000);
+    cd->penalty = PENALTY_L2;
+    cd->lambda = 0.05;
+    train_logistic_regression_cd(cd, dataset);
+    
+    LogisticRegression* gd = create_logistic_regression(3, 0.5, 3000);
+    gd->penalty = PENALTY_L2;
+    gd->lambda = 0.05;
+    train_logistic_regression(gd, dataset);
+    
+    assert(fabs(cd->bias - gd->bias) < 1e-3);
+    for (int j = 0; j < 3; j++) {
+        assert(fabs(cd->weights[j] - gd->weights[j]) < 1e-3);
+    }
+    
+    free_logistic_regression(cd);
+    free_logistic_regression(gd);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_fast_math_mode() {
+    printf("Test 8: Sigmoïde et log-loss en mode rapide... ");
+    
+    // Bornes d'erreur documentées dans fast_math.h
+    for (double x = -700.0; x <= 700.0; x += 0.37) {
+        assert(fabs(fast_exp(x) / exp(x) - 1.0) < 2e-7);
+    }
+    for (double lx = -30.0; lx <= 30.0; lx += 0.013) {
+        double x = exp(lx);
+        assert(fabs(fast_log(x) - log(x)) < 1e-9);
+    }
+    
+    Dataset* dataset = make_noisy_dataset(500);
+    
+    LogisticRegression* exact = create_logistic_regression(3, 0.1, 300);
+    LogisticRegression* fast = create_logistic_regression(3, 0.1, 300);
+    fast->math_mode = MATH_FAST;
+    train_logistic_regression(exact, dataset);
+    train_logistic_regression(fast, dataset);
+    
+    for (int j = 0; j < 3; j++) {
+        assert(fabs(exact->weights[j] - fast->weights[j]) < 1e-5);
+    }
+    
+    double* p_exact = predict_proba(exact, dataset);
+    double* p_fast = predict_proba(fast, dataset);
+    int* labels_exact = predict(exact, dataset);
+    int mismatches = 0;
+    for (int i = 0; i < dataset->rows; i++) {
+        assert(fabs(p_exact[i] - p_fast[i]) < 1e-5);
+        if (labels_exact[i] != (p_exact[i] >= 0.5 ? 1 : 0)) mismatches++;
+    }
+    assert(mismatches == 0);
+    
+    free(p_exact);
+    free(p_fast);
+    free(labels_exact);
+    free_logistic_regression(exact);
+    free_logistic_regression(fast);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_fused_scoring() {
+    printf("Test 9: Scoring fusionné (marges, probabilités, classes)... ");
+    
+    Dataset* dataset = make_noisy_dataset(600);
+    LogisticRegression* model = create_logistic_regression(3, 0.1, 200);
+    train_logistic_regression(model, dataset);
+    
+    int* labels = predict(model, dataset);
+    double* probas = predict_proba(model, dataset);
+    
+    int* fused_labels = (int*)safe_malloc(dataset->rows * sizeof(int));
+    double* fused_probas = (double*)safe_malloc(dataset->rows * sizeof(double));
+    double* margins = (double*)safe_malloc(dataset->rows * sizeof(double));
+    
+    score_logistic_regression(model, dataset, 0.5, fused_probas, fused_labels, margins);
+    for (int i = 0; i < dataset->rows; i++) {
+        assert(fused_labels[i] == labels[i]);
+        assert(fused_probas[i] == probas[i]);
+        assert(fabs(sigmoid(margins[i]) - probas[i]) < 1e-12);
+    }
+    
+    // Seuil personnalisé, sans buffer de probabilités
+    score_logistic_regression(model, dataset, 0.3, NULL, fused_labels, NULL);
+    for (int i = 0; i < dataset->rows; i++) {
+        assert(fused_labels[i] == (probas[i] >= 0.3 ? 1 : 0));
+    }
+    
+    free(labels);
+    free(probas);
+    free(fused_labels);
+    free(fused_probas);
+    free(margins);
+    free_logistic_regression(model);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_sparse_training() {
+    printf("Test 10: Entraînement et scoring sur données creuses (CSR)... ");
+    
+    Dataset* dataset = make_noisy_dataset(400);
+    // Annuler une partie des valeurs pour obtenir une matrice réellement creuse
+    for (int i = 0; i < dataset->rows; i++) {
+        if (i % 3 == 0) dataset->data[i][1] = 0.0;
+        if (i % 2 == 0) dataset->data[i][2] = 0.0;
+    }
+    SparseDataset* sparse = dense_to_sparse(dataset);
+    assert(sparse->rows == 400);
+    assert(sparse->nnz < 400 * 3);
+    
+    LogisticRegression* dense_model = create_logistic_regression(3, 0.1, 300);
+    LogisticRegression* sparse_model = create_logistic_regression(3, 0.1, 300);
+    dense_model->penalty = sparse_model->penalty = PENALTY_L1;
+    dense_model->lambda = sparse_model->lambda = 0.01;
+    train_logistic_regression(dense_model, dataset);
+    train_logistic_regression_sparse(sparse_model, sparse);
+    
+    assert(fabs(dense_model->bias - sparse_model->bias) < 1e-9);
+    for (int j = 0; j < 3; j++) {
+        assert(fabs(dense_model->weights[j] - sparse_model->weights[j]) < 1e-9);
+    }
+    
+    double* dense_probas = predict_proba(dense_model, dataset);
+    double* sparse_probas = (double*)safe_malloc(400 * sizeof(double));
+    int* sparse_labels = (int*)safe_malloc(400 * sizeof(int));
+    score_logistic_regression_sparse(sparse_model, sparse, 0.5, sparse_probas, sparse_labels, NULL);
+    for (int i = 0; i < 400; i++) {
+        assert(fabs(dense_probas[i] - sparse_probas[i]) < 1e-9);
+        assert(sparse_labels[i] == (sparse_probas[i] >= 0.5 ? 1 : 0));
+    }
+    
+    free(dense_probas);
+    free(sparse_probas);
+    free(sparse_labels);
+    free_logistic_regression(dense_model);
+    free_logistic_regression(sparse_model);
+    free_sparse_dataset(sparse);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_export_raw_model() {
+    printf("Test 11: Export avec normalisation intégrée aux poids... ");
+    
+    Dataset* raw = make_noisy_dataset(300);
+    Dataset* scaled = make_noisy_dataset(300);
+    for (int i = 0; i < raw->rows; i++) {
+        raw->data[i][0] = raw->data[i][0] * 5000.0 + 40000.0;  // échelle de revenu
+        scaled->data[i][0] = raw->data[i][0];
+    }
+    
+    Scaler* scaler = fit_scaler(scaled);
+    transform_dataset(scaled, scaler);
+    
+    LogisticRegression* model = create_logistic_regression(3, 0.1, 200);
+    train_logistic_regression(model, scaled);
+    LogisticRegression* raw_model = export_raw_logistic_regression(model, scaler);
+    assert(raw_model != NULL);
+    
+    double* expected = predict_proba(model, scaled);
+    double* actual = predict_proba(raw_model, raw);
+    for (int i = 0; i < raw->rows; i++) {
+        assert(fabs(expected[i] - actual[i]) < 1e-9);
+    }
+    
+    free(expected);
+    free(actual);
+    free_logistic_regression(model);
+    free_logistic_regression(raw_model);
+    free_scaler(scaler);
+    free_dataset(raw);
+    free_dataset(scaled);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_fused_interactions() {
+    printf("Test 12: Interactions fusionnées dans le noyau... ");
+    
+    // Label porté par le terme croisé x0 * x1 : invisible pour un modèle linéaire simple
+    Dataset* dataset = make_noisy_dataset(400);
+    for (int i = 0; i < dataset->rows; i++) {
+        dataset->labels[i] = dataset->data[i][0] * dataset->data[i][1] > 0.0 ? 1 : 0;
+    }
+    
+    Interactions* interactions = create_degree2_interactions(3, 1);
+    assert(interactions->n_pairs == 6 && interactions_output_size(interactions) == 9);
+    Dataset* expanded = materialize_interactions(interactions, dataset);
+    assert(expanded->cols == 9);
+    assert(expanded->data[7][4] == dataset->data[7][0] * dataset->data[7][1]);
+    
+    LogisticRegression* fused = create_logistic_regression(9, 0.5, 300);
+    LogisticRegression* materialized = create_logistic_regression(9, 0.5, 300);
+    train_logistic_regression_interactions(fused, dataset, interactions);
+    train_logistic_regression(materialized, expanded);
+    
+    // Même ordre de calcul : poids identiques au bit près
+    for (int j = 0; j < 9; j++) {
+        assert(fused->weights[j] == materialized->weights[j]);
+    }
+    assert(fused->bias == materialized->bias);
+    
+    double* probas = (double*)safe_malloc(dataset->rows * sizeof(double));
+    int* labels = (int*)safe_malloc(dataset->rows * sizeof(int));
+    double* expected = predict_proba(materialized, expanded);
+    score_logistic_regression_interactions(fused, dataset, interactions, 0.5, probas, labels, NULL);
+    int correct = 0;
+    for (int i = 0; i < dataset->rows; i++) {
+        assert(probas[i] == expected[i]);
+        correct += labels[i] == dataset->labels[i];
+    }
+    assert(correct > 0.9 * dataset->rows);
+    
+    save_interactions("test_interactions.bin", interactions);
+    Interactions* loaded = load_interactions("test_interactions.bin");
+    assert(loaded != NULL && loaded->n_pairs == 6 && loaded->left[4] == 1 && loaded->right[4] == 2);
+    remove("test_interactions.bin");
+    
+    free(probas);
+    free(labels);
+    free(expected);
+    free_interactions(interactions);
+    free_interactions(loaded);
+    free_logistic_regression(fused);
+    free_logistic_regression(materialized);
+    free_dataset(expanded);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
 int main() {
     printf("\n=== TESTS DE LA RÉGRESSION LOGISTIQUE ===\n\n");
     
@@ -162,6 +540,14 @@ int main() {
     test_training_simple();
     test_predict_proba();
     test_model_save_load();
+    test_partial_fit_warm_start();
+    test_regularization_path();
+    test_l2_coordinate_descent();
+    test_fast_math_mode();
+    test_fused_scoring();
+    test_sparse_training();
+    test_export_raw_model();
+    test_fused_interactions();
     
     printf("\n✓ Tous les tests sont passés avec succès!\n\n");
     return 0;
@@ -21,6 +21,16 @@ Usage : Pour compiler : make
 #include <math.h>
 #include "../src/evaluation/metrics.h"
 #include "../src/evaluation/confusion_matrix.h"
+#include "../src/utils/radix_sort.h"
+#include "../src/evaluation/score_histogram.h"
+#include "../src/evaluation/threshold_sweep.h"
+#include "../src/evaluation/bootstrap.h"
+#include "../src/evaluation/cross_validation.h"
+#include "../src/evaluation/hyperparameter_search.h"
+#include "../src/evaluation/drift_monitor.h"
+#include "../src/evaluation/permutation_importance.h"
+#include "../src/utils/parallel.h"
+#include "../src/utils/utils.h"
 
 void test_perfect_predictions() {
     printf("Test 1: Prédictions parfaites... ");
@@ -247,6 +257,589 @@ void test_auc_roc_all_negative() {
     printf("✓ PASSÉ (AUC=%.4f, cas limite)\n", auc);
 }
 
+void test_metrics_report() {
+    printf("Test 13: Rapport de métriques en une passe... ");
+    
+    int y_true[] = {0, 0, 0, 1, 1, 1, 0, 1};
+    int y_pred[] = {0, 0, 1, 1, 1, 0, 0, 1};
+    int n = 8;
+    
+    MetricsReport report = compute_metrics_report(y_true, y_pred, n);
+    ConfusionMatrix* cm = compute_confusion_matrix(y_true, y_pred, n);
+    assert(report.cm.tp == 3 && report.cm.tn == 3 && report.cm.fp == 1 && report.cm.fn == 1);
+    assert(cm->tp == report.cm.tp && cm->tn == report.cm.tn && cm->fp == report.cm.fp && cm->fn == report.cm.fn);
+    
+    // Identique aux fonctions individuelles
+    assert(report.accuracy == compute_accuracy(y_true, y_pred, n));
+    assert(report.precision == compute_precision(y_true, y_pred, n));
+    assert(report.recall == compute_recall(y_true, y_pred, n));
+    assert(fabs(report.f1_score - 0.75) < 1e-12);
+    assert(report.specificity == 0.75);
+    assert(isnan(report.auc_roc));
+    
+    report.auc_roc = 0.8;
+    save_metrics_report("test_report.txt", &report);
+    FILE* f = fopen("test_report.txt", "r");
+    char line[64];
+    int lines = 0;
+    double auc = 0.0;
+    while (fgets(line, sizeof(line), f)) {
+        lines++;
+        sscanf(line, "AUC-ROC: %lf", &auc);
+    }
+    fclose(f);
+    assert(lines == 5 && auc == 0.8);
+    remove("test_report.txt");
+    
+    free_confusion_matrix(cm);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_auc_roc_ties() {
+    printf("Test 14: AUC-ROC avec ex aequo (Mann-Whitney)... ");
+    
+    // Scores tous égaux : aucune information, AUC = 0.5 quel que soit l'ordre des labels
+    double flat[] = {0.3, 0.3, 0.3, 0.3, 0.3};
+    int y_flat[] = {1, 0, 1, 0, 0};
+    assert(fabs(compute_auc_roc(flat, y_flat, 5) - 0.5) < 1e-12);
+    
+    // Scores à la manière d'un arbre (peu de valeurs distinctes) : comparaison à la définition par paires
+    int n = 500;
+    double* scores = (double*)malloc(n * sizeof(double));
+    int* labels = (int*)malloc(n * sizeof(int));
+    srand(42);
+    for (int i = 0; i < n; i++) {
+        labels[i] = rand() % 3 == 0;
+        scores[i] = (rand() % 6 + 2 * labels[i]) / 8.0;
+    }
+    double wins = 0.0;
+    long pairs = 0;
+    for (int i = 0; i < n; i++) {
+        if (!labels[i]) continue;
+        for (int k = 0; k < n; k++) {
+            if (labels[k]) continue;
+            wins += scores[i] > scores[k] ? 1.0 : (scores[i] == scores[k] ? 0.5 : 0.0);
+            pairs++;
+        }
+    }
+    double auc = compute_auc_roc(scores, labels, n);
+    assert(fabs(auc - wins / pairs) < 1e-12);
+    
+    // Tri radix : négatifs, zéros signés et positifs dans l'ordre, stable sur les égalités
+    double values[] = {0.5, -2.0, 0.0, -0.0, 3.0, -0.25, 0.5, -1e300};
+    int* order = radix_argsort(values, 8);
+    for (int i = 1; i < 8; i++) {
+        assert(values[order[i - 1]] <= values[order[i]]);
+    }
+    assert(order[0] == 7 && order[3] == 2 && order[4] == 3 && order[5] == 0 && order[6] == 6);
+    
+    free(order);
+    free(scores);
+    free(labels);
+    
+    printf("✓ PASSÉ (AUC=%.4f)\n", auc);
+}
+
+void test_score_histogram() {
+    printf("Test 15: Histogramme de scores fusionnable (AUC, Gini, KS)... ");
+    
+    int n = 20000;
+    double* scores = (double*)malloc(n * sizeof(double));
+    int* labels = (int*)malloc(n * sizeof(int));
+    srand(7);
+    for (int i = 0; i < n; i++) {
+        labels[i] = rand() % 4 == 0;
+        scores[i] = (rand() / (double)RAND_MAX + 0.5 * labels[i]) / 1.5;
+    }
+    double exact = compute_auc_roc(scores, labels, n);
+    
+    // Un lot unique contre trois lots fusionnés : compteurs entiers, résultats identiques
+    ScoreHistogram* whole = create_score_histogram(1024);
+    score_histogram_update(whole, scores, labels, n);
+    ScoreHistogram* parts[3];
+    for (int p = 0; p < 3; p++) {
+        parts[p] = create_score_histogram(1024);
+        score_histogram_update(parts[p], scores + p * (n / 3), labels + p * (n / 3), p < 2 ? n / 3 : n - 2 * (n / 3));
+    }
+    assert(score_histogram_merge(parts[0], parts[1]) == 0 && score_histogram_merge(parts[0], parts[2]) == 0);
+    assert(parts[0]->n_positive == whole->n_positive && parts[0]->n_negative == whole->n_negative);
+    assert(score_histogram_auc(parts[0]) == score_histogram_auc(whole));
+    assert(score_histogram_ks(parts[0]) == score_histogram_ks(whole));
+    
+    // Écart à l'AUC exacte dans la borne annoncée
+    double auc = score_histogram_auc(whole);
+    assert(fabs(auc - exact) <= score_histogram_auc_error(whole) + 1e-12);
+    assert(fabs(score_histogram_gini(whole) - (2.0 * auc - 1.0)) < 1e-12);
+    
+    // Positifs uniformes sur [1/3, 1], négatifs sur [0, 2/3] : écart des répartitions de 1/2 sur [1/3, 2/3]
+    double ks = score_histogram_ks(whole);
+    assert(fabs(ks - 0.5) < 0.03);
+    
+    // KS exact (max |TPR - FPR| sur tous les seuils) : au-dessus de la valeur aux bornes, dans la borne annoncée,
+    // y compris avec un histogramme grossier
+    ThresholdSweep* sweep = compute_threshold_sweep(scores, labels, n, 0);
+    double exact_ks = 0.0;
+    for (int p = 0; p < sweep->n_points; p++) {
+        double gap = fabs(sweep->points[p].tpr - sweep->points[p].fpr);
+        if (gap > exact_ks) exact_ks = gap;
+    }
+    ScoreHistogram* coarse = create_score_histogram(8);
+    score_histogram_update(coarse, scores, labels, n);
+    ScoreHistogram* histograms[2] = {whole, coarse};
+    for (int h = 0; h < 2; h++) {
+        double approximate = score_histogram_ks(histograms[h]);
+        assert(approximate <= exact_ks + 1e-12);
+        assert(exact_ks - approximate <= score_histogram_ks_error(histograms[h]) + 1e-12);
+    }
+    assert(score_histogram_ks_error(coarse) > score_histogram_ks_error(whole));
+    free_score_histogram(coarse);
+    free_threshold_sweep(sweep);
+    
+    // Fusion entre processus via fichier ; nombres d'intervalles incompatibles refusés
+    save_score_histogram("test_score_histogram.bin", whole);
+    ScoreHistogram* loaded = load_score_histogram("test_score_histogram.bin");
+    assert(loaded && loaded->n_positive == whole->n_positive && score_histogram_auc(loaded) == auc);
+    remove("test_score_histogram.bin");
+    ScoreHistogram* other = create_score_histogram(10);
+    assert(score_histogram_merge(whole, other) == -1);
+    
+    free_score_histogram(other);
+    free_score_histogram(loaded);
+    for (int p = 0; p < 3; p++) free_score_histogram(parts[p]);
+    free_score_histogram(whole);
+    free(scores);
+    free(labels);
+    
+    printf("✓ PASSÉ (AUC=%.4f, KS=%.4f)\n", auc, ks);
+}
+
+void test_threshold_sweep() {
+    printf("Test 16: Balayage des seuils (ROC, PR, lift) en un parcours... ");
+    
+    int n = 1000;
+    double* scores = (double*)malloc(n * sizeof(double));
+    int* labels = (int*)malloc(n * sizeof(int));
+    int* predictions = (int*)malloc(n * sizeof(int));
+    srand(11);
+    for (int i = 0; i < n; i++) {
+        labels[i] = rand() % 5 == 0;
+        scores[i] = (rand() % 40 + 15 * labels[i]) / 55.0;   // ex aequo nombreux
+    }
+    
+    ThresholdSweep* sweep = compute_threshold_sweep(scores, labels, n, 0);
+    assert(fabs(sweep->auc_roc - compute_auc_roc(scores, labels, n)) < 1e-12);
+    assert(sweep->points[0].cm.tp == 0 && sweep->points[0].cm.fp == 0);
+    assert(sweep->points[sweep->n_points - 1].tpr == 1.0 && sweep->points[sweep->n_points - 1].fpr == 1.0);
+    
+    // Chaque point coïncide avec la matrice de confusion calculée directement au même seuil
+    for (int p = 1; p < sweep->n_points; p += 7) {
+        double threshold = sweep->points[p].threshold;
+        for (int i = 0; i < n; i++) predictions[i] = scores[i] >= threshold;
+        MetricsReport report = compute_metrics_report(labels, predictions, n);
+        ThresholdPoint point = threshold_sweep_at(sweep, threshold);
+        assert(point.cm.tp == report.cm.tp && point.cm.fp == report.cm.fp && point.cm.tn == report.cm.tn);
+        assert(fabs(point.precision - report.precision) < 1e-12 && fabs(point.tpr - report.recall) < 1e-12);
+    }
+    
+    // Déciles : partition de la population, gains cumulés jusqu'à 1, lift moyen de 1
+    int total = 0;
+    double mean_lift = 0.0;
+    for (int d = 0; d < SWEEP_DECILES; d++) {
+        total += sweep->deciles[d].n_samples;
+        mean_lift += sweep->deciles[d].lift / SWEEP_DECILES;
+    }
+    assert(total == n && fabs(sweep->deciles[SWEEP_DECILES - 1].cumulative_gain - 1.0) < 1e-12);
+    assert(fabs(mean_lift - 1.0) < 1e-9 && sweep->deciles[0].lift > 1.0);
+    
+    // Sous-échantillonnage : au plus max_points, extrémités conservées
+    ThresholdSweep* coarse = compute_threshold_sweep(scores, labels, n, 12);
+    assert(coarse->n_points <= 12 && coarse->n_points >= 3);
+    assert(coarse->points[coarse->n_points - 1].tpr == 1.0 && coarse->auc_roc == sweep->auc_roc);
+    
+    // Score NaN écarté : même balayage que sans la ligne, sans boucle infinie sur le groupe d'ex aequo
+    double nan_scores[] = {0.2, NAN, 0.8, 0.5};
+    int nan_labels[] = {0, 1, 1, 0};
+    ThresholdSweep* with_nan = compute_threshold_sweep(nan_scores, nan_labels, 4, 0);
+    assert(with_nan->n_ignored == 1 && with_nan->n_samples == 3);
+    assert(with_nan->n_positive == 1 && with_nan->n_negative == 2);
+    assert(with_nan->n_points == 4 && with_nan->auc_roc == 1.0);
+    free_threshold_sweep(with_nan);
+    
+    free_threshold_sweep(coarse);
+    free_threshold_sweep(sweep);
+    free(scores);
+    free(labels);
+    free(predictions);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_bootstrap_metrics() {
+    printf("Test 17: Intervalles de confiance bootstrap... ");
+    
+    int n = 2000;
+    double* scores = (double*)malloc(n * sizeof(double));
+    int* labels = (int*)malloc(n * sizeof(int));
+    int* predictions = (int*)malloc(n * sizeof(int));
+    srand(3);
+    for (int i = 0; i < n; i++) {
+        labels[i] = rand() % 4 == 0;
+        scores[i] = (rand() % 100 + 40 * labels[i]) / 140.0;
+        predictions[i] = scores[i] >= 0.5;
+    }
+    
+    set_num_threads(1);
+    BootstrapReport serial = bootstrap_metrics(scores, labels, predictions, n, 200, 0.9, 1234);
+    set_num_threads(4);
+    BootstrapReport parallel = bootstrap_metrics(scores, labels, predictions, n, 200, 0.9, 1234);
+    set_num_threads(0);
+    
+    // Estimations identiques aux métriques directes
+    MetricsReport direct = compute_metrics_report(labels, predictions, n);
+    assert(fabs(serial.auc_roc.estimate - compute_auc_roc(scores, labels, n)) < 1e-12);
+    assert(fabs(serial.f1_score.estimate - direct.f1_score) < 1e-12);
+    assert(fabs(serial.precision.estimate - direct.precision) < 1e-12);
+    assert(fabs(serial.recall.estimate - direct.recall) < 1e-12);
+    
+    // Flux par réplicat : mêmes intervalles quel que soit le nombre de threads
+    assert(serial.auc_roc.lower == parallel.auc_roc.lower && serial.auc_roc.upper == parallel.auc_roc.upper);
+    assert(serial.ks.std_error == parallel.ks.std_error && serial.f1_score.upper == parallel.f1_score.upper);
+    
+    assert(serial.auc_roc.lower < serial.auc_roc.estimate && serial.auc_roc.estimate < serial.auc_roc.upper);
+    assert(serial.auc_roc.std_error > 0.001 && serial.auc_roc.std_error < 0.05);
+    assert(serial.ks.lower <= serial.ks.upper && serial.f1_score.lower < serial.f1_score.upper);
+    
+    free(scores);
+    free(labels);
+    free(predictions);
+    
+    printf("✓ PASSÉ (AUC=%.4f [%.4f, %.4f])\n", serial.auc_roc.estimate, serial.auc_roc.lower, serial.auc_roc.upper);
+}
+
+void test_cross_validation() {
+    printf("Test 18: Validation croisée stratifiée parallèle... ");
+    
+    // Deux features informatives d'échelles très différentes, ~22 % de positifs
+    Dataset data;
+    data.rows = 1000;
+    data.cols = 3;
+    data.data = allocate_matrix(data.rows, data.cols);
+    data.labels = (int*)malloc(data.rows * sizeof(int));
+    srand(5);
+    for (int i = 0; i < data.rows; i++) {
+        data.labels[i] = rand() % 100 < 22;
+        data.data[i][0] = 50000.0 + 20000.0 * (rand() / (double)RAND_MAX) - 15000.0 * data.labels[i];
+        data.data[i][1] = rand() / (double)RAND_MAX + 0.6 * data.labels[i];
+        data.data[i][2] = rand() / (double)RAND_MAX;
+    }
+    
+    // Partition stratifiée : chaque ligne une fois, défauts répartis à une ligne près
+    Folds* folds = make_stratified_folds(data.labels, data.rows, 5, 99);
+    int* seen = (int*)calloc(data.rows, sizeof(int));
+    int total_positive = 0;
+    for (int i = 0; i < data.rows; i++) total_positive += data.labels[i];
+    for (int f = 0; f < 5; f++) {
+        int positives = 0;
+        for (int k = folds->offsets[f]; k < folds->offsets[f + 1]; k++) {
+            seen[folds->indices[k]]++;
+            positives += data.labels[folds->indices[k]];
+        }
+        assert(folds->offsets[f + 1] - folds->offsets[f] == data.rows / 5);
+        assert(abs(positives * 5 - total_positive) <= 5);
+    }
+    for (int i = 0; i < data.rows; i++) assert(seen[i] == 1);
+    
+    LogisticRegression* config = create_logistic_regression(data.cols, 0.1, 300);
+    DecisionTree* tree_config = create_decision_tree(4, 10, 5, GINI);
+    set_num_threads(1);
+    CrossValidationReport* serial = cross_validate_logistic(&data, folds, config);
+    set_num_threads(3);
+    CrossValidationReport* parallel = cross_validate_logistic(&data, folds, config);
+    CrossValidationReport* trees = cross_validate_tree(&data, folds, tree_config);
+    set_num_threads(0);
+    
+    // Folds indépendants : résultats identiques quel que soit le nombre de threads
+    for (int f = 0; f < 5; f++) {
+        assert(serial->folds[f].auc_roc == parallel->folds[f].auc_roc);
+        assert(serial->folds[f].cm.tp == parallel->folds[f].cm.tp);
+    }
+    assert(serial->auc_roc.mean > 0.85 && serial->auc_roc.std < 0.05);
+    assert(trees->auc_roc.mean > 0.8 && trees->accuracy.mean > 0.8);
+    
+    // Probabilités hors fold : chaque ligne scorée une fois, AUC globale proche de la moyenne des folds
+    double oof_auc = compute_auc_roc(serial->oof_probabilities, data.labels, data.rows);
+    assert(fabs(oof_auc - serial->auc_roc.mean) < 0.03);
+    
+    assert(make_kfolds(data.rows, 1, 0) == NULL);
+    MetricSummary auc = parallel->auc_roc;
+    
+    free_cross_validation_report(serial);
+    free_cross_validation_report(parallel);
+    free_cross_validation_report(trees);
+    free_logistic_regression(config);
+    free_decision_tree(tree_config);
+    free_folds(folds);
+    free(seen);
+    free_matrix(data.data, data.rows);
+    free(data.labels);
+    
+    printf("✓ PASSÉ (AUC LR=%.4f ± %.4f)\n", auc.mean, auc.std);
+}
+
+void test_hyperparameter_search() {
+    printf("Test 19: Recherche d'hyperparamètres par successive halving... ");
+    
+    Dataset data;
+    data.rows = 3000;
+    data.cols = 3;
+    data.data = allocate_matrix(data.rows, data.cols);
+    data.labels = (int*)malloc(data.rows * sizeof(int));
+    srand(11);
+    for (int i = 0; i < data.rows; i++) {
+        data.labels[i] = rand() % 100 < 25;
+        data.data[i][0] = rand() / (double)RAND_MAX + 0.5 * data.labels[i];
+        data.data[i][1] = rand() / (double)RAND_MAX * (data.labels[i] ? 2.0 : 1.0);
+        data.data[i][2] = rand() / (double)RAND_MAX;
+    }
+    
+    // Arbre entraîné sur des lignes via le pré-tri partagé = arbre entraîné sur la copie de ces lignes
+    int n_rows = 1200;
+    int* rows = (int*)malloc(n_rows * sizeof(int));
+    Dataset subset;
+    subset.rows = n_rows;
+    subset.cols = data.cols;
+    subset.data = (double**)malloc(n_rows * sizeof(double*));
+    subset.labels = (int*)malloc(n_rows * sizeof(int));
+    for (int k = 0; k < n_rows; k++) {
+        rows[k] = (k * 7) % data.rows;
+        subset.data[k] = data.data[rows[k]];
+        subset.labels[k] = data.labels[rows[k]];
+    }
+    TreePresort* presort = presort_dataset(&data);
+    DecisionTree* from_rows = create_decision_tree(5, 10, 5, ENTROPY);
+    DecisionTree* from_copy = create_decision_tree(5, 10, 5, ENTROPY);
+    train_decision_tree_rows(from_rows, &data, presort, rows, n_rows);
+    train_decision_tree(from_copy, &subset);
+    assert(count_tree_nodes(from_rows) == count_tree_nodes(from_copy));
+    for (int i = 0; i < data.rows; i += 13) {
+        assert(predict_tree_single(from_rows, data.data[i]) == predict_tree_single(from_copy, data.data[i]));
+    }
+    
+    // Grille 3 x 2 x 2 = 12 essais, 3 paliers avec eta = 3 ; résultat indépendant du nombre de threads
+    SearchSpace space = create_tree_search_space();
+    const double depths[] = {1, 3, 5};
+    const double leaves[] = {5, 50};
+    const double criteria[] = {GINI, ENTROPY};
+    search_space_grid(&space, DT_MAX_DEPTH, 3, depths);
+    search_space_grid(&space, DT_MIN_SAMPLES_LEAF, 2, leaves);
+    search_space_grid(&space, DT_CRITERION, 2, criteria);
+    SearchOptions options = default_search_options();
+    options.min_budget = 200;
+    set_num_threads(1);
+    SearchReport* serial = hyperparameter_search(&data, &space, &options);
+    set_num_threads(3);
+    SearchReport* parallel = hyperparameter_search(&data, &space, &options);
+    set_num_threads(0);
+    
+    assert(serial->n_trials == 12 && serial->n_rungs == 3);
+    assert(serial->n_train + serial->n_validation == data.rows);
+    assert(serial->best == parallel->best);
+    int finalists = 0;
+    for (int t = 0; t < serial->n_trials; t++) {
+        assert(serial->trials[t].score == parallel->trials[t].score);
+        finalists += serial->trials[t].rung == serial->n_rungs - 1;
+    }
+    assert(finalists == 1);
+    SearchTrial* best = &serial->trials[serial->best];
+    assert(best->rung == serial->n_rungs - 1 && best->budget == serial->n_train);
+    assert(best->values[DT_MAX_DEPTH] > 1 && best->score > 0.7);
+    assert(serial->n_fitted_rows < (long)serial->n_trials * serial->n_train / 2);
+    
+    // Recherche aléatoire : tirages dans les bornes, configuration du meilleur essai
+    SearchSpace lr_space = create_logistic_search_space();
+    search_space_range(&lr_space, LR_LEARNING_RATE, PARAM_LOG_UNIFORM, 0.01, 1.0);
+    search_space_range(&lr_space, LR_MAX_ITERATIONS, PARAM_INT_UNIFORM, 50, 200);
+    options.n_trials = 6;
+    SearchReport* random = hyperparameter_search(&data, &lr_space, &options);
+    assert(random->n_trials == 6);
+    for (int t = 0; t < random->n_trials; t++) {
+        double rate = random->trials[t].values[LR_LEARNING_RATE];
+        double iterations = random->trials[t].values[LR_MAX_ITERATIONS];
+        assert(rate >= 0.01 && rate <= 1.0);
+        assert(iterations >= 50 && iterations <= 200 && iterations == floor(iterations));
+    }
+    LogisticRegression* tuned = search_logistic_config(random, random->best, data.cols);
+    assert(tuned->learning_rate == random->trials[random->best].values[LR_LEARNING_RATE]);
+    assert(search_tree_config(random, random->best) == NULL);
+    double best_auc = best->score;
+    
+    free_logistic_regression(tuned);
+    free_search_report(random);
+    free_search_report(serial);
+    free_search_report(parallel);
+    free_decision_tree(from_rows);
+    free_decision_tree(from_copy);
+    free_tree_presort(presort);
+    free(rows);
+    free(subset.data);
+    free(subset.labels);
+    free_matrix(data.data, data.rows);
+    free(data.labels);
+    
+    printf("✓ PASSÉ (meilleure AUC arbre=%.4f)\n", best_auc);
+}
+
+void test_drift_monitor() {
+    printf("Test 20: Suivi de dérive PSI/CSI et KS en flux... ");
+    
+    // Référence : deux features uniformes (la seconde avec 5 % de NaN) et un score
+    int n = 5000;
+    Dataset reference;
+    reference.rows = n;
+    reference.cols = 2;
+    reference.data = allocate_matrix(n, 2);
+    reference.labels = (int*)calloc(n, sizeof(int));
+    double* scores = (double*)malloc(n * sizeof(double));
+    srand(21);
+    for (int i = 0; i < n; i++) {
+        reference.data[i][0] = rand() / (double)RAND_MAX;
+        reference.data[i][1] = (i % 20 == 0) ? NAN : 100.0 * rand() / RAND_MAX;
+        scores[i] = rand() / (double)RAND_MAX;
+    }
+    DriftMonitor* monitor = create_drift_monitor(&reference, DRIFT_DEFAULT_BINS);
+    drift_monitor_fit_scores(monitor, scores, n);
+    
+    // Effectifs de référence : déciles (~n / 10 par intervalle), NaN dans la dernière case
+    long total = 0;
+    for (int b = 0; b <= monitor->feature_binner->n_bins[1]; b++) total += monitor->reference[1][b];
+    assert(total == n && monitor->reference[1][monitor->feature_binner->n_bins[1]] == n / 20);
+    assert(abs((int)monitor->reference[0][0] - n / 10) <= 1);
+    
+    // Même population en deux lots : aucune dérive
+    Dataset half = reference;
+    half.rows = n / 2;
+    drift_monitor_update(monitor, &half, scores);
+    half.data = reference.data + n / 2;
+    half.rows = n - n / 2;
+    drift_monitor_update(monitor, &half, scores + n / 2);
+    DriftReport* report = compute_drift_report(monitor);
+    assert(report->n_rows == n);
+    assert(report->features[0].psi < 1e-12 && report->features[1].ks < 1e-12 && report->score.psi < 1e-12);
+    free_drift_report(report);
+    
+    // Lot décalé sur la première feature et le score : dérive significative, seconde feature stable
+    drift_monitor_reset(monitor);
+    Dataset shifted;
+    shifted.rows = n;
+    shifted.cols = 2;
+    shifted.data = allocate_matrix(n, 2);
+    shifted.labels = reference.labels;
+    double* shifted_scores = (double*)malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        shifted.data[i][0] = reference.data[i][0] + 0.3;
+        shifted.data[i][1] = reference.data[(i + 1) % n][1];
+        shifted_scores[i] = scores[i] * scores[i];
+    }
+    drift_monitor_update(monitor, &shifted, shifted_scores);
+    report = compute_drift_report(monitor);
+    assert(report->features[0].psi >= DRIFT_PSI_SIGNIFICANT && fabs(report->features[0].ks - 0.3) < 0.03);
+    assert(report->features[1].psi < DRIFT_PSI_MODERATE);
+    assert(report->score.psi >= DRIFT_PSI_MODERATE);
+    
+    // Référence sauvegardée puis relue : même rapport sur le même lot
+    FILE* file = tmpfile();
+    write_drift_monitor(file, monitor);
+    rewind(file);
+    DriftMonitor* loaded = read_drift_monitor(file);
+    fclose(file);
+    assert(loaded != NULL && loaded->current_rows == 0);
+    drift_monitor_update(loaded, &shifted, shifted_scores);
+    DriftReport* reloaded = compute_drift_report(loaded);
+    assert(reloaded->features[0].psi == report->features[0].psi);
+    assert(reloaded->score.psi == report->score.psi);
+    double psi = report->features[0].psi;
+    
+    free_drift_report(report);
+    free_drift_report(reloaded);
+    free_drift_monitor(monitor);
+    free_drift_monitor(loaded);
+    free_matrix(shifted.data, n);
+    free_matrix(reference.data, n);
+    free(reference.labels);
+    free(scores);
+    free(shifted_scores);
+    
+    printf("✓ PASSÉ (CSI décalé=%.3f)\n", psi);
+}
+
+void test_permutation_importance() {
+    printf("Test 21: Importance par permutation (logistique et arbre)... ");
+    
+    // x0 détermine le label (10 % de bruit), x1 est du bruit, x2 est constante
+    int n = 4000;
+    Dataset data;
+    data.rows = n;
+    data.cols = 3;
+    data.data = allocate_matrix(n, 3);
+    data.labels = (int*)malloc(n * sizeof(int));
+    srand(50);
+    for (int i = 0; i < n; i++) {
+        data.data[i][0] = rand() / (double)RAND_MAX;
+        data.data[i][1] = rand() / (double)RAND_MAX;
+        data.data[i][2] = 1.0;
+        data.labels[i] = (data.data[i][0] > 0.5) != (rand() % 10 == 0);
+    }
+    double checksum = 0.0;
+    for (int i = 0; i < n; i++) checksum += data.data[i][0] * (i + 1) + data.data[i][1];
+    
+    LogisticRegression* model = create_logistic_regression(3, 0.1, 1);
+    model->weights[0] = 8.0;
+    model->weights[1] = 0.0;
+    model->weights[2] = 0.0;
+    model->bias = -4.0;
+    PermutationImportance* lr = permutation_importance_logistic(model, &data, 4, 7);
+    assert(lr && lr->n_features == 3 && lr->n_repeats == 4);
+    assert(lr->baseline > 0.85);
+    assert(lr->mean[0] > 0.3);
+    // Poids nul et colonne constante : probabilités inchangées, baisse exactement nulle
+    assert(lr->mean[1] == 0.0 && lr->std[1] == 0.0);
+    assert(lr->mean[2] == 0.0);
+    
+    DecisionTree* tree = create_decision_tree(3, 10, 5, GINI);
+    train_decision_tree(tree, &data);
+    PermutationImportance* dt = permutation_importance_tree(tree, &data, 4, 7);
+    assert(dt && dt->mean[0] > 0.3);
+    assert(fabs(dt->mean[1]) < 0.05 && dt->mean[2] == 0.0);
+    
+    // Flux aléatoire par (feature, répétition) : mêmes baisses quel que soit le nombre de threads
+    set_num_threads(1);
+    PermutationImportance* serial = permutation_importance_tree(tree, &data, 4, 7);
+    set_num_threads(0);
+    for (int k = 0; k < 3 * 4; k++) assert(serial->drops[k] == dt->drops[k]);
+    
+    // Le dataset partagé n'est pas modifié par les permutations
+    double after = 0.0;
+    for (int i = 0; i < n; i++) after += data.data[i][0] * (i + 1) + data.data[i][1];
+    assert(after == checksum);
+    
+    // Dimensions incompatibles refusées
+    data.cols = 2;
+    assert(permutation_importance_logistic(model, &data, 4, 7) == NULL);
+    data.cols = 3;
+    
+    double drop = lr->mean[0];
+    free_permutation_importance(lr);
+    free_permutation_importance(dt);
+    free_permutation_importance(serial);
+    free_logistic_regression(model);
+    free_decision_tree(tree);
+    free_matrix(data.data, n);
+    free(data.labels);
+    
+    printf("✓ PASSÉ (baisse d'AUC x0=%.3f)\n", drop);
+}
+
 int main() {
     printf("\n=== TESTS DES MÉTRIQUES ===\n\n");
     
@@ -262,6 +855,15 @@ int main() {
     test_auc_roc_intermediate();
     test_auc_roc_all_positive();
     test_auc_roc_all_negative();
+    test_metrics_report();
+    test_auc_roc_ties();
+    test_score_histogram();
+    test_threshold_sweep();
+    test_bootstrap_metrics();
+    test_cross_validation();
+    test_hyperparameter_search();
+    test_drift_monitor();
+    test_permutation_importance();
     
     printf("\n✓ Tous les tests sont passés avec succès!\n\n");
     return 0;
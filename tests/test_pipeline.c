@@ -0,0 +1,525 @@
+/*****************************************************************************************************
+
+Nom : tests/test_pipeline.c
+
+Rôle : Tests unitaires pour le pipeline de scoring bout-en-bout
+
+Auteur : Maxime BRONNY
+
+Version : V1
+
+Licence : Réalisé dans le cadre du cours Technique d'intelligence artificiel M1 INFORMATIQUE BIG-DATA
+
+Usage : Pour compiler : make
+        Pour executer : ./test_pipeline
+
+******************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+#include "../src/models/pipeline.h"
+#include "../src/data/schema.h"
+#include "../src/preprocessing/preprocessing.h"
+#include "../src/utils/memory_manager.h"
+#include "../src/utils/utils.h"
+
+/*
+ * CSV brut de test : age, housing (catégorielle), label, income
+ * Features : [age, housing, income]
+ */
+static Dataset* make_raw_dataset(int n) {
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = n;
+    dataset->cols = 3;
+    dataset->data = allocate_matrix(n, 3);
+    dataset->labels = (int*)safe_malloc(n * sizeof(int));
+
+    unsigned int state = 777;
+    for (int i = 0; i < n; i++) {
+        state = state * 1103515245u + 12345u;
+        double noise = ((state >> 8) % 1000) / 1000.0;
+        dataset->data[i][0] = 20.0 + (i % 40);
+        dataset->data[i][1] = (double)(i % 3);
+        dataset->data[i][2] = 10000.0 + 500.0 * (i % 50) + 1000.0 * noise;
+        dataset->labels[i] = (dataset->data[i][0] + 10.0 * dataset->data[i][1] > 45.0) ? 1 : 0;
+    }
+    return dataset;
+}
+
+static Pipeline* make_pipeline(Scaler* scaler, double* impute_values) {
+    Pipeline* pipeline = create_pipeline(4, 2, impute_values, scaler);
+    assert(pipeline != NULL);
+
+    CategoryDictionary* housing = create_category_dictionary(0);
+    add_category(housing, "RENT", 0);
+    add_category(housing, "OWN", 1);
+    add_category(housing, "MORTGAGE", 2);
+    pipeline_set_dictionary(pipeline, 1, housing);
+    free_category_dictionary(housing);
+    return pipeline;
+}
+
+/*
+ * Dictionnaire d'une colonne du schéma Credit Risk (data/schema/credit_risk.schema), NULL si elle n'en a pas
+ */
+static CategoryDictionary* schema_dictionary(Schema* schema, const char* name) {
+    for (int c = 0; c < schema->n_columns; c++) {
+        if (strcmp(schema->columns[c].name, name) == 0) return schema->columns[c].dictionary;
+    }
+    return NULL;
+}
+
+void test_category_dictionary() {
+    printf("Test 1: Dictionnaire de modalités... ");
+
+    Schema* schema = load_schema("../data/schema/credit_risk.schema");
+    assert(schema != NULL);
+    CategoryDictionary* dict = schema_dictionary(schema, "loan_grade");
+    assert(dict != NULL);
+
+    // Recherche directement dans un buffer, sans terminateur après la modalité
+    const char* line = "C,0.2";
+    int found;
+    assert(lookup_category(dict, line, 1, &found) == 3 && found == 1);
+    assert(lookup_category(dict, "G", 1, &found) == 7 && found == 1);
+    assert(lookup_category(dict, "Z", 1, &found) == 3 && found == 0);
+    assert(lookup_category(dict, "AB", 2, &found) == 3 && found == 0);
+    assert(schema_dictionary(schema, "person_age") == NULL);
+
+    free_schema(schema);
+
+    printf("✓ PASSÉ\n");
+}
+
+void test_perfect_hash_encoder() {
+    printf("Test 2: Encodeur appris par hachage parfait... ");
+
+    // Les dictionnaires compilés du schéma reproduisent exactement les fonctions encode_*
+    const char* homes[] = {"RENT", "OWN", "MORTGAGE", "OTHER", "BOAT", "", "RENTAL"};
+    const char* intents[] = {"PERSONAL", "EDUCATION", "MEDICAL", "VENTURE", "HOMEIMPROVEMENT", "DEBTCONSOLIDATION", "TRAVEL"};
+    const char* grades[] = {"A", "B", "C", "D", "E", "F", "G", "H", "AA"};
+    const char* defaults[] = {"N", "Y", "YES"};
+    Schema* schema = load_schema("../data/schema/credit_risk.schema");
+    assert(schema != NULL);
+    CategoryDictionary* home = schema_dictionary(schema, "person_home_ownership");
+    CategoryDictionary* intent = schema_dictionary(schema, "loan_intent");
+    CategoryDictionary* grade = schema_dictionary(schema, "loan_grade");
+    CategoryDictionary* flag = schema_dictionary(schema, "cb_person_default_on_file");
+    assert(home->table_size == home->n_values && grade->table_size == grade->n_values);
+
+    for (int k = 0; k < 7; k++) {
+        assert(lookup_category(home, homes[k], (int)strlen(homes[k]), NULL) == encode_home_ownership(homes[k]));
+        assert(lookup_category(intent, intents[k], (int)strlen(intents[k]), NULL) == encode_loan_intent(intents[k]));
+    }
+    for (int k = 0; k < 9; k++) {
+        assert(lookup_category(grade, grades[k], (int)strlen(grades[k]), NULL) == encode_loan_grade(grades[k]));
+    }
+    for (int k = 0; k < 3; k++) {
+        assert(lookup_category(flag, defaults[k], (int)strlen(defaults[k]), NULL) == encode_default_on_file(defaults[k]));
+    }
+    free_schema(schema);
+
+    // Vocabulaire appris : codes dans l'ordre lexicographique, inconnues signalées
+    int n = 3000;
+    char** names = (char**)safe_malloc(n * sizeof(char*));
+    for (int i = 0; i < n; i++) {
+        names[i] = (char*)safe_malloc(16);
+        snprintf(names[i], 16, "cat_%04d", (i * 7) % 1000);
+    }
+    CategoryDictionary* learned = fit_category_dictionary((const char**)names, n, CATEGORY_UNSEEN);
+    assert(learned->n_values == 1000 && learned->slots != NULL);
+
+    int found;
+    char buffer[32];
+    for (int v = 0; v < 1000; v++) {
+        snprintf(buffer, sizeof(buffer), "cat_%04d,x", v);
+        assert(lookup_category(learned, buffer, 8, &found) == v && found == 1);
+    }
+    assert(lookup_category(learned, "cat_1000", 8, &found) == CATEGORY_UNSEEN && found == 0);
+    assert(lookup_category(learned, "cat_00", 6, &found) == CATEGORY_UNSEEN && found == 0);
+
+    for (int i = 0; i < n; i++) free(names[i]);
+    free(names);
+    free_category_dictionary(learned);
+
+    printf("✓ PASSÉ\n");
+}
+
+void test_pipeline_score_logistic() {
+    printf("Test 3: Scoring d'une ligne brute (régression logistique)... ");
+
+    Dataset* dataset = make_raw_dataset(300);
+    double* impute_values = fit_missing_values(dataset);
+    Scaler* scaler = fit_scaler(dataset);
+    Pipeline* pipeline = make_pipeline(scaler, impute_values);
+
+    transform_dataset(dataset, scaler);
+    LogisticRegression* model = create_logistic_regression(3, 0.1, 300);
+    train_logistic_regression(model, dataset);
+    pipeline_set_logistic(pipeline, model);
+
+    double sample[3] = {42.0, 2.0, 15500.0};
+    double z = model->bias;
+    for (int j = 0; j < 3; j++) {
+        z += model->weights[j] * (sample[j] - scaler->mean[j]) / scaler->std[j];
+    }
+    double expected = sigmoid(z);
+
+    assert(fabs(pipeline_score(pipeline, "42,MORTGAGE,1,15500", NULL) - expected) < 1e-9);
+    assert(fabs(pipeline_score(pipeline, "42,MORTGAGE,15500\n", NULL) - expected) < 1e-9);
+
+    // Champ vide : valeur d'imputation
+    z += model->weights[2] * (impute_values[2] - sample[2]) / scaler->std[2];
+    expected = sigmoid(z);
+    assert(fabs(pipeline_score(pipeline, "42,MORTGAGE,1,", NULL) - expected) < 1e-9);
+    // Champ partiellement numérique : manquant, comme au chargement du CSV d'entraînement
+    assert(fabs(pipeline_score(pipeline, "42,MORTGAGE,1,15500abc", NULL) - expected) < 1e-9);
+
+    // Modalité inconnue d'un dictionnaire appris : signalée puis imputée
+    const char* housing_values[] = {"MORTGAGE", "OWN", "RENT"};
+    CategoryDictionary* learned = fit_category_dictionary(housing_values, 3, CATEGORY_UNSEEN);
+    pipeline_set_dictionary(pipeline, 1, learned);
+    free_category_dictionary(learned);
+    int n_unseen;
+    double unseen_score = pipeline_score(pipeline, "42,BOAT,1,", &n_unseen);
+    assert(n_unseen == 1);
+    z += model->weights[1] * (impute_values[1] - sample[1]) / scaler->std[1];
+    assert(fabs(unseen_score - sigmoid(z)) < 1e-9);
+    pipeline_score(pipeline, "42,RENT,1,", &n_unseen);
+    assert(n_unseen == 0);
+
+    // Nombre de champs incohérent
+    assert(pipeline_score(pipeline, "42,MORTGAGE", NULL) == -1.0);
+
+    free_pipeline(pipeline);
+    free_logistic_regression(model);
+    free_scaler(scaler);
+    free(impute_values);
+    free_dataset(dataset);
+
+    printf("✓ PASSÉ\n");
+}
+
+void test_pipeline_save_load() {
+    printf("Test 4: Sauvegarde/chargement du pipeline (régression et arbre)... ");
+
+    Dataset* dataset = make_raw_dataset(300);
+    double* impute_values = fit_missing_values(dataset);
+    Scaler* scaler = fit_scaler(dataset);
+    Pipeline* pipeline = make_pipeline(scaler, impute_values);
+
+    transform_dataset(dataset, scaler);
+    LogisticRegression* model = create_logistic_regression(3, 0.1, 200);
+    train_logistic_regression(model, dataset);
+    DecisionTree* tree = create_decision_tree(4, 10, 5, GINI);
+    train_decision_tree(tree, dataset);
+
+    const char* lines[3] = {"25,RENT,0,12000", "58,OWN,1,", "33,UNKNOWN,0,30000"};
+
+    pipeline_set_logistic(pipeline, model);
+    save_pipeline("test_pipeline.bin", pipeline);
+    Pipeline* loaded = load_pipeline("test_pipeline.bin");
+    assert(loaded != NULL && loaded->model_type == PIPELINE_LOGISTIC);
+    assert(loaded->dictionaries[1] != NULL && loaded->dictionaries[0] == NULL);
+    for (int k = 0; k < 3; k++) {
+        assert(pipeline_score(loaded, lines[k], NULL) == pipeline_score(pipeline, lines[k], NULL));
+    }
+    free_pipeline(loaded);
+
+    pipeline_set_tree(pipeline, tree);
+    save_pipeline("test_pipeline.bin", pipeline);
+    loaded = load_pipeline("test_pipeline.bin");
+    assert(loaded != NULL && loaded->model_type == PIPELINE_TREE);
+    assert(count_tree_nodes(loaded->tree) == count_tree_nodes(tree));
+
+    // L'arbre du pipeline reproduit l'arbre entraîné sur les features normalisées
+    Dataset* single = make_raw_dataset(1);
+    single->data[0][0] = 58.0;
+    single->data[0][1] = 1.0;
+    single->data[0][2] = impute_values[2];
+    transform_dataset(single, scaler);
+    double* expected = get_tree_probabilities(tree, single);
+    assert(fabs(pipeline_score(loaded, lines[1], NULL) - expected[0]) < 1e-12);
+    free(expected);
+    free_dataset(single);
+    remove("test_pipeline.bin");
+
+    free_pipeline(loaded);
+    free_pipeline(pipeline);
+    free_decision_tree(tree);
+    free_logistic_regression(model);
+    free_scaler(scaler);
+    free(impute_values);
+    free_dataset(dataset);
+
+    printf("✓ PASSÉ\n");
+}
+
+void test_calibration() {
+    printf("Test 5: Calibration Platt et isotonique (PAV), dans le pipeline... ");
+
+    // PAV : (0.2, 1), (0.3, 0), (0.4, 0) fusionnés en un palier 1/3 ; (0.5, 1), (0.6, 1) en un palier 1
+    double scores[6] = {0.6, 0.1, 0.3, 0.5, 0.2, 0.4};
+    int labels[6] = {1, 0, 0, 1, 1, 0};
+    Calibrator* isotonic = fit_isotonic_calibrator(scores, labels, 6);
+    assert(isotonic->method == CALIBRATION_ISOTONIC && isotonic->n_knots == 5);
+    assert(fabs(calibrate_probability(isotonic, 0.05) - 0.0) < 1e-12);
+    assert(fabs(calibrate_probability(isotonic, 0.15) - 1.0 / 6.0) < 1e-12);
+    assert(fabs(calibrate_probability(isotonic, 0.3) - 1.0 / 3.0) < 1e-12);
+    assert(fabs(calibrate_probability(isotonic, 0.45) - 2.0 / 3.0) < 1e-12);
+    assert(fabs(calibrate_probability(isotonic, 0.9) - 1.0) < 1e-12);
+    free_calibrator(isotonic);
+
+    // Platt : labels tirés selon sigmoid(2 * logit(p) - 0.5), retrouvés à l'échantillonnage près
+    int n = 20000;
+    double* raw = (double*)malloc(n * sizeof(double));
+    int* y = (int*)malloc(n * sizeof(int));
+    unsigned int state = 31;
+    for (int i = 0; i < n; i++) {
+        double z = -3.0 + 6.0 * i / n;
+        state = state * 1103515245u + 12345u;
+        double u = ((state >> 8) & 0xFFFF) / 65536.0;
+        raw[i] = 1.0 / (1.0 + exp(-z));
+        y[i] = u < 1.0 / (1.0 + exp(-(2.0 * z - 0.5)));
+    }
+    Calibrator* platt = fit_platt_calibrator(raw, y, n);
+    assert(fabs(platt->a - 2.0) < 0.15 && fabs(platt->b + 0.5) < 0.1);
+
+    // Isotonique : croissante, et meilleur Brier que les scores bruts sur ses propres données
+    isotonic = fit_isotonic_calibrator(raw, y, n);
+    double* calibrated = (double*)malloc(n * sizeof(double));
+    calibrate_probabilities(isotonic, raw, calibrated, n);
+    for (int i = 1; i < n; i++) assert(calibrated[i] >= calibrated[i - 1]);
+    assert(compute_brier_score(calibrated, y, n) < compute_brier_score(raw, y, n));
+
+    // Pipeline : calibrateur sauvegardé dans l'artefact, appliqué au score, retiré au changement de modèle
+    Dataset* dataset = make_raw_dataset(300);
+    double* impute_values = fit_missing_values(dataset);
+    Scaler* scaler = fit_scaler(dataset);
+    Pipeline* pipeline = make_pipeline(scaler, impute_values);
+    transform_dataset(dataset, scaler);
+    LogisticRegression* model = create_logistic_regression(3, 0.1, 200);
+    model->verbose = 0;
+    train_logistic_regression(model, dataset);
+
+    const char* line = "33,OWN,0,30000";
+    pipeline_set_logistic(pipeline, model);
+    double uncalibrated = pipeline_score(pipeline, line, NULL);
+    pipeline_set_calibrator(pipeline, platt);
+    save_pipeline("test_pipeline.bin", pipeline);
+    Pipeline* loaded = load_pipeline("test_pipeline.bin");
+    assert(loaded != NULL && loaded->calibrator != NULL && loaded->calibrator->a == platt->a);
+    assert(pipeline_score(loaded, line, NULL) == calibrate_probability(platt, uncalibrated));
+    free_pipeline(loaded);
+
+    pipeline_set_calibrator(pipeline, isotonic);
+    save_pipeline("test_pipeline.bin", pipeline);
+    loaded = load_pipeline("test_pipeline.bin");
+    assert(loaded->calibrator->n_knots == isotonic->n_knots);
+    assert(pipeline_score(loaded, line, NULL) == calibrate_probability(isotonic, uncalibrated));
+    free_pipeline(loaded);
+    remove("test_pipeline.bin");
+
+    DecisionTree* tree = create_decision_tree(3, 10, 5, GINI);
+    train_decision_tree(tree, dataset);
+    pipeline_set_tree(pipeline, tree);
+    assert(pipeline->calibrator == NULL);
+
+    free_pipeline(pipeline);
+    free_decision_tree(tree);
+    free_logistic_regression(model);
+    free_scaler(scaler);
+    free(impute_values);
+    free_dataset(dataset);
+    free_calibrator(platt);
+    free_calibrator(isotonic);
+    free(calibrated);
+    free(raw);
+    free(y);
+
+    printf("✓ PASSÉ\n");
+}
+
+void test_pipeline_drift() {
+    printf("Test 6: Suivi de dérive alimenté par pipeline_score... ");
+
+    // Référence : features brutes imputées et probabilités du modèle avant calibration sur le train
+    int n = 2000;
+    Dataset* dataset = make_raw_dataset(n);
+    const char* housing[] = {"RENT", "OWN", "MORTGAGE"};
+    char** lines = (char**)malloc(n * sizeof(char*));
+    char** shifted = (char**)malloc(n * sizeof(char*));
+    for (int i = 0; i < n; i++) {
+        lines[i] = (char*)malloc(64);
+        shifted[i] = (char*)malloc(64);
+        snprintf(lines[i], 64, "%.0f,%s,%d,%.0f", dataset->data[i][0], housing[(int)dataset->data[i][1]],
+                 dataset->labels[i], dataset->data[i][2]);
+        snprintf(shifted[i], 64, "%.0f,%s,%d,%.0f", dataset->data[i][0] + 30.0, housing[(int)dataset->data[i][1]],
+                 dataset->labels[i], dataset->data[i][2]);
+    }
+    DriftMonitor* monitor = create_drift_monitor(dataset, DRIFT_DEFAULT_BINS);
+    double* impute_values = fit_missing_values(dataset);
+    Scaler* scaler = fit_scaler(dataset);
+    Pipeline* pipeline = make_pipeline(scaler, impute_values);
+    transform_dataset(dataset, scaler);
+    LogisticRegression* model = create_logistic_regression(3, 0.1, 200);
+    model->verbose = 0;
+    train_logistic_regression(model, dataset);
+    double* probabilities = predict_proba(model, dataset);
+    drift_monitor_fit_scores(monitor, probabilities, n);
+
+    // Calibrateur isotonique : change l'échelle des probabilités servies, pas celle du score suivi
+    Calibrator* isotonic = fit_isotonic_calibrator(probabilities, dataset->labels, n);
+    pipeline_set_logistic(pipeline, model);
+    pipeline_set_calibrator(pipeline, isotonic);
+    assert(pipeline_drift_report(pipeline) == NULL);
+    pipeline_set_drift_monitor(pipeline, monitor);
+    free_drift_monitor(monitor);
+    save_pipeline("test_pipeline.bin", pipeline);
+    
+    // Setters : argument copié, jamais libéré, même refusé (le moniteur installé est conservé)
+    Dataset two_features = *dataset;
+    two_features.cols = 2;
+    DriftMonitor* wrong = create_drift_monitor(&two_features, DRIFT_DEFAULT_BINS);
+    pipeline_set_drift_monitor(pipeline, wrong);
+    assert(wrong->n_features == 2 && pipeline->monitor->n_features == 3);
+    free_drift_monitor(wrong);
+    CategoryDictionary* label_dict = create_category_dictionary(0);
+    pipeline_set_dictionary(pipeline, 2, label_dict);
+    assert(label_dict->n_values == 0 && pipeline->dictionaries[2] == NULL);
+    free_category_dictionary(label_dict);
+
+    // Les lignes du train scorées par l'artefact rechargé : aucune dérive, ni des features ni du score
+    Pipeline* loaded = load_pipeline("test_pipeline.bin");
+    assert(loaded != NULL && loaded->monitor != NULL && loaded->monitor->current_rows == 0);
+    for (int i = 0; i < n; i++) assert(pipeline_score(loaded, lines[i], NULL) >= 0.0);
+    assert(pipeline_score(loaded, "42,MORTGAGE", NULL) == -1.0);
+    DriftReport* report = pipeline_drift_report(loaded);
+    assert(report->n_rows == n);
+    for (int j = 0; j < 3; j++) assert(report->features[j].psi < 1e-9 && report->features[j].ks < 1e-9);
+    assert(report->score.psi < 0.01);
+    free_drift_report(report);
+    free_pipeline(loaded);
+
+    // Âges décalés de 30 ans : dérive significative de la feature et du score
+    loaded = load_pipeline("test_pipeline.bin");
+    for (int i = 0; i < n; i++) pipeline_score(loaded, shifted[i], NULL);
+    report = pipeline_drift_report(loaded);
+    assert(report->features[0].psi >= DRIFT_PSI_SIGNIFICANT && report->features[2].psi < 1e-9);
+    assert(report->score.psi >= DRIFT_PSI_SIGNIFICANT);
+    double psi = report->features[0].psi;
+    free_drift_report(report);
+    free_pipeline(loaded);
+    remove("test_pipeline.bin");
+
+    for (int i = 0; i < n; i++) {
+        free(lines[i]);
+        free(shifted[i]);
+    }
+    free(lines);
+    free(shifted);
+    free(probabilities);
+    free_calibrator(isotonic);
+    free_pipeline(pipeline);
+    free_logistic_regression(model);
+    free_scaler(scaler);
+    free(impute_values);
+    free_dataset(dataset);
+
+    printf("✓ PASSÉ (CSI âge décalé=%.3f)\n", psi);
+}
+
+/*
+ * Réécrit test_pipeline.bin en modifiant l'entier situé à offset octets après l'en-tête de la
+ * section tag (tag 2 = imputation, 5 = arbre), puis retourne le résultat de load_pipeline
+ */
+static Pipeline* load_corrupted(const unsigned char* bytes, long length, int tag, long offset, int value) {
+    unsigned char* copy = (unsigned char*)safe_malloc(length);
+    memcpy(copy, bytes, length);
+
+    long position = 2 * sizeof(int);
+    while (position + 2 * (long)sizeof(int) <= length) {
+        int section_tag, size;
+        memcpy(&section_tag, copy + position, sizeof(int));
+        memcpy(&size, copy + position + sizeof(int), sizeof(int));
+        if (section_tag == tag) {
+            memcpy(copy + position + offset, &value, sizeof(int));
+            break;
+        }
+        position += 2 * sizeof(int) + size;
+    }
+
+    FILE* file = fopen("test_pipeline.bin", "wb");
+    fwrite(copy, 1, length, file);
+    fclose(file);
+    safe_free(copy);
+    return load_pipeline("test_pipeline.bin");
+}
+
+void test_corrupted_artifact() {
+    printf("Test 7: Rejet des artefacts corrompus... ");
+
+    Dataset* dataset = make_raw_dataset(300);
+    double* impute_values = fit_missing_values(dataset);
+    Scaler* scaler = fit_scaler(dataset);
+    Pipeline* pipeline = make_pipeline(scaler, impute_values);
+
+    transform_dataset(dataset, scaler);
+    DecisionTree* tree = create_decision_tree(4, 10, 5, GINI);
+    train_decision_tree(tree, dataset);
+    assert(!tree->root->is_leaf);
+    pipeline_set_tree(pipeline, tree);
+    save_pipeline("test_pipeline.bin", pipeline);
+
+    FILE* file = fopen("test_pipeline.bin", "rb");
+    assert(file != NULL);
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* bytes = (unsigned char*)safe_malloc(length);
+    assert(fread(bytes, 1, length, file) == (size_t)length);
+    fclose(file);
+
+    // Racine de l'arbre : en-tête (8) + paramètres (16) + is_leaf, predicted_class, class_probability (16)
+    long root_feature = 2 * sizeof(int) + 4 * sizeof(int) + 2 * sizeof(int) + sizeof(double);
+    Pipeline* loaded = load_corrupted(bytes, length, 5, root_feature, 0);
+    assert(loaded != NULL);
+    free_pipeline(loaded);
+    assert(load_corrupted(bytes, length, 5, root_feature, 3) == NULL);
+    assert(load_corrupted(bytes, length, 5, root_feature, -1) == NULL);
+
+    // Taille annoncée de la section d'imputation (3 doubles) différente des octets lus
+    loaded = load_corrupted(bytes, length, 2, sizeof(int), 3 * sizeof(double));
+    assert(loaded != NULL);
+    free_pipeline(loaded);
+    assert(load_corrupted(bytes, length, 2, sizeof(int), 4 * sizeof(double)) == NULL);
+    assert(load_corrupted(bytes, length, 2, sizeof(int), 2 * sizeof(double)) == NULL);
+    remove("test_pipeline.bin");
+
+    safe_free(bytes);
+    free_pipeline(pipeline);
+    free_decision_tree(tree);
+    free_scaler(scaler);
+    free(impute_values);
+    free_dataset(dataset);
+
+    printf("✓ PASSÉ\n");
+}
+
+int main() {
+    printf("\n=== TESTS DU PIPELINE DE SCORING ===\n\n");
+
+    test_category_dictionary();
+    test_perfect_hash_encoder();
+    test_pipeline_score_logistic();
+    test_pipeline_save_load();
+    test_calibration();
+    test_pipeline_drift();
+    test_corrupted_artifact();
+
+    printf("\n✓ Tous les tests sont passés avec succès!\n\n");
+    return 0;
+}
@@ -23,6 +23,13 @@ Usage : Pour compiler : make
 #include "../src/preprocessing/scaler.h"
 #include "../src/utils/csv_parser.h"
 #include "../src/utils/memory_manager.h"
+#include "../src/preprocessing/feature_hasher.h"
+#include "../src/utils/parallel.h"
+#include "../src/utils/utils.h"
+#include "../src/preprocessing/encoder.h"
+#include "../src/preprocessing/imputer.h"
+#include "../src/utils/quantile_sketch.h"
+#include "../src/preprocessing/binner.h"
 
 void test_scaler_fit() {
     printf("Test 1: Calcul des paramètres du scaler... ");
@@ -204,6 +211,558 @@ void test_preprocess_dataset() {
     printf("✓ PASSÉ\n");
 }
 
+void test_feature_hasher() {
+    printf("Test 6: Hachage de features catégorielles... ");
+    
+    FeatureHasher* hasher = create_feature_hasher(2, 1024, 1, 0);
+    
+    double sign_a, sign_b;
+    int col_a = hash_feature(hasher, "merchant", "GROCERY", &sign_a);
+    int col_b = hash_feature(hasher, "merchant", "GROCERY", &sign_b);
+    assert(col_a == col_b && sign_a == sign_b);
+    assert(col_a >= 2 && col_a < 2 + 1024);
+    assert(sign_a == 1.0 || sign_a == -1.0);
+    
+    // Le nom de colonne fait partie de la clé
+    int col_c = hash_feature(hasher, "region", "GROCERY", NULL);
+    assert(col_c >= 2 && col_c < 2 + 1024);
+    
+    SparseDataset* sparse = create_sparse_dataset(2 + 1024);
+    double dense[] = {1.5, 0.0};
+    const char* names[] = {"merchant", "merchant", "region"};
+    const char* values[] = {"GROCERY", "GROCERY", "NORTH"};
+    hasher_add_row(hasher, sparse, dense, names, values, 3, 1);
+    
+    // 1 valeur dense non nulle + 2 colonnes hachées (doublon fusionné)
+    assert(sparse->rows == 1);
+    assert(sparse->labels[0] == 1);
+    int nnz = sparse->row_ptr[1] - sparse->row_ptr[0];
+    assert(nnz == 3 || nnz == 2);
+    assert(sparse->col_idx[0] == 0 && sparse->values[0] == 1.5);
+    for (int k = 1; k < nnz; k++) {
+        if (sparse->col_idx[k] == col_a) {
+            assert(fabs(sparse->values[k] - 2.0 * sign_a) < 1e-12);
+        }
+    }
+    
+    free_sparse_dataset(sparse);
+    free_feature_hasher(hasher);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_running_stats_merge() {
+    printf("Test 7: Statistiques Welford fusionnables et parallèles... ");
+    
+    int n = 10000;
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = n;
+    dataset->cols = 2;
+    dataset->data = allocate_matrix(n, 2);
+    dataset->labels = (int*)safe_malloc(n * sizeof(int));
+    
+    double sum0 = 0.0, sum1 = 0.0;
+    int count1 = 0;
+    for (int i = 0; i < n; i++) {
+        dataset->data[i][0] = 1e6 + (i % 97) * 0.5;
+        dataset->data[i][1] = (i % 5 == 0) ? NAN : (double)(i % 13);
+        dataset->labels[i] = 0;
+        sum0 += dataset->data[i][0];
+        if (i % 5 != 0) { sum1 += dataset->data[i][1]; count1++; }
+    }
+    double mean0 = sum0 / n, mean1 = sum1 / count1;
+    double ss0 = 0.0;
+    for (int i = 0; i < n; i++) {
+        ss0 += (dataset->data[i][0] - mean0) * (dataset->data[i][0] - mean0);
+    }
+    
+    // Accumulation en deux partitions fusionnées == une seule passe
+    RunningStats* part_a = create_running_stats(2);
+    RunningStats* part_b = create_running_stats(2);
+    update_running_stats(part_a, dataset->data, 3000);
+    update_running_stats(part_b, dataset->data + 3000, n - 3000);
+    merge_running_stats(part_a, part_b);
+    
+    assert(part_a->count[0] == n);
+    assert(part_a->count[1] == count1);
+    assert(fabs(part_a->mean[0] - mean0) < 1e-6);
+    assert(fabs(part_a->mean[1] - mean1) < 1e-9);
+    assert(fabs(part_a->m2[0] - ss0) / ss0 < 1e-9);
+    
+    // Résultat identique quel que soit le nombre de threads
+    set_num_threads(1);
+    Scaler* sequential = fit_scaler(dataset);
+    set_num_threads(4);
+    Scaler* parallel = fit_scaler(dataset);
+    set_num_threads(0);
+    for (int j = 0; j < 2; j++) {
+        assert(sequential->mean[j] == parallel->mean[j]);
+        assert(sequential->std[j] == parallel->std[j]);
+    }
+    assert(fabs(parallel->std[0] - sqrt(ss0 / n)) < 1e-6);
+    
+    // Sauvegarde / rechargement pour fusion ultérieure
+    save_running_stats("test_stats.txt", part_a);
+    RunningStats* loaded = load_running_stats("test_stats.txt");
+    assert(loaded != NULL && loaded->count[1] == count1);
+    assert(loaded->mean[0] == part_a->mean[0]);
+    remove("test_stats.txt");
+    
+    free_running_stats(part_a);
+    free_running_stats(part_b);
+    free_running_stats(loaded);
+    free_scaler(sequential);
+    free_scaler(parallel);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_one_hot_encoder() {
+    printf("Test 8: Encodage one-hot creux... ");
+    
+    // Colonnes : [montant, intent (codes 0..2), taux]
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = 4;
+    dataset->cols = 3;
+    dataset->data = allocate_matrix(4, 3);
+    dataset->labels = (int*)safe_calloc(4, sizeof(int));
+    double codes[4] = {0.0, 2.0, 1.0, 2.0};
+    for (int i = 0; i < 4; i++) {
+        dataset->data[i][0] = 100.0 * (i + 1);
+        dataset->data[i][1] = codes[i];
+        dataset->data[i][2] = 0.1 * (i + 1);
+    }
+    
+    int columns[1] = {1};
+    OneHotEncoder* encoder = fit_one_hot_encoder(dataset, columns, 1);
+    assert(encoder->n_output == 5);
+    
+    int indices[3];
+    double values[3];
+    int count = one_hot_transform_row(encoder, dataset->data[1], indices, values);
+    assert(count == 3);
+    assert(indices[0] == 0 && values[0] == 200.0);
+    assert(indices[1] == 1 && fabs(values[1] - 0.2) < 1e-12);
+    assert(indices[2] == 2 + 2 && values[2] == 1.0);
+    
+    // Modalité inconnue : aucune indicatrice active
+    double unseen[3] = {50.0, 7.0, 0.3};
+    assert(one_hot_transform_row(encoder, unseen, indices, values) == 2);
+    
+    SparseDataset* sparse = one_hot_transform(encoder, dataset);
+    assert(sparse->rows == 4 && sparse->cols == 5 && sparse->nnz == 12);
+    
+    save_one_hot_encoder("test_onehot.bin", encoder);
+    OneHotEncoder* loaded = load_one_hot_encoder("test_onehot.bin");
+    assert(loaded != NULL && loaded->n_output == 5);
+    int loaded_indices[3];
+    double loaded_values[3];
+    assert(one_hot_transform_row(loaded, dataset->data[2], loaded_indices, loaded_values) == 3);
+    assert(loaded_indices[2] == 2 + 1);
+    remove("test_onehot.bin");
+    
+    // Codes 1..7 (loan_grade) : 7 colonnes, pas de colonne pour le code 0 ; un code aberrant est ignoré
+    Dataset* grades = (Dataset*)safe_malloc(sizeof(Dataset));
+    grades->rows = 8;
+    grades->cols = 3;
+    grades->data = allocate_matrix(8, 3);
+    grades->labels = (int*)safe_calloc(8, sizeof(int));
+    for (int i = 0; i < 8; i++) {
+        grades->data[i][0] = 100.0;
+        grades->data[i][1] = (i < 7) ? (double)(i + 1) : 1e9;
+        grades->data[i][2] = 0.1;
+    }
+    OneHotEncoder* grade_encoder = fit_one_hot_encoder(grades, columns, 1);
+    assert(grade_encoder->n_output == 2 + 7);
+    assert(one_hot_transform_row(grade_encoder, grades->data[0], indices, values) == 3 && indices[2] == 2);
+    assert(one_hot_transform_row(grade_encoder, grades->data[6], indices, values) == 3 && indices[2] == 2 + 6);
+    assert(one_hot_transform_row(grade_encoder, grades->data[7], indices, values) == 2);
+    free_one_hot_encoder(grade_encoder);
+    free_dataset(grades);
+    
+    free_sparse_dataset(sparse);
+    free_one_hot_encoder(encoder);
+    free_one_hot_encoder(loaded);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_woe_encoder() {
+    printf("Test 9: Encodage WoE hors-pli... ");
+    
+    // Code 0 : 3 bons / 1 mauvais, code 1 : 1 bon / 3 mauvais
+    int n = 8;
+    double codes[8] = {0, 1, 0, 1, 0, 1, 0, 1};
+    int labels[8] = {0, 1, 0, 1, 0, 0, 1, 1};
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = n;
+    dataset->cols = 1;
+    dataset->data = allocate_matrix(n, 1);
+    dataset->labels = (int*)safe_malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        dataset->data[i][0] = codes[i];
+        dataset->labels[i] = labels[i];
+    }
+    
+    int columns[1] = {0};
+    TargetEncoder* encoder = create_target_encoder(TARGET_WOE, columns, 1, 0.5);
+    fit_target_encoder(encoder, dataset);
+    assert(fabs(encoder->values[0][0] - log(3.5 / 1.5)) < 1e-12);
+    assert(fabs(encoder->values[0][1] + log(3.5 / 1.5)) < 1e-12);
+    assert(target_encode_value(encoder, 0, 9.0) == 0.0);
+    
+    // Hors-pli (2 plis) : les lignes paires sont encodées avec les effectifs des lignes impaires
+    Dataset odd = {(double**)safe_malloc(4 * sizeof(double*)), (int*)safe_malloc(4 * sizeof(int)), 4, 1};
+    for (int i = 0; i < 4; i++) {
+        odd.data[i] = dataset->data[2 * i + 1];
+        odd.labels[i] = dataset->labels[2 * i + 1];
+    }
+    TargetEncoder* odd_encoder = create_target_encoder(TARGET_WOE, columns, 1, 0.5);
+    fit_target_encoder(odd_encoder, &odd);
+    double expected_row0 = target_encode_value(odd_encoder, 0, 0.0);
+    
+    fit_transform_target_encoder(encoder, dataset, 2);
+    assert(fabs(dataset->data[0][0] - expected_row0) < 1e-12);
+    // L'état de scoring reste celui ajusté sur tout le dataset
+    assert(fabs(encoder->values[0][0] - log(3.5 / 1.5)) < 1e-12);
+    
+    save_target_encoder("test_woe.bin", encoder);
+    TargetEncoder* loaded = load_target_encoder("test_woe.bin");
+    assert(loaded != NULL && loaded->mode == TARGET_WOE);
+    assert(target_encode_value(loaded, 0, 1.0) == encoder->values[0][1]);
+    
+    // Artefact corrompu : colonne hors de [0, n_input) ou mode inconnu (mode, lissage, n_input, n_columns, colonne)
+    FILE* file = fopen("test_woe.bin", "r+b");
+    int bad_column = 1;
+    fseek(file, 2 * sizeof(int) + sizeof(double) + sizeof(int), SEEK_SET);
+    fwrite(&bad_column, sizeof(int), 1, file);
+    fclose(file);
+    assert(load_target_encoder("test_woe.bin") == NULL);
+    save_target_encoder("test_woe.bin", encoder);
+    file = fopen("test_woe.bin", "r+b");
+    int bad_mode = 7;
+    fwrite(&bad_mode, sizeof(int), 1, file);
+    fclose(file);
+    assert(load_target_encoder("test_woe.bin") == NULL);
+    remove("test_woe.bin");
+    
+    // Largeur différente de celle de l'ajustement : dataset laissé intact
+    Dataset* wide = (Dataset*)safe_malloc(sizeof(Dataset));
+    wide->rows = 1;
+    wide->cols = 2;
+    wide->data = allocate_matrix(1, 2);
+    wide->labels = (int*)safe_calloc(1, sizeof(int));
+    wide->data[0][0] = 1.0;
+    transform_target_encoder(encoder, wide);
+    assert(wide->data[0][0] == 1.0);
+    free_dataset(wide);
+    int out_of_range[1] = {3};
+    TargetEncoder* narrow = create_target_encoder(TARGET_WOE, out_of_range, 1, 0.5);
+    fit_target_encoder(narrow, dataset);
+    assert(narrow->n_input == 0 && narrow->values[0] == NULL);
+    free_target_encoder(narrow);
+    
+    // Encodage par la moyenne : une modalité inconnue prend le taux global
+    TargetEncoder* mean_encoder = create_target_encoder(TARGET_MEAN, columns, 1, 2.0);
+    for (int i = 0; i < n; i++) dataset->data[i][0] = codes[i];
+    fit_target_encoder(mean_encoder, dataset);
+    assert(fabs(target_encode_value(mean_encoder, 0, -1.0) - 0.5) < 1e-12);
+    assert(fabs(mean_encoder->values[0][1] - (3.0 + 2.0 * 0.5) / (4.0 + 2.0)) < 1e-12);
+    
+    free(odd.data);
+    free(odd.labels);
+    free_target_encoder(encoder);
+    free_target_encoder(odd_encoder);
+    free_target_encoder(loaded);
+    free_target_encoder(mean_encoder);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+static int compare_double_values(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+void test_median_imputer() {
+    printf("Test 10: Imputation médiane/quantile/constante... ");
+    
+    // Sélection linéaire = tri complet, y compris avec beaucoup de doublons
+    int n = 5001;
+    double* values = (double*)safe_malloc(n * sizeof(double));
+    double* sorted = (double*)safe_malloc(n * sizeof(double));
+    unsigned int state = 42;
+    for (int i = 0; i < n; i++) {
+        state = state * 1103515245u + 12345u;
+        sorted[i] = (double)((state >> 8) % 50);
+    }
+    qsort(sorted, n, sizeof(double), compare_double_values);
+    double quantiles[4] = {0.0, 0.25, 0.5, 0.9};
+    for (int q = 0; q < 4; q++) {
+        for (int i = 0; i < n; i++) values[i] = sorted[(i * 7919) % n];
+        double position = quantiles[q] * (n - 1);
+        int k = (int)position;
+        double expected = sorted[k] + (position - k) * (sorted[k + 1 < n ? k + 1 : k] - sorted[k]);
+        assert(fabs(select_quantile(values, n, quantiles[q]) - expected) < 1e-12);
+    }
+    double small[4] = {4.0, 1.0, 3.0, 2.0};
+    assert(select_quantile(small, 4, 0.5) == 2.5);
+    
+    // Train : colonne à queue lourde avec une valeur manquante ; test : uniquement manquant
+    Dataset* train = (Dataset*)safe_malloc(sizeof(Dataset));
+    train->rows = 5;
+    train->cols = 2;
+    train->data = allocate_matrix(5, 2);
+    train->labels = (int*)safe_calloc(5, sizeof(int));
+    double incomes[5] = {30000, 35000, NAN, 40000, 2000000};
+    for (int i = 0; i < 5; i++) {
+        train->data[i][0] = incomes[i];
+        train->data[i][1] = i;
+    }
+    Dataset* test = (Dataset*)safe_malloc(sizeof(Dataset));
+    test->rows = 1;
+    test->cols = 2;
+    test->data = allocate_matrix(1, 2);
+    test->labels = (int*)safe_calloc(1, sizeof(int));
+    test->data[0][0] = NAN;
+    test->data[0][1] = NAN;
+    
+    Imputer* median = create_imputer(IMPUTE_MEDIAN, 0.0, 0.0, 0);
+    fit_imputer(median, train);
+    assert(median->values[0] == 37500.0 && median->values[1] == 2.0);
+    transform_imputer(median, test);
+    assert(test->data[0][0] == 37500.0 && test->data[0][1] == 2.0);
+    
+    Imputer* mean = create_imputer(IMPUTE_MEAN, 0.0, 0.0, 0);
+    fit_imputer(mean, train);
+    assert(fabs(mean->values[0] - 526250.0) < 1e-6);
+    
+    // Moyenne sauvegardée, rechargée puis complétée par un lot : identique à l'ajustement sur les données concaténées
+    Dataset* extra = (Dataset*)safe_malloc(sizeof(Dataset));
+    extra->rows = 3;
+    extra->cols = 2;
+    extra->data = allocate_matrix(3, 2);
+    extra->labels = (int*)safe_calloc(3, sizeof(int));
+    double extra_incomes[3] = {25000, NAN, 50000};
+    for (int i = 0; i < 3; i++) {
+        extra->data[i][0] = extra_incomes[i];
+        extra->data[i][1] = 10.0 + i;
+    }
+    save_imputer("test_imputer.bin", mean);
+    Imputer* resumed = load_imputer("test_imputer.bin");
+    assert(resumed != NULL && resumed->stats != NULL && resumed->stats->count[0] == 4);
+    partial_fit_imputer(resumed, extra);
+    remove("test_imputer.bin");
+    
+    Dataset* all = (Dataset*)safe_malloc(sizeof(Dataset));
+    all->rows = 8;
+    all->cols = 2;
+    all->data = allocate_matrix(8, 2);
+    all->labels = (int*)safe_calloc(8, sizeof(int));
+    for (int i = 0; i < 8; i++) {
+        double* source = (i < 5) ? train->data[i] : extra->data[i - 5];
+        all->data[i][0] = source[0];
+        all->data[i][1] = source[1];
+    }
+    Imputer* concatenated = create_imputer(IMPUTE_MEAN, 0.0, 0.0, 0);
+    fit_imputer(concatenated, all);
+    for (int j = 0; j < 2; j++) {
+        assert(fabs(resumed->values[j] - concatenated->values[j]) < 1e-9 * fabs(concatenated->values[j]));
+        assert(resumed->stats->count[j] == concatenated->stats->count[j]);
+    }
+    free_imputer(resumed);
+    free_imputer(concatenated);
+    free_dataset(extra);
+    free_dataset(all);
+    
+    Imputer* constant = create_imputer(IMPUTE_CONSTANT, 0.0, -1.0, 0);
+    fit_imputer(constant, train);
+    transform_imputer(constant, train);
+    assert(train->data[2][0] == -1.0);
+    
+    free(values);
+    free(sorted);
+    free_imputer(median);
+    free_imputer(mean);
+    free_imputer(constant);
+    free_dataset(train);
+    free_dataset(test);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_quantile_sketch() {
+    printf("Test 11: Sketch de quantiles KLL fusionnable... ");
+    
+    // Distribution exponentielle (queue lourde) répartie sur deux sketches fusionnés
+    int n = 100000;
+    double* values = (double*)safe_malloc(n * sizeof(double));
+    QuantileSketch* part_a = create_quantile_sketch(200);
+    QuantileSketch* part_b = create_quantile_sketch(200);
+    unsigned int state = 7;
+    for (int i = 0; i < n; i++) {
+        state = state * 1103515245u + 12345u;
+        double u = ((state >> 8) + 0.5) / 16777216.0;
+        values[i] = -10000.0 * log(u);
+        sketch_update(i % 3 ? part_a : part_b, values[i]);
+    }
+    sketch_merge(part_a, part_b);
+    assert(part_a->count == n);
+    
+    qsort(values, n, sizeof(double), compare_double_values);
+    double quantiles[5] = {0.05, 0.25, 0.5, 0.9, 0.99};
+    for (int q = 0; q < 5; q++) {
+        double estimate = sketch_quantile(part_a, quantiles[q]);
+        // Erreur de rang : position de l'estimation dans les données triées
+        int rank = 0;
+        while (rank < n && values[rank] < estimate) rank++;
+        assert(fabs((double)rank / n - quantiles[q]) < 0.02);
+    }
+    
+    // Imputeur approché alimenté par lots, puis sauvegardé avec ses sketches
+    Dataset* batch = (Dataset*)safe_malloc(sizeof(Dataset));
+    batch->rows = 1000;
+    batch->cols = 1;
+    batch->data = allocate_matrix(1000, 1);
+    batch->labels = (int*)safe_calloc(1000, sizeof(int));
+    Imputer* imputer = create_imputer(IMPUTE_QUANTILE, 0.5, 0.0, 1);
+    for (int b = 0; b < 10; b++) {
+        for (int i = 0; i < 1000; i++) batch->data[i][0] = values[(i * 97 + b) % n];
+        partial_fit_imputer(imputer, batch);
+    }
+    double median = values[n / 2];
+    assert(fabs(imputer->values[0] - median) / median < 0.1);
+    
+    save_imputer("test_imputer.bin", imputer);
+    Imputer* loaded = load_imputer("test_imputer.bin");
+    assert(loaded != NULL && loaded->sketches != NULL);
+    assert(loaded->values[0] == imputer->values[0]);
+    assert(loaded->sketches[0]->count == 10000);
+    remove("test_imputer.bin");
+    
+    free(values);
+    free_quantile_sketch(part_a);
+    free_quantile_sketch(part_b);
+    free_imputer(imputer);
+    free_imputer(loaded);
+    free_dataset(batch);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_binner() {
+    printf("Test 12: Discrétisation par quantiles en codes uint8... ");
+    
+    // Colonne 0 : 1000 valeurs distinctes ; colonne 1 : 3 valeurs répétées et une valeur manquante
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = 1000;
+    dataset->cols = 2;
+    dataset->data = allocate_matrix(1000, 2);
+    dataset->labels = (int*)safe_calloc(1000, sizeof(int));
+    for (int i = 0; i < 1000; i++) {
+        dataset->data[i][0] = (double)((i * 7919) % 1000);
+        dataset->data[i][1] = (double)(i % 3);
+        dataset->labels[i] = i % 2;
+    }
+    dataset->data[5][1] = NAN;
+    
+    Binner* binner = create_binner(10, 0);
+    fit_binner(binner, dataset);
+    assert(binner->n_bins[0] == 10 && binner->n_bins[1] == 3);
+    
+    BinnedDataset* binned = binner_transform(binner, dataset);
+    assert(binned != NULL && binned->rows == 1000 && binned->labels[3] == 1);
+    int counts[10] = {0};
+    for (int i = 0; i < 1000; i++) {
+        uint8_t code = binned->codes[i];
+        double value = dataset->data[i][0];
+        // Effectifs égaux et convention x <= borne supérieure
+        counts[code]++;
+        assert(value <= bin_upper_edge(binner, 0, code));
+        assert(code == 0 || value > bin_upper_edge(binner, 0, code - 1));
+        assert(bin_value(binner, 0, value) == code);
+    }
+    for (int b = 0; b < 10; b++) assert(counts[b] == 100);
+    assert(binned->codes[1000 + 5] == BIN_MISSING);
+    assert(binned->codes[1000 + 4] == 1);
+    assert(bin_value(binner, 0, -1e9) == 0 && bin_value(binner, 0, 1e9) == 9);
+    
+    // Mode approché : bornes proches des bornes exactes
+    Binner* approx = create_binner(10, 1);
+    fit_binner(approx, dataset);
+    assert(approx->n_bins[0] == 10);
+    for (int b = 0; b < 9; b++) {
+        assert(fabs(approx->edges[0][b] - binner->edges[0][b]) <= 20.0);
+    }
+    
+    save_binner("test_binner.bin", approx);
+    Binner* loaded = load_binner("test_binner.bin");
+    assert(loaded != NULL && loaded->sketches != NULL && loaded->n_bins[1] == 3);
+    for (int i = 0; i < 1000; i++) {
+        assert(bin_value(loaded, 0, dataset->data[i][0]) == bin_value(approx, 0, dataset->data[i][0]));
+    }
+    remove("test_binner.bin");
+    
+    free_binned_dataset(binned);
+    free_binner(binner);
+    free_binner(approx);
+    free_binner(loaded);
+    free_dataset(dataset);
+    
+    printf("✓ PASSÉ\n");
+}
+
+void test_transform_variants() {
+    printf("Test 13: Normalisation en place, hors place et float32... ");
+    
+    // Plusieurs blocs de lignes pour couvrir le découpage parallèle
+    int rows = 2500, cols = 5;
+    Dataset* dataset = (Dataset*)safe_malloc(sizeof(Dataset));
+    dataset->rows = rows;
+    dataset->cols = cols;
+    dataset->data = allocate_matrix(rows, cols);
+    dataset->labels = (int*)safe_calloc(rows, sizeof(int));
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            dataset->data[i][j] = (double)((i * 31 + j * 17) % 101) * (j + 1) * 1000.0;
+        }
+        dataset->labels[i] = i % 2;
+    }
+    Scaler* scaler = fit_scaler(dataset);
+    
+    Dataset* scaled = transform_dataset_copy(dataset, scaler);
+    float* scaled_f32 = (float*)safe_malloc(rows * cols * sizeof(float));
+    transform_dataset_f32(dataset, scaler, scaled_f32);
+    for (int i = 0; i < rows; i++) {
+        assert(scaled->labels[i] == dataset->labels[i]);
+        for (int j = 0; j < cols; j++) {
+            double expected = (dataset->data[i][j] - scaler->mean[j]) / scaler->std[j];
+            assert(fabs(scaled->data[i][j] - expected) < 1e-12);
+            assert(fabs(scaled_f32[i * cols + j] - expected) < 1e-6);
+        }
+    }
+    // Les données brutes sont conservées par les variantes hors place
+    assert(dataset->data[1][1] == 48.0 * 2 * 1000.0);
+    
+    transform_dataset(dataset, scaler);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            assert(dataset->data[i][j] == scaled->data[i][j]);
+        }
+    }
+    
+    free(scaled_f32);
+    free_dataset(scaled);
+    free_dataset(dataset);
+    free_scaler(scaler);
+    
+    printf("✓ PASSÉ\n");
+}
+
 int main() {
     printf("\n=== TESTS DU PRÉTRAITEMENT ===\n\n");
     
@@ -212,6 +771,14 @@ int main() {
     test_scaler_save_load();
     test_handle_missing_values();
     test_preprocess_dataset();
+    test_feature_hasher();
+    test_running_stats_merge();
+    test_one_hot_encoder();
+    test_woe_encoder();
+    test_median_imputer();
+    test_quantile_sketch();
+    test_binner();
+    test_transform_variants();
     
     printf("\n✓ Tous les tests sont passés avec succès!\n\n");
     return 0;